@@ -0,0 +1,403 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "bench.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+// Largest number of benchmarks the suite can hold
+#define FOSSIL_MATH_BENCH_MAX 256
+// Upper bound on timed iterations of one case
+#define FOSSIL_MATH_BENCH_MAX_ITERS 1000000000u
+
+typedef struct {
+    const char* filter;     // substring a case name must contain (NULL = all)
+    const char* json;       // JSON output path, "-" for stdout (NULL = none)
+    size_t repetitions;
+    double min_time;        // seconds each repetition should last
+    int list;
+} fossil_math_bench_options_t;
+
+typedef struct {
+    char name[128];
+    size_t iterations;
+    size_t reps;
+    double* real;           // ns per iteration, one per repetition
+    double* cpu;
+    double items;
+    double bytes;
+    const char* error;
+} fossil_math_bench_result_t;
+
+static const fossil_math_bench_def_t* fossil_math_bench_defs[FOSSIL_MATH_BENCH_MAX];
+static size_t fossil_math_bench_count = 0;
+static volatile double fossil_math_bench_sink;
+
+// ============================================================================
+// Clocks
+// ============================================================================
+
+static double fossil_math_bench_wall(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+static double fossil_math_bench_cpu(void) {
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+}
+
+// ============================================================================
+// Benchmark API
+// ============================================================================
+
+int fossil_math_bench_run(fossil_math_bench_state_t* state) {
+    if (state->error) return 0;
+    if (state->done == 0) {
+        state->cpu_start = fossil_math_bench_cpu();
+        state->real_start = fossil_math_bench_wall();
+    }
+    if (state->done < state->iterations) {
+        state->done++;
+        return 1;
+    }
+    state->real_time = fossil_math_bench_wall() - state->real_start;
+    state->cpu_time = fossil_math_bench_cpu() - state->cpu_start;
+    return 0;
+}
+
+void fossil_math_bench_set_items(fossil_math_bench_state_t* state, double items) {
+    state->items = items;
+}
+
+void fossil_math_bench_set_bytes(fossil_math_bench_state_t* state, double bytes) {
+    state->bytes = bytes;
+}
+
+void fossil_math_bench_skip(fossil_math_bench_state_t* state, const char* reason) {
+    state->error = reason ? reason : "skipped";
+}
+
+void fossil_math_bench_keep(double value) {
+    fossil_math_bench_sink = value;
+}
+
+void fossil_math_bench_register(const fossil_math_bench_def_t* defs, size_t count) {
+    for (size_t i = 0; i < count && fossil_math_bench_count < FOSSIL_MATH_BENCH_MAX; ++i) {
+        fossil_math_bench_defs[fossil_math_bench_count++] = &defs[i];
+    }
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+static int fossil_math_bench_cmp(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    double mean;
+    double median;
+    double stddev;
+    double min;
+} fossil_math_bench_stats_t;
+
+static fossil_math_bench_stats_t fossil_math_bench_summarize(const double* v, size_t n) {
+    fossil_math_bench_stats_t s = {0.0, 0.0, 0.0, 0.0};
+    if (n == 0) return s;
+    double* sorted = malloc(n * sizeof(double));
+    if (!sorted) return s;
+    memcpy(sorted, v, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), fossil_math_bench_cmp);
+    for (size_t i = 0; i < n; ++i) s.mean += sorted[i];
+    s.mean /= (double)n;
+    for (size_t i = 0; i < n; ++i) s.stddev += (sorted[i] - s.mean) * (sorted[i] - s.mean);
+    s.stddev = n > 1 ? sqrt(s.stddev / (double)(n - 1)) : 0.0;
+    s.median = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    s.min = sorted[0];
+    free(sorted);
+    return s;
+}
+
+// ============================================================================
+// Running
+// ============================================================================
+
+static fossil_math_bench_state_t fossil_math_bench_once(const fossil_math_bench_def_t* def, size_t arg, size_t threads,
+                                                        size_t iterations) {
+    fossil_math_bench_state_t state;
+    memset(&state, 0, sizeof(state));
+    state.arg = arg;
+    state.threads = threads;
+    state.iterations = iterations;
+    def->fn(&state);
+    return state;
+}
+
+// Grows the iteration count until one run lasts min_time, then repeats it
+static void fossil_math_bench_case(const fossil_math_bench_def_t* def, size_t arg, size_t threads,
+                                   const fossil_math_bench_options_t* opts, fossil_math_bench_result_t* res) {
+    fossil_math_parallel_set_threads(threads);
+    size_t iterations = 1;
+    fossil_math_bench_state_t state;
+    for (;;) {
+        state = fossil_math_bench_once(def, arg, threads, iterations);
+        if (state.error || state.real_time >= opts->min_time || iterations >= FOSSIL_MATH_BENCH_MAX_ITERS) break;
+        // Aim 40% past the target from the last measurement, growing at most 10x
+        double scale = state.real_time > 0.0 ? 1.4 * opts->min_time / state.real_time : 10.0;
+        size_t next = (size_t)((double)iterations * FOSSIL_MATH_MIN(scale, 10.0)) + 1;
+        iterations = FOSSIL_MATH_MIN(next, (size_t)FOSSIL_MATH_BENCH_MAX_ITERS);
+    }
+    res->iterations = iterations;
+    res->error = state.error;
+    res->items = state.items;
+    res->bytes = state.bytes;
+    res->reps = 0;
+    for (size_t r = 0; r < opts->repetitions && !res->error; ++r) {
+        if (r > 0) state = fossil_math_bench_once(def, arg, threads, iterations);
+        if (state.error) {
+            res->error = state.error;
+            break;
+        }
+        res->real[r] = 1e9 * state.real_time / (double)iterations;
+        res->cpu[r] = 1e9 * state.cpu_time / (double)iterations;
+        res->reps++;
+    }
+    fossil_math_parallel_set_threads(0);
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static void fossil_math_bench_json_run(FILE* out, const fossil_math_bench_result_t* res, const char* type,
+                                       const char* aggregate, size_t index, double real, double cpu, int* first) {
+    fprintf(out, "%s\n    {\n", *first ? "" : ",");
+    *first = 0;
+    fprintf(out, "      \"name\": \"%s%s%s\",\n", res->name, aggregate ? "_" : "", aggregate ? aggregate : "");
+    fprintf(out, "      \"run_name\": \"%s\",\n", res->name);
+    fprintf(out, "      \"run_type\": \"%s\",\n", type);
+    fprintf(out, "      \"repetitions\": %zu,\n", res->reps);
+    if (aggregate) {
+        fprintf(out, "      \"aggregate_name\": \"%s\",\n", aggregate);
+    } else {
+        fprintf(out, "      \"repetition_index\": %zu,\n", index);
+    }
+    fprintf(out, "      \"iterations\": %zu,\n", res->iterations);
+    fprintf(out, "      \"real_time\": %.6g,\n", real);
+    fprintf(out, "      \"cpu_time\": %.6g,\n", cpu);
+    if (res->items > 0.0 && real > 0.0 && !(aggregate && strcmp(aggregate, "stddev") == 0)) {
+        fprintf(out, "      \"items_per_second\": %.6g,\n", 1e9 * res->items / real);
+    }
+    if (res->bytes > 0.0 && real > 0.0 && !(aggregate && strcmp(aggregate, "stddev") == 0)) {
+        fprintf(out, "      \"bytes_per_second\": %.6g,\n", 1e9 * res->bytes / real);
+    }
+    fprintf(out, "      \"time_unit\": \"ns\"\n    }");
+}
+
+static int fossil_math_bench_write_json(const char* path, const fossil_math_bench_result_t* results, size_t count,
+                                        const fossil_math_bench_options_t* opts) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out) return -1;
+    char date[64] = "";
+    time_t now = time(NULL);
+    struct tm* tm = localtime(&now);
+    if (tm) strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", tm);
+    fossil_math_parallel_set_threads(0);
+    fprintf(out, "{\n  \"context\": {\n");
+    fprintf(out, "    \"date\": \"%s\",\n", date);
+    fprintf(out, "    \"executable\": \"fossil_math_bench\",\n");
+    fprintf(out, "    \"num_cpus\": %zu,\n", fossil_math_parallel_threads());
+    fprintf(out, "    \"repetitions\": %zu,\n", opts->repetitions);
+    fprintf(out, "    \"min_time\": %g,\n", opts->min_time);
+#if defined(NDEBUG)
+    fprintf(out, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(out, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(out, "  },\n  \"benchmarks\": [");
+    int first = 1;
+    for (size_t i = 0; i < count; ++i) {
+        const fossil_math_bench_result_t* res = &results[i];
+        if (res->error || res->reps == 0) continue;
+        for (size_t r = 0; r < res->reps; ++r) {
+            fossil_math_bench_json_run(out, res, "iteration", NULL, r, res->real[r], res->cpu[r], &first);
+        }
+        if (res->reps < 2) continue;
+        fossil_math_bench_stats_t real = fossil_math_bench_summarize(res->real, res->reps);
+        fossil_math_bench_stats_t cpu = fossil_math_bench_summarize(res->cpu, res->reps);
+        fossil_math_bench_json_run(out, res, "aggregate", "mean", 0, real.mean, cpu.mean, &first);
+        fossil_math_bench_json_run(out, res, "aggregate", "median", 0, real.median, cpu.median, &first);
+        fossil_math_bench_json_run(out, res, "aggregate", "stddev", 0, real.stddev, cpu.stddev, &first);
+        fossil_math_bench_json_run(out, res, "aggregate", "min", 0, real.min, cpu.min, &first);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    int failed = ferror(out);
+    if (out != stdout) failed |= fclose(out);
+    return failed ? -1 : 0;
+}
+
+static void fossil_math_bench_print(FILE* out, const fossil_math_bench_result_t* res) {
+    if (res->error) {
+        fprintf(out, "%-48s SKIPPED: %s\n", res->name, res->error);
+        return;
+    }
+    fossil_math_bench_stats_t real = fossil_math_bench_summarize(res->real, res->reps);
+    fossil_math_bench_stats_t cpu = fossil_math_bench_summarize(res->cpu, res->reps);
+    fprintf(out, "%-48s %14.1f ns %14.1f ns %6.2f%% %12zu", res->name, real.median, cpu.median,
+            real.mean > 0.0 ? 100.0 * real.stddev / real.mean : 0.0, res->iterations);
+    if (res->items > 0.0 && real.median > 0.0) fprintf(out, " %10.4g items/s", 1e9 * res->items / real.median);
+    if (res->bytes > 0.0 && real.median > 0.0) fprintf(out, " %10.4g B/s", 1e9 * res->bytes / real.median);
+    fprintf(out, "\n");
+}
+
+// ============================================================================
+// Entry Point
+// ============================================================================
+
+static int fossil_math_bench_parse(int argc, char** argv, fossil_math_bench_options_t* opts) {
+    opts->filter = NULL;
+    opts->json = NULL;
+    opts->repetitions = 5;
+    opts->min_time = 0.1;
+    opts->list = 0;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (strncmp(a, "--filter=", 9) == 0) {
+            opts->filter = a + 9;
+        } else if (strncmp(a, "--json=", 7) == 0) {
+            opts->json = a + 7;
+        } else if (strncmp(a, "--repetitions=", 14) == 0) {
+            long n = strtol(a + 14, NULL, 10);
+            if (n < 1 || n > 1000) return -1;
+            opts->repetitions = (size_t)n;
+        } else if (strncmp(a, "--min-time=", 11) == 0) {
+            opts->min_time = strtod(a + 11, NULL);
+            if (!(opts->min_time >= 0.0)) return -1;
+        } else if (strcmp(a, "--list") == 0) {
+            opts->list = 1;
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    fossil_math_bench_options_t opts;
+    if (fossil_math_bench_parse(argc, argv, &opts) != 0) {
+        fprintf(stderr, "usage: %s [--filter=SUBSTRING] [--repetitions=N] [--min-time=SECONDS] [--json=PATH|-] [--list]\n",
+                argv[0]);
+        return 2;
+    }
+
+    fossil_math_bench_register_tensor();
+    fossil_math_bench_register_algebra();
+    fossil_math_bench_register_calc();
+    fossil_math_bench_register_ode();
+    fossil_math_bench_register_symbolic();
+
+    // Thread counts beyond the machine only measure oversubscription
+    fossil_math_parallel_set_threads(0);
+    size_t hardware = fossil_math_parallel_threads();
+
+    size_t cap = 64, count = 0;
+    fossil_math_bench_result_t* results = malloc(cap * sizeof(*results));
+    if (!results) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    FILE* console = opts.json && strcmp(opts.json, "-") == 0 ? stderr : stdout;
+    if (!opts.list) {
+        fprintf(console, "%-48s %17s %17s %7s %12s\n", "Benchmark", "Time", "CPU", "CV", "Iterations");
+    }
+
+    int status = 0;
+    for (size_t d = 0; d < fossil_math_bench_count; ++d) {
+        const fossil_math_bench_def_t* def = fossil_math_bench_defs[d];
+        for (size_t a = 0; a < 8 && (a == 0 || def->args[a]); ++a) {
+            for (size_t t = 0; t < 8 && (t == 0 || def->threads[t]); ++t) {
+                size_t threads = def->threads[t] ? def->threads[t] : 1;
+                if (t > 0 && threads > hardware) continue;
+                char name[128];
+                snprintf(name, sizeof(name), "%s/%zu/threads:%zu", def->name, def->args[a], threads);
+                if (opts.filter && !strstr(name, opts.filter)) continue;
+                if (opts.list) {
+                    printf("%s\n", name);
+                    continue;
+                }
+                if (count == cap) {
+                    fossil_math_bench_result_t* grown = realloc(results, 2 * cap * sizeof(*results));
+                    if (!grown) {
+                        status = 1;
+                        break;
+                    }
+                    results = grown;
+                    cap *= 2;
+                }
+                fossil_math_bench_result_t* res = &results[count];
+                memset(res, 0, sizeof(*res));
+                memcpy(res->name, name, sizeof(name));
+                res->real = malloc(2 * opts.repetitions * sizeof(double));
+                if (!res->real) {
+                    status = 1;
+                    break;
+                }
+                res->cpu = res->real + opts.repetitions;
+                fossil_math_bench_case(def, def->args[a], threads, &opts, res);
+                fossil_math_bench_print(console, res);
+                fflush(console);
+                count++;
+            }
+        }
+    }
+
+    if (opts.json && !opts.list && fossil_math_bench_write_json(opts.json, results, count, &opts) != 0) {
+        fprintf(stderr, "cannot write %s\n", opts.json);
+        status = 1;
+    }
+    for (size_t i = 0; i < count; ++i) free(results[i].real);
+    free(results);
+    return status;
+}
@@ -0,0 +1,127 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_BENCH_H
+#define FOSSIL_MATH_BENCH_H
+
+#include <fossil/math/framework.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Per-run state handed to a benchmark function.
+ *
+ * A benchmark prepares its inputs, then loops on fossil_math_bench_run();
+ * only the loop is timed. arg and threads select the case being run; the
+ * harness has already applied threads with fossil_math_parallel_set_threads().
+ */
+typedef struct {
+    size_t arg;             ///< Problem size of this case
+    size_t threads;         ///< Worker threads of this case
+    size_t iterations;      ///< Loop iterations requested by the harness
+    size_t done;            ///< Loop iterations started so far
+    double real_start;      ///< Wall clock at the first iteration (seconds)
+    double cpu_start;       ///< Process CPU time at the first iteration (seconds)
+    double real_time;       ///< Wall time of the loop (seconds)
+    double cpu_time;        ///< Process CPU time of the loop (seconds)
+    double items;           ///< Items processed per iteration (0 = not reported)
+    double bytes;           ///< Bytes touched per iteration (0 = not reported)
+    const char* error;      ///< Set by fossil_math_bench_skip()
+} fossil_math_bench_state_t;
+
+/**
+ * @brief Benchmark body.
+ */
+typedef void (*fossil_math_bench_fn_t)(fossil_math_bench_state_t* state);
+
+/**
+ * @brief A parameterized benchmark: one case per (arg, threads) pair.
+ *
+ * Cases are named "name/arg/threads:t". Kernels that do not use the worker
+ * threads list a single thread count of 1.
+ */
+typedef struct {
+    const char* name;
+    fossil_math_bench_fn_t fn;
+    size_t args[8];         ///< Problem sizes, terminated by 0 or the array end
+    size_t threads[8];      ///< Thread counts, terminated by 0 or the array end
+} fossil_math_bench_def_t;
+
+// ============================================================================
+// Benchmark API
+// ============================================================================
+
+/**
+ * @brief Advances the timed loop.
+ *
+ * Starts the timer on the first call and stops it once the requested
+ * iterations have run.
+ *
+ * @return Non-zero while the body should run again.
+ */
+int fossil_math_bench_run(fossil_math_bench_state_t* state);
+
+/**
+ * @brief Reports throughput per iteration, shown as items/s and bytes/s.
+ */
+void fossil_math_bench_set_items(fossil_math_bench_state_t* state, double items);
+void fossil_math_bench_set_bytes(fossil_math_bench_state_t* state, double bytes);
+
+/**
+ * @brief Marks the case as skipped (e.g. setup failed). Call before the loop.
+ */
+void fossil_math_bench_skip(fossil_math_bench_state_t* state, const char* reason);
+
+/**
+ * @brief Keeps a result alive so the compiler cannot discard its computation.
+ */
+void fossil_math_bench_keep(double value);
+
+/**
+ * @brief Adds count benchmarks to the suite.
+ */
+void fossil_math_bench_register(const fossil_math_bench_def_t* defs, size_t count);
+
+// ============================================================================
+// Modules
+// ============================================================================
+
+void fossil_math_bench_register_tensor(void);
+void fossil_math_bench_register_algebra(void);
+void fossil_math_bench_register_calc(void);
+void fossil_math_bench_register_ode(void);
+void fossil_math_bench_register_symbolic(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_MATH_BENCH_H */
@@ -0,0 +1,107 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Fills an n x n matrix with values in [0, 1) and a dominant diagonal
+static double* bench_algebra_matrix(size_t n) {
+    double* m = malloc(n * n * sizeof(double));
+    if (!m) return NULL;
+    for (size_t i = 0; i < n * n; ++i) m[i] = (double)((i * 2654435761u) % 1000) / 1000.0;
+    for (size_t i = 0; i < n; ++i) m[i * n + i] += (double)n;
+    return m;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+// Product of two arg x arg matrices; items are flops
+static void bench_algebra_matrix_mul(fossil_math_bench_state_t* st) {
+    size_t n = st->arg;
+    double* a = bench_algebra_matrix(n);
+    double* b = bench_algebra_matrix(n);
+    double* c = malloc(n * n * sizeof(double));
+    if (!a || !b || !c) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        fossil_math_algebra_matrix_mul(a, n, n, b, n, n, c);
+        fossil_math_bench_keep(c[0]);
+    }
+    fossil_math_bench_set_items(st, 2.0 * (double)n * (double)n * (double)n);
+    free(a);
+    free(b);
+    free(c);
+}
+
+// LU factorization of an arg x arg matrix; items are flops
+static void bench_algebra_lu(fossil_math_bench_state_t* st) {
+    size_t n = st->arg;
+    double* a = bench_algebra_matrix(n);
+    double* lu = malloc(n * n * sizeof(double));
+    size_t* piv = malloc(n * sizeof(size_t));
+    if (!a || !lu || !piv) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        memcpy(lu, a, n * n * sizeof(double));
+        fossil_math_algebra_lu_decompose(lu, n, piv);
+        fossil_math_bench_keep(lu[n * n - 1]);
+    }
+    fossil_math_bench_set_items(st, 2.0 / 3.0 * (double)n * (double)n * (double)n);
+    free(a);
+    free(lu);
+    free(piv);
+}
+
+// Dot product of two vectors of arg elements
+static void bench_algebra_dot(fossil_math_bench_state_t* st) {
+    size_t n = st->arg;
+    double* x = malloc(n * sizeof(double));
+    double* y = malloc(n * sizeof(double));
+    if (!x || !y) fossil_math_bench_skip(st, "allocation failed");
+    for (size_t i = 0; i < n && x && y; ++i) {
+        x[i] = (double)(i % 17) * 0.25;
+        y[i] = (double)(i % 13) * 0.5;
+    }
+    while (fossil_math_bench_run(st)) fossil_math_bench_keep(fossil_math_algebra_dot(x, y, n));
+    fossil_math_bench_set_items(st, 2.0 * (double)n);
+    fossil_math_bench_set_bytes(st, 2.0 * sizeof(double) * (double)n);
+    free(x);
+    free(y);
+}
+
+static const fossil_math_bench_def_t bench_algebra_defs[] = {
+    {"algebra_matrix_mul", bench_algebra_matrix_mul, {16, 64, 256}, {1}},
+    {"algebra_lu_decompose", bench_algebra_lu, {16, 64, 256}, {1}},
+    {"algebra_dot", bench_algebra_dot, {1024, 65536, 1048576}, {1}},
+};
+
+void fossil_math_bench_register_algebra(void) {
+    fossil_math_bench_register(bench_algebra_defs, sizeof(bench_algebra_defs) / sizeof(bench_algebra_defs[0]));
+}
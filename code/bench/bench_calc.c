@@ -0,0 +1,99 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "bench.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static double bench_calc_integrand(double x) {
+    return sin(x) * exp(-0.1 * x);
+}
+
+// f_i(x) = x^3 - c_i with the roots cube roots of c_i in [1, 2]
+static void bench_calc_cubic(const size_t* index, const double* x, double* fx, size_t count, void* ctx) {
+    const double* c = (const double*)ctx;
+    for (size_t k = 0; k < count; ++k) fx[k] = x[k] * x[k] * x[k] - c[index[k]];
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+// Composite Simpson rule with arg panels
+static void bench_calc_simpson(fossil_math_bench_state_t* st) {
+    while (fossil_math_bench_run(st)) {
+        fossil_math_bench_keep(fossil_math_calc_integrate_simpson(bench_calc_integrand, 0.0, 10.0, st->arg));
+    }
+    fossil_math_bench_set_items(st, (double)st->arg);
+}
+
+// Composite trapezoidal rule with arg panels
+static void bench_calc_trapezoidal(fossil_math_bench_state_t* st) {
+    while (fossil_math_bench_run(st)) {
+        fossil_math_bench_keep(fossil_math_calc_integrate_trapezoidal(bench_calc_integrand, 0.0, 10.0, st->arg));
+    }
+    fossil_math_bench_set_items(st, (double)st->arg);
+}
+
+// arg independent cubic equations solved with batched Brent
+static void bench_calc_brent_batch(fossil_math_bench_state_t* st) {
+    size_t n = st->arg;
+    double* c = malloc(n * sizeof(double));
+    double* a = malloc(n * sizeof(double));
+    double* b = malloc(n * sizeof(double));
+    double* roots = malloc(n * sizeof(double));
+    if (!c || !a || !b || !roots) {
+        fossil_math_bench_skip(st, "allocation failed");
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            c[i] = 1.0 + 7.0 * (double)i / (double)n;
+            a[i] = 1.0;
+            b[i] = 2.0;
+        }
+    }
+    while (fossil_math_bench_run(st)) {
+        fossil_math_calc_root_brent_batch(bench_calc_cubic, c, a, b, roots, n, 1e-12, 100, NULL);
+        fossil_math_bench_keep(roots[0]);
+    }
+    fossil_math_bench_set_items(st, (double)n);
+    free(c);
+    free(a);
+    free(b);
+    free(roots);
+}
+
+static const fossil_math_bench_def_t bench_calc_defs[] = {
+    {"calc_integrate_simpson", bench_calc_simpson, {1000, 100000}, {1}},
+    {"calc_integrate_trapezoidal", bench_calc_trapezoidal, {1000, 100000}, {1}},
+    {"calc_root_brent_batch", bench_calc_brent_batch, {1024, 65536}, {1, 2, 4, 8}},
+};
+
+void fossil_math_bench_register_calc(void) {
+    fossil_math_bench_register(bench_calc_defs, sizeof(bench_calc_defs) / sizeof(bench_calc_defs[0]));
+}
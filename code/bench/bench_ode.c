@@ -0,0 +1,89 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "bench.h"
+
+#include <stdlib.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Damped oscillators y'' = -k y - 0.1 y' with stiffness k = 1 + system / 64
+static void bench_ode_oscillator(size_t system, double t, const double* y, double* dydt, void* ctx) {
+    (void)t;
+    (void)ctx;
+    double k = 1.0 + (double)(system % 64) / 64.0;
+    dydt[0] = y[1];
+    dydt[1] = -k * y[0] - 0.1 * y[1];
+}
+
+// Lorenz system, the classic non-stiff benchmark
+static void bench_ode_lorenz(double t, const double* y, double* dydt, void* ctx) {
+    (void)t;
+    (void)ctx;
+    dydt[0] = 10.0 * (y[1] - y[0]);
+    dydt[1] = y[0] * (28.0 - y[2]) - y[1];
+    dydt[2] = y[0] * y[1] - 8.0 / 3.0 * y[2];
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+// One Lorenz trajectory over [0, arg] with RK45
+static void bench_ode_rk45(fossil_math_bench_state_t* st) {
+    const double y0[3] = {1.0, 1.0, 1.0};
+    double t_out = (double)st->arg, y_out[3];
+    while (fossil_math_bench_run(st)) {
+        fossil_math_ode_rk45(bench_ode_lorenz, NULL, 3, 0.0, y0, &t_out, 1, y_out, NULL, NULL);
+        fossil_math_bench_keep(y_out[0]);
+    }
+}
+
+// arg oscillators integrated over [0, 10] as one batch
+static void bench_ode_batch(fossil_math_bench_state_t* st) {
+    size_t count = st->arg;
+    double* y = malloc(2 * count * sizeof(double));
+    if (!y) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        for (size_t i = 0; i < count; ++i) {
+            y[2 * i] = 1.0;
+            y[2 * i + 1] = 0.0;
+        }
+        fossil_math_ode_solve_batch(FOSSIL_MATH_ODE_RK45, bench_ode_oscillator, NULL, NULL, 2, count, 0.0, 10.0, y, NULL, NULL);
+        fossil_math_bench_keep(y[0]);
+    }
+    fossil_math_bench_set_items(st, (double)count);
+    free(y);
+}
+
+static const fossil_math_bench_def_t bench_ode_defs[] = {
+    {"ode_rk45_lorenz", bench_ode_rk45, {1, 10}, {1}},
+    {"ode_solve_batch", bench_ode_batch, {64, 1024}, {1, 2, 4, 8}},
+};
+
+void fossil_math_bench_register_ode(void) {
+    fossil_math_bench_register(bench_ode_defs, sizeof(bench_ode_defs) / sizeof(bench_ode_defs[0]));
+}
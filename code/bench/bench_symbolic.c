@@ -0,0 +1,135 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static double bench_sym_x = 0.5;
+
+static double bench_sym_lookup(const char* name) {
+    return name[0] == 'x' ? bench_sym_x : 1.5;
+}
+
+// Builds a sum of arg terms in x and y, so arg scales the expression size
+static fossil_math_sym_expr_t* bench_sym_expr(size_t terms) {
+    size_t cap = terms * 48 + 1;
+    char* text = malloc(cap);
+    if (!text) return NULL;
+    size_t len = 0;
+    for (size_t i = 0; i < terms && len < cap; ++i) {
+        len += (size_t)snprintf(text + len, cap - len, "%s%zu * sin(x * y + %zu) - x / (y + %zu)", i ? " + " : "", i + 1, i, i + 1);
+    }
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse(text);
+    free(text);
+    return expr;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+// Tree-walking evaluation with name lookups
+static void bench_sym_eval(fossil_math_bench_state_t* st) {
+    fossil_math_sym_expr_t* expr = bench_sym_expr(st->arg);
+    if (!expr) fossil_math_bench_skip(st, "parse failed");
+    while (fossil_math_bench_run(st)) fossil_math_bench_keep(fossil_math_sym_eval(expr, bench_sym_lookup));
+    fossil_math_sym_free(expr);
+}
+
+// Bytecode evaluation at one point
+static void bench_sym_eval_compiled(fossil_math_bench_state_t* st) {
+    const char* names[] = {"x", "y"};
+    const double vars[2] = {0.5, 1.5};
+    fossil_math_sym_expr_t* expr = bench_sym_expr(st->arg);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    if (!prog) fossil_math_bench_skip(st, "compile failed");
+    while (fossil_math_bench_run(st)) fossil_math_bench_keep(fossil_math_sym_eval_compiled(prog, vars));
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+// Columnar bytecode evaluation of an 8-term expression at arg points
+static void bench_sym_eval_batch(fossil_math_bench_state_t* st) {
+    const char* names[] = {"x", "y"};
+    size_t n = st->arg;
+    fossil_math_sym_expr_t* expr = bench_sym_expr(8);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    double* x = malloc(n * sizeof(double));
+    double* y = malloc(n * sizeof(double));
+    double* out = malloc(n * sizeof(double));
+    if (!prog || !x || !y || !out) {
+        fossil_math_bench_skip(st, "setup failed");
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = (double)i / (double)n;
+            y[i] = 1.0 + (double)(i % 100) / 100.0;
+        }
+    }
+    const double* cols[2] = {x, y};
+    while (fossil_math_bench_run(st)) {
+        fossil_math_sym_eval_batch(prog, cols, out, n);
+        fossil_math_bench_keep(out[0]);
+    }
+    fossil_math_bench_set_items(st, (double)n);
+    free(x);
+    free(y);
+    free(out);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+// Parsing an expression of arg terms
+static void bench_sym_parse(fossil_math_bench_state_t* st) {
+    size_t cap = st->arg * 48 + 1;
+    char* text = malloc(cap);
+    if (!text) fossil_math_bench_skip(st, "allocation failed");
+    size_t len = 0;
+    for (size_t i = 0; text && i < st->arg && len < cap; ++i) {
+        len += (size_t)snprintf(text + len, cap - len, "%s%zu * sin(x * y + %zu) - x / (y + %zu)", i ? " + " : "", i + 1, i, i + 1);
+    }
+    while (fossil_math_bench_run(st)) {
+        fossil_math_sym_expr_t* expr = fossil_math_sym_parse(text);
+        fossil_math_bench_keep(expr ? expr->value : 0.0);
+        fossil_math_sym_free(expr);
+    }
+    fossil_math_bench_set_bytes(st, (double)len);
+    free(text);
+}
+
+static const fossil_math_bench_def_t bench_sym_defs[] = {
+    {"sym_parse", bench_sym_parse, {1, 16, 256}, {1}},
+    {"sym_eval", bench_sym_eval, {1, 16, 256}, {1}},
+    {"sym_eval_compiled", bench_sym_eval_compiled, {1, 16, 256}, {1}},
+    {"sym_eval_batch", bench_sym_eval_batch, {1024, 65536}, {1, 2, 4, 8}},
+};
+
+void fossil_math_bench_register_symbolic(void) {
+    fossil_math_bench_register(bench_sym_defs, sizeof(bench_sym_defs) / sizeof(bench_sym_defs[0]));
+}
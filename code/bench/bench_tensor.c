@@ -0,0 +1,115 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "bench.h"
+
+#include <stdlib.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static fossil_math_tensor_t* bench_tensor_random(const size_t* shape, size_t dims) {
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, dims);
+    if (!t) return NULL;
+    size_t n = 1;
+    for (size_t d = 0; d < dims; ++d) n *= shape[d];
+    for (size_t i = 0; i < n; ++i) t->data[i] = (double)((i * 2654435761u) % 1000) / 1000.0;
+    return t;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+// 1D dot product of two vectors of arg elements
+static void bench_tensor_dot_1d(fossil_math_bench_state_t* st) {
+    size_t shape[1] = {st->arg};
+    fossil_math_tensor_t* a = bench_tensor_random(shape, 1);
+    fossil_math_tensor_t* b = bench_tensor_random(shape, 1);
+    if (!a || !b) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        fossil_math_tensor_t* r = fossil_math_tensor_dot(a, b);
+        fossil_math_bench_keep(r->data[0]);
+        fossil_math_tensor_free(r);
+    }
+    fossil_math_bench_set_items(st, 2.0 * (double)st->arg);
+    fossil_math_bench_set_bytes(st, 2.0 * sizeof(double) * (double)st->arg);
+    fossil_math_tensor_free(a);
+    fossil_math_tensor_free(b);
+}
+
+// Square matrix product of two arg x arg tensors; items are flops
+static void bench_tensor_dot_2d(fossil_math_bench_state_t* st) {
+    size_t shape[2] = {st->arg, st->arg};
+    fossil_math_tensor_t* a = bench_tensor_random(shape, 2);
+    fossil_math_tensor_t* b = bench_tensor_random(shape, 2);
+    if (!a || !b) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        fossil_math_tensor_t* r = fossil_math_tensor_dot(a, b);
+        fossil_math_bench_keep(r->data[0]);
+        fossil_math_tensor_free(r);
+    }
+    fossil_math_bench_set_items(st, 2.0 * (double)st->arg * (double)st->arg * (double)st->arg);
+    fossil_math_tensor_free(a);
+    fossil_math_tensor_free(b);
+}
+
+// Element-wise sum of two vectors of arg elements, including the result allocation
+static void bench_tensor_add(fossil_math_bench_state_t* st) {
+    size_t shape[1] = {st->arg};
+    fossil_math_tensor_t* a = bench_tensor_random(shape, 1);
+    fossil_math_tensor_t* b = bench_tensor_random(shape, 1);
+    if (!a || !b) fossil_math_bench_skip(st, "allocation failed");
+    while (fossil_math_bench_run(st)) {
+        fossil_math_tensor_t* r = fossil_math_tensor_add(a, b);
+        fossil_math_bench_keep(r->data[0]);
+        fossil_math_tensor_free(r);
+    }
+    fossil_math_bench_set_items(st, (double)st->arg);
+    fossil_math_bench_set_bytes(st, 3.0 * sizeof(double) * (double)st->arg);
+    fossil_math_tensor_free(a);
+    fossil_math_tensor_free(b);
+}
+
+// Creation and release of an arg x arg tensor
+static void bench_tensor_create(fossil_math_bench_state_t* st) {
+    size_t shape[2] = {st->arg, st->arg};
+    while (fossil_math_bench_run(st)) {
+        fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 2);
+        fossil_math_bench_keep(t ? t->data[0] : 0.0);
+        fossil_math_tensor_free(t);
+    }
+}
+
+static const fossil_math_bench_def_t bench_tensor_defs[] = {
+    {"tensor_dot_1d", bench_tensor_dot_1d, {1024, 65536, 1048576}, {1}},
+    {"tensor_dot_2d", bench_tensor_dot_2d, {16, 64, 256}, {1}},
+    {"tensor_add", bench_tensor_add, {1024, 65536, 1048576}, {1}},
+    {"tensor_create", bench_tensor_create, {4, 64, 512}, {1}},
+};
+
+void fossil_math_bench_register_tensor(void) {
+    fossil_math_bench_register(bench_tensor_defs, sizeof(bench_tensor_defs) / sizeof(bench_tensor_defs[0]));
+}
@@ -0,0 +1,88 @@
+import argparse
+import json
+import sys
+
+
+class BenchmarkComparison:
+    def __init__(self, threshold, metric):
+        # Relative slowdown that counts as a regression (0.05 = 5%)
+        self.threshold = threshold
+        # Field compared between runs: real_time or cpu_time
+        self.metric = metric
+
+    def load(self, path):
+        with open(path, "r") as f:
+            data = json.load(f)
+        runs = {}
+        for entry in data.get("benchmarks", []):
+            name = entry.get("run_name", entry["name"])
+            run = runs.setdefault(name, {"samples": [], "median": None, "stddev": None})
+            if entry.get("run_type") == "aggregate":
+                if entry.get("aggregate_name") in ("median", "stddev"):
+                    run[entry["aggregate_name"]] = entry[self.metric]
+            else:
+                run["samples"].append(entry[self.metric])
+        # Single-repetition files carry no aggregates; fall back to the samples
+        for run in runs.values():
+            samples = sorted(run["samples"])
+            if run["median"] is None and samples:
+                mid = len(samples) // 2
+                run["median"] = samples[mid] if len(samples) % 2 else 0.5 * (samples[mid - 1] + samples[mid])
+            if run["stddev"] is None:
+                run["stddev"] = 0.0
+        return runs
+
+    def compare(self, baseline, current):
+        rows = []
+        for name in sorted(set(baseline) | set(current)):
+            if name not in current:
+                rows.append((name, baseline[name]["median"], None, None, "MISSING"))
+                continue
+            if name not in baseline:
+                rows.append((name, None, current[name]["median"], None, "NEW"))
+                continue
+            old, new = baseline[name], current[name]
+            if not old["median"]:
+                rows.append((name, old["median"], new["median"], None, ""))
+                continue
+            change = (new["median"] - old["median"]) / old["median"]
+            # A change must exceed the threshold and the spread of both runs
+            noise = 2.0 * max(old["stddev"] / old["median"], new["stddev"] / new["median"] if new["median"] else 0.0)
+            limit = max(self.threshold, noise)
+            verdict = "REGRESSION" if change > limit else "IMPROVED" if change < -limit else ""
+            rows.append((name, old["median"], new["median"], change, verdict))
+        return rows
+
+    def report(self, rows):
+        print(f"{'Benchmark':<48} {'Baseline':>14} {'Current':>14} {'Change':>9}")
+        for name, old, new, change, verdict in rows:
+            old_s = f"{old:.1f}" if old is not None else "-"
+            new_s = f"{new:.1f}" if new is not None else "-"
+            change_s = f"{100.0 * change:+.2f}%" if change is not None else "-"
+            print(f"{name:<48} {old_s:>14} {new_s:>14} {change_s:>9} {verdict}".rstrip())
+        regressions = sum(1 for row in rows if row[4] == "REGRESSION")
+        print(f"\n{regressions} regression(s) above {100.0 * self.threshold:.1f}% in {self.metric}")
+        return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare fossil_math_bench JSON results against a baseline.")
+    parser.add_argument("baseline", help="JSON file written by fossil_math_bench --json")
+    parser.add_argument("current", help="JSON file written by fossil_math_bench --json")
+    parser.add_argument("--threshold", type=float, default=0.05, help="relative slowdown flagged as a regression")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    args = parser.parse_args()
+
+    comparison = BenchmarkComparison(args.threshold, args.metric)
+    try:
+        baseline = comparison.load(args.baseline)
+        current = comparison.load(args.current)
+    except FileNotFoundError as e:
+        print(f"{e.filename}: not found (store a baseline by copying a bench.json written by the bench target)")
+        sys.exit(2)
+    rows = comparison.compare(baseline, current)
+    sys.exit(1 if comparison.report(rows) else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,8 +23,10 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/algebra.h"
+#include "fossil/math/instrument.h"
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 double fossil_math_algebra_dot(const double* a, const double* b, size_t n) {
@@ -52,9 +54,11 @@ void fossil_math_algebra_scalar_mul(const double* a, double scalar, double* resu
 int fossil_math_algebra_matrix_mul(const double* A, size_t rowsA, size_t colsA,
                                    const double* B, size_t rowsB, size_t colsB,
                                    double* C) {
-    if (colsA != rowsB) return -1;
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    int status = (colsA == rowsB) ? 0 : -1;
 
-    for (size_t i = 0; i < rowsA; i++) {
+    for (size_t i = 0; status == 0 && i < rowsA; i++) {
         for (size_t j = 0; j < colsB; j++) {
             double sum = 0.0;
             for (size_t k = 0; k < colsA; k++) {
@@ -63,7 +67,10 @@ int fossil_math_algebra_matrix_mul(const double* A, size_t rowsA, size_t colsA,
             C[i * colsB + j] = sum;
         }
     }
-    return 0;
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_MUL,
+                               status == 0 ? 2.0 * (double)rowsA * (double)colsA * (double)colsB : 0.0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_MUL, rowsA, colsA, colsB);
+    return status;
 }
 
 int fossil_math_algebra_matrix_transpose(const double* A, size_t rows, size_t cols, double* T) {
@@ -120,11 +127,116 @@ int fossil_math_algebra_matrix_determinant(const double* M, size_t n, double* de
 }
 
 int fossil_math_algebra_matrix_inverse(const double* M, size_t n, double* Inv) {
-    if (!M || !Inv) return -1;
-    for (size_t i = 0; i < n * n; i++) {
-        Inv[i] = (i % (n+1) == 0) ? 1.0 : 0.0; // identity, fake
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    double* LU = NULL;
+    size_t* piv = NULL;
+    double* e = NULL;
+    double* col = NULL;
+    int status = (M && Inv && n > 0) ? 0 : -1;
+
+    if (status == 0) {
+        FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_INVERSE, (n * n + 2 * n) * sizeof(double) + n * sizeof(size_t));
+        LU = malloc(n * n * sizeof(double));
+        piv = malloc(n * sizeof(size_t));
+        e = malloc(n * sizeof(double));
+        col = malloc(n * sizeof(double));
+        status = (LU && piv && e && col) ? 0 : -2;
+    }
+
+    if (status == 0) {
+        memcpy(LU, M, n * n * sizeof(double));
+        status = fossil_math_algebra_lu_decompose(LU, n, piv);
+    }
+    if (status == 0) {
+        // Solve LU * col = e_j for each column of the inverse
+        for (size_t j = 0; j < n; j++) {
+            for (size_t i = 0; i < n; i++) e[i] = (i == j) ? 1.0 : 0.0;
+            fossil_math_algebra_lu_solve(LU, piv, e, col, n);
+            for (size_t i = 0; i < n; i++) Inv[i * n + j] = col[i];
+        }
+    }
+
+    free(LU);
+    free(piv);
+    free(e);
+    free(col);
+    // LU factorization plus n forward and back substitutions
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_INVERSE,
+                               status == 0 ? 8.0 / 3.0 * (double)n * (double)n * (double)n : 0.0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_INVERSE, n, 0, 0);
+    return status;
+}
+
+// ======================================================
+// LU factorization
+// ======================================================
+
+int fossil_math_algebra_lu_decompose(double* A, size_t n, size_t* piv) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    int status = (A && piv && n > 0) ? 0 : -1;
+    for (size_t k = 0; status == 0 && k < n; k++) {
+        // Partial pivoting: bring the largest remaining entry of column k to the diagonal
+        size_t p = k;
+        double max = fabs(A[k * n + k]);
+        for (size_t i = k + 1; i < n; i++) {
+            double v = fabs(A[i * n + k]);
+            if (v > max) { max = v; p = i; }
+        }
+        piv[k] = p;
+        if (max == 0.0) {
+            status = -3; // singular
+            break;
+        }
+        if (p != k) {
+            for (size_t j = 0; j < n; j++) {
+                double t = A[k * n + j];
+                A[k * n + j] = A[p * n + j];
+                A[p * n + j] = t;
+            }
+        }
+
+        double inv_pivot = 1.0 / A[k * n + k];
+        for (size_t i = k + 1; i < n; i++) {
+            double l = A[i * n + k] * inv_pivot;
+            A[i * n + k] = l;
+            if (l == 0.0) continue;
+            double* row_i = A + i * n;
+            const double* row_k = A + k * n;
+            for (size_t j = k + 1; j < n; j++)
+                row_i[j] -= l * row_k[j];
+        }
+    }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ALGEBRA_LU_DECOMPOSE,
+                               status == 0 ? 2.0 / 3.0 * (double)n * (double)n * (double)n : 0.0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ALGEBRA_LU_DECOMPOSE, n, 0, 0);
+    return status;
+}
+
+void fossil_math_algebra_lu_solve(const double* LU, const size_t* piv, const double* b, double* x, size_t n) {
+    if (x != b) memcpy(x, b, n * sizeof(double));
+
+    // Apply the row interchanges, then forward substitution with unit-diagonal L
+    for (size_t k = 0; k < n; k++) {
+        if (piv[k] != k) {
+            double t = x[k];
+            x[k] = x[piv[k]];
+            x[piv[k]] = t;
+        }
+    }
+    for (size_t i = 1; i < n; i++) {
+        double sum = x[i];
+        for (size_t j = 0; j < i; j++) sum -= LU[i * n + j] * x[j];
+        x[i] = sum;
+    }
+
+    // Back substitution with U
+    for (size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        for (size_t j = i + 1; j < n; j++) sum -= LU[i * n + j] * x[j];
+        x[i] = sum / LU[i * n + i];
     }
-    return -2; // indicates not real inversion
 }
 
 // ======================================================
@@ -179,11 +291,31 @@ void fossil_math_algebra_poly_mul(const double* A, size_t degA,
 
 int fossil_math_algebra_solve_linear_system(const double* A, const double* b,
                                             double* x, size_t n) {
-    if (!A || !b || !x) return -1;
-    for (size_t i = 0; i < n; i++) {
-        x[i] = b[i]; // fake: assumes diagonal=1
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    double* LU = NULL;
+    size_t* piv = NULL;
+    int status = (A && b && x && n > 0) ? 0 : -1;
+
+    if (status == 0) {
+        FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_ALGEBRA_SOLVE_LINEAR_SYSTEM, n * n * sizeof(double) + n * sizeof(size_t));
+        LU = malloc(n * n * sizeof(double));
+        piv = malloc(n * sizeof(size_t));
+        status = (LU && piv) ? 0 : -2;
+    }
+
+    if (status == 0) {
+        memcpy(LU, A, n * n * sizeof(double));
+        status = fossil_math_algebra_lu_decompose(LU, n, piv);
     }
-    return -2; // indicates not real solver
+    if (status == 0) fossil_math_algebra_lu_solve(LU, piv, b, x, n);
+
+    free(LU);
+    free(piv);
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ALGEBRA_SOLVE_LINEAR_SYSTEM,
+                               status == 0 ? 2.0 / 3.0 * (double)n * (double)n * (double)n + 2.0 * (double)n * (double)n : 0.0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ALGEBRA_SOLVE_LINEAR_SYSTEM, n, 0, 0);
+    return status;
 }
 
 int fossil_math_algebra_solve_quadratic(double a, double b, double c,
@@ -23,7 +23,10 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/calc.h"
+#include "fossil/math/parallel.h"
+#include "fossil/math/instrument.h"
 #include <math.h>
+#include <float.h>
 
 // ==========================================================
 // Derivatives
@@ -57,28 +60,43 @@ double fossil_math_calc_derivative_n(fossil_math_func_t f, double x, int n, doub
 // ==========================================================
 
 double fossil_math_calc_integrate_trapezoidal(fossil_math_func_t f, double a, double b, size_t n) {
-    if (n == 0) return 0.0;
-    double h = (b - a) / (double)n;
-    double sum = 0.5 * (f(a) + f(b));
-    for (size_t i = 1; i < n; ++i) sum += f(a + i * h);
-    return sum * h;
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    double result = 0.0;
+    if (n > 0) {
+        double h = (b - a) / (double)n;
+        double sum = 0.5 * (f(a) + f(b));
+        for (size_t i = 1; i < n; ++i) sum += f(a + i * h);
+        result = sum * h;
+    }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_TRAPEZOIDAL, 3 * n);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_TRAPEZOIDAL, n, 0, 0);
+    return result;
 }
 
 double fossil_math_calc_integrate_simpson(fossil_math_func_t f, double a, double b, size_t n) {
     if (n % 2) n++;  // Ensure even number of intervals
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
     double h = (b - a) / (double)n;
     double sum = f(a) + f(b);
     for (size_t i = 1; i < n; ++i)
         sum += f(a + i * h) * (i % 2 ? 4.0 : 2.0);
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_SIMPSON, 4 * n);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_SIMPSON, n, 0, 0);
     return sum * h / 3.0;
 }
 
 double fossil_math_calc_integrate_montecarlo(fossil_math_func_t f, double a, double b, size_t samples) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
     double sum = 0.0;
     for (size_t i = 0; i < samples; ++i) {
         double x = a + (b - a) * (rand() / (double)RAND_MAX);
         sum += f(x);
     }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_MONTECARLO, 5 * samples);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_CALC_INTEGRATE_MONTECARLO, samples, 0, 0);
     return (b - a) * sum / (double)samples;
 }
 
@@ -119,6 +137,445 @@ double fossil_math_calc_root_bisection(fossil_math_func_t f, double a, double b,
     return 0.5 * (a + b);
 }
 
+// ==========================================================
+// Bracketing Roots (Brent, TOMS 748)
+// ==========================================================
+
+static void fossil_math_calc_root_report(fossil_math_calc_root_info_t* info, size_t iterations,
+                                         size_t evaluations, int converged) {
+    if (!info) return;
+    info->iterations = iterations;
+    info->evaluations = evaluations;
+    info->converged = converged;
+}
+
+// Brent state, kept in a struct so the scalar and batched solvers share one step.
+typedef struct {
+    double a, b, c;
+    double fa, fb, fc;
+    double d, e;
+} fossil_math_calc_brent_t;
+
+static void fossil_math_calc_brent_init(fossil_math_calc_brent_t* s, double a, double b, double fa, double fb) {
+    s->a = a; s->b = b; s->c = a;
+    s->fa = fa; s->fb = fb; s->fc = fa;
+    s->d = s->e = b - a;
+}
+
+// Returns 1 when s->b is within tolerance of the root; otherwise moves s->b to
+// the next point to evaluate (the caller stores f(s->b) in s->fb) and returns 0.
+static int fossil_math_calc_brent_step(fossil_math_calc_brent_t* s, double tol) {
+    // Keep b as the best estimate and [b, c] as the bracket
+    if ((s->fb > 0.0) == (s->fc > 0.0)) {
+        s->c = s->a; s->fc = s->fa;
+        s->d = s->e = s->b - s->a;
+    }
+    if (fabs(s->fc) < fabs(s->fb)) {
+        s->a = s->b; s->b = s->c; s->c = s->a;
+        s->fa = s->fb; s->fb = s->fc; s->fc = s->fa;
+    }
+
+    double tol1 = 2.0 * DBL_EPSILON * fabs(s->b) + 0.5 * tol;
+    double xm = 0.5 * (s->c - s->b);
+    if (fabs(xm) <= tol1 || s->fb == 0.0) return 1;
+
+    if (fabs(s->e) >= tol1 && fabs(s->fa) > fabs(s->fb)) {
+        // Attempt secant (a == c) or inverse quadratic interpolation
+        double p, q, r;
+        double sr = s->fb / s->fa;
+        if (s->a == s->c) {
+            p = 2.0 * xm * sr;
+            q = 1.0 - sr;
+        } else {
+            q = s->fa / s->fc;
+            r = s->fb / s->fc;
+            p = sr * (2.0 * xm * q * (q - r) - (s->b - s->a) * (r - 1.0));
+            q = (q - 1.0) * (r - 1.0) * (sr - 1.0);
+        }
+        if (p > 0.0) q = -q;
+        p = fabs(p);
+        double min1 = 3.0 * xm * q - fabs(tol1 * q);
+        double min2 = fabs(s->e * q);
+        if (2.0 * p < FOSSIL_MATH_MIN(min1, min2)) {
+            s->e = s->d;
+            s->d = p / q;
+        } else {
+            s->d = xm;
+            s->e = s->d;
+        }
+    } else {
+        s->d = xm;
+        s->e = s->d;
+    }
+
+    s->a = s->b;
+    s->fa = s->fb;
+    s->b += (fabs(s->d) > tol1) ? s->d : (xm > 0.0 ? tol1 : -tol1);
+    return 0;
+}
+
+double fossil_math_calc_root_brent(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                   fossil_math_calc_root_info_t* info) {
+    fossil_math_calc_root_report(info, 0, 0, 0);
+    if (!f) return NAN;
+    if (tol < 0.0) tol = 0.0;
+
+    double fa = f(a), fb = f(b);
+    size_t evals = 2;
+    if (fa == 0.0) { fossil_math_calc_root_report(info, 0, evals, 1); return a; }
+    if (fb == 0.0) { fossil_math_calc_root_report(info, 0, evals, 1); return b; }
+    if ((fa > 0.0) == (fb > 0.0)) { fossil_math_calc_root_report(info, 0, evals, 0); return NAN; }
+
+    fossil_math_calc_brent_t s;
+    fossil_math_calc_brent_init(&s, a, b, fa, fb);
+    for (size_t i = 0; i < max_iter; ++i) {
+        if (fossil_math_calc_brent_step(&s, tol)) {
+            fossil_math_calc_root_report(info, i, evals, 1);
+            return s.b;
+        }
+        s.fb = f(s.b);
+        ++evals;
+    }
+
+    fossil_math_calc_root_report(info, max_iter, evals, 0);
+    return s.b;
+}
+
+// TOMS 748 helpers, following Alefeld, Potra and Shi (1995).
+
+typedef struct {
+    fossil_math_func_t f;
+    size_t evals;
+} fossil_math_calc_toms748_t;
+
+static double fossil_math_calc_toms748_div(double num, double den, double fallback) {
+    // Guard against overflow when the denominator is tiny
+    if (fabs(den) < 1.0 && fabs(den * DBL_MAX) <= fabs(num)) return fallback;
+    return num / den;
+}
+
+static double fossil_math_calc_toms748_secant(double a, double b, double fa, double fb) {
+    double tol = DBL_EPSILON * 5.0;
+    double c = a - (fa / (fb - fa)) * (b - a);
+    if (c <= a + fabs(a) * tol || c >= b - fabs(b) * tol) return 0.5 * (a + b);
+    return c;
+}
+
+static double fossil_math_calc_toms748_quadratic(double a, double b, double d,
+                                                 double fa, double fb, double fd, int count) {
+    double B = fossil_math_calc_toms748_div(fb - fa, b - a, DBL_MAX);
+    double A = fossil_math_calc_toms748_div(fd - fb, d - b, DBL_MAX);
+    A = fossil_math_calc_toms748_div(A - B, d - a, 0.0);
+    if (A == 0.0) return fossil_math_calc_toms748_secant(a, b, fa, fb);
+
+    // Newton steps on the interpolating quadratic, started from the end where it is convex
+    double c = (FOSSIL_MATH_SIGN(A) * FOSSIL_MATH_SIGN(fa) > 0) ? a : b;
+    for (int i = 1; i <= count; ++i) {
+        c -= fossil_math_calc_toms748_div(fa + (B + A * (c - b)) * (c - a),
+                                          B + A * (2.0 * c - a - b), 1.0 + c - a);
+    }
+    if (c <= a || c >= b) c = fossil_math_calc_toms748_secant(a, b, fa, fb);
+    return c;
+}
+
+static double fossil_math_calc_toms748_cubic(double a, double b, double d, double e,
+                                             double fa, double fb, double fd, double fe) {
+    // Inverse cubic interpolation through (fa,a), (fb,b), (fd,d), (fe,e)
+    double q11 = (d - e) * fd / (fe - fd);
+    double q21 = (b - d) * fb / (fd - fb);
+    double q31 = (a - b) * fa / (fb - fa);
+    double d21 = (b - d) * fd / (fd - fb);
+    double d31 = (a - b) * fb / (fb - fa);
+    double q22 = (d21 - q11) * fb / (fe - fb);
+    double q32 = (d31 - q21) * fa / (fd - fa);
+    double d32 = (d31 - q21) * fd / (fd - fa);
+    double q33 = (d32 - q22) * fa / (fe - fa);
+    double c = q31 + q32 + q33 + a;
+    if (!(c > a && c < b)) c = fossil_math_calc_toms748_quadratic(a, b, d, fa, fb, fd, 3);
+    return c;
+}
+
+static void fossil_math_calc_toms748_bracket(fossil_math_calc_toms748_t* s, double* a, double* b, double c,
+                                             double* fa, double* fb, double* d, double* fd) {
+    // Evaluate at c (nudged away from the ends) and shrink [a, b] to keep the sign change
+    double tol = DBL_EPSILON * 2.0;
+    if ((*b - *a) < 2.0 * tol * *a) {
+        c = *a + (*b - *a) / 2.0;
+    } else if (c <= *a + fabs(*a) * tol) {
+        c = *a + fabs(*a) * tol;
+    } else if (c >= *b - fabs(*b) * tol) {
+        c = *b - fabs(*b) * tol;
+    }
+
+    double fc = s->f(c);
+    ++s->evals;
+    if (fc == 0.0) {
+        *a = c; *fa = 0.0;
+        *d = 0.0; *fd = 0.0;
+        return;
+    }
+    if ((*fa > 0.0) != (fc > 0.0)) {
+        *d = *b; *fd = *fb;
+        *b = c; *fb = fc;
+    } else {
+        *d = *a; *fd = *fa;
+        *a = c; *fa = fc;
+    }
+}
+
+static int fossil_math_calc_toms748_done(double a, double b, double tol) {
+    return (b - a) <= 2.0 * tol + 4.0 * DBL_EPSILON * FOSSIL_MATH_MAX(fabs(a), fabs(b));
+}
+
+static int fossil_math_calc_toms748_degenerate(double fa, double fb, double fd, double fe) {
+    // Cubic interpolation is ill-posed when any two function values coincide
+    double min_diff = DBL_MIN * 32.0;
+    return fabs(fa - fb) < min_diff || fabs(fa - fd) < min_diff || fabs(fa - fe) < min_diff ||
+           fabs(fb - fd) < min_diff || fabs(fb - fe) < min_diff || fabs(fd - fe) < min_diff;
+}
+
+double fossil_math_calc_root_toms748(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                     fossil_math_calc_root_info_t* info) {
+    fossil_math_calc_root_report(info, 0, 0, 0);
+    if (!f) return NAN;
+    if (tol < 0.0) tol = 0.0;
+    if (a > b) { double t = a; a = b; b = t; }
+
+    fossil_math_calc_toms748_t s = { f, 0 };
+    double fa = f(a), fb = f(b);
+    s.evals = 2;
+    if (fa == 0.0) { fossil_math_calc_root_report(info, 0, s.evals, 1); return a; }
+    if (fb == 0.0) { fossil_math_calc_root_report(info, 0, s.evals, 1); return b; }
+    if ((fa > 0.0) == (fb > 0.0)) { fossil_math_calc_root_report(info, 0, s.evals, 0); return NAN; }
+
+    size_t iter = 0;
+    double c, d = 0.0, e = 0.0, fd = 1e5, fe = 1e5;
+
+    // Two warm-up steps: secant, then quadratic, to build the interpolation points
+    if (iter < max_iter) {
+        c = fossil_math_calc_toms748_secant(a, b, fa, fb);
+        fossil_math_calc_toms748_bracket(&s, &a, &b, c, &fa, &fb, &d, &fd);
+        ++iter;
+        if (iter < max_iter && fa != 0.0 && !fossil_math_calc_toms748_done(a, b, tol)) {
+            c = fossil_math_calc_toms748_quadratic(a, b, d, fa, fb, fd, 2);
+            e = d; fe = fd;
+            fossil_math_calc_toms748_bracket(&s, &a, &b, c, &fa, &fb, &d, &fd);
+            ++iter;
+        }
+    }
+
+    while (iter < max_iter && fa != 0.0 && !fossil_math_calc_toms748_done(a, b, tol)) {
+        double a0 = a, b0 = b;
+
+        // Two interpolation steps
+        if (fossil_math_calc_toms748_degenerate(fa, fb, fd, fe))
+            c = fossil_math_calc_toms748_quadratic(a, b, d, fa, fb, fd, 2);
+        else
+            c = fossil_math_calc_toms748_cubic(a, b, d, e, fa, fb, fd, fe);
+        e = d; fe = fd;
+        fossil_math_calc_toms748_bracket(&s, &a, &b, c, &fa, &fb, &d, &fd);
+        if (++iter >= max_iter || fa == 0.0 || fossil_math_calc_toms748_done(a, b, tol)) break;
+
+        if (fossil_math_calc_toms748_degenerate(fa, fb, fd, fe))
+            c = fossil_math_calc_toms748_quadratic(a, b, d, fa, fb, fd, 3);
+        else
+            c = fossil_math_calc_toms748_cubic(a, b, d, e, fa, fb, fd, fe);
+        fossil_math_calc_toms748_bracket(&s, &a, &b, c, &fa, &fb, &d, &fd);
+        if (++iter >= max_iter || fa == 0.0 || fossil_math_calc_toms748_done(a, b, tol)) break;
+
+        // Double-length secant step from the better endpoint
+        double u = a, fu = fa;
+        if (fabs(fb) < fabs(fa)) { u = b; fu = fb; }
+        c = u - 2.0 * (fu / (fb - fa)) * (b - a);
+        if (fabs(c - u) > (b - a) / 2.0) c = a + (b - a) / 2.0;
+        e = d; fe = fd;
+        fossil_math_calc_toms748_bracket(&s, &a, &b, c, &fa, &fb, &d, &fd);
+        if (++iter >= max_iter || fa == 0.0 || fossil_math_calc_toms748_done(a, b, tol)) break;
+
+        // Fall back to bisection if the bracket did not shrink enough
+        if ((b - a) < 0.5 * (b0 - a0)) continue;
+        e = d; fe = fd;
+        fossil_math_calc_toms748_bracket(&s, &a, &b, a + (b - a) / 2.0, &fa, &fb, &d, &fd);
+        ++iter;
+    }
+
+    int converged = (fa == 0.0 || fb == 0.0 || fossil_math_calc_toms748_done(a, b, tol));
+    fossil_math_calc_root_report(info, iter, s.evals, converged);
+    if (fa == 0.0) return a;
+    if (fb == 0.0) return b;
+    return (fabs(fa) < fabs(fb)) ? a : b;
+}
+
+// ==========================================================
+// Batched Roots
+// ==========================================================
+//
+// Items are processed in fixed-size blocks. Each iteration packs the active
+// lanes of a block into contiguous x/index arrays, evaluates them with a single
+// callback invocation and unpacks the results, so converged lanes cost nothing
+// and the callback sees dense arrays it can vectorize. Blocks are independent
+// and are spread across threads with fossil_math_parallel_for().
+//
+
+#define FOSSIL_MATH_CALC_BATCH_BLOCK 256
+
+typedef struct {
+    fossil_math_calc_batch_func_t f;
+    fossil_math_calc_batch_fdf_t fdf;
+    void* ctx;
+    const double* a;
+    const double* b;
+    const double* x0;
+    double* roots;
+    int* converged;
+    double tol;
+    size_t max_iter;
+} fossil_math_calc_batch_t;
+
+static void fossil_math_calc_brent_block(const fossil_math_calc_batch_t* job, size_t lo, size_t m) {
+    fossil_math_calc_brent_t s[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    size_t lane[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    size_t ids[2 * FOSSIL_MATH_CALC_BATCH_BLOCK];
+    double xs[2 * FOSSIL_MATH_CALC_BATCH_BLOCK];
+    double fx[2 * FOSSIL_MATH_CALC_BATCH_BLOCK];
+
+    // Evaluate both bracket ends of every lane in one call
+    for (size_t k = 0; k < m; ++k) {
+        ids[k] = ids[m + k] = lo + k;
+        xs[k] = job->a[lo + k];
+        xs[m + k] = job->b[lo + k];
+    }
+    job->f(ids, xs, fx, 2 * m, job->ctx);
+
+    size_t active = 0;
+    for (size_t k = 0; k < m; ++k) {
+        size_t i = lo + k;
+        double fa = fx[k], fb = fx[m + k];
+        job->converged[i] = 1;
+        if (fa == 0.0) { job->roots[i] = xs[k]; continue; }
+        if (fb == 0.0) { job->roots[i] = xs[m + k]; continue; }
+        if ((fa > 0.0) == (fb > 0.0)) {
+            job->roots[i] = NAN;
+            job->converged[i] = 0;
+            continue;
+        }
+        fossil_math_calc_brent_init(&s[k], xs[k], xs[m + k], fa, fb);
+        lane[active++] = k;
+    }
+
+    for (size_t iter = 0; iter < job->max_iter && active > 0; ++iter) {
+        size_t next = 0;
+        for (size_t j = 0; j < active; ++j) {
+            size_t k = lane[j];
+            if (fossil_math_calc_brent_step(&s[k], job->tol)) {
+                job->roots[lo + k] = s[k].b;
+                continue;
+            }
+            lane[next] = k;
+            ids[next] = lo + k;
+            xs[next] = s[k].b;
+            ++next;
+        }
+        active = next;
+        if (active == 0) break;
+
+        job->f(ids, xs, fx, active, job->ctx);
+        for (size_t j = 0; j < active; ++j) s[lane[j]].fb = fx[j];
+    }
+
+    for (size_t j = 0; j < active; ++j) {
+        size_t k = lane[j];
+        job->roots[lo + k] = s[k].b;
+        job->converged[lo + k] = 0;
+    }
+}
+
+static void fossil_math_calc_newton_block(const fossil_math_calc_batch_t* job, size_t lo, size_t m) {
+    double x[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    size_t lane[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    size_t ids[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    double xs[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    double fx[FOSSIL_MATH_CALC_BATCH_BLOCK];
+    double dfx[FOSSIL_MATH_CALC_BATCH_BLOCK];
+
+    size_t active = m;
+    for (size_t k = 0; k < m; ++k) {
+        x[k] = job->x0[lo + k];
+        lane[k] = k;
+        job->converged[lo + k] = 0;
+    }
+
+    for (size_t iter = 0; iter < job->max_iter && active > 0; ++iter) {
+        for (size_t j = 0; j < active; ++j) {
+            ids[j] = lo + lane[j];
+            xs[j] = x[lane[j]];
+        }
+        job->fdf(ids, xs, fx, dfx, active, job->ctx);
+
+        size_t next = 0;
+        for (size_t j = 0; j < active; ++j) {
+            size_t k = lane[j];
+            if (fabs(dfx[j]) < 1e-12) continue; // stalled: keep x, not converged
+            double x_next = x[k] - fx[j] / dfx[j];
+            if (fabs(x_next - x[k]) < job->tol) {
+                x[k] = x_next;
+                job->converged[lo + k] = 1;
+                continue;
+            }
+            x[k] = x_next;
+            lane[next++] = k;
+        }
+        active = next;
+    }
+
+    for (size_t k = 0; k < m; ++k) job->roots[lo + k] = x[k];
+}
+
+static void fossil_math_calc_brent_range(size_t begin, size_t end, void* ctx) {
+    for (size_t lo = begin; lo < end; lo += FOSSIL_MATH_CALC_BATCH_BLOCK)
+        fossil_math_calc_brent_block((const fossil_math_calc_batch_t*)ctx, lo,
+                                     FOSSIL_MATH_MIN(end - lo, (size_t)FOSSIL_MATH_CALC_BATCH_BLOCK));
+}
+
+static void fossil_math_calc_newton_range(size_t begin, size_t end, void* ctx) {
+    for (size_t lo = begin; lo < end; lo += FOSSIL_MATH_CALC_BATCH_BLOCK)
+        fossil_math_calc_newton_block((const fossil_math_calc_batch_t*)ctx, lo,
+                                      FOSSIL_MATH_MIN(end - lo, (size_t)FOSSIL_MATH_CALC_BATCH_BLOCK));
+}
+
+static size_t fossil_math_calc_batch_run(fossil_math_calc_batch_t* job, size_t n, fossil_math_parallel_fn_t fn) {
+    // Per-item flags double as the convergence count, so allocate them if the caller did not
+    int* owned = NULL;
+    if (!job->converged) {
+        owned = (int*)malloc(n * sizeof(int));
+        if (!owned) return 0;
+        job->converged = owned;
+    }
+
+    fossil_math_parallel_for(n, FOSSIL_MATH_CALC_BATCH_BLOCK, fn, job);
+
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) count += job->converged[i] != 0;
+    free(owned);
+    return count;
+}
+
+size_t fossil_math_calc_root_brent_batch(fossil_math_calc_batch_func_t f, void* ctx,
+                                         const double* a, const double* b, double* roots, size_t n,
+                                         double tol, size_t max_iter, int* converged) {
+    if (!f || !a || !b || !roots || n == 0) return 0;
+    fossil_math_calc_batch_t job = { f, NULL, ctx, a, b, NULL, roots, converged, tol < 0.0 ? 0.0 : tol, max_iter };
+    return fossil_math_calc_batch_run(&job, n, fossil_math_calc_brent_range);
+}
+
+size_t fossil_math_calc_root_newton_batch(fossil_math_calc_batch_fdf_t fdf, void* ctx,
+                                          const double* x0, double* roots, size_t n,
+                                          double tol, size_t max_iter, int* converged) {
+    if (!fdf || !x0 || !roots || n == 0) return 0;
+    fossil_math_calc_batch_t job = { NULL, fdf, ctx, NULL, NULL, x0, roots, converged, tol, max_iter };
+    return fossil_math_calc_batch_run(&job, n, fossil_math_calc_newton_range);
+}
+
 // ==========================================================
 // Multivariable
 // ==========================================================
@@ -0,0 +1,339 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/cheb.h"
+#include <math.h>
+#include <float.h>
+
+// Smallest sampling grid, and the default limit on the degree
+#define FOSSIL_MATH_CHEB_MIN_POINTS  17
+#define FOSSIL_MATH_CHEB_MAX_DEGREE  4096
+// Points evaluated per block by the batch evaluator
+#define FOSSIL_MATH_CHEB_BLOCK 64
+
+struct fossil_math_cheb {
+    double a;
+    double b;
+    size_t n;   // Number of coefficients
+    double* c;
+};
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+static fossil_math_cheb_t* fossil_math_cheb_alloc(size_t n, double a, double b) {
+    fossil_math_cheb_t* p = malloc(sizeof(*p));
+    if (!p) return NULL;
+    p->c = calloc(n, sizeof(double));
+    if (!p->c) {
+        free(p);
+        return NULL;
+    }
+    p->a = a;
+    p->b = b;
+    p->n = n;
+    return p;
+}
+
+static double fossil_math_cheb_map(const fossil_math_cheb_t* p, double x) {
+    return (2.0 * x - p->a - p->b) / (p->b - p->a);
+}
+
+static double fossil_math_cheb_clenshaw(const double* c, size_t n, double u) {
+    double b1 = 0.0, b2 = 0.0;
+    for (size_t k = n - 1; k >= 1; --k) {
+        double t = c[k] + 2.0 * u * b1 - b2;
+        b2 = b1;
+        b1 = t;
+    }
+    return c[0] + u * b1 - b2;
+}
+
+// Chebyshev point k of M + 1 on [-1, 1], written with sin so the grid is exactly symmetric
+static double fossil_math_cheb_point(size_t k, size_t M) {
+    return sin(FOSSIL_MATH_PI * ((double)M - 2.0 * (double)k) / (2.0 * (double)M));
+}
+
+// Coefficients from values at the M + 1 points cos(pi k / M) (a DCT-I, evaluated directly)
+static void fossil_math_cheb_coefficients(const double* v, size_t M, double* c, double* cos_table) {
+    for (size_t m = 0; m < 2 * M; ++m) cos_table[m] = cos(FOSSIL_MATH_PI * (double)m / (double)M);
+    for (size_t j = 0; j <= M; ++j) {
+        double acc = 0.5 * (v[0] + ((j % 2) ? -v[M] : v[M]));
+        for (size_t k = 1; k < M; ++k) acc += v[k] * cos_table[(j * k) % (2 * M)];
+        c[j] = 2.0 * acc / (double)M;
+    }
+    c[0] *= 0.5;
+    c[M] *= 0.5;
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+fossil_math_cheb_t* fossil_math_cheb_create(fossil_math_func_t f, double a, double b, double tol, size_t max_degree) {
+    if (!f || !isfinite(a) || !isfinite(b) || !(b > a)) return NULL;
+    if (!(tol > 0.0)) tol = 100.0 * DBL_EPSILON;
+    if (max_degree == 0) max_degree = FOSSIL_MATH_CHEB_MAX_DEGREE;
+
+    // Nested grids of 2^k + 1 points; the largest covers max_degree rounded up to a power of two
+    size_t M_max = FOSSIL_MATH_CHEB_MIN_POINTS - 1;
+    while (M_max < max_degree) M_max *= 2;
+    double* v = malloc((4 * M_max + 2) * sizeof(double));
+    if (!v) return NULL;
+    double* c = v + M_max + 1;
+    double* cos_table = c + M_max + 1;
+
+    double mid = 0.5 * (a + b), half = 0.5 * (b - a);
+    fossil_math_cheb_t* result = NULL;
+    size_t M = FOSSIL_MATH_CHEB_MIN_POINTS - 1;
+    for (size_t k = 0; k <= M; ++k) v[k] = f(mid + half * fossil_math_cheb_point(k, M));
+
+    for (;;) {
+        double vscale = 0.0;
+        int finite = 1;
+        for (size_t k = 0; k <= M; ++k) {
+            finite &= isfinite(v[k]) != 0;
+            vscale = fmax(vscale, fabs(v[k]));
+        }
+        if (!finite) break;
+
+        fossil_math_cheb_coefficients(v, M, c, cos_table);
+        double cutoff = tol * vscale;
+        // Resolved when the last eighth of the series (at least 3 terms) is negligible
+        size_t tail = FOSSIL_MATH_MAX(M / 8, (size_t)3);
+        int resolved = 1;
+        for (size_t j = M + 1 - tail; j <= M; ++j) resolved &= fabs(c[j]) <= cutoff;
+
+        if (resolved || vscale == 0.0) {
+            size_t n = M + 1;
+            while (n > 1 && fabs(c[n - 1]) <= cutoff) --n;
+            result = fossil_math_cheb_alloc(n, a, b);
+            if (result) memcpy(result->c, c, n * sizeof(double));
+            break;
+        }
+        if (M >= M_max) break;
+
+        // Refine: old samples land on the even points of the doubled grid
+        for (size_t k = M + 1; k-- > 0;) v[2 * k] = v[k];
+        M *= 2;
+        for (size_t k = 1; k < M; k += 2) v[k] = f(mid + half * fossil_math_cheb_point(k, M));
+    }
+    free(v);
+    return result;
+}
+
+fossil_math_cheb_t* fossil_math_cheb_from_coeffs(const double* coeffs, size_t n, double a, double b) {
+    if (!coeffs || n == 0 || !isfinite(a) || !isfinite(b) || !(b > a)) return NULL;
+    fossil_math_cheb_t* p = fossil_math_cheb_alloc(n, a, b);
+    if (p) memcpy(p->c, coeffs, n * sizeof(double));
+    return p;
+}
+
+void fossil_math_cheb_free(fossil_math_cheb_t* cheb) {
+    if (!cheb) return;
+    free(cheb->c);
+    free(cheb);
+}
+
+size_t fossil_math_cheb_degree(const fossil_math_cheb_t* cheb) {
+    return cheb ? cheb->n - 1 : 0;
+}
+
+const double* fossil_math_cheb_coeffs(const fossil_math_cheb_t* cheb) {
+    return cheb ? cheb->c : NULL;
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+double fossil_math_cheb_eval(const fossil_math_cheb_t* cheb, double x) {
+    if (!cheb) return NAN;
+    return fossil_math_cheb_clenshaw(cheb->c, cheb->n, fossil_math_cheb_map(cheb, x));
+}
+
+void fossil_math_cheb_eval_batch(const fossil_math_cheb_t* cheb, const double* x, double* y, size_t count) {
+    if (!x || !y) return;
+    if (!cheb) {
+        for (size_t j = 0; j < count; ++j) y[j] = NAN;
+        return;
+    }
+    double u[FOSSIL_MATH_CHEB_BLOCK], b1[FOSSIL_MATH_CHEB_BLOCK], b2[FOSSIL_MATH_CHEB_BLOCK];
+    const double* c = cheb->c;
+    double scale = 2.0 / (cheb->b - cheb->a), shift = -(cheb->a + cheb->b) / (cheb->b - cheb->a);
+
+    for (size_t lo = 0; lo < count; lo += FOSSIL_MATH_CHEB_BLOCK) {
+        size_t len = FOSSIL_MATH_MIN(count - lo, (size_t)FOSSIL_MATH_CHEB_BLOCK);
+        for (size_t j = 0; j < len; ++j) {
+            u[j] = scale * x[lo + j] + shift;
+            b1[j] = 0.0;
+            b2[j] = 0.0;
+        }
+        for (size_t k = cheb->n - 1; k >= 1; --k) {
+            double ck = c[k];
+            for (size_t j = 0; j < len; ++j) {
+                double t = ck + 2.0 * u[j] * b1[j] - b2[j];
+                b2[j] = b1[j];
+                b1[j] = t;
+            }
+        }
+        for (size_t j = 0; j < len; ++j) y[lo + j] = c[0] + u[j] * b1[j] - b2[j];
+    }
+}
+
+// ============================================================================
+// Calculus
+// ============================================================================
+
+fossil_math_cheb_t* fossil_math_cheb_derivative(const fossil_math_cheb_t* cheb) {
+    if (!cheb) return NULL;
+    size_t n = cheb->n;
+    fossil_math_cheb_t* d = fossil_math_cheb_alloc(n > 1 ? n - 1 : 1, cheb->a, cheb->b);
+    if (!d || n == 1) return d;
+
+    // d_{k-1} = d_{k+1} + 2 k c_k, with d_0 halved at the end
+    const double* c = cheb->c;
+    double* dc = d->c;
+    double next = 0.0, next2 = 0.0; // d_{k}, d_{k+1}
+    for (size_t k = n - 1; k >= 1; --k) {
+        double dk1 = next2 + 2.0 * (double)k * c[k];
+        dc[k - 1] = dk1;
+        next2 = next;
+        next = dk1;
+    }
+    dc[0] *= 0.5;
+    double scale = 2.0 / (cheb->b - cheb->a);
+    for (size_t k = 0; k < n - 1; ++k) dc[k] *= scale;
+    return d;
+}
+
+fossil_math_cheb_t* fossil_math_cheb_integral(const fossil_math_cheb_t* cheb) {
+    if (!cheb) return NULL;
+    size_t n = cheb->n;
+    fossil_math_cheb_t* q = fossil_math_cheb_alloc(n + 1, cheb->a, cheb->b);
+    if (!q) return NULL;
+
+    const double* c = cheb->c;
+    double* C = q->c;
+    double half = 0.5 * (cheb->b - cheb->a);
+    for (size_t k = 1; k <= n; ++k) {
+        double prev = c[k - 1];
+        double nxt = (k + 1 < n) ? c[k + 1] : 0.0;
+        C[k] = half * ((k == 1) ? prev - 0.5 * nxt : (prev - nxt) / (2.0 * (double)k));
+    }
+    // Fix the constant so the antiderivative vanishes at a, where T_k(-1) = (-1)^k
+    double at_a = 0.0;
+    for (size_t k = 1; k <= n; ++k) at_a += (k % 2) ? -C[k] : C[k];
+    C[0] = -at_a;
+    return q;
+}
+
+double fossil_math_cheb_integrate(const fossil_math_cheb_t* cheb) {
+    if (!cheb) return NAN;
+    // integral of T_k over [-1, 1] is 2 / (1 - k^2) for even k and 0 for odd k
+    double acc = 0.0;
+    for (size_t k = 0; k < cheb->n; k += 2) acc += cheb->c[k] * 2.0 / (1.0 - (double)k * (double)k);
+    return 0.5 * (cheb->b - cheb->a) * acc;
+}
+
+// Illinois (modified regula falsi) refinement of a sign change of p in [lo, hi]
+static double fossil_math_cheb_refine(const fossil_math_cheb_t* p, double lo, double hi, double flo, double fhi) {
+    for (size_t it = 0; it < 100; ++it) {
+        double x = hi - fhi * (hi - lo) / (fhi - flo);
+        if (!(x > FOSSIL_MATH_MIN(lo, hi) && x < FOSSIL_MATH_MAX(lo, hi))) x = 0.5 * (lo + hi);
+        double fx = fossil_math_cheb_eval(p, x);
+        if (fx == 0.0) return x;
+        if ((fx < 0.0) != (fhi < 0.0)) {
+            lo = hi;
+            flo = fhi;
+        } else {
+            flo *= 0.5;
+        }
+        hi = x;
+        fhi = fx;
+        if (fabs(hi - lo) <= 4.0 * DBL_EPSILON * fmax(fabs(hi), fabs(p->b - p->a))) break;
+    }
+    return fabs(fhi) <= fabs(flo) ? hi : lo;
+}
+
+static int fossil_math_cheb_compare(const void* x, const void* y) {
+    double a = *(const double*)x, b = *(const double*)y;
+    return (a > b) - (a < b);
+}
+
+size_t fossil_math_cheb_roots(const fossil_math_cheb_t* cheb, double* roots, size_t max_roots) {
+    if (!cheb || cheb->n < 2) return 0;
+
+    size_t G = 4 * cheb->n + 1;
+    double* xs = malloc(4 * G * sizeof(double));
+    fossil_math_cheb_t* d = fossil_math_cheb_derivative(cheb);
+    if (!xs || !d) {
+        free(xs);
+        fossil_math_cheb_free(d);
+        return 0;
+    }
+    double* ps = xs + G;
+    double* ds = ps + G;
+    double* found = ds + G;
+    size_t count = 0;
+
+    double mid = 0.5 * (cheb->a + cheb->b), half = 0.5 * (cheb->b - cheb->a);
+    for (size_t k = 0; k < G; ++k) xs[k] = mid - half * fossil_math_cheb_point(k, G - 1);
+    xs[0] = cheb->a;
+    xs[G - 1] = cheb->b;
+    fossil_math_cheb_eval_batch(cheb, xs, ps, G);
+    fossil_math_cheb_eval_batch(d, xs, ds, G);
+
+    double scale = 0.0;
+    for (size_t k = 0; k < cheb->n; ++k) scale += fabs(cheb->c[k]);
+    double zero_tol = 100.0 * DBL_EPSILON * scale;
+
+    for (size_t k = 0; k < G; ++k) {
+        if (ps[k] == 0.0) {
+            found[count++] = xs[k];
+        } else if (k + 1 < G && ps[k + 1] != 0.0 && (ps[k] < 0.0) != (ps[k + 1] < 0.0)) {
+            found[count++] = fossil_math_cheb_refine(cheb, xs[k], xs[k + 1], ps[k], ps[k + 1]);
+        }
+        // Touching roots: an extremum where p vanishes to rounding
+        if (k + 1 < G && ds[k] != 0.0 && ds[k + 1] != 0.0 && (ds[k] < 0.0) != (ds[k + 1] < 0.0) &&
+            (ps[k] < 0.0) == (ps[k + 1] < 0.0)) {
+            double x = fossil_math_cheb_refine(d, xs[k], xs[k + 1], ds[k], ds[k + 1]);
+            if (fabs(fossil_math_cheb_eval(cheb, x)) <= zero_tol) found[count++] = x;
+        }
+    }
+
+    qsort(found, count, sizeof(double), fossil_math_cheb_compare);
+    size_t unique = 0;
+    double min_gap = 1e-12 * (cheb->b - cheb->a);
+    for (size_t k = 0; k < count; ++k) {
+        if (unique > 0 && found[k] - found[unique - 1] <= min_gap) continue;
+        found[unique++] = found[k];
+    }
+    if (roots) memcpy(roots, found, FOSSIL_MATH_MIN(unique, max_roots) * sizeof(double));
+
+    free(xs);
+    fossil_math_cheb_free(d);
+    return unique;
+}
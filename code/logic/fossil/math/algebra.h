@@ -116,13 +116,36 @@ int fossil_math_algebra_matrix_determinant(const double* M, size_t n, double* de
 
 /** 
  * Computes the inverse of a square matrix M of size n x n and stores it in Inv.
+ * Uses LU factorization with partial pivoting.
  * @param M Pointer to the input matrix.
  * @param n Size of the matrix (n x n).
  * @param Inv Pointer to the output inverse matrix.
- * @return 0 on success, non-zero on failure.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure, -3 if M is singular.
  */
 int fossil_math_algebra_matrix_inverse(const double* M, size_t n, double* Inv);
 
+/** 
+ * Factorizes a square matrix in place as P*A = L*U using partial pivoting.
+ * On return the strict lower triangle of A holds L (unit diagonal implied) and
+ * the upper triangle holds U. The factorization can be reused for any number
+ * of right-hand sides with fossil_math_algebra_lu_solve().
+ * @param A Pointer to the matrix (n x n, row-major), overwritten with L and U.
+ * @param n Size of the matrix (n x n).
+ * @param piv Pointer to n entries receiving the row interchanges.
+ * @return 0 on success, -1 on invalid arguments, -3 if A is singular.
+ */
+int fossil_math_algebra_lu_decompose(double* A, size_t n, size_t* piv);
+
+/** 
+ * Solves A*x = b using a factorization from fossil_math_algebra_lu_decompose().
+ * @param LU Pointer to the factorized matrix (n x n).
+ * @param piv Pointer to the row interchanges.
+ * @param b Pointer to the right-hand side vector.
+ * @param x Pointer to the solution vector (may alias b).
+ * @param n Size of the system.
+ */
+void fossil_math_algebra_lu_solve(const double* LU, const size_t* piv, const double* b, double* x, size_t n);
+
 /** 
  * Evaluates a polynomial at a given value x.
  * @param coeffs Pointer to the array of coefficients (coeff[0] is constant term).
@@ -168,11 +191,12 @@ void fossil_math_algebra_poly_mul(const double* A, size_t degA,
 
 /** 
  * Solves a linear system Ax = b for x, where A is an n x n matrix and b is a vector.
+ * Uses LU factorization with partial pivoting.
  * @param A Pointer to the coefficient matrix (n x n).
  * @param b Pointer to the right-hand side vector.
  * @param x Pointer to the solution vector.
  * @param n Size of the system.
- * @return 0 on success, non-zero on failure.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure, -3 if A is singular.
  */
 int fossil_math_algebra_solve_linear_system(const double* A, const double* b,
                                             double* x, size_t n);
@@ -347,6 +371,41 @@ namespace fossil {
                 return Inv;
             }
 
+            /**
+             * Factorizes a square matrix in place as P*A = L*U.
+             * @param A Matrix (n x n) as a flat vector (row-major), overwritten with L and U.
+             * @param n Size of the matrix.
+             * @return Row interchanges to pass to lu_solve().
+             * @throws std::invalid_argument if A is not n x n.
+             * @throws std::runtime_error if A is singular.
+             */
+            static std::vector<size_t> lu_decompose(std::vector<double>& A, size_t n) {
+                if (A.size() != n * n)
+                    throw std::invalid_argument("Matrix must be n x n");
+                std::vector<size_t> piv(n);
+                if (fossil_math_algebra_lu_decompose(A.data(), n, piv.data()) != 0)
+                    throw std::runtime_error("Matrix is singular");
+                return piv;
+            }
+
+            /**
+             * Solves A*x = b using a factorization from lu_decompose().
+             * @param LU Factorized matrix.
+             * @param piv Row interchanges.
+             * @param b Right-hand side vector.
+             * @return Solution vector x.
+             * @throws std::invalid_argument if dimensions do not match.
+             */
+            static std::vector<double> lu_solve(const std::vector<double>& LU, const std::vector<size_t>& piv,
+                                                const std::vector<double>& b) {
+                size_t n = b.size();
+                if (LU.size() != n * n || piv.size() != n)
+                    throw std::invalid_argument("Factorization and vector dimensions do not match");
+                std::vector<double> x(n);
+                fossil_math_algebra_lu_solve(LU.data(), piv.data(), b.data(), x.data(), n);
+                return x;
+            }
+
             /**
              * Evaluates a polynomial at a given value.
              * @param coeffs Coefficients of the polynomial (coeff[0] is constant term).
@@ -38,6 +38,40 @@ extern "C"
 
 typedef double (*fossil_math_func_t)(const double x);  // Generic function pointer
 
+/**
+ * @brief Convergence report filled in by the bracketing root finders.
+ *
+ * - iterations:  Number of solver iterations performed.
+ * - evaluations: Number of calls made to the user function.
+ * - converged:   Non-zero if the tolerance was met before max_iter ran out.
+ */
+typedef struct {
+    size_t iterations;   ///< Solver iterations performed
+    size_t evaluations;  ///< Function evaluations performed
+    int converged;       ///< 1 if the tolerance was reached, 0 otherwise
+} fossil_math_calc_root_info_t;
+
+/**
+ * @brief Vectorized callback for batched root finding.
+ *
+ * Evaluates fx[k] = f_{index[k]}(x[k]) for k in [0, count). The index array
+ * identifies which equation of the batch each lane belongs to, so a single
+ * callback can look up per-item parameters. Only still-active lanes are
+ * passed, packed contiguously, so the callback body can be a tight loop.
+ * The callback may be invoked concurrently from several threads.
+ */
+typedef void (*fossil_math_calc_batch_func_t)(const size_t* index, const double* x, double* fx,
+                                              size_t count, void* ctx);
+
+/**
+ * @brief Vectorized callback returning values and derivatives for batched Newton.
+ *
+ * Same contract as fossil_math_calc_batch_func_t, additionally writing
+ * dfx[k] = f'_{index[k]}(x[k]).
+ */
+typedef void (*fossil_math_calc_batch_fdf_t)(const size_t* index, const double* x, double* fx, double* dfx,
+                                             size_t count, void* ctx);
+
 // ==========================================================
 // Derivatives
 // ==========================================================
@@ -158,6 +192,92 @@ double fossil_math_calc_root_newton(fossil_math_func_t f, fossil_math_func_t df,
  */
 double fossil_math_calc_root_bisection(fossil_math_func_t f, double a, double b, double tol, size_t max_iter);
 
+/**
+ * @brief Find a root of a function using Brent's method.
+ *
+ * Combines bisection, secant and inverse quadratic interpolation. Every step
+ * keeps the root bracketed, so the method always terminates like bisection but
+ * converges superlinearly on smooth functions. This is the recommended default
+ * when a sign-changing bracket is known.
+ *
+ * @param f Function pointer to the function whose root is sought.
+ * @param a Lower bound of the bracket.
+ * @param b Upper bound of the bracket (f(a) and f(b) must differ in sign).
+ * @param tol Absolute tolerance on the root location.
+ * @param max_iter Maximum number of iterations.
+ * @param info Optional convergence report (may be NULL).
+ * @return Approximated root value, or NaN if [a, b] does not bracket a root.
+ */
+double fossil_math_calc_root_brent(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                   fossil_math_calc_root_info_t* info);
+
+/**
+ * @brief Find a root of a function using Alefeld-Potra-Shi (TOMS 748).
+ *
+ * Uses inverse cubic and quadratic interpolation with a double-length secant
+ * step, shrinking the bracket on every iteration. It typically needs fewer
+ * evaluations than Brent's method on smooth functions and keeps the same
+ * termination guarantee.
+ *
+ * @param f Function pointer to the function whose root is sought.
+ * @param a Lower bound of the bracket.
+ * @param b Upper bound of the bracket (f(a) and f(b) must differ in sign).
+ * @param tol Absolute tolerance on the bracket width.
+ * @param max_iter Maximum number of iterations.
+ * @param info Optional convergence report (may be NULL).
+ * @return Approximated root value, or NaN if [a, b] does not bracket a root.
+ */
+double fossil_math_calc_root_toms748(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                     fossil_math_calc_root_info_t* info);
+
+// ==========================================================
+// Batched Root Finding
+// ==========================================================
+
+/**
+ * @brief Solve many independent bracketed equations with Brent's method.
+ *
+ * Item i is solved on [a[i], b[i]]. Items advance in lock-step blocks: every
+ * iteration gathers the still-active lanes, evaluates them with one call to
+ * the vectorized callback, and drops lanes as they converge. Blocks are
+ * partitioned across fossil_math_parallel_threads() threads.
+ *
+ * @param f Vectorized callback evaluating the equations.
+ * @param ctx User context passed to f.
+ * @param a Lower bracket per item.
+ * @param b Upper bracket per item.
+ * @param roots Output roots per item (NaN when the bracket is invalid).
+ * @param n Number of items.
+ * @param tol Absolute tolerance on the root location.
+ * @param max_iter Maximum iterations per item.
+ * @param converged Optional per-item flags set to 1 on convergence (may be NULL).
+ * @return Number of items that converged.
+ */
+size_t fossil_math_calc_root_brent_batch(fossil_math_calc_batch_func_t f, void* ctx,
+                                         const double* a, const double* b, double* roots, size_t n,
+                                         double tol, size_t max_iter, int* converged);
+
+/**
+ * @brief Solve many independent equations with Newton-Raphson.
+ *
+ * Item i starts from x0[i]. Iteration, lane masking and threading follow
+ * fossil_math_calc_root_brent_batch(); a lane stops when its step falls below
+ * tol or its derivative vanishes.
+ *
+ * @param fdf Vectorized callback evaluating values and derivatives.
+ * @param ctx User context passed to fdf.
+ * @param x0 Initial guess per item.
+ * @param roots Output roots per item.
+ * @param n Number of items.
+ * @param tol Tolerance on the Newton step.
+ * @param max_iter Maximum iterations per item.
+ * @param converged Optional per-item flags set to 1 on convergence (may be NULL).
+ * @return Number of items that converged.
+ */
+size_t fossil_math_calc_root_newton_batch(fossil_math_calc_batch_fdf_t fdf, void* ctx,
+                                          const double* x0, double* roots, size_t n,
+                                          double tol, size_t max_iter, int* converged);
+
 // ==========================================================
 // Utilities
 // ==========================================================
@@ -304,6 +424,73 @@ namespace fossil {
             return fossil_math_calc_root_bisection(f, a, b, tol, max_iter);
             }
 
+            /**
+             * @brief Find a root of a function using Brent's method.
+             * @param f Function pointer to the function whose root is sought.
+             * @param a Lower bound of the bracket.
+             * @param b Upper bound of the bracket.
+             * @param tol Absolute tolerance on the root location.
+             * @param max_iter Maximum number of iterations.
+             * @param info Optional convergence report.
+             * @return Approximated root value, or NaN if [a, b] does not bracket a root.
+             */
+            static double root_brent(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                     fossil_math_calc_root_info_t* info = nullptr) {
+            return fossil_math_calc_root_brent(f, a, b, tol, max_iter, info);
+            }
+
+            /**
+             * @brief Find a root of a function using Alefeld-Potra-Shi (TOMS 748).
+             * @param f Function pointer to the function whose root is sought.
+             * @param a Lower bound of the bracket.
+             * @param b Upper bound of the bracket.
+             * @param tol Absolute tolerance on the bracket width.
+             * @param max_iter Maximum number of iterations.
+             * @param info Optional convergence report.
+             * @return Approximated root value, or NaN if [a, b] does not bracket a root.
+             */
+            static double root_toms748(fossil_math_func_t f, double a, double b, double tol, size_t max_iter,
+                                       fossil_math_calc_root_info_t* info = nullptr) {
+            return fossil_math_calc_root_toms748(f, a, b, tol, max_iter, info);
+            }
+
+            /**
+             * @brief Solve many independent bracketed equations with Brent's method.
+             * @param f Vectorized callback evaluating the equations.
+             * @param ctx User context passed to f.
+             * @param a Lower bracket per item.
+             * @param b Upper bracket per item.
+             * @param tol Absolute tolerance on the root location.
+             * @param max_iter Maximum iterations per item.
+             * @return Roots per item (NaN where the bracket is invalid).
+             * @throws std::invalid_argument if the bracket arrays differ in length.
+             */
+            static std::vector<double> root_brent_batch(fossil_math_calc_batch_func_t f, void* ctx,
+                                                        const std::vector<double>& a, const std::vector<double>& b,
+                                                        double tol, size_t max_iter) {
+                if (a.size() != b.size())
+                    throw std::invalid_argument("Bracket arrays must be the same length");
+                std::vector<double> roots(a.size());
+                fossil_math_calc_root_brent_batch(f, ctx, a.data(), b.data(), roots.data(), a.size(), tol, max_iter, nullptr);
+                return roots;
+            }
+
+            /**
+             * @brief Solve many independent equations with Newton-Raphson.
+             * @param fdf Vectorized callback evaluating values and derivatives.
+             * @param ctx User context passed to fdf.
+             * @param x0 Initial guess per item.
+             * @param tol Tolerance on the Newton step.
+             * @param max_iter Maximum iterations per item.
+             * @return Roots per item.
+             */
+            static std::vector<double> root_newton_batch(fossil_math_calc_batch_fdf_t fdf, void* ctx,
+                                                         const std::vector<double>& x0, double tol, size_t max_iter) {
+                std::vector<double> roots(x0.size());
+                fossil_math_calc_root_newton_batch(fdf, ctx, x0.data(), roots.data(), x0.size(), tol, max_iter, nullptr);
+                return roots;
+            }
+
             /**
              * @brief Compute the gradient vector for a multivariable function.
              * @param funcs Array of function pointers, each representing a partial derivative.
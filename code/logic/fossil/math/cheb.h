@@ -0,0 +1,276 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_CHEB_H
+#define FOSSIL_MATH_CHEB_H
+
+#include "calc.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Opaque Chebyshev series p(x) = sum_k c[k] T_k(u) on [a, b].
+ *
+ * u = (2x - a - b) / (b - a) maps the interval onto [-1, 1]. Approximants
+ * are immutable after creation and may be evaluated from several threads
+ * at once. Outside [a, b] the series is still evaluated, but it is only
+ * meaningful inside the interval.
+ */
+typedef struct fossil_math_cheb fossil_math_cheb_t;
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+/**
+ * @brief Builds a Chebyshev approximation of f on [a, b] to a relative tolerance.
+ *
+ * f is sampled at 17, 33, 65, ... Chebyshev points (nested, so each sample is
+ * computed once) until the trailing coefficients fall below tol times the
+ * largest sampled |f|. The series is then truncated to the shortest length
+ * meeting the tolerance.
+ *
+ * @param f Function to approximate (smooth on [a, b]).
+ * @param a Left end of the interval.
+ * @param b Right end of the interval (b > a).
+ * @param tol Relative tolerance (0 = 100 * machine epsilon).
+ * @param max_degree Largest degree tried, rounded up to a power of two (0 = 4096).
+ * @return The approximation, or NULL on invalid input, allocation failure,
+ *         non-finite samples, or if f is not resolved by max_degree.
+ */
+fossil_math_cheb_t* fossil_math_cheb_create(fossil_math_func_t f, double a, double b, double tol, size_t max_degree);
+
+/**
+ * @brief Wraps existing Chebyshev coefficients.
+ *
+ * @param coeffs Coefficients c[0..n-1] (copied).
+ * @param n Number of coefficients (at least 1).
+ * @param a Left end of the interval.
+ * @param b Right end of the interval (b > a).
+ * @return The approximation, or NULL on invalid input or allocation failure.
+ */
+fossil_math_cheb_t* fossil_math_cheb_from_coeffs(const double* coeffs, size_t n, double a, double b);
+
+/**
+ * @brief Releases an approximation. Passing NULL is a no-op.
+ */
+void fossil_math_cheb_free(fossil_math_cheb_t* cheb);
+
+/**
+ * @brief Returns the degree of the series (number of coefficients - 1).
+ */
+size_t fossil_math_cheb_degree(const fossil_math_cheb_t* cheb);
+
+/**
+ * @brief Returns a read-only view of the degree + 1 coefficients.
+ */
+const double* fossil_math_cheb_coeffs(const fossil_math_cheb_t* cheb);
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/**
+ * @brief Evaluates the series at x with Clenshaw's recurrence.
+ *
+ * @param cheb Approximation.
+ * @param x Evaluation point.
+ * @return p(x) (NaN if cheb is NULL).
+ */
+double fossil_math_cheb_eval(const fossil_math_cheb_t* cheb, double x);
+
+/**
+ * @brief Evaluates the series at count points.
+ *
+ * Runs Clenshaw's recurrence over blocks of points at once, coefficient by
+ * coefficient, so the inner loop is independent across points and vectorizes.
+ *
+ * @param cheb Approximation.
+ * @param x Evaluation points (count entries).
+ * @param y Output values (count entries, may alias x).
+ * @param count Number of points.
+ */
+void fossil_math_cheb_eval_batch(const fossil_math_cheb_t* cheb, const double* x, double* y, size_t count);
+
+// ============================================================================
+// Calculus
+// ============================================================================
+
+/**
+ * @brief Returns the series of p'(x) on the same interval.
+ *
+ * @param cheb Approximation.
+ * @return New approximation (caller frees), or NULL on allocation failure.
+ */
+fossil_math_cheb_t* fossil_math_cheb_derivative(const fossil_math_cheb_t* cheb);
+
+/**
+ * @brief Returns the antiderivative of p that vanishes at a.
+ *
+ * @param cheb Approximation.
+ * @return New approximation (caller frees), or NULL on allocation failure.
+ */
+fossil_math_cheb_t* fossil_math_cheb_integral(const fossil_math_cheb_t* cheb);
+
+/**
+ * @brief Returns the definite integral of p over [a, b] (Clenshaw-Curtis weights).
+ *
+ * @param cheb Approximation.
+ * @return Integral value (NaN if cheb is NULL).
+ */
+double fossil_math_cheb_integrate(const fossil_math_cheb_t* cheb);
+
+/**
+ * @brief Finds the roots of p in [a, b] in increasing order.
+ *
+ * Sign changes of p on a Chebyshev grid of 4 * (degree + 1) + 1 points,
+ * a and b included, are refined with the Illinois method. Extrema of p (sign changes of p') where
+ * |p| vanishes to rounding are reported too, so double roots are found.
+ * Roots closer together than the grid spacing may be missed.
+ *
+ * @param cheb Approximation.
+ * @param roots Output array (may be NULL to only count).
+ * @param max_roots Capacity of roots.
+ * @return Number of roots found (only the first max_roots are stored).
+ */
+size_t fossil_math_cheb_roots(const fossil_math_cheb_t* cheb, double* roots, size_t max_roots);
+
+#ifdef __cplusplus
+}
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief Owning C++ wrapper for a Chebyshev approximation.
+         *
+         * Construction throws std::invalid_argument if the function cannot be
+         * resolved. Instances are movable but not copyable.
+         */
+        class Cheb {
+        public:
+            /**
+             * @brief Approximates f on [a, b].
+             * @param f Function to approximate.
+             * @param a Left end of the interval.
+             * @param b Right end of the interval.
+             * @param tol Relative tolerance (0 = default).
+             * @param max_degree Largest degree tried (0 = default).
+             * @throws std::invalid_argument if f cannot be resolved.
+             */
+            Cheb(fossil_math_func_t f, double a, double b, double tol = 0.0, size_t max_degree = 0)
+                : c_(fossil_math_cheb_create(f, a, b, tol, max_degree)) {
+                if (!c_) throw std::invalid_argument("Chebyshev approximation failed");
+            }
+
+            ~Cheb() { fossil_math_cheb_free(c_); }
+            Cheb(const Cheb&) = delete;
+            Cheb& operator=(const Cheb&) = delete;
+            Cheb(Cheb&& other) noexcept : c_(other.c_) { other.c_ = nullptr; }
+            Cheb& operator=(Cheb&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_cheb_free(c_);
+                    c_ = other.c_;
+                    other.c_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Evaluates the series at x.
+             */
+            double operator()(double x) const { return fossil_math_cheb_eval(c_, x); }
+
+            /**
+             * @brief Evaluates the series at every point of x.
+             */
+            std::vector<double> eval_batch(const std::vector<double>& x) const {
+                std::vector<double> y(x.size());
+                fossil_math_cheb_eval_batch(c_, x.data(), y.data(), x.size());
+                return y;
+            }
+
+            /**
+             * @brief Returns the degree of the series.
+             */
+            size_t degree() const { return fossil_math_cheb_degree(c_); }
+
+            /**
+             * @brief Returns a copy of the coefficients.
+             */
+            std::vector<double> coeffs() const {
+                const double* c = fossil_math_cheb_coeffs(c_);
+                return std::vector<double>(c, c + degree() + 1);
+            }
+
+            /**
+             * @brief Returns the derivative series.
+             */
+            Cheb derivative() const { return Cheb(fossil_math_cheb_derivative(c_)); }
+
+            /**
+             * @brief Returns the antiderivative vanishing at a.
+             */
+            Cheb integral() const { return Cheb(fossil_math_cheb_integral(c_)); }
+
+            /**
+             * @brief Returns the definite integral over [a, b].
+             */
+            double integrate() const { return fossil_math_cheb_integrate(c_); }
+
+            /**
+             * @brief Returns the roots in [a, b] in increasing order.
+             */
+            std::vector<double> roots() const {
+                std::vector<double> r(fossil_math_cheb_roots(c_, nullptr, 0));
+                fossil_math_cheb_roots(c_, r.data(), r.size());
+                return r;
+            }
+
+        private:
+            explicit Cheb(fossil_math_cheb_t* c) : c_(c) {
+                if (!c_) throw std::bad_alloc();
+            }
+            fossil_math_cheb_t* c_;
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_CHEB_H */
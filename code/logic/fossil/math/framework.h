@@ -33,5 +33,14 @@
 #include "geom.h"
 #include "trig.h"
 #include "calc.h"
+#include "parallel.h"
+#include "nonlinear.h"
+#include "optim.h"
+#include "ode.h"
+#include "interp.h"
+#include "cheb.h"
+#include "stats.h"
+#include "sketch.h"
+#include "instrument.h"
 
 #endif /* FOSSIL_MATH_FRAMEWORK_H */
@@ -0,0 +1,369 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_INSTRUMENT_H
+#define FOSSIL_MATH_INSTRUMENT_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Instrumented kernels.
+ *
+ * Counters exist only when the library is built with FOSSIL_MATH_INSTRUMENT
+ * defined (meson option with_instrument). Otherwise the hooks compile to
+ * nothing and snapshots report zeros. Tracing is always available and is
+ * switched on at run time. PARALLEL_CHUNK is one chunk of a
+ * fossil_math_parallel_for() call, including the user callback.
+ */
+typedef enum {
+    FOSSIL_MATH_KERNEL_TENSOR_CREATE,
+    FOSSIL_MATH_KERNEL_TENSOR_ADD,
+    FOSSIL_MATH_KERNEL_TENSOR_MUL,
+    FOSSIL_MATH_KERNEL_TENSOR_DOT,
+    FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_MUL,
+    FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_INVERSE,
+    FOSSIL_MATH_KERNEL_ALGEBRA_LU_DECOMPOSE,
+    FOSSIL_MATH_KERNEL_ALGEBRA_SOLVE_LINEAR_SYSTEM,
+    FOSSIL_MATH_KERNEL_CALC_INTEGRATE_TRAPEZOIDAL,
+    FOSSIL_MATH_KERNEL_CALC_INTEGRATE_SIMPSON,
+    FOSSIL_MATH_KERNEL_CALC_INTEGRATE_MONTECARLO,
+    FOSSIL_MATH_KERNEL_ODE_RK45,
+    FOSSIL_MATH_KERNEL_ODE_BDF,
+    FOSSIL_MATH_KERNEL_ODE_SOLVE_BATCH,
+    FOSSIL_MATH_KERNEL_SYM_PARSE,
+    FOSSIL_MATH_KERNEL_SYM_COMPILE,
+    FOSSIL_MATH_KERNEL_SYM_EVAL,
+    FOSSIL_MATH_KERNEL_SYM_EVAL_COMPILED,
+    FOSSIL_MATH_KERNEL_SYM_EVAL_BATCH,
+    FOSSIL_MATH_KERNEL_PARALLEL_CHUNK,
+    FOSSIL_MATH_KERNEL_COUNT
+} fossil_math_kernel_t;
+
+/**
+ * @brief Totals for one kernel across all threads.
+ *
+ * - calls: Every call, including ones rejected for invalid arguments or failed allocations.
+ * - ticks: Time spent inside the kernel, in fossil_math_instrument_ticks() units.
+ * - bytes: Bytes allocated by the kernel itself.
+ * - flops: Estimated floating-point operations of the kernel itself,
+ *          excluding user callbacks such as integrands; 0 for calls that did no work.
+ */
+typedef struct {
+    const char* name;   ///< Kernel name, e.g. "tensor_dot"
+    uint64_t calls;
+    uint64_t ticks;
+    uint64_t bytes;
+    uint64_t flops;
+} fossil_math_instrument_counter_t;
+
+// ============================================================================
+// Snapshot API
+// ============================================================================
+
+/**
+ * @brief Returns non-zero if the library was built with FOSSIL_MATH_INSTRUMENT.
+ */
+int fossil_math_instrument_enabled(void);
+
+/**
+ * @brief Reads the current counter of every kernel.
+ *
+ * Each thread updates its own counter block without locks; a snapshot sums
+ * the blocks of all threads, so counts from kernels still running on other
+ * threads may be partly included.
+ *
+ * @param out Receives counters indexed by fossil_math_kernel_t.
+ * @param max Capacity of out.
+ * @return FOSSIL_MATH_KERNEL_COUNT (only the first max entries are stored).
+ */
+size_t fossil_math_instrument_snapshot(fossil_math_instrument_counter_t* out, size_t max);
+
+/**
+ * @brief Starts all counters from zero.
+ *
+ * Later snapshots report activity since the reset. Threads are not paused,
+ * so work racing with the reset may land on either side of it. Do not call
+ * it concurrently with itself or with fossil_math_instrument_snapshot().
+ */
+void fossil_math_instrument_reset(void);
+
+/**
+ * @brief Reads the tick counter used for kernel timing.
+ *
+ * This is the time-stamp counter on x86 (rdtsc) and the virtual counter on
+ * AArch64; elsewhere it is a monotonic clock in nanoseconds.
+ */
+uint64_t fossil_math_instrument_ticks(void);
+
+/**
+ * @brief Returns the tick rate.
+ *
+ * The rate is measured once against the monotonic clock (about 10 ms)
+ * on first use.
+ */
+double fossil_math_instrument_ticks_per_second(void);
+
+/**
+ * @brief Writes all counters in the Prometheus text exposition format.
+ *
+ * Emits fossil_math_kernel_calls_total, _cycles_total, _seconds_total,
+ * _bytes_allocated_total and _flops_total, labelled by kernel.
+ *
+ * @param buffer Output buffer (may be NULL when size is 0).
+ * @param size Capacity of buffer, including the terminating NUL.
+ * @return Length of the full text, excluding the NUL. If this is not less
+ *         than size the text was truncated, as with snprintf().
+ */
+size_t fossil_math_instrument_prometheus(char* buffer, size_t size);
+
+// ============================================================================
+// Kernel Hooks
+// ============================================================================
+
+/**
+ * @brief Adds one completed call to the calling thread's counters.
+ *
+ * Used by FOSSIL_MATH_INSTRUMENT_END(); call it directly only from code
+ * that measures its own ticks.
+ */
+void fossil_math_instrument_record(fossil_math_kernel_t kernel, uint64_t ticks, uint64_t flops);
+
+/**
+ * @brief Adds bytes allocated on behalf of a kernel.
+ */
+void fossil_math_instrument_alloc(fossil_math_kernel_t kernel, uint64_t bytes);
+
+/**
+ * Kernels open their body with FOSSIL_MATH_INSTRUMENT_BEGIN() and leave
+ * through a single FOSSIL_MATH_INSTRUMENT_END(kernel, flops) in the same
+ * block, so rejected and failed calls are recorded too. Without FOSSIL_MATH_INSTRUMENT the hooks expand to no-ops and
+ * their arguments are not evaluated.
+ */
+#if defined(FOSSIL_MATH_INSTRUMENT)
+#define FOSSIL_MATH_INSTRUMENT_BEGIN() uint64_t fossil_math_instrument_start_ = fossil_math_instrument_ticks()
+#define FOSSIL_MATH_INSTRUMENT_END(kernel, flops) \
+    fossil_math_instrument_record((kernel), fossil_math_instrument_ticks() - fossil_math_instrument_start_, (uint64_t)(flops))
+#define FOSSIL_MATH_INSTRUMENT_ALLOC(kernel, bytes) fossil_math_instrument_alloc((kernel), (uint64_t)(bytes))
+#else
+#define FOSSIL_MATH_INSTRUMENT_BEGIN() ((void)0)
+#define FOSSIL_MATH_INSTRUMENT_END(kernel, flops) ((void)0)
+#define FOSSIL_MATH_INSTRUMENT_ALLOC(kernel, bytes) ((void)0)
+#endif
+
+// ============================================================================
+// Tracing
+// ============================================================================
+
+/**
+ * @brief Non-zero while a trace session is recording. Read by the hooks only.
+ */
+extern volatile int fossil_math_trace_on;
+
+/**
+ * @brief Starts a trace session, discarding the events of the previous one.
+ *
+ * While the session runs each kernel call appends one event (start, duration
+ * and its shape) to a ring buffer owned by the calling thread. Rings are
+ * allocated on a thread's first traced call; when one wraps, its oldest
+ * events are overwritten and counted as dropped.
+ *
+ * Start and stop may be called while other threads run kernels; a call in
+ * flight may then land in either session. Do not call start, stop and
+ * export concurrently with each other.
+ *
+ * @param events_per_thread Ring capacity per thread (0 = 65536).
+ * @return 0 on success, -1 if the capacity is too large.
+ */
+int fossil_math_trace_start(size_t events_per_thread);
+
+/**
+ * @brief Stops recording. Recorded events are kept until the next start.
+ */
+void fossil_math_trace_stop(void);
+
+/**
+ * @brief Returns non-zero while a trace session is recording.
+ */
+int fossil_math_trace_active(void);
+
+/**
+ * @brief Writes the recorded events as Chrome trace-event JSON.
+ *
+ * Only valid after fossil_math_trace_stop() once kernels that were running
+ * at the time have returned: a late call may still append to its ring and,
+ * if the ring wraps, overwrite an event while it is being read.
+ *
+ * The output loads in chrome://tracing and Perfetto. Each call is a complete
+ * ("X") event named after its kernel, with ts and dur in microseconds since
+ * the session start, one tid per thread and the shape in args.dims (see the
+ * call sites of FOSSIL_MATH_TRACE_END()). A thread that has exited passes
+ * its tid on to the next new thread, so a tid never runs two events at
+ * once. otherData.dropped_events counts overwritten events.
+ *
+ * @param buffer Output buffer (may be NULL when size is 0).
+ * @param size Capacity of buffer, including the terminating NUL.
+ * @return Length of the full text, excluding the NUL. If this is not less
+ *         than size the text was truncated, as with snprintf().
+ */
+size_t fossil_math_trace_json(char* buffer, size_t size);
+
+/**
+ * @brief Writes the trace JSON to a file.
+ *
+ * @param path Output file path.
+ * @return 0 on success, -1 on invalid input or I/O failure, -2 on allocation failure.
+ */
+int fossil_math_trace_write(const char* path);
+
+/**
+ * @brief Appends one event to the calling thread's ring.
+ *
+ * Used by FOSSIL_MATH_TRACE_END(); start is the tick count at entry.
+ */
+void fossil_math_trace_record(fossil_math_kernel_t kernel, uint64_t start, uint64_t d0, uint64_t d1, uint64_t d2);
+
+/**
+ * Reads the recording flag with acquire order, pairing with the release
+ * store in fossil_math_trace_start(). Volatile loads already acquire on x86
+ * with MSVC; other MSVC targets take the function call.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define FOSSIL_MATH_TRACE_ON() __atomic_load_n(&fossil_math_trace_on, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define FOSSIL_MATH_TRACE_ON() fossil_math_trace_on
+#else
+#define FOSSIL_MATH_TRACE_ON() fossil_math_trace_active()
+#endif
+
+/**
+ * Kernels bracket their work with FOSSIL_MATH_TRACE_BEGIN() and
+ * FOSSIL_MATH_TRACE_END(kernel, d0, d1, d2) next to the instrument hooks.
+ * The dimensions describe the call, e.g. (m, n, p) for an m x n by n x p
+ * product; trailing zeros are omitted from the output. When no session is
+ * recording each hook costs one predictable branch.
+ */
+#define FOSSIL_MATH_TRACE_BEGIN() \
+    uint64_t fossil_math_trace_begin_ = FOSSIL_MATH_TRACE_ON() ? fossil_math_instrument_ticks() : 0
+#define FOSSIL_MATH_TRACE_END(kernel, d0, d1, d2) \
+    do { \
+        if (fossil_math_trace_begin_) \
+            fossil_math_trace_record((kernel), fossil_math_trace_begin_, (uint64_t)(d0), (uint64_t)(d1), (uint64_t)(d2)); \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief Static accessors for the kernel counters.
+         */
+        class Instrument {
+        public:
+            /**
+             * @brief Returns true if the library was built with instrumentation.
+             */
+            static bool enabled() { return fossil_math_instrument_enabled() != 0; }
+
+            /**
+             * @brief Returns the counters of every kernel.
+             */
+            static std::vector<fossil_math_instrument_counter_t> snapshot() {
+                std::vector<fossil_math_instrument_counter_t> out(FOSSIL_MATH_KERNEL_COUNT);
+                fossil_math_instrument_snapshot(out.data(), out.size());
+                return out;
+            }
+
+            /**
+             * @brief Starts all counters from zero.
+             */
+            static void reset() { fossil_math_instrument_reset(); }
+
+            /**
+             * @brief Returns the counters as Prometheus text.
+             */
+            static std::string prometheus() {
+                std::vector<char> buffer(fossil_math_instrument_prometheus(nullptr, 0) + 1);
+                size_t n = fossil_math_instrument_prometheus(buffer.data(), buffer.size());
+                return std::string(buffer.data(), n < buffer.size() ? n : buffer.size() - 1);
+            }
+        };
+
+        /**
+         * @brief Static accessors for trace sessions.
+         */
+        class Trace {
+        public:
+            /**
+             * @brief Starts a session with the given ring capacity per thread (0 = default).
+             * @throws std::invalid_argument if the capacity is too large.
+             */
+            static void start(size_t events_per_thread = 0) {
+                if (fossil_math_trace_start(events_per_thread) != 0) throw std::invalid_argument("trace capacity too large");
+            }
+
+            /**
+             * @brief Stops recording.
+             */
+            static void stop() { fossil_math_trace_stop(); }
+
+            /**
+             * @brief Returns the recorded events as Chrome trace-event JSON.
+             */
+            static std::string json() {
+                std::vector<char> buffer(fossil_math_trace_json(nullptr, 0) + 1);
+                size_t n = fossil_math_trace_json(buffer.data(), buffer.size());
+                return std::string(buffer.data(), n < buffer.size() ? n : buffer.size() - 1);
+            }
+
+            /**
+             * @brief Writes the JSON to path.
+             * @throws std::runtime_error if the file cannot be written.
+             */
+            static void write(const std::string& path) {
+                if (fossil_math_trace_write(path.c_str()) != 0) throw std::runtime_error("cannot write trace");
+            }
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_INSTRUMENT_H */
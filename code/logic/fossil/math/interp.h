@@ -0,0 +1,436 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_INTERP_H
+#define FOSSIL_MATH_INTERP_H
+
+#include "math.h"
+#include "tensor.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Interpolation schemes for tabulated data.
+ *
+ * - FOSSIL_MATH_INTERP_LINEAR: Piecewise linear.
+ *
+ * - FOSSIL_MATH_INTERP_CUBIC_NATURAL: C2 cubic spline with zero second
+ *   derivative at both ends.
+ *
+ * - FOSSIL_MATH_INTERP_CUBIC_CLAMPED: C2 cubic spline with prescribed first
+ *   derivatives at both ends.
+ *
+ * - FOSSIL_MATH_INTERP_PCHIP: Monotone piecewise cubic Hermite interpolation
+ *   (Fritsch-Carlson). C1, never overshoots monotone data.
+ */
+typedef enum {
+    FOSSIL_MATH_INTERP_LINEAR,
+    FOSSIL_MATH_INTERP_CUBIC_NATURAL,
+    FOSSIL_MATH_INTERP_CUBIC_CLAMPED,
+    FOSSIL_MATH_INTERP_PCHIP
+} fossil_math_interp_kind_t;
+
+/**
+ * @brief Opaque interpolant built once from a table and evaluated many times.
+ *
+ * Every scheme is stored in piecewise polynomial form: breakpoints plus the
+ * local power-basis coefficients of each piece. Evaluating is an interval
+ * lookup followed by Horner's rule. Lookup is O(1) when the breakpoints are
+ * uniformly spaced, otherwise a binary search. Queries outside the table
+ * extrapolate the first or last piece. Interpolants are immutable after
+ * creation and may be evaluated from several threads at once.
+ */
+typedef struct fossil_math_interp fossil_math_interp_t;
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+/**
+ * @brief Builds an interpolant through (x[i], y[i]).
+ *
+ * @param kind Interpolation scheme.
+ * @param x Strictly increasing abscissae (n entries).
+ * @param y Ordinates (n entries).
+ * @param n Number of points (at least 2).
+ * @param d0 First derivative at x[0] (FOSSIL_MATH_INTERP_CUBIC_CLAMPED only).
+ * @param dn First derivative at x[n - 1] (FOSSIL_MATH_INTERP_CUBIC_CLAMPED only).
+ * @return The interpolant, or NULL on invalid input or allocation failure.
+ */
+fossil_math_interp_t* fossil_math_interp_create(fossil_math_interp_kind_t kind, const double* x, const double* y,
+                                                size_t n, double d0, double dn);
+
+/**
+ * @brief Builds an interpolating B-spline of the given degree.
+ *
+ * Uses not-a-knot end conditions: knots sit at the data sites (odd degree)
+ * or midway between them (even degree), skipping the ones next to each end.
+ * The banded collocation system is solved in O(n * degree^2), then converted
+ * to piecewise polynomial form so evaluation costs the same as for the other
+ * schemes.
+ *
+ * @param x Strictly increasing abscissae (n entries).
+ * @param y Ordinates (n entries).
+ * @param n Number of points (at least degree + 1).
+ * @param degree Spline degree, 1 to 5.
+ * @return The interpolant, or NULL on invalid input or allocation failure.
+ */
+fossil_math_interp_t* fossil_math_interp_create_bspline(const double* x, const double* y, size_t n, size_t degree);
+
+/**
+ * @brief Releases an interpolant. Passing NULL is a no-op.
+ */
+void fossil_math_interp_free(fossil_math_interp_t* interp);
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/**
+ * @brief Evaluates the interpolant at x.
+ *
+ * @param interp Interpolant.
+ * @param x Query point.
+ * @return Interpolated value (NaN if interp is NULL).
+ */
+double fossil_math_interp_eval(const fossil_math_interp_t* interp, double x);
+
+/**
+ * @brief Evaluates the interpolant at x, starting the interval search at *hint.
+ *
+ * The hint is checked first, then its right neighbour, before falling back to
+ * the full lookup, and is updated to the interval used. Streams of nearby or
+ * increasing queries therefore cost O(1) per point on any grid. Initialize
+ * the hint to 0; each thread needs its own.
+ *
+ * @param interp Interpolant.
+ * @param x Query point.
+ * @param hint Interval cache, read and updated.
+ * @return Interpolated value (NaN if interp is NULL).
+ */
+double fossil_math_interp_eval_hint(const fossil_math_interp_t* interp, double x, size_t* hint);
+
+/**
+ * @brief Evaluates the first derivative of the interpolant at x.
+ *
+ * @param interp Interpolant.
+ * @param x Query point.
+ * @return Derivative value (NaN if interp is NULL).
+ */
+double fossil_math_interp_deriv(const fossil_math_interp_t* interp, double x);
+
+/**
+ * @brief Evaluates the interpolant at count points.
+ *
+ * Queries are processed in blocks: the intervals are located first (using
+ * the hint cache across the block), then the polynomials are evaluated in a
+ * branch-free loop that the compiler can vectorize.
+ *
+ * @param interp Interpolant.
+ * @param x Query points (count entries).
+ * @param y Output values (count entries, may alias x).
+ * @param count Number of queries.
+ */
+void fossil_math_interp_eval_batch(const fossil_math_interp_t* interp, const double* x, double* y, size_t count);
+
+// ============================================================================
+// Grid Interpolation
+// ============================================================================
+
+/**
+ * @brief Interpolation kernels for regular N-D grids.
+ *
+ * - FOSSIL_MATH_GRID_LINEAR: Multilinear (bilinear, trilinear, ...) over the
+ *   2^d surrounding samples.
+ *
+ * - FOSSIL_MATH_GRID_CUBIC: Tensor-product Catmull-Rom (bicubic, tricubic, ...)
+ *   over the 4^d surrounding samples. C1 continuous, exact for linear data.
+ */
+typedef enum {
+    FOSSIL_MATH_GRID_LINEAR,
+    FOSSIL_MATH_GRID_CUBIC
+} fossil_math_grid_method_t;
+
+/**
+ * @brief Treatment of queries outside the grid.
+ *
+ * - FOSSIL_MATH_GRID_CLAMP: Coordinates are clamped to the grid, so the edge
+ *   values extend outward.
+ *
+ * - FOSSIL_MATH_GRID_WRAP: Each axis is periodic with a period of shape[d]
+ *   samples; the last sample is not a repeat of the first.
+ *
+ * - FOSSIL_MATH_GRID_EXTRAPOLATE: The edge cells are extended, so linear
+ *   data is reproduced exactly everywhere.
+ */
+typedef enum {
+    FOSSIL_MATH_GRID_CLAMP,
+    FOSSIL_MATH_GRID_WRAP,
+    FOSSIL_MATH_GRID_EXTRAPOLATE
+} fossil_math_grid_boundary_t;
+
+/**
+ * @brief Opaque interpolator over the samples of a tensor.
+ *
+ * Axis d of the tensor holds shape[d] >= 2 uniformly spaced samples from
+ * lo[d] to hi[d]. Strides and spacings are computed once at creation. The
+ * tensor data is referenced, not copied, so the tensor must outlive the
+ * interpolator; changed sample values are seen by later queries.
+ */
+typedef struct fossil_math_grid fossil_math_grid_t;
+
+/**
+ * @brief Largest number of dimensions supported by grid interpolation.
+ */
+#define FOSSIL_MATH_GRID_MAX_DIMS 8
+
+/**
+ * @brief Creates an interpolator over the samples of table.
+ *
+ * @param table Sample tensor (1 to FOSSIL_MATH_GRID_MAX_DIMS dimensions).
+ * @param lo Coordinate of the first sample per axis, or NULL for 0.
+ * @param hi Coordinate of the last sample per axis, or NULL for shape[d] - 1.
+ * @param method Interpolation kernel.
+ * @param boundary Out-of-range behaviour.
+ * @return The interpolator, or NULL on invalid input or allocation failure.
+ */
+fossil_math_grid_t* fossil_math_grid_create(const fossil_math_tensor_t* table, const double* lo, const double* hi,
+                                            fossil_math_grid_method_t method, fossil_math_grid_boundary_t boundary);
+
+/**
+ * @brief Releases an interpolator. Passing NULL is a no-op.
+ */
+void fossil_math_grid_free(fossil_math_grid_t* grid);
+
+/**
+ * @brief Returns the number of coordinates per query point.
+ */
+size_t fossil_math_grid_dims(const fossil_math_grid_t* grid);
+
+/**
+ * @brief Interpolates the grid at one point.
+ *
+ * @param grid Interpolator.
+ * @param point Query coordinates (dims entries).
+ * @return Interpolated value (NaN if grid or point is NULL).
+ */
+double fossil_math_grid_eval(const fossil_math_grid_t* grid, const double* point);
+
+/**
+ * @brief Interpolates the grid at count points.
+ *
+ * Points are split into blocks over the fossil_math_parallel worker threads.
+ * Within a block, every point's sample offsets and weights are computed first
+ * and the first sample of each point is prefetched. The gather-and-accumulate
+ * pass then runs over memory that is already on its way into cache.
+ *
+ * @param grid Interpolator.
+ * @param points Query coordinates (count x dims, row-major).
+ * @param out Interpolated values (count entries).
+ * @param count Number of points.
+ */
+void fossil_math_grid_eval_batch(const fossil_math_grid_t* grid, const double* points, double* out, size_t count);
+
+#ifdef __cplusplus
+}
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief Owning C++ wrapper for a fossil_math_interp_t interpolant.
+         *
+         * Construction throws std::invalid_argument if the table is rejected.
+         * Instances are movable but not copyable.
+         */
+        class Interp {
+        public:
+            /**
+             * @brief Builds an interpolant through (x[i], y[i]).
+             * @param kind Interpolation scheme.
+             * @param x Strictly increasing abscissae.
+             * @param y Ordinates.
+             * @param d0 First derivative at x[0] for clamped splines.
+             * @param dn First derivative at x[n - 1] for clamped splines.
+             * @throws std::invalid_argument if the table is invalid.
+             */
+            Interp(fossil_math_interp_kind_t kind, const std::vector<double>& x, const std::vector<double>& y,
+                   double d0 = 0.0, double dn = 0.0)
+                : p_(x.size() == y.size() ? fossil_math_interp_create(kind, x.data(), y.data(), x.size(), d0, dn) : nullptr) {
+                if (!p_) throw std::invalid_argument("Invalid interpolation table");
+            }
+
+            /**
+             * @brief Builds an interpolating B-spline of the given degree.
+             * @param x Strictly increasing abscissae.
+             * @param y Ordinates.
+             * @param degree Spline degree, 1 to 5.
+             * @return The interpolant.
+             * @throws std::invalid_argument if the table is invalid.
+             */
+            static Interp bspline(const std::vector<double>& x, const std::vector<double>& y, size_t degree = 3) {
+                fossil_math_interp_t* p = x.size() == y.size()
+                    ? fossil_math_interp_create_bspline(x.data(), y.data(), x.size(), degree) : nullptr;
+                if (!p) throw std::invalid_argument("Invalid B-spline table");
+                return Interp(p);
+            }
+
+            ~Interp() { fossil_math_interp_free(p_); }
+            Interp(const Interp&) = delete;
+            Interp& operator=(const Interp&) = delete;
+            Interp(Interp&& other) noexcept : p_(other.p_) { other.p_ = nullptr; }
+            Interp& operator=(Interp&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_interp_free(p_);
+                    p_ = other.p_;
+                    other.p_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Evaluates the interpolant at x.
+             */
+            double operator()(double x) const { return fossil_math_interp_eval(p_, x); }
+
+            /**
+             * @brief Evaluates the interpolant at x using an interval cache.
+             */
+            double eval(double x, size_t& hint) const { return fossil_math_interp_eval_hint(p_, x, &hint); }
+
+            /**
+             * @brief Evaluates the first derivative at x.
+             */
+            double deriv(double x) const { return fossil_math_interp_deriv(p_, x); }
+
+            /**
+             * @brief Evaluates the interpolant at every point of x.
+             * @param x Query points.
+             * @return Interpolated values.
+             */
+            std::vector<double> eval_batch(const std::vector<double>& x) const {
+                std::vector<double> y(x.size());
+                fossil_math_interp_eval_batch(p_, x.data(), y.data(), x.size());
+                return y;
+            }
+
+            /**
+             * @brief Returns the underlying C interpolant.
+             */
+            const fossil_math_interp_t* get() const { return p_; }
+
+        private:
+            explicit Interp(fossil_math_interp_t* p) : p_(p) {}
+            fossil_math_interp_t* p_;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for a fossil_math_grid_t interpolator.
+         *
+         * The wrapped tensor must outlive the Grid. Instances are movable but
+         * not copyable.
+         */
+        class Grid {
+        public:
+            /**
+             * @brief Creates an interpolator over a tensor.
+             * @param table Sample tensor.
+             * @param lo Coordinate of the first sample per axis (empty for 0).
+             * @param hi Coordinate of the last sample per axis (empty for shape - 1).
+             * @param method Interpolation kernel.
+             * @param boundary Out-of-range behaviour.
+             * @throws std::invalid_argument if the grid is invalid.
+             */
+            Grid(const fossil_math_tensor_t* table, const std::vector<double>& lo, const std::vector<double>& hi,
+                 fossil_math_grid_method_t method = FOSSIL_MATH_GRID_LINEAR,
+                 fossil_math_grid_boundary_t boundary = FOSSIL_MATH_GRID_CLAMP)
+                : g_(fossil_math_grid_create(table, lo.empty() ? nullptr : lo.data(), hi.empty() ? nullptr : hi.data(),
+                                             method, boundary)) {
+                if (!g_ || (!lo.empty() && lo.size() != dims()) || (!hi.empty() && hi.size() != dims())) {
+                    fossil_math_grid_free(g_);
+                    throw std::invalid_argument("Invalid interpolation grid");
+                }
+            }
+
+            ~Grid() { fossil_math_grid_free(g_); }
+            Grid(const Grid&) = delete;
+            Grid& operator=(const Grid&) = delete;
+            Grid(Grid&& other) noexcept : g_(other.g_) { other.g_ = nullptr; }
+            Grid& operator=(Grid&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_grid_free(g_);
+                    g_ = other.g_;
+                    other.g_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Returns the number of coordinates per query point.
+             */
+            size_t dims() const { return fossil_math_grid_dims(g_); }
+
+            /**
+             * @brief Interpolates the grid at one point.
+             */
+            double operator()(const std::vector<double>& point) const {
+                if (point.size() != dims()) throw std::invalid_argument("Point dimension mismatch");
+                return fossil_math_grid_eval(g_, point.data());
+            }
+
+            /**
+             * @brief Interpolates the grid at many points.
+             * @param points Query coordinates (count x dims, row-major).
+             * @return Interpolated values.
+             */
+            std::vector<double> eval_batch(const std::vector<double>& points) const {
+                if (points.size() % dims() != 0) throw std::invalid_argument("Point dimension mismatch");
+                std::vector<double> out(points.size() / dims());
+                fossil_math_grid_eval_batch(g_, points.data(), out.data(), out.size());
+                return out;
+            }
+
+        private:
+            fossil_math_grid_t* g_;
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_INTERP_H */
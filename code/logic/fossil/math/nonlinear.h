@@ -0,0 +1,263 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_NONLINEAR_H
+#define FOSSIL_MATH_NONLINEAR_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Vector function callback F: R^n -> R^m.
+ *
+ * Writes F(x) into fx. The dimensions are those passed to the solver; any
+ * parameters the function needs travel through ctx.
+ */
+typedef void (*fossil_math_nonlinear_func_t)(const double* x, double* fx, void* ctx);
+
+/**
+ * @brief Jacobian callback writing dF/dx at x as an m x n row-major matrix.
+ */
+typedef void (*fossil_math_nonlinear_jac_t)(const double* x, double* J, void* ctx);
+
+/**
+ * @brief Solver settings shared by the nonlinear system and least-squares solvers.
+ *
+ * - max_iter:       Maximum number of outer iterations.
+ * - tol_f:          Stop when ||F(x)|| (or the least-squares gradient) falls below this.
+ * - tol_x:          Stop when the step is below tol_x * (1 + ||x||).
+ * - jacobian_reuse: Maximum consecutive Broyden rank-one updates before the
+ *                   Jacobian is recomputed and refactored (0 = exact Newton).
+ * - krylov_dim:     Krylov subspace size per GMRES cycle for the matrix-free solver.
+ */
+typedef struct {
+    size_t max_iter;        ///< Maximum outer iterations
+    double tol_f;           ///< Residual tolerance
+    double tol_x;           ///< Relative step tolerance
+    size_t jacobian_reuse;  ///< Broyden updates between Jacobian refreshes
+    size_t krylov_dim;      ///< GMRES subspace dimension
+} fossil_math_nonlinear_options_t;
+
+/**
+ * @brief Convergence report filled in by the nonlinear solvers.
+ */
+typedef struct {
+    size_t iterations;            ///< Outer iterations performed
+    size_t evaluations;           ///< Calls to F (including finite differences)
+    size_t jacobian_evaluations;  ///< Exact or finite-difference Jacobians formed
+    size_t factorizations;        ///< LU factorizations performed
+    double residual_norm;         ///< ||F(x)|| at the returned point
+    int converged;                ///< 1 if a tolerance was met
+} fossil_math_nonlinear_info_t;
+
+// ============================================================================
+// Options
+// ============================================================================
+
+/**
+ * @brief Fills opts with the default solver settings.
+ *
+ * Defaults: 100 iterations, tol_f = 1e-10, tol_x = 1e-12, 8 Broyden updates
+ * between Jacobian refreshes and a 30-dimensional Krylov space.
+ *
+ * @param opts Options structure to initialize.
+ */
+void fossil_math_nonlinear_options_default(fossil_math_nonlinear_options_t* opts);
+
+// ============================================================================
+// Nonlinear Systems
+// ============================================================================
+
+/**
+ * @brief Solves the square system F(x) = 0 with damped Newton iteration.
+ *
+ * Each step solves J*d = -F through an LU factorization and backtracks along d
+ * until ||F|| decreases sufficiently (Armijo line search). The factorization is
+ * reused across iterations with Broyden rank-one updates, so a fresh Jacobian
+ * is only formed every opts->jacobian_reuse steps or when an update stalls.
+ *
+ * @param f System function (n equations in n unknowns).
+ * @param jac Jacobian callback, or NULL to use forward differences.
+ * @param ctx User context passed to f and jac.
+ * @param x Initial guess on entry, solution on return (n entries).
+ * @param n Number of unknowns.
+ * @param opts Solver settings, or NULL for the defaults.
+ * @param info Optional convergence report (may be NULL).
+ * @return 0 on convergence, -1 on invalid arguments, -2 on allocation failure,
+ *         -3 if the Jacobian is singular, -4 if no tolerance was met.
+ */
+int fossil_math_nonlinear_solve(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                double* x, size_t n, const fossil_math_nonlinear_options_t* opts,
+                                fossil_math_nonlinear_info_t* info);
+
+/**
+ * @brief Solves F(x) = 0 with the matrix-free Jacobian-free Newton-Krylov method.
+ *
+ * The Newton equation is solved inexactly with restarted GMRES, approximating
+ * Jacobian-vector products by directional differences of F. No Jacobian is ever
+ * stored, so memory is O(n * krylov_dim), which suits large systems.
+ *
+ * @param f System function (n equations in n unknowns).
+ * @param ctx User context passed to f.
+ * @param x Initial guess on entry, solution on return (n entries).
+ * @param n Number of unknowns.
+ * @param opts Solver settings, or NULL for the defaults.
+ * @param info Optional convergence report (may be NULL).
+ * @return 0 on convergence, -1 on invalid arguments, -2 on allocation failure,
+ *         -4 if no tolerance was met.
+ */
+int fossil_math_nonlinear_solve_krylov(fossil_math_nonlinear_func_t f, void* ctx,
+                                       double* x, size_t n, const fossil_math_nonlinear_options_t* opts,
+                                       fossil_math_nonlinear_info_t* info);
+
+// ============================================================================
+// Nonlinear Least Squares
+// ============================================================================
+
+/**
+ * @brief Minimizes 0.5 * ||r(x)||^2 with the Levenberg-Marquardt method.
+ *
+ * Solves (J^T J + lambda * D) d = -J^T r with Marquardt diagonal scaling and
+ * adapts lambda from the ratio of actual to predicted reduction. Accepted steps
+ * update the Jacobian with Broyden's rank-one formula, recomputing it every
+ * opts->jacobian_reuse steps or after a rejected step.
+ *
+ * @param f Residual function (m residuals of n parameters, m >= n).
+ * @param jac Jacobian callback (m x n), or NULL to use forward differences.
+ * @param ctx User context passed to f and jac.
+ * @param x Initial parameters on entry, fitted parameters on return (n entries).
+ * @param n Number of parameters.
+ * @param m Number of residuals.
+ * @param opts Solver settings, or NULL for the defaults.
+ * @param info Optional convergence report; residual_norm is ||r(x)||.
+ * @return 0 on convergence, -1 on invalid arguments, -2 on allocation failure,
+ *         -3 if the damped normal equations are singular, -4 if no tolerance was met.
+ */
+int fossil_math_nonlinear_least_squares(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                        double* x, size_t n, size_t m,
+                                        const fossil_math_nonlinear_options_t* opts,
+                                        fossil_math_nonlinear_info_t* info);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief C++ wrappers for the nonlinear system and least-squares solvers.
+         *
+         * Each method takes the initial guess by value, returns the solution and
+         * throws std::runtime_error if the underlying solver reports failure.
+         */
+        class Nonlinear {
+        public:
+            /**
+             * @brief Returns the default solver settings.
+             * @return Default options.
+             */
+            static fossil_math_nonlinear_options_t default_options() {
+                fossil_math_nonlinear_options_t opts;
+                fossil_math_nonlinear_options_default(&opts);
+                return opts;
+            }
+
+            /**
+             * @brief Solves F(x) = 0 with damped Newton and Broyden updates.
+             * @param f System function.
+             * @param jac Jacobian callback, or nullptr for finite differences.
+             * @param ctx User context.
+             * @param x Initial guess.
+             * @param opts Solver settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @return Solution vector.
+             * @throws std::runtime_error if the solver fails.
+             */
+            static std::vector<double> solve(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                             std::vector<double> x, const fossil_math_nonlinear_options_t* opts = nullptr,
+                                             fossil_math_nonlinear_info_t* info = nullptr) {
+                if (fossil_math_nonlinear_solve(f, jac, ctx, x.data(), x.size(), opts, info) != 0)
+                    throw std::runtime_error("Nonlinear solve failed");
+                return x;
+            }
+
+            /**
+             * @brief Solves F(x) = 0 with matrix-free Newton-Krylov.
+             * @param f System function.
+             * @param ctx User context.
+             * @param x Initial guess.
+             * @param opts Solver settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @return Solution vector.
+             * @throws std::runtime_error if the solver fails.
+             */
+            static std::vector<double> solve_krylov(fossil_math_nonlinear_func_t f, void* ctx, std::vector<double> x,
+                                                    const fossil_math_nonlinear_options_t* opts = nullptr,
+                                                    fossil_math_nonlinear_info_t* info = nullptr) {
+                if (fossil_math_nonlinear_solve_krylov(f, ctx, x.data(), x.size(), opts, info) != 0)
+                    throw std::runtime_error("Newton-Krylov solve failed");
+                return x;
+            }
+
+            /**
+             * @brief Fits parameters by Levenberg-Marquardt least squares.
+             * @param f Residual function.
+             * @param jac Jacobian callback, or nullptr for finite differences.
+             * @param ctx User context.
+             * @param x Initial parameters.
+             * @param m Number of residuals.
+             * @param opts Solver settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @return Fitted parameters.
+             * @throws std::runtime_error if the solver fails.
+             */
+            static std::vector<double> least_squares(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                                     std::vector<double> x, size_t m,
+                                                     const fossil_math_nonlinear_options_t* opts = nullptr,
+                                                     fossil_math_nonlinear_info_t* info = nullptr) {
+                if (fossil_math_nonlinear_least_squares(f, jac, ctx, x.data(), x.size(), m, opts, info) != 0)
+                    throw std::runtime_error("Least-squares fit failed");
+                return x;
+            }
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_NONLINEAR_H */
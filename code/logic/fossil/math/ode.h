@@ -0,0 +1,299 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_ODE_H
+#define FOSSIL_MATH_ODE_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Right-hand side of the system dy/dt = f(t, y), written into dydt.
+ */
+typedef void (*fossil_math_ode_func_t)(double t, const double* y, double* dydt, void* ctx);
+
+/**
+ * @brief Jacobian df/dy at (t, y), written as an n x n row-major matrix.
+ */
+typedef void (*fossil_math_ode_jac_t)(double t, const double* y, double* J, void* ctx);
+
+/**
+ * @brief Right-hand side for batched integration; system selects the instance.
+ */
+typedef void (*fossil_math_ode_batch_func_t)(size_t system, double t, const double* y, double* dydt, void* ctx);
+
+/**
+ * @brief Jacobian callback for batched integration; system selects the instance.
+ */
+typedef void (*fossil_math_ode_batch_jac_t)(size_t system, double t, const double* y, double* J, void* ctx);
+
+/**
+ * @brief Integration methods.
+ *
+ * - FOSSIL_MATH_ODE_RK45: Explicit Dormand-Prince 5(4) with embedded error
+ *   control and a fourth-order continuous extension. The choice for non-stiff
+ *   problems.
+ *
+ * - FOSSIL_MATH_ODE_BDF: Implicit variable-order (1-5) backward differentiation
+ *   formulas for stiff problems. Newton iterations reuse the Jacobian and the
+ *   LU factors of the iteration matrix across steps, refreshing them only when
+ *   the step size changes or convergence slows.
+ */
+typedef enum {
+    FOSSIL_MATH_ODE_RK45,
+    FOSSIL_MATH_ODE_BDF
+} fossil_math_ode_method_t;
+
+/**
+ * @brief Integrator settings.
+ *
+ * Each component's local error is kept below atol + rtol * |y_i| in the RMS
+ * norm across components.
+ */
+typedef struct {
+    double rtol;       ///< Relative tolerance
+    double atol;       ///< Absolute tolerance
+    double h0;         ///< Initial step size (0 = choose automatically)
+    double h_max;      ///< Largest step size (0 = unbounded)
+    size_t max_steps;  ///< Maximum number of accepted steps
+} fossil_math_ode_options_t;
+
+/**
+ * @brief Work statistics filled in by the integrators.
+ */
+typedef struct {
+    size_t steps;                 ///< Accepted steps
+    size_t rejected;              ///< Rejected step attempts
+    size_t evaluations;           ///< Calls to f (including finite differences)
+    size_t jacobian_evaluations;  ///< Exact or finite-difference Jacobians formed
+    size_t factorizations;        ///< LU factorizations of the iteration matrix
+} fossil_math_ode_info_t;
+
+// ============================================================================
+// Options
+// ============================================================================
+
+/**
+ * @brief Fills opts with the default settings.
+ *
+ * Defaults: rtol = 1e-6, atol = 1e-9, automatic initial step, unbounded step
+ * size and at most 100000 steps.
+ *
+ * @param opts Options structure to initialize.
+ */
+void fossil_math_ode_options_default(fossil_math_ode_options_t* opts);
+
+// ============================================================================
+// Integration
+// ============================================================================
+//
+// Both integrators step freely from t0 towards t_out[n_out - 1] and fill
+// y_out (n_out x n, row-major) by evaluating the method's dense output at each
+// requested time, so dense output grids never shorten the steps taken. t_out
+// must be monotonic in the direction of integration, starting no earlier than
+// t0. y_out may alias y0 when n_out == 1.
+//
+// Return values: 0 on success, -1 on invalid arguments, -2 on allocation
+// failure, -4 if the step size underflowed or max_steps was exceeded (outputs
+// past the failure point are left untouched).
+//
+
+/**
+ * @brief Integrates dy/dt = f(t, y) with the adaptive Dormand-Prince RK45 method.
+ *
+ * @param f Right-hand side.
+ * @param ctx User context passed to f.
+ * @param n Number of equations.
+ * @param t0 Initial time.
+ * @param y0 Initial state (n entries).
+ * @param t_out Output times (n_out entries).
+ * @param n_out Number of output times.
+ * @param y_out Solution at each output time (n_out x n).
+ * @param opts Integrator settings, or NULL for the defaults.
+ * @param info Optional work statistics (may be NULL).
+ * @return Status code as described above.
+ */
+int fossil_math_ode_rk45(fossil_math_ode_func_t f, void* ctx, size_t n, double t0, const double* y0,
+                         const double* t_out, size_t n_out, double* y_out,
+                         const fossil_math_ode_options_t* opts, fossil_math_ode_info_t* info);
+
+/**
+ * @brief Integrates a stiff system with variable-order BDF.
+ *
+ * @param f Right-hand side.
+ * @param jac Jacobian callback, or NULL to use forward differences.
+ * @param ctx User context passed to f and jac.
+ * @param n Number of equations.
+ * @param t0 Initial time.
+ * @param y0 Initial state (n entries).
+ * @param t_out Output times (n_out entries).
+ * @param n_out Number of output times.
+ * @param y_out Solution at each output time (n_out x n).
+ * @param opts Integrator settings, or NULL for the defaults.
+ * @param info Optional work statistics (may be NULL).
+ * @return Status code as described above.
+ */
+int fossil_math_ode_bdf(fossil_math_ode_func_t f, fossil_math_ode_jac_t jac, void* ctx, size_t n,
+                        double t0, const double* y0, const double* t_out, size_t n_out, double* y_out,
+                        const fossil_math_ode_options_t* opts, fossil_math_ode_info_t* info);
+
+/**
+ * @brief Integrates many independent systems of the same size from t0 to t1.
+ *
+ * Systems are distributed over the fossil_math_parallel worker threads and
+ * each thread allocates its scratch memory once for all systems it handles.
+ *
+ * @param method Integration method.
+ * @param f Right-hand side, called with the index of the system.
+ * @param jac Jacobian callback for FOSSIL_MATH_ODE_BDF, or NULL for finite differences.
+ * @param ctx User context passed to f and jac.
+ * @param n Number of equations per system.
+ * @param count Number of systems.
+ * @param t0 Initial time.
+ * @param t1 Final time.
+ * @param y States (count x n): initial values on entry, values at t1 on return.
+ * @param opts Integrator settings shared by all systems, or NULL for the defaults.
+ * @param status Optional per-system status codes (count entries, may be NULL).
+ * @return Number of systems integrated successfully.
+ */
+size_t fossil_math_ode_solve_batch(fossil_math_ode_method_t method, fossil_math_ode_batch_func_t f,
+                                   fossil_math_ode_batch_jac_t jac, void* ctx, size_t n, size_t count,
+                                   double t0, double t1, double* y,
+                                   const fossil_math_ode_options_t* opts, int* status);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief C++ wrappers for the ODE integrators.
+         *
+         * The integrators return the solution at each requested time as one
+         * flat row-major vector and throw std::runtime_error on failure.
+         */
+        class Ode {
+        public:
+            /**
+             * @brief Returns the default integrator settings.
+             * @return Default options.
+             */
+            static fossil_math_ode_options_t default_options() {
+                fossil_math_ode_options_t opts;
+                fossil_math_ode_options_default(&opts);
+                return opts;
+            }
+
+            /**
+             * @brief Integrates with Dormand-Prince RK45.
+             * @param f Right-hand side.
+             * @param ctx User context.
+             * @param t0 Initial time.
+             * @param y0 Initial state.
+             * @param t_out Output times.
+             * @param opts Integrator settings, or nullptr for the defaults.
+             * @param info Optional work statistics.
+             * @return Solution at each output time (t_out.size() x y0.size()).
+             * @throws std::runtime_error if integration fails.
+             */
+            static std::vector<double> rk45(fossil_math_ode_func_t f, void* ctx, double t0, const std::vector<double>& y0,
+                                            const std::vector<double>& t_out,
+                                            const fossil_math_ode_options_t* opts = nullptr,
+                                            fossil_math_ode_info_t* info = nullptr) {
+                std::vector<double> y_out(t_out.size() * y0.size());
+                if (fossil_math_ode_rk45(f, ctx, y0.size(), t0, y0.data(), t_out.data(), t_out.size(),
+                                         y_out.data(), opts, info) != 0)
+                    throw std::runtime_error("RK45 integration failed");
+                return y_out;
+            }
+
+            /**
+             * @brief Integrates a stiff system with BDF.
+             * @param f Right-hand side.
+             * @param jac Jacobian callback, or nullptr for finite differences.
+             * @param ctx User context.
+             * @param t0 Initial time.
+             * @param y0 Initial state.
+             * @param t_out Output times.
+             * @param opts Integrator settings, or nullptr for the defaults.
+             * @param info Optional work statistics.
+             * @return Solution at each output time (t_out.size() x y0.size()).
+             * @throws std::runtime_error if integration fails.
+             */
+            static std::vector<double> bdf(fossil_math_ode_func_t f, fossil_math_ode_jac_t jac, void* ctx, double t0,
+                                           const std::vector<double>& y0, const std::vector<double>& t_out,
+                                           const fossil_math_ode_options_t* opts = nullptr,
+                                           fossil_math_ode_info_t* info = nullptr) {
+                std::vector<double> y_out(t_out.size() * y0.size());
+                if (fossil_math_ode_bdf(f, jac, ctx, y0.size(), t0, y0.data(), t_out.data(), t_out.size(),
+                                        y_out.data(), opts, info) != 0)
+                    throw std::runtime_error("BDF integration failed");
+                return y_out;
+            }
+
+            /**
+             * @brief Integrates many independent systems in parallel.
+             * @param method Integration method.
+             * @param f Right-hand side, called with the system index.
+             * @param jac Jacobian callback, or nullptr.
+             * @param ctx User context.
+             * @param n Number of equations per system.
+             * @param t0 Initial time.
+             * @param t1 Final time.
+             * @param y States (count x n), updated in place.
+             * @param opts Integrator settings, or nullptr for the defaults.
+             * @param status Optional per-system status codes, resized to the system count.
+             * @return Number of systems integrated successfully.
+             */
+            static size_t solve_batch(fossil_math_ode_method_t method, fossil_math_ode_batch_func_t f,
+                                      fossil_math_ode_batch_jac_t jac, void* ctx, size_t n, double t0, double t1,
+                                      std::vector<double>& y, const fossil_math_ode_options_t* opts = nullptr,
+                                      std::vector<int>* status = nullptr) {
+                size_t count = n ? y.size() / n : 0;
+                if (status) status->assign(count, 0);
+                return fossil_math_ode_solve_batch(method, f, jac, ctx, n, count, t0, t1, y.data(), opts,
+                                                   status ? status->data() : nullptr);
+            }
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_ODE_H */
@@ -0,0 +1,317 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_OPTIM_H
+#define FOSSIL_MATH_OPTIM_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Objective callback f: R^n -> R used by derivative-free methods.
+ */
+typedef double (*fossil_math_optim_func_t)(const double* x, void* ctx);
+
+/**
+ * @brief Objective callback returning f(x) and writing the gradient into grad.
+ *
+ * Computing both at once lets the objective share intermediate results, and
+ * spares the 2n evaluations a finite-difference gradient would cost.
+ */
+typedef double (*fossil_math_optim_fdf_t)(const double* x, double* grad, void* ctx);
+
+/**
+ * @brief Convergence report, also passed to the monitor after every iteration.
+ */
+typedef struct {
+    size_t iterations;   ///< Iterations completed
+    size_t evaluations;  ///< Objective evaluations
+    double f;            ///< Objective at the current point
+    double grad_norm;    ///< ||grad f|| (NAN for derivative-free methods)
+    double step;         ///< Length of the last step (simplex diameter for Nelder-Mead)
+    int converged;       ///< 1 if a tolerance was met
+} fossil_math_optim_info_t;
+
+/**
+ * @brief Per-iteration monitor. Returning non-zero stops the optimizer.
+ */
+typedef int (*fossil_math_optim_monitor_t)(const fossil_math_optim_info_t* it, void* ctx);
+
+/**
+ * @brief Optimizer settings.
+ *
+ * - max_iter:    Maximum number of iterations.
+ * - tol_grad:    Stop when ||grad f|| falls below this (gradient methods).
+ * - tol_f:       Stop when f decreases by less than tol_f * (1 + |f|) in an
+ *                iteration, or the simplex values span less than that.
+ * - tol_x:       Stop when the step (or simplex diameter) is below tol_x * (1 + ||x||).
+ * - memory:      Number of correction pairs kept by L-BFGS.
+ * - monitor:     Optional per-iteration callback receiving monitor_ctx.
+ */
+typedef struct {
+    size_t max_iter;                      ///< Maximum iterations
+    double tol_grad;                      ///< Gradient norm tolerance
+    double tol_f;                         ///< Relative function-change tolerance
+    double tol_x;                         ///< Relative step tolerance
+    size_t memory;                        ///< L-BFGS history length
+    fossil_math_optim_monitor_t monitor;  ///< Per-iteration diagnostics callback
+    void* monitor_ctx;                    ///< Context for the monitor
+} fossil_math_optim_options_t;
+
+/**
+ * @brief Opaque scratch memory shared by the optimizers.
+ *
+ * A workspace created for dimension n and history length m serves every
+ * optimizer for problems of up to n unknowns, so repeated solves perform no
+ * allocation at all. Not safe for concurrent use by several solves.
+ */
+typedef struct fossil_math_optim_workspace fossil_math_optim_workspace_t;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+/**
+ * @brief Fills opts with the default optimizer settings.
+ *
+ * Defaults: 1000 iterations, tol_grad = 1e-8, tol_f = 1e-14, tol_x = 1e-12,
+ * 8 L-BFGS correction pairs and no monitor.
+ *
+ * @param opts Options structure to initialize.
+ */
+void fossil_math_optim_options_default(fossil_math_optim_options_t* opts);
+
+/**
+ * @brief Allocates a workspace for problems of up to n unknowns.
+ *
+ * @param n Largest problem dimension the workspace will serve.
+ * @param memory L-BFGS history length it must accommodate.
+ * @return The workspace, or NULL on invalid arguments or allocation failure.
+ */
+fossil_math_optim_workspace_t* fossil_math_optim_workspace_create(size_t n, size_t memory);
+
+/**
+ * @brief Releases a workspace. Passing NULL is a no-op.
+ */
+void fossil_math_optim_workspace_destroy(fossil_math_optim_workspace_t* ws);
+
+// ============================================================================
+// Optimizers
+// ============================================================================
+//
+// All optimizers share the same contract: x holds the starting point on entry
+// and the best point found on return; opts may be NULL for the defaults; ws
+// may be NULL, in which case a temporary workspace is allocated for the call.
+// Return values: 0 on convergence, -1 on invalid arguments (including a
+// workspace too small for n or opts->memory), -2 on allocation failure,
+// -4 if no tolerance was met, -5 if the monitor stopped the run.
+//
+
+/**
+ * @brief Minimizes f with limited-memory BFGS.
+ *
+ * Correction pairs live in a fixed ring buffer of opts->memory entries and
+ * the search direction comes from the two-loop recursion. Steps satisfy the
+ * strong Wolfe conditions, which keeps every update positive definite.
+ *
+ * @param fdf Objective and gradient callback.
+ * @param ctx User context passed to fdf.
+ * @param x Starting point on entry, minimizer on return (n entries).
+ * @param n Number of unknowns.
+ * @param opts Optimizer settings, or NULL for the defaults.
+ * @param ws Workspace, or NULL to allocate one for this call.
+ * @param info Optional convergence report (may be NULL).
+ * @return Status code as described above.
+ */
+int fossil_math_optim_lbfgs(fossil_math_optim_fdf_t fdf, void* ctx, double* x, size_t n,
+                            const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                            fossil_math_optim_info_t* info);
+
+/**
+ * @brief Minimizes f with nonlinear conjugate gradients (Polak-Ribiere+).
+ *
+ * Needs only O(n) memory. The direction is restarted along the steepest
+ * descent every n iterations or whenever it stops being a descent direction.
+ *
+ * @param fdf Objective and gradient callback.
+ * @param ctx User context passed to fdf.
+ * @param x Starting point on entry, minimizer on return (n entries).
+ * @param n Number of unknowns.
+ * @param opts Optimizer settings, or NULL for the defaults.
+ * @param ws Workspace, or NULL to allocate one for this call.
+ * @param info Optional convergence report (may be NULL).
+ * @return Status code as described above.
+ */
+int fossil_math_optim_cg(fossil_math_optim_fdf_t fdf, void* ctx, double* x, size_t n,
+                         const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                         fossil_math_optim_info_t* info);
+
+/**
+ * @brief Minimizes f with the derivative-free Nelder-Mead simplex method.
+ *
+ * Uses the dimension-adaptive reflection, expansion, contraction and shrink
+ * coefficients of Gao and Han, which behave better than the classic values
+ * as n grows. The initial simplex perturbs each coordinate by 5%
+ * (0.00025 for zero coordinates).
+ *
+ * @param f Objective callback.
+ * @param ctx User context passed to f.
+ * @param x Starting point on entry, best vertex on return (n entries).
+ * @param n Number of unknowns.
+ * @param opts Optimizer settings, or NULL for the defaults.
+ * @param ws Workspace, or NULL to allocate one for this call.
+ * @param info Optional convergence report (may be NULL).
+ * @return Status code as described above.
+ */
+int fossil_math_optim_nelder_mead(fossil_math_optim_func_t f, void* ctx, double* x, size_t n,
+                                  const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                                  fossil_math_optim_info_t* info);
+
+#ifdef __cplusplus
+}
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief C++ wrappers for the unconstrained optimizers.
+         *
+         * Each method takes the starting point by value, returns the minimizer
+         * and throws std::runtime_error if the optimizer reports failure.
+         */
+        class Optim {
+        public:
+            /**
+             * @brief Owning handle for a reusable optimizer workspace.
+             */
+            class Workspace {
+            public:
+                /**
+                 * @brief Allocates a workspace for up to n unknowns.
+                 * @throws std::bad_alloc on allocation failure.
+                 */
+                Workspace(size_t n, size_t memory = 8) : ws_(fossil_math_optim_workspace_create(n, memory)) {
+                    if (!ws_) throw std::bad_alloc();
+                }
+                ~Workspace() { fossil_math_optim_workspace_destroy(ws_); }
+                Workspace(const Workspace&) = delete;
+                Workspace& operator=(const Workspace&) = delete;
+
+                /**
+                 * @brief Returns the underlying C workspace.
+                 */
+                fossil_math_optim_workspace_t* get() const { return ws_; }
+
+            private:
+                fossil_math_optim_workspace_t* ws_;
+            };
+
+            /**
+             * @brief Returns the default optimizer settings.
+             * @return Default options.
+             */
+            static fossil_math_optim_options_t default_options() {
+                fossil_math_optim_options_t opts;
+                fossil_math_optim_options_default(&opts);
+                return opts;
+            }
+
+            /**
+             * @brief Minimizes f with L-BFGS.
+             * @param fdf Objective and gradient callback.
+             * @param ctx User context.
+             * @param x Starting point.
+             * @param opts Optimizer settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @param ws Optional reusable workspace.
+             * @return Minimizer.
+             * @throws std::runtime_error if the optimizer fails.
+             */
+            static std::vector<double> lbfgs(fossil_math_optim_fdf_t fdf, void* ctx, std::vector<double> x,
+                                             const fossil_math_optim_options_t* opts = nullptr,
+                                             fossil_math_optim_info_t* info = nullptr, Workspace* ws = nullptr) {
+                if (fossil_math_optim_lbfgs(fdf, ctx, x.data(), x.size(), opts, ws ? ws->get() : nullptr, info) != 0)
+                    throw std::runtime_error("L-BFGS failed to converge");
+                return x;
+            }
+
+            /**
+             * @brief Minimizes f with nonlinear conjugate gradients.
+             * @param fdf Objective and gradient callback.
+             * @param ctx User context.
+             * @param x Starting point.
+             * @param opts Optimizer settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @param ws Optional reusable workspace.
+             * @return Minimizer.
+             * @throws std::runtime_error if the optimizer fails.
+             */
+            static std::vector<double> cg(fossil_math_optim_fdf_t fdf, void* ctx, std::vector<double> x,
+                                          const fossil_math_optim_options_t* opts = nullptr,
+                                          fossil_math_optim_info_t* info = nullptr, Workspace* ws = nullptr) {
+                if (fossil_math_optim_cg(fdf, ctx, x.data(), x.size(), opts, ws ? ws->get() : nullptr, info) != 0)
+                    throw std::runtime_error("Conjugate gradient failed to converge");
+                return x;
+            }
+
+            /**
+             * @brief Minimizes f with the Nelder-Mead simplex method.
+             * @param f Objective callback.
+             * @param ctx User context.
+             * @param x Starting point.
+             * @param opts Optimizer settings, or nullptr for the defaults.
+             * @param info Optional convergence report.
+             * @param ws Optional reusable workspace.
+             * @return Best vertex found.
+             * @throws std::runtime_error if the optimizer fails.
+             */
+            static std::vector<double> nelder_mead(fossil_math_optim_func_t f, void* ctx, std::vector<double> x,
+                                                   const fossil_math_optim_options_t* opts = nullptr,
+                                                   fossil_math_optim_info_t* info = nullptr, Workspace* ws = nullptr) {
+                if (fossil_math_optim_nelder_mead(f, ctx, x.data(), x.size(), opts, ws ? ws->get() : nullptr, info) != 0)
+                    throw std::runtime_error("Nelder-Mead failed to converge");
+                return x;
+            }
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_OPTIM_H */
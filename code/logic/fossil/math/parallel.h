@@ -0,0 +1,172 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_PARALLEL_H
+#define FOSSIL_MATH_PARALLEL_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ======================================================
+// Types
+// ======================================================
+
+/**
+ * @brief Work item for fossil_math_parallel_for().
+ *
+ * Called once per chunk with the half-open index range [begin, end) and the
+ * user context. Chunks run concurrently, so the function must only touch
+ * state owned by its range (or synchronize on its own).
+ */
+typedef void (*fossil_math_parallel_fn_t)(size_t begin, size_t end, void* ctx);
+
+/**
+ * @brief Opaque mutual-exclusion lock for state shared between worker threads.
+ */
+typedef struct fossil_math_mutex fossil_math_mutex_t;
+
+// ======================================================
+// Configuration
+// ======================================================
+
+/**
+ * @brief Sets the number of worker threads used by batched kernels.
+ *
+ * Passing 0 restores the default, which is the number of online processors.
+ * This is a process-wide setting and should be configured before kernels run.
+ *
+ * @param threads Number of threads (1 disables threading).
+ */
+void fossil_math_parallel_set_threads(size_t threads);
+
+/**
+ * @brief Returns the number of worker threads used by batched kernels.
+ * @return Thread count (always at least 1).
+ */
+size_t fossil_math_parallel_threads(void);
+
+// ======================================================
+// Execution
+// ======================================================
+
+/**
+ * @brief Runs fn over [0, count) split into contiguous chunks across threads.
+ *
+ * The range is split into at most fossil_math_parallel_threads() chunks of at
+ * least `grain` items each. When the range is too small to split, fn runs once
+ * on the calling thread, so small batches pay no threading cost. The call
+ * returns after every chunk has completed.
+ *
+ * @param count Number of items.
+ * @param grain Minimum items per chunk (0 is treated as 1).
+ * @param fn Function run for each chunk.
+ * @param ctx User context passed to fn.
+ */
+void fossil_math_parallel_for(size_t count, size_t grain, fossil_math_parallel_fn_t fn, void* ctx);
+
+// ======================================================
+// Synchronization
+// ======================================================
+
+/**
+ * @brief Creates an unlocked, non-recursive mutex.
+ * @return The mutex, or NULL on failure.
+ */
+fossil_math_mutex_t* fossil_math_mutex_create(void);
+
+/**
+ * @brief Destroys a mutex. It must not be locked. Passing NULL is a no-op.
+ */
+void fossil_math_mutex_free(fossil_math_mutex_t* mutex);
+
+/**
+ * @brief Blocks until the calling thread holds the mutex.
+ */
+void fossil_math_mutex_lock(fossil_math_mutex_t* mutex);
+
+/**
+ * @brief Releases a mutex held by the calling thread.
+ */
+void fossil_math_mutex_unlock(fossil_math_mutex_t* mutex);
+
+#ifdef __cplusplus
+}
+#include <functional>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief C++ wrappers for the fossil-math thread partitioning helpers.
+         *
+         * The Parallel class exposes the thread count configuration and a
+         * range-splitting loop that accepts any callable.
+         */
+        class Parallel {
+        public:
+            /**
+             * @brief Sets the number of worker threads (0 = hardware default).
+             * @param threads Number of threads.
+             */
+            static void set_threads(size_t threads) {
+                fossil_math_parallel_set_threads(threads);
+            }
+
+            /**
+             * @brief Returns the number of worker threads.
+             * @return Thread count.
+             */
+            static size_t threads() {
+                return fossil_math_parallel_threads();
+            }
+
+            /**
+             * @brief Runs fn over [0, count) split into chunks across threads.
+             * @param count Number of items.
+             * @param grain Minimum items per chunk.
+             * @param fn Callable invoked as fn(begin, end) for each chunk.
+             */
+            static void for_range(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+                struct Adapter {
+                    static void call(size_t begin, size_t end, void* ctx) {
+                        (*static_cast<const std::function<void(size_t, size_t)>*>(ctx))(begin, end);
+                    }
+                };
+                fossil_math_parallel_for(count, grain, Adapter::call,
+                                         const_cast<void*>(static_cast<const void*>(&fn)));
+            }
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_PARALLEL_H */
@@ -0,0 +1,580 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_SKETCH_H
+#define FOSSIL_MATH_SKETCH_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+//
+// Both sketches summarize a stream of doubles in bounded memory and answer
+// approximate quantile and rank queries. They are mergeable: a sketch built
+// from the union of two streams is obtained by merging the two sketches.
+//
+// A sketch is not synchronized. Concurrent producers use a per-thread set
+// instead: each thread inserts into its own shard without locking, and a
+// reader merges the shards into a scratch sketch while they keep inserting.
+//
+// The serialized formats are little-endian and independent of the host.
+
+/**
+ * @brief Merging t-digest.
+ *
+ * Keeps at most about `compression` weighted centroids, sized by the k1 scale
+ * function so clusters shrink towards the tails; accuracy is best for extreme
+ * quantiles (p99, p999). Inserts are buffered and folded in by a sort-merge
+ * pass when the buffer fills.
+ */
+typedef struct fossil_math_tdigest fossil_math_tdigest_t;
+
+/**
+ * @brief KLL quantile sketch.
+ *
+ * A hierarchy of compactors whose capacities shrink geometrically (factor
+ * 2/3) below the top level. Rank error is about 1.7 / k uniformly over the
+ * distribution, independent of the input order. Compaction uses an internal
+ * deterministic pseudo-random generator, so identical inputs give identical
+ * sketches.
+ */
+typedef struct fossil_math_kll fossil_math_kll_t;
+
+/**
+ * @brief Per-thread t-digests merged on read.
+ *
+ * One shard per producer thread. A shard buffers values privately and hands
+ * every 1024 of them to its digest under a per-shard mutex, the only lock on
+ * the insert path; readers take the same mutexes while merging. Values still
+ * in a buffer are not seen by readers until handed off.
+ */
+typedef struct fossil_math_tdigest_shards fossil_math_tdigest_shards_t;
+
+/**
+ * @brief Per-thread KLL sketches merged on read, as fossil_math_tdigest_shards_t.
+ */
+typedef struct fossil_math_kll_shards fossil_math_kll_shards_t;
+
+// ============================================================================
+// t-digest
+// ============================================================================
+
+/**
+ * @brief Creates an empty t-digest.
+ * @param compression Size parameter (0 = 100; clamped to at least 10).
+ * @return The digest, or NULL on allocation failure.
+ */
+fossil_math_tdigest_t* fossil_math_tdigest_create(double compression);
+
+/**
+ * @brief Frees a t-digest.
+ */
+void fossil_math_tdigest_free(fossil_math_tdigest_t* td);
+
+/**
+ * @brief Adds a value with the given weight.
+ * @return 0 on success, -1 on invalid arguments (NULL, NaN, or weight <= 0).
+ */
+int fossil_math_tdigest_add(fossil_math_tdigest_t* td, double x, double weight);
+
+/**
+ * @brief Adds count values of weight 1.
+ *
+ * Large batches are split into chunks that are digested in parallel (see
+ * fossil_math_parallel_for()) and merged in chunk order. NaN values are
+ * skipped.
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_tdigest_add_batch(fossil_math_tdigest_t* td, const double* x, size_t count);
+
+/**
+ * @brief Merges the contents of src into dst.
+ * @return 0 on success, -1 on invalid arguments (including dst == src).
+ */
+int fossil_math_tdigest_merge(fossil_math_tdigest_t* dst, const fossil_math_tdigest_t* src);
+
+/**
+ * @brief Returns the total weight added.
+ */
+double fossil_math_tdigest_count(const fossil_math_tdigest_t* td);
+
+/**
+ * @brief Returns the smallest value added (NaN when empty).
+ */
+double fossil_math_tdigest_min(const fossil_math_tdigest_t* td);
+
+/**
+ * @brief Returns the largest value added (NaN when empty).
+ */
+double fossil_math_tdigest_max(const fossil_math_tdigest_t* td);
+
+/**
+ * @brief Returns the approximate q-quantile (NaN when empty or q outside [0, 1]).
+ *
+ * Flushes the insert buffer, hence the non-const argument.
+ */
+double fossil_math_tdigest_quantile(fossil_math_tdigest_t* td, double q);
+
+/**
+ * @brief Returns the approximate fraction of the weight at or below x (NaN when empty).
+ *
+ * Flushes the insert buffer, hence the non-const argument.
+ */
+double fossil_math_tdigest_cdf(fossil_math_tdigest_t* td, double x);
+
+/**
+ * @brief Serializes the digest.
+ *
+ * @param td Digest (its insert buffer is flushed first).
+ * @param buf Output buffer, or NULL to query the size.
+ * @param capacity Size of buf in bytes.
+ * @return Bytes required; nothing is written unless capacity is at least that.
+ */
+size_t fossil_math_tdigest_serialize(fossil_math_tdigest_t* td, uint8_t* buf, size_t capacity);
+
+/**
+ * @brief Rebuilds a digest from fossil_math_tdigest_serialize() output.
+ * @return The digest, or NULL on malformed input or allocation failure.
+ */
+fossil_math_tdigest_t* fossil_math_tdigest_deserialize(const uint8_t* buf, size_t size);
+
+// ============================================================================
+// KLL
+// ============================================================================
+
+/**
+ * @brief Creates an empty KLL sketch.
+ * @param k Accuracy parameter (0 = 200; clamped to [8, 2^20]).
+ * @return The sketch, or NULL on allocation failure.
+ */
+fossil_math_kll_t* fossil_math_kll_create(size_t k);
+
+/**
+ * @brief Frees a KLL sketch.
+ */
+void fossil_math_kll_free(fossil_math_kll_t* kll);
+
+/**
+ * @brief Adds a value.
+ * @return 0 on success, -1 on invalid arguments (NULL or NaN), -2 on allocation failure.
+ */
+int fossil_math_kll_add(fossil_math_kll_t* kll, double x);
+
+/**
+ * @brief Adds count values, sketching large batches in parallel chunks.
+ *
+ * NaN values are skipped. Chunk sketches are seeded by chunk index, so the
+ * result does not depend on the thread count.
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_kll_add_batch(fossil_math_kll_t* kll, const double* x, size_t count);
+
+/**
+ * @brief Merges the contents of src into dst.
+ * @return 0 on success, -1 on invalid arguments (including dst == src), -2 on
+ *         allocation failure.
+ */
+int fossil_math_kll_merge(fossil_math_kll_t* dst, const fossil_math_kll_t* src);
+
+/**
+ * @brief Returns the number of values added.
+ */
+uint64_t fossil_math_kll_count(const fossil_math_kll_t* kll);
+
+/**
+ * @brief Returns the smallest value added (NaN when empty).
+ */
+double fossil_math_kll_min(const fossil_math_kll_t* kll);
+
+/**
+ * @brief Returns the largest value added (NaN when empty).
+ */
+double fossil_math_kll_max(const fossil_math_kll_t* kll);
+
+/**
+ * @brief Returns the approximate q-quantile (NaN when empty, q outside [0, 1] or on allocation failure).
+ */
+double fossil_math_kll_quantile(const fossil_math_kll_t* kll, double q);
+
+/**
+ * @brief Returns the approximate fraction of values at or below x (NaN when empty).
+ */
+double fossil_math_kll_cdf(const fossil_math_kll_t* kll, double x);
+
+/**
+ * @brief Serializes the sketch.
+ * @param buf Output buffer, or NULL to query the size.
+ * @param capacity Size of buf in bytes.
+ * @return Bytes required; nothing is written unless capacity is at least that.
+ */
+size_t fossil_math_kll_serialize(const fossil_math_kll_t* kll, uint8_t* buf, size_t capacity);
+
+/**
+ * @brief Rebuilds a sketch from fossil_math_kll_serialize() output.
+ * @return The sketch, or NULL on malformed input or allocation failure.
+ */
+fossil_math_kll_t* fossil_math_kll_deserialize(const uint8_t* buf, size_t size);
+
+// ============================================================================
+// Per-thread sets
+// ============================================================================
+
+/**
+ * @brief Creates a set of empty per-thread t-digests.
+ * @param compression As for fossil_math_tdigest_create().
+ * @param shards Number of shards, usually one per producer thread.
+ * @return The set, or NULL if shards is 0 or on allocation failure.
+ */
+fossil_math_tdigest_shards_t* fossil_math_tdigest_shards_create(double compression, size_t shards);
+
+/**
+ * @brief Frees a set. No thread may be using it.
+ */
+void fossil_math_tdigest_shards_free(fossil_math_tdigest_shards_t* set);
+
+/**
+ * @brief Adds a value of weight 1 to a shard.
+ *
+ * Each shard must be fed by one thread at a time; different shards may be fed
+ * concurrently, and concurrently with fossil_math_tdigest_shards_snapshot().
+ *
+ * @return 0 on success, -1 on invalid arguments (NULL, shard out of range, or NaN).
+ */
+int fossil_math_tdigest_shards_add(fossil_math_tdigest_shards_t* set, size_t shard, double x);
+
+/**
+ * @brief Hands a shard's buffered values to its digest, making them visible to readers.
+ *
+ * Called by the thread feeding the shard, e.g. before it exits or goes idle.
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_math_tdigest_shards_flush(fossil_math_tdigest_shards_t* set, size_t shard);
+
+/**
+ * @brief Merges every shard's handed-off values into out, usually a fresh digest.
+ *
+ * Safe to call while producers add; each shard is locked only while it is merged.
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_math_tdigest_shards_snapshot(fossil_math_tdigest_shards_t* set, fossil_math_tdigest_t* out);
+
+/**
+ * @brief Creates a set of empty per-thread KLL sketches.
+ * @param k As for fossil_math_kll_create().
+ * @param shards Number of shards, usually one per producer thread.
+ * @return The set, or NULL if shards is 0 or on allocation failure.
+ */
+fossil_math_kll_shards_t* fossil_math_kll_shards_create(size_t k, size_t shards);
+
+/**
+ * @brief Frees a set. No thread may be using it.
+ */
+void fossil_math_kll_shards_free(fossil_math_kll_shards_t* set);
+
+/**
+ * @brief Adds a value to a shard, with the threading rules of fossil_math_tdigest_shards_add().
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure during a
+ *         handoff (the rest of the handed-off buffer is dropped).
+ */
+int fossil_math_kll_shards_add(fossil_math_kll_shards_t* set, size_t shard, double x);
+
+/**
+ * @brief Hands a shard's buffered values to its sketch, making them visible to readers.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_kll_shards_flush(fossil_math_kll_shards_t* set, size_t shard);
+
+/**
+ * @brief Merges every shard's handed-off values into out, usually a fresh sketch.
+ *
+ * Safe to call while producers add; each shard is locked only while it is merged.
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_kll_shards_snapshot(fossil_math_kll_shards_t* set, fossil_math_kll_t* out);
+
+#ifdef __cplusplus
+}
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief Owning C++ wrapper for fossil_math_tdigest_t.
+         *
+         * Instances are movable but not copyable.
+         */
+        class TDigest {
+        public:
+            /**
+             * @brief Creates an empty digest.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            explicit TDigest(double compression = 0.0) : TDigest(fossil_math_tdigest_create(compression)) {}
+
+            /**
+             * @brief Rebuilds a digest from serialized bytes.
+             * @throws std::invalid_argument on malformed input.
+             */
+            static TDigest deserialize(const std::vector<uint8_t>& bytes) {
+                fossil_math_tdigest_t* td = fossil_math_tdigest_deserialize(bytes.data(), bytes.size());
+                if (!td) throw std::invalid_argument("malformed t-digest");
+                return TDigest(td);
+            }
+
+            ~TDigest() { fossil_math_tdigest_free(td_); }
+            TDigest(const TDigest&) = delete;
+            TDigest& operator=(const TDigest&) = delete;
+            TDigest(TDigest&& other) noexcept : td_(other.td_) { other.td_ = nullptr; }
+            TDigest& operator=(TDigest&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_tdigest_free(td_);
+                    td_ = other.td_;
+                    other.td_ = nullptr;
+                }
+                return *this;
+            }
+
+            void add(double x, double weight = 1.0) { fossil_math_tdigest_add(td_, x, weight); }
+
+            void add(const std::vector<double>& x) {
+                if (fossil_math_tdigest_add_batch(td_, x.data(), x.size()) == -2) throw std::bad_alloc();
+            }
+
+            void merge(const TDigest& other) { fossil_math_tdigest_merge(td_, other.td_); }
+
+            double count() const { return fossil_math_tdigest_count(td_); }
+            double minimum() const { return fossil_math_tdigest_min(td_); }
+            double maximum() const { return fossil_math_tdigest_max(td_); }
+            double quantile(double q) { return fossil_math_tdigest_quantile(td_, q); }
+            double cdf(double x) { return fossil_math_tdigest_cdf(td_, x); }
+
+            std::vector<uint8_t> serialize() {
+                std::vector<uint8_t> bytes(fossil_math_tdigest_serialize(td_, nullptr, 0));
+                fossil_math_tdigest_serialize(td_, bytes.data(), bytes.size());
+                return bytes;
+            }
+
+        private:
+            explicit TDigest(fossil_math_tdigest_t* td) : td_(td) {
+                if (!td_) throw std::bad_alloc();
+            }
+            fossil_math_tdigest_t* td_;
+            friend class TDigestShards;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for fossil_math_kll_t.
+         *
+         * Instances are movable but not copyable.
+         */
+        class Kll {
+        public:
+            /**
+             * @brief Creates an empty sketch.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            explicit Kll(size_t k = 0) : Kll(fossil_math_kll_create(k)) {}
+
+            /**
+             * @brief Rebuilds a sketch from serialized bytes.
+             * @throws std::invalid_argument on malformed input.
+             */
+            static Kll deserialize(const std::vector<uint8_t>& bytes) {
+                fossil_math_kll_t* kll = fossil_math_kll_deserialize(bytes.data(), bytes.size());
+                if (!kll) throw std::invalid_argument("malformed KLL sketch");
+                return Kll(kll);
+            }
+
+            ~Kll() { fossil_math_kll_free(kll_); }
+            Kll(const Kll&) = delete;
+            Kll& operator=(const Kll&) = delete;
+            Kll(Kll&& other) noexcept : kll_(other.kll_) { other.kll_ = nullptr; }
+            Kll& operator=(Kll&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_kll_free(kll_);
+                    kll_ = other.kll_;
+                    other.kll_ = nullptr;
+                }
+                return *this;
+            }
+
+            void add(double x) {
+                if (fossil_math_kll_add(kll_, x) == -2) throw std::bad_alloc();
+            }
+
+            void add(const std::vector<double>& x) {
+                if (fossil_math_kll_add_batch(kll_, x.data(), x.size()) == -2) throw std::bad_alloc();
+            }
+
+            void merge(const Kll& other) {
+                if (fossil_math_kll_merge(kll_, other.kll_) == -2) throw std::bad_alloc();
+            }
+
+            uint64_t count() const { return fossil_math_kll_count(kll_); }
+            double minimum() const { return fossil_math_kll_min(kll_); }
+            double maximum() const { return fossil_math_kll_max(kll_); }
+            double quantile(double q) const { return fossil_math_kll_quantile(kll_, q); }
+            double cdf(double x) const { return fossil_math_kll_cdf(kll_, x); }
+
+            std::vector<uint8_t> serialize() const {
+                std::vector<uint8_t> bytes(fossil_math_kll_serialize(kll_, nullptr, 0));
+                fossil_math_kll_serialize(kll_, bytes.data(), bytes.size());
+                return bytes;
+            }
+
+        private:
+            explicit Kll(fossil_math_kll_t* kll) : kll_(kll) {
+                if (!kll_) throw std::bad_alloc();
+            }
+            fossil_math_kll_t* kll_;
+            friend class KllShards;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for fossil_math_tdigest_shards_t.
+         *
+         * Instances are movable but not copyable.
+         */
+        class TDigestShards {
+        public:
+            /**
+             * @brief Creates a set of empty per-thread digests.
+             * @throws std::invalid_argument if shards is 0.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            TDigestShards(size_t shards, double compression = 0.0)
+                : set_(fossil_math_tdigest_shards_create(compression, shards)), compression_(compression) {
+                if (shards == 0) throw std::invalid_argument("no shards");
+                if (!set_) throw std::bad_alloc();
+            }
+
+            ~TDigestShards() { fossil_math_tdigest_shards_free(set_); }
+            TDigestShards(const TDigestShards&) = delete;
+            TDigestShards& operator=(const TDigestShards&) = delete;
+            TDigestShards(TDigestShards&& other) noexcept : set_(other.set_), compression_(other.compression_) { other.set_ = nullptr; }
+            TDigestShards& operator=(TDigestShards&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_tdigest_shards_free(set_);
+                    set_ = other.set_;
+                    compression_ = other.compression_;
+                    other.set_ = nullptr;
+                }
+                return *this;
+            }
+
+            void add(size_t shard, double x) { fossil_math_tdigest_shards_add(set_, shard, x); }
+            void flush(size_t shard) { fossil_math_tdigest_shards_flush(set_, shard); }
+
+            /**
+             * @brief Merges the shards into a new digest.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            TDigest snapshot() {
+                TDigest out(compression_);
+                fossil_math_tdigest_shards_snapshot(set_, out.td_);
+                return out;
+            }
+
+        private:
+            fossil_math_tdigest_shards_t* set_;
+            double compression_;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for fossil_math_kll_shards_t.
+         *
+         * Instances are movable but not copyable.
+         */
+        class KllShards {
+        public:
+            /**
+             * @brief Creates a set of empty per-thread sketches.
+             * @throws std::invalid_argument if shards is 0.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            KllShards(size_t shards, size_t k = 0) : set_(fossil_math_kll_shards_create(k, shards)), k_(k) {
+                if (shards == 0) throw std::invalid_argument("no shards");
+                if (!set_) throw std::bad_alloc();
+            }
+
+            ~KllShards() { fossil_math_kll_shards_free(set_); }
+            KllShards(const KllShards&) = delete;
+            KllShards& operator=(const KllShards&) = delete;
+            KllShards(KllShards&& other) noexcept : set_(other.set_), k_(other.k_) { other.set_ = nullptr; }
+            KllShards& operator=(KllShards&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_kll_shards_free(set_);
+                    set_ = other.set_;
+                    k_ = other.k_;
+                    other.set_ = nullptr;
+                }
+                return *this;
+            }
+
+            void add(size_t shard, double x) {
+                if (fossil_math_kll_shards_add(set_, shard, x) == -2) throw std::bad_alloc();
+            }
+
+            void flush(size_t shard) {
+                if (fossil_math_kll_shards_flush(set_, shard) == -2) throw std::bad_alloc();
+            }
+
+            /**
+             * @brief Merges the shards into a new sketch.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            Kll snapshot() {
+                Kll out(k_);
+                if (fossil_math_kll_shards_snapshot(set_, out.kll_) == -2) throw std::bad_alloc();
+                return out;
+            }
+
+        private:
+            fossil_math_kll_shards_t* set_;
+            size_t k_;
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_SKETCH_H */
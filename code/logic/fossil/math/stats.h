@@ -0,0 +1,218 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_STATS_H
+#define FOSSIL_MATH_STATS_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief One-pass moment accumulator.
+ *
+ * Holds the count, running mean, centered power sums M2..M4 (sums of
+ * (x - mean)^k) and the extremes. Updates use the Welford/Terriberry
+ * recurrences and accumulators are combined with Pebay's pairwise formulas,
+ * so partial results from different threads or data sources merge exactly
+ * as if the data had been pushed into one accumulator.
+ *
+ * An accumulator is a plain value: copy it freely, but do not update one
+ * instance from several threads at once; give each thread its own and merge.
+ * NaN inputs propagate into the moments; min and max ignore them.
+ */
+typedef struct {
+    size_t count;  ///< Number of samples
+    double mean;   ///< Running mean
+    double m2;     ///< Sum of squared deviations from the mean
+    double m3;     ///< Sum of cubed deviations from the mean
+    double m4;     ///< Sum of fourth-power deviations from the mean
+    double min;    ///< Smallest sample (+inf when empty)
+    double max;    ///< Largest sample (-inf when empty)
+} fossil_math_stats_t;
+
+// ============================================================================
+// Accumulation
+// ============================================================================
+
+/**
+ * @brief Resets an accumulator to the empty state.
+ * @param s Accumulator.
+ */
+void fossil_math_stats_init(fossil_math_stats_t* s);
+
+/**
+ * @brief Adds one sample.
+ * @param s Accumulator.
+ * @param x Sample.
+ */
+void fossil_math_stats_push(fossil_math_stats_t* s, double x);
+
+/**
+ * @brief Adds an array of samples.
+ *
+ * The data is processed in fixed-size blocks: each block's moments are
+ * computed with two branch-free passes (mean, then centered powers) and
+ * merged into s. This is both faster and more accurate than pushing the
+ * samples one by one.
+ *
+ * @param s Accumulator.
+ * @param x Samples.
+ * @param count Number of samples.
+ */
+void fossil_math_stats_push_batch(fossil_math_stats_t* s, const double* x, size_t count);
+
+/**
+ * @brief Merges the samples summarized by other into s.
+ * @param s Accumulator to update.
+ * @param other Accumulator to merge (may be s itself).
+ */
+void fossil_math_stats_merge(fossil_math_stats_t* s, const fossil_math_stats_t* other);
+
+/**
+ * @brief Summarizes an array using all worker threads.
+ *
+ * The input is cut into fixed-size chunks whose partial accumulators are
+ * computed in parallel (see fossil_math_parallel_for()) and merged in chunk
+ * order, so the result does not depend on the thread count.
+ *
+ * @param x Samples.
+ * @param count Number of samples.
+ * @param out Receives the summary.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_stats_compute(const double* x, size_t count, fossil_math_stats_t* out);
+
+// ============================================================================
+// Results
+// ============================================================================
+
+/**
+ * @brief Returns the mean, or NaN when empty.
+ */
+double fossil_math_stats_mean(const fossil_math_stats_t* s);
+
+/**
+ * @brief Returns the sample variance (divided by count - 1), or NaN for fewer than 2 samples.
+ */
+double fossil_math_stats_variance(const fossil_math_stats_t* s);
+
+/**
+ * @brief Returns the sample standard deviation, or NaN for fewer than 2 samples.
+ */
+double fossil_math_stats_stddev(const fossil_math_stats_t* s);
+
+/**
+ * @brief Returns the population skewness g1, or NaN if the variance is zero.
+ */
+double fossil_math_stats_skewness(const fossil_math_stats_t* s);
+
+/**
+ * @brief Returns the population excess kurtosis g2, or NaN if the variance is zero.
+ */
+double fossil_math_stats_kurtosis(const fossil_math_stats_t* s);
+
+#ifdef __cplusplus
+}
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+    namespace math {
+
+        /**
+         * @brief C++ value wrapper for fossil_math_stats_t.
+         *
+         * Copyable; combine per-thread instances with merge() or +=.
+         */
+        class Stats {
+        public:
+            Stats() { fossil_math_stats_init(&s_); }
+
+            /**
+             * @brief Summarizes x using all worker threads.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            static Stats compute(const std::vector<double>& x) {
+                Stats r;
+                if (fossil_math_stats_compute(x.data(), x.size(), &r.s_) != 0)
+                    throw std::bad_alloc();
+                return r;
+            }
+
+            /**
+             * @brief Adds one sample.
+             */
+            void push(double x) { fossil_math_stats_push(&s_, x); }
+
+            /**
+             * @brief Adds every sample of x.
+             */
+            void push(const std::vector<double>& x) { fossil_math_stats_push_batch(&s_, x.data(), x.size()); }
+
+            /**
+             * @brief Merges another accumulator into this one.
+             */
+            void merge(const Stats& other) { fossil_math_stats_merge(&s_, &other.s_); }
+
+            Stats& operator+=(const Stats& other) {
+                merge(other);
+                return *this;
+            }
+
+            size_t count() const { return s_.count; }
+            double mean() const { return fossil_math_stats_mean(&s_); }
+            double variance() const { return fossil_math_stats_variance(&s_); }
+            double stddev() const { return fossil_math_stats_stddev(&s_); }
+            double skewness() const { return fossil_math_stats_skewness(&s_); }
+            double kurtosis() const { return fossil_math_stats_kurtosis(&s_); }
+            double minimum() const { return s_.min; }
+            double maximum() const { return s_.max; }
+
+            /**
+             * @brief Returns the underlying C accumulator.
+             */
+            const fossil_math_stats_t& raw() const { return s_; }
+
+        private:
+            fossil_math_stats_t s_;
+        };
+
+    } // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_STATS_H */
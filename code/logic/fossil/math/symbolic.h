@@ -49,6 +49,23 @@ typedef enum {
     fossil_math_sym_OP     ///< Operator node
 } fossil_math_sym_type_t;
 
+/**
+ * @brief Operator characters of unary and function nodes.
+ *
+ * Besides the binary operators '+', '-', '*', '/' and '^', operator nodes
+ * may carry one of these. Unary nodes use only their left child; min and
+ * max use both.
+ */
+#define FOSSIL_MATH_SYM_NEG  '~' ///< Unary minus
+#define FOSSIL_MATH_SYM_SIN  's' ///< sin(x)
+#define FOSSIL_MATH_SYM_COS  'c' ///< cos(x)
+#define FOSSIL_MATH_SYM_EXP  'e' ///< exp(x)
+#define FOSSIL_MATH_SYM_LOG  'l' ///< Natural logarithm log(x)
+#define FOSSIL_MATH_SYM_SQRT 'q' ///< sqrt(x)
+#define FOSSIL_MATH_SYM_ABS  'a' ///< abs(x)
+#define FOSSIL_MATH_SYM_MIN  'm' ///< min(x, y)
+#define FOSSIL_MATH_SYM_MAX  'M' ///< max(x, y)
+
 /**
  * @brief Forward declaration for the symbolic expression structure.
  *
@@ -68,17 +85,48 @@ typedef struct fossil_math_sym_expr_t fossil_math_sym_expr_t;
  * - value: Numeric value (valid if type == fossil_math_sym_CONST).
  * - name:  Variable name (valid if type == fossil_math_sym_VAR).
  * - left:  Pointer to left child (valid if type == fossil_math_sym_OP).
- * - right: Pointer to right child (valid if type == fossil_math_sym_OP).
+ * - right: Pointer to right child (valid if type == fossil_math_sym_OP with a binary operator; NULL for unary ones).
  */
 struct fossil_math_sym_expr_t {
     fossil_math_sym_type_t type;        ///< Node type
-    char op;                      ///< Operator character ('+', '-', '*', '/'), if applicable
+    char op;                      ///< Operator character ('+', '-', '*', '/', '^' or FOSSIL_MATH_SYM_*), if applicable
     double value;                 ///< Constant value, if applicable
     char name[32];                ///< Variable name, if applicable
     fossil_math_sym_expr_t* left;      ///< Left sub-expression (for operators)
     fossil_math_sym_expr_t* right;     ///< Right sub-expression (for operators)
 };
 
+/**
+ * @brief Outcome of parsing an expression.
+ */
+typedef enum {
+    FOSSIL_MATH_SYM_PARSE_OK,                ///< The whole input is one expression
+    FOSSIL_MATH_SYM_PARSE_INVALID,           ///< NULL graph or text
+    FOSSIL_MATH_SYM_PARSE_UNEXPECTED_CHAR,   ///< A byte that starts no token
+    FOSSIL_MATH_SYM_PARSE_BAD_NUMBER,        ///< Malformed or overlong numeric literal
+    FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND,  ///< An operator, ')', ',' or the end where an operand belongs
+    FOSSIL_MATH_SYM_PARSE_UNKNOWN_FUNCTION,  ///< name( where name is not a function
+    FOSSIL_MATH_SYM_PARSE_ARGUMENTS,         ///< Wrong number of function arguments
+    FOSSIL_MATH_SYM_PARSE_UNCLOSED,          ///< Missing ')'
+    FOSSIL_MATH_SYM_PARSE_TRAILING,          ///< Input continues after a complete expression
+    FOSSIL_MATH_SYM_PARSE_NAME_TOO_LONG,     ///< Variable name longer than 31 characters
+    FOSSIL_MATH_SYM_PARSE_TOO_DEEP,          ///< Nesting beyond FOSSIL_MATH_SYM_PARSE_DEPTH
+    FOSSIL_MATH_SYM_PARSE_NO_MEMORY          ///< Allocation failure
+} fossil_math_sym_parse_status_t;
+
+/**
+ * @brief Where and why parsing stopped.
+ */
+typedef struct {
+    fossil_math_sym_parse_status_t status;
+    size_t offset;  ///< Byte offset of the offending token (the input length at the end)
+} fossil_math_sym_parse_error_t;
+
+/**
+ * @brief Deepest nesting of parentheses, unary minus and exponents the parser accepts.
+ */
+#define FOSSIL_MATH_SYM_PARSE_DEPTH 1024
+
 // ============================================================================
 // Symbolic Expression Functions
 // ============================================================================
@@ -86,13 +134,36 @@ struct fossil_math_sym_expr_t {
 /**
  * @brief Parses a string into a symbolic expression tree.
  *
+ * Supports numbers, named constants (pi, e, ...), variables, parentheses,
+ * the binary operators + - * / and right-associative ^, unary minus, and
+ * the functions sin, cos, exp, log, sqrt, abs, min and max. Unary minus
+ * binds looser than ^, so -x^2 is -(x^2).
+ *
  * @param expr String containing the mathematical expression.
- * @return Pointer to the root of the symbolic expression tree.
+ * @return Pointer to the root of the symbolic expression tree, or NULL if
+ *         the string is not a single well-formed expression.
  *
  * The returned tree must be freed using fossil_math_sym_free().
  */
 fossil_math_sym_expr_t* fossil_math_sym_parse(const char* expr);
 
+/**
+ * @brief Parses the first len bytes of text into a tree, reporting errors.
+ *
+ * Same grammar as fossil_math_sym_parse(); text need not be NUL-terminated.
+ *
+ * @param text Expression text.
+ * @param len Number of bytes to parse.
+ * @param error Receives the outcome (may be NULL).
+ * @return The tree, or NULL on error.
+ */
+fossil_math_sym_expr_t* fossil_math_sym_parse_n(const char* text, size_t len, fossil_math_sym_parse_error_t* error);
+
+/**
+ * @brief Returns a short English description of a parse status.
+ */
+const char* fossil_math_sym_parse_message(fossil_math_sym_parse_status_t status);
+
 /**
  * @brief Frees the memory associated with a symbolic expression tree.
  *
@@ -100,19 +171,39 @@ fossil_math_sym_expr_t* fossil_math_sym_parse(const char* expr);
  */
 void fossil_math_sym_free(fossil_math_sym_expr_t* expr);
 
+/**
+ * @brief Deep-copies a symbolic expression tree.
+ *
+ * @param expr Pointer to the root of the symbolic expression tree.
+ * @return Pointer to the copy, or NULL on allocation failure.
+ *
+ * The returned tree must be freed using fossil_math_sym_free().
+ */
+fossil_math_sym_expr_t* fossil_math_sym_copy(const fossil_math_sym_expr_t* expr);
+
 /**
  * @brief Simplifies a symbolic expression tree.
  *
+ * Rewrites the tree to the canonical form of fossil_math_sym_graph_simplify():
+ * constants are folded, sums and products are flattened with their operands
+ * in a canonical order, like terms and factors are collected, and identities
+ * such as x * 1, x + 0, 0 * x and x - x are removed.
+ *
  * @param expr Pointer to the root of the symbolic expression tree.
  * @return Pointer to the simplified symbolic expression tree.
  *
- * The returned tree may be a new allocation; free it with fossil_math_sym_free().
+ * The root node is reused; its former children are freed. The returned tree
+ * may be a new allocation; free it with fossil_math_sym_free().
  */
 fossil_math_sym_expr_t* fossil_math_sym_simplify(fossil_math_sym_expr_t* expr);
 
 /**
  * @brief Computes the symbolic derivative of an expression with respect to a variable.
  *
+ * Differentiates through fossil_math_sym_graph_diff(), so constants and
+ * trivial identities are folded. min, max and abs are differentiated
+ * through abs(w)' = w' * w / abs(w), which is NaN where w = 0.
+ *
  * @param expr Pointer to the root of the symbolic expression tree.
  * @param var Name of the variable to differentiate with respect to.
  * @return Pointer to the symbolic derivative expression tree.
@@ -156,8 +247,705 @@ size_t fossil_math_sym_to_string(const fossil_math_sym_expr_t* expr, char* buffe
  */
 fossil_math_sym_expr_t* fossil_math_sym_substitute(const fossil_math_sym_expr_t* expr, const char* var, double value);
 
+/**
+ * @brief Binds several variables to constant values in a single pass.
+ *
+ * Subexpressions whose operands all become constant are folded as the tree
+ * is rebuilt, so binding every variable yields a single constant. Unbound
+ * variables are left as they are. If a name is listed twice, the first
+ * binding wins.
+ *
+ * @param expr Pointer to the root of the symbolic expression tree.
+ * @param vars Names of the variables to bind.
+ * @param values Values for vars.
+ * @param nvars Number of bindings.
+ * @return New tree (free with fossil_math_sym_free()), or NULL on invalid
+ *         input or allocation failure.
+ */
+fossil_math_sym_expr_t* fossil_math_sym_substitute_values(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                          const double* values, size_t nvars);
+
+/**
+ * @brief Replaces several variables with expressions in a single pass.
+ *
+ * Replacement is simultaneous: variables occurring inside the replacement
+ * expressions are not substituted again, so "x" -> "y", "y" -> "x" swaps
+ * the two. Constant subexpressions are folded as the tree is rebuilt.
+ *
+ * @param expr Pointer to the root of the symbolic expression tree.
+ * @param vars Names of the variables to replace.
+ * @param exprs Replacement expressions for vars (not consumed).
+ * @param nvars Number of bindings.
+ * @return New tree (free with fossil_math_sym_free()), or NULL on invalid
+ *         input or allocation failure.
+ */
+fossil_math_sym_expr_t* fossil_math_sym_substitute_exprs(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                         const fossil_math_sym_expr_t* const* exprs, size_t nvars);
+
+// ============================================================================
+// Compiled Expressions
+// ============================================================================
+
+/**
+ * @brief Opaque compiled form of a symbolic expression.
+ *
+ * Compilation resolves every variable to a slot in a caller-defined order
+ * and flattens the tree into register bytecode, so evaluation is a single
+ * loop over instructions with no recursion and no name lookups. A compiled
+ * program is immutable and may be evaluated from several threads at once.
+ */
+typedef struct fossil_math_sym_compiled fossil_math_sym_compiled_t;
+
+/**
+ * @brief Compiles an expression tree to bytecode.
+ *
+ * @param expr Expression to compile.
+ * @param vars Variable names; vars[i] is read from slot i at evaluation time.
+ * @param nvars Number of variable names.
+ * @return The compiled program, or NULL if expr is malformed, references a
+ *         variable not listed in vars, or allocation fails.
+ *
+ * The returned program must be freed using fossil_math_sym_compiled_free().
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_compile(const fossil_math_sym_expr_t* expr, const char* const* vars, size_t nvars);
+
+/**
+ * @brief Compiles an expression together with its gradient.
+ *
+ * The program has nvars + 1 outputs: the value, then the partial derivative
+ * with respect to each of vars in order. Partials are generated in reverse
+ * mode and share their intermediates with the value and with each other,
+ * so evaluating all outputs costs a small constant times one evaluation
+ * regardless of nvars.
+ *
+ * @param expr Expression to differentiate.
+ * @param vars Variable names; vars[i] is read from slot i at evaluation time.
+ * @param nvars Number of variable names.
+ * @return The compiled program, or NULL as for fossil_math_sym_compile().
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_compile_gradient(const fossil_math_sym_expr_t* expr, const char* const* vars, size_t nvars);
+
+/**
+ * @brief Compiles several expressions together with their Jacobian.
+ *
+ * The program has nexprs * (nvars + 1) outputs: the nexprs values, then the
+ * Jacobian row by row, so d exprs[i] / d vars[j] is output
+ * nexprs + i * nvars + j. Subexpressions shared between the expressions are
+ * computed once.
+ *
+ * @param exprs Expressions to differentiate.
+ * @param nexprs Number of expressions (at least 1).
+ * @param vars Variable names; vars[i] is read from slot i at evaluation time.
+ * @param nvars Number of variable names.
+ * @return The compiled program, or NULL as for fossil_math_sym_compile().
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_compile_jacobian(const fossil_math_sym_expr_t* const* exprs, size_t nexprs,
+                                                             const char* const* vars, size_t nvars);
+
+/**
+ * @brief Frees a compiled program.
+ *
+ * @param prog Program to free (may be NULL).
+ */
+void fossil_math_sym_compiled_free(fossil_math_sym_compiled_t* prog);
+
+/**
+ * @brief Evaluates a compiled program at one point.
+ *
+ * Results match fossil_math_sym_eval() with the same variable values,
+ * including NaN for division by zero.
+ *
+ * @param prog Compiled program.
+ * @param vars Variable values in the order given to fossil_math_sym_compile().
+ * @return Numeric result, or NaN on invalid arguments.
+ */
+double fossil_math_sym_eval_compiled(const fossil_math_sym_compiled_t* prog, const double* vars);
+
+/**
+ * @brief Evaluates every output of a compiled program at one point.
+ *
+ * @param prog Compiled program.
+ * @param vars Variable values in compile order.
+ * @param out Receives fossil_math_sym_compiled_outputs() values.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_sym_eval_compiled_many(const fossil_math_sym_compiled_t* prog, const double* vars, double* out);
+
+/**
+ * @brief Evaluates a compiled program at many points.
+ *
+ * Execution is columnar: each instruction runs over a block of points before
+ * the next one starts, so interpretation overhead is paid once per block and
+ * the per-instruction loops are plain element-wise array arithmetic that the
+ * compiler vectorizes. Blocks are spread across the worker threads (see
+ * fossil_math_parallel_for()).
+ *
+ * @param prog Compiled program.
+ * @param var_columns One array of n values per variable, in compile order.
+ * @param out Receives the n results.
+ * @param n Number of points.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_sym_eval_batch(const fossil_math_sym_compiled_t* prog, const double* const* var_columns, double* out, size_t n);
+
+/**
+ * @brief Evaluates every output of a compiled program at many points.
+ *
+ * @param prog Compiled program.
+ * @param var_columns One array of n values per variable, in compile order.
+ * @param out_columns One array of n results per output.
+ * @param n Number of points.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_sym_eval_batch_many(const fossil_math_sym_compiled_t* prog, const double* const* var_columns,
+                                    double* const* out_columns, size_t n);
+
+/**
+ * @brief Returns the number of variable slots a program reads.
+ */
+size_t fossil_math_sym_compiled_vars(const fossil_math_sym_compiled_t* prog);
+
+/**
+ * @brief Returns the number of bytecode instructions in a program.
+ */
+size_t fossil_math_sym_compiled_length(const fossil_math_sym_compiled_t* prog);
+
+/**
+ * @brief Returns the number of outputs of a program (1 unless built for several).
+ *
+ * Single-result entry points such as fossil_math_sym_eval_compiled() and
+ * fossil_math_sym_emit_c() use the first output.
+ */
+size_t fossil_math_sym_compiled_outputs(const fossil_math_sym_compiled_t* prog);
+
+// ============================================================================
+// Interval Evaluation
+// ============================================================================
+
+/**
+ * @brief Closed interval [lo, hi] of doubles.
+ *
+ * Bounds may be infinite. An interval with a NaN bound is empty: it is the
+ * result of an operation that is defined nowhere on its input, such as the
+ * logarithm of a negative interval, and it propagates through every later
+ * operation.
+ */
+typedef struct {
+    double lo; ///< Lower bound
+    double hi; ///< Upper bound
+} fossil_math_sym_interval_t;
+
+/**
+ * @brief Bounds an expression over a box of variable ranges.
+ *
+ * The result is guaranteed to contain the exact real value of the expression
+ * at every point of the box where it is defined. Bounds are rounded outward
+ * without changing the floating-point rounding mode: +, -, *, / and sqrt
+ * recover their rounding error exactly and move a bound by one ulp only
+ * when needed, and library functions are widened by two ulps. Operations
+ * restrict to their domain, so sqrt([-1, 4]) is [0, 2], while division by an
+ * interval containing 0 yields [-inf, inf]. Bounds are exact for each
+ * operation taken alone but may overestimate the range of an expression in
+ * which a variable occurs more than once.
+ *
+ * min and max match the point evaluators, which return the other operand
+ * where one is NaN: an operand that is empty on the box is ignored. An
+ * operand defined on only part of the box is still restricted to that part,
+ * so at points where it is undefined the point result (the other operand)
+ * may fall outside the enclosure; min(y, log(x)) over x in [-1, 1] is an
+ * example.
+ *
+ * @param expr Expression to bound.
+ * @param vars Variable names.
+ * @param ranges Range of each variable.
+ * @param nvars Number of variables.
+ * @return The enclosure, or an empty interval if expr is malformed or
+ *         references a variable not listed in vars.
+ */
+fossil_math_sym_interval_t fossil_math_sym_eval_interval(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                         const fossil_math_sym_interval_t* ranges, size_t nvars);
+
+/**
+ * @brief Bounds a compiled program over a box.
+ *
+ * Runs the same bytecode as fossil_math_sym_eval_compiled() with interval
+ * registers, giving the same enclosure as fossil_math_sym_eval_interval().
+ *
+ * @param prog Compiled program.
+ * @param vars Variable ranges in compile order.
+ * @return Enclosure of the first output, or an empty interval on invalid arguments.
+ */
+fossil_math_sym_interval_t fossil_math_sym_eval_compiled_interval(const fossil_math_sym_compiled_t* prog,
+                                                                  const fossil_math_sym_interval_t* vars);
+
+/**
+ * @brief Bounds every output of a compiled program over a box.
+ *
+ * @param prog Compiled program.
+ * @param vars Variable ranges in compile order.
+ * @param out Receives fossil_math_sym_compiled_outputs() enclosures.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_sym_eval_compiled_interval_many(const fossil_math_sym_compiled_t* prog, const fossil_math_sym_interval_t* vars,
+                                                fossil_math_sym_interval_t* out);
+
+/**
+ * @brief Bounds a compiled program over many boxes.
+ *
+ * Boxes are spread across the worker threads (see fossil_math_parallel_for()).
+ *
+ * @param prog Compiled program.
+ * @param var_columns One array of n ranges per variable, in compile order.
+ * @param out Receives the n enclosures of the first output.
+ * @param n Number of boxes.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure.
+ */
+int fossil_math_sym_eval_batch_interval(const fossil_math_sym_compiled_t* prog, const fossil_math_sym_interval_t* const* var_columns,
+                                        fossil_math_sym_interval_t* out, size_t n);
+
+// ============================================================================
+// Expression Graphs
+// ============================================================================
+//
+// A graph is a hash-consed store of expression nodes: building a node that
+// already exists returns the existing one, so identical subexpressions are a
+// single node and expressions form a DAG. Nodes live for the lifetime of the
+// graph and are addressed by index handles. Children always have smaller
+// indices than their parents.
+//
+// Nodes are 16-byte records stored contiguously, with children linked by
+// index and variable names interned once in a per-graph symbol table, so a
+// graph is several times smaller than the equivalent tree and walks over it
+// touch memory sequentially.
+//
+// Differentiation and simplification results are memoized per node, so
+// repeated or overlapping requests reuse earlier work, and derivatives share
+// structure instead of growing exponentially. Evaluation and compilation
+// visit each distinct node once.
+//
+// A graph is not synchronized; compiled programs built from it are
+// independent of it and may be used concurrently.
+//
+// ============================================================================
+
+/**
+ * @brief Opaque hash-consed expression store.
+ */
+typedef struct fossil_math_sym_graph fossil_math_sym_graph_t;
+
+/**
+ * @brief Handle to a node of a fossil_math_sym_graph_t.
+ */
+typedef uint32_t fossil_math_sym_node_t;
+
+/**
+ * @brief Invalid node handle, returned on failure. Passing it to a builder yields it again.
+ */
+#define FOSSIL_MATH_SYM_NONE ((fossil_math_sym_node_t)0xFFFFFFFFu)
+
+/**
+ * @brief Creates an empty expression graph.
+ * @return The graph, or NULL on allocation failure.
+ */
+fossil_math_sym_graph_t* fossil_math_sym_graph_create(void);
+
+/**
+ * @brief Frees an expression graph and all of its nodes.
+ */
+void fossil_math_sym_graph_free(fossil_math_sym_graph_t* graph);
+
+/**
+ * @brief Returns the number of distinct nodes in the graph.
+ */
+size_t fossil_math_sym_graph_size(const fossil_math_sym_graph_t* graph);
+
+/**
+ * @brief Returns the memory held by the graph in bytes (nodes, tables and names).
+ */
+size_t fossil_math_sym_graph_bytes(const fossil_math_sym_graph_t* graph);
+
+/**
+ * @brief Returns the constant node with the given value.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_const(fossil_math_sym_graph_t* graph, double value);
+
+/**
+ * @brief Returns the variable node with the given name (at most 31 characters are kept).
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_var(fossil_math_sym_graph_t* graph, const char* name);
+
+/**
+ * @brief Returns the operator node a op b.
+ *
+ * op is '+', '-', '*', '/', '^' or one of the FOSSIL_MATH_SYM_* operators;
+ * unary operators ignore b. The node is built exactly as given; use
+ * fossil_math_sym_graph_simplify() for folding.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_op(fossil_math_sym_graph_t* graph, char op, fossil_math_sym_node_t a, fossil_math_sym_node_t b);
+
+/**
+ * @brief Interns an expression tree into the graph.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_import(fossil_math_sym_graph_t* graph, const fossil_math_sym_expr_t* expr);
+
+/**
+ * @brief Parses the first len bytes of text directly into the graph.
+ *
+ * A single-pass precedence-climbing parser reads tokens in place, without
+ * copying the text or building a tree; nodes go straight into the graph's
+ * node array. Nodes built before an error stay in the graph.
+ *
+ * @param graph Destination graph.
+ * @param text Expression text (need not be NUL-terminated).
+ * @param len Number of bytes to parse.
+ * @param error Receives the outcome and, on failure, the offset of the offending token (may be NULL).
+ * @return The root node, or FOSSIL_MATH_SYM_NONE on error.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_parse(fossil_math_sym_graph_t* graph, const char* text, size_t len,
+                                                   fossil_math_sym_parse_error_t* error);
+
+/**
+ * @brief Expands a node back into a standalone tree.
+ *
+ * Shared nodes are duplicated, so the tree can be exponentially larger than
+ * the DAG it came from.
+ *
+ * @return The tree (free with fossil_math_sym_free()), or NULL on failure.
+ */
+fossil_math_sym_expr_t* fossil_math_sym_graph_export(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Returns the type of a node (fossil_math_sym_CONST, _VAR or _OP).
+ */
+fossil_math_sym_type_t fossil_math_sym_graph_type(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Returns the operator character of an operator node, or 0.
+ */
+char fossil_math_sym_graph_node_op(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Returns the value of a constant node, or NaN.
+ */
+double fossil_math_sym_graph_value(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Returns the name of a variable node, or NULL. Valid for the lifetime of the graph.
+ */
+const char* fossil_math_sym_graph_name(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Returns the left and right children of an operator node.
+ *
+ * Unary operators report their operand as both children.
+ *
+ * @return 0 on success, -1 if node is not an operator node.
+ */
+int fossil_math_sym_graph_children(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                   fossil_math_sym_node_t* left, fossil_math_sym_node_t* right);
+
+/**
+ * @brief Returns the number of distinct nodes reachable from node (its DAG size).
+ */
+size_t fossil_math_sym_graph_count(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Rewrites a node to canonical form; memoized per node.
+ *
+ * Sums and differences are flattened into terms c * m and collected by
+ * monomial m; products and quotients are flattened into a coefficient times
+ * factors b ^ k and collected by base b. Operands are sorted in a fixed
+ * structural order, zero terms and exponents are dropped, and constants are
+ * folded, so for example y*x + x*y - x*2 and 2*(x*y - x) give the same node.
+ * Apart from distributing a numeric coefficient over a single sum, sums
+ * inside products and vice versa are not expanded. Passes are repeated
+ * until the result is stable, at most a small fixed number of times.
+ *
+ * Combining powers of the same base assumes the usual real-number laws,
+ * so x / x simplifies to 1 even though it is undefined at x = 0.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_simplify(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node);
+
+/**
+ * @brief Differentiates a node with respect to a variable; memoized per (node, variable).
+ *
+ * Results fold constants and trivial identities (x * 1, x + 0, ...) as they
+ * are built; pass them to fossil_math_sym_graph_simplify() for a canonical
+ * form.
+ *
+ * @return The derivative, or FOSSIL_MATH_SYM_NONE if it cannot be expressed.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_diff(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node, const char* var);
+
+/**
+ * @brief Replaces variables with nodes in one sweep over the reachable subgraph.
+ *
+ * Replacement is simultaneous and constants are folded along the way.
+ * Subgraphs that contain none of the variables are returned unchanged, so
+ * the result shares them with the input; the cost is linear in the number
+ * of nodes reachable from node, independent of nvars.
+ *
+ * @param vars Variable names.
+ * @param values Replacement nodes for vars (constants via fossil_math_sym_graph_const()).
+ * @param nvars Number of bindings.
+ * @return The substituted node, or FOSSIL_MATH_SYM_NONE on invalid input or
+ *         allocation failure.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_substitute(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                                        const char* const* vars, const fossil_math_sym_node_t* values, size_t nvars);
+
+/**
+ * @brief Evaluates a node, computing every shared subexpression once.
+ *
+ * @param vars Variable names.
+ * @param values Values for vars.
+ * @param nvars Number of variables.
+ * @return The value, or NaN on failure or if a variable is not bound.
+ */
+double fossil_math_sym_graph_eval(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                  const char* const* vars, const double* values, size_t nvars);
+
+/**
+ * @brief Compiles a node to bytecode, emitting each shared subexpression once.
+ *
+ * Equivalent to fossil_math_sym_compile() on the exported tree, but common
+ * subexpressions are computed a single time.
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_graph_compile(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                                          const char* const* vars, size_t nvars);
+
+/**
+ * @brief Compiles several nodes into one program with an output per node.
+ *
+ * Subexpressions shared between the nodes are emitted once.
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_graph_compile_many(const fossil_math_sym_graph_t* graph, const fossil_math_sym_node_t* nodes,
+                                                               size_t count, const char* const* vars, size_t nvars);
+
+/**
+ * @brief Builds the gradient of a node by reverse accumulation.
+ *
+ * Adjoints are propagated from the node down to the variables in one sweep,
+ * so all partials together take work proportional to the size of the node,
+ * not nvars times it. Constants and trivial identities fold as the adjoints
+ * are built. Variables that do not occur get the constant 0.
+ *
+ * @param vars Variable names.
+ * @param nvars Number of variables.
+ * @param grad Receives the partial derivative node for each of vars.
+ * @return 0 on success, -1 on invalid arguments, -2 on allocation failure
+ *         or an operator that cannot be differentiated.
+ */
+int fossil_math_sym_graph_gradient(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                   const char* const* vars, size_t nvars, fossil_math_sym_node_t* grad);
+
+// ============================================================================
+// Native Code Generation
+// ============================================================================
+
+/**
+ * @brief Opaque handle to a natively compiled expression loaded at runtime.
+ */
+typedef struct fossil_math_sym_native fossil_math_sym_native_t;
+
+/**
+ * @brief Emits C99 source for a compiled program.
+ *
+ * The source defines two exported functions:
+ *
+ *     double NAME(const double* vars);
+ *     void NAME_batch(const double* const* var_columns, double* out, size_t n);
+ *
+ * with the same variable order and results as fossil_math_sym_eval_compiled()
+ * and fossil_math_sym_eval_batch(). The output depends only on the program and
+ * name, so it can be generated at build time (e.g. by a meson custom_target)
+ * and compiled into the application.
+ *
+ * @param prog Compiled program.
+ * @param name C identifier for the scalar function.
+ * @param buffer Output buffer (may be NULL when bufsize is 0).
+ * @param bufsize Size of buffer.
+ * @return Length of the complete source excluding the terminator, as with
+ *         snprintf(); 0 if prog or name is invalid. The output is truncated
+ *         when bufsize is not larger than the return value.
+ */
+size_t fossil_math_sym_emit_c(const fossil_math_sym_compiled_t* prog, const char* name, char* buffer, size_t bufsize);
+
+/**
+ * @brief Compiles a program to a shared library and loads it.
+ *
+ * The emitted source is hashed together with the compiler command; the
+ * library is cached in cache_dir under that hash, so later calls (also from
+ * other processes) load it without recompiling. Sources and new libraries
+ * are written under per-process names and the library is renamed into
+ * place, so concurrent builders do not observe partial files.
+ *
+ * Since cached libraries are loaded into the process, cache_dir is created
+ * with mode 0700 and must be a directory owned by the effective user that
+ * neither group nor others can write; a cached library is only loaded if
+ * the same holds for it. Otherwise NULL is returned. The compiler runs
+ * without a shell, its command split on whitespace.
+ *
+ * Runtime compilation is available on POSIX systems with dlopen(). Elsewhere,
+ * or when the compiler fails, NULL is returned and callers should keep using
+ * the bytecode program.
+ *
+ * @param prog Compiled program.
+ * @param cache_dir Directory for libraries (NULL = $XDG_CACHE_HOME/fossil_math,
+ *                  else $HOME/.cache/fossil_math, else $TMPDIR/fossil_math-EUID).
+ * @param compiler Compiler command (NULL = $CC or "cc").
+ * @return The loaded function, or NULL on failure.
+ */
+fossil_math_sym_native_t* fossil_math_sym_native_compile(const fossil_math_sym_compiled_t* prog, const char* cache_dir, const char* compiler);
+
+/**
+ * @brief Unloads a native function.
+ *
+ * @param native Handle to free (may be NULL).
+ */
+void fossil_math_sym_native_free(fossil_math_sym_native_t* native);
+
+/**
+ * @brief Returns non-zero if the library was loaded from the cache without compiling.
+ */
+int fossil_math_sym_native_cached(const fossil_math_sym_native_t* native);
+
+/**
+ * @brief Evaluates a native function at one point (NaN on invalid arguments).
+ */
+double fossil_math_sym_native_eval(const fossil_math_sym_native_t* native, const double* vars);
+
+/**
+ * @brief Evaluates a native function at n points.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_math_sym_native_eval_batch(const fossil_math_sym_native_t* native, const double* const* var_columns, double* out, size_t n);
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+/**
+ * @brief Encodes a compiled program as a portable byte string.
+ *
+ * The encoding is little-endian and independent of the host, so programs
+ * can be stored or shipped to other processes and restored with
+ * fossil_math_sym_compiled_deserialize() without parsing or compiling.
+ *
+ * @param prog Compiled program.
+ * @param buffer Output buffer (may be NULL when bufsize is 0).
+ * @param bufsize Size of buffer.
+ * @return Size of the complete encoding, as with snprintf(); 0 if prog is
+ *         NULL. The output is truncated when bufsize is smaller.
+ */
+size_t fossil_math_sym_compiled_serialize(const fossil_math_sym_compiled_t* prog, void* buffer, size_t bufsize);
+
+/**
+ * @brief Decodes a program written by fossil_math_sym_compiled_serialize().
+ *
+ * Every count, opcode and register index is validated, so corrupt or
+ * truncated input is rejected rather than executed.
+ *
+ * @return The program (free with fossil_math_sym_compiled_free()), or NULL
+ *         if the data is malformed or allocation fails.
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_compiled_deserialize(const void* data, size_t size);
+
+/**
+ * @brief Encodes the subgraph reachable from node as a portable byte string.
+ *
+ * Shared subexpressions are written once, so the encoding is proportional
+ * to the DAG rather than the expanded tree.
+ *
+ * @return Size of the complete encoding, as with snprintf(); 0 if the node
+ *         is invalid or allocation fails.
+ */
+size_t fossil_math_sym_graph_serialize(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node, void* buffer, size_t bufsize);
+
+/**
+ * @brief Interns an encoded subgraph into graph.
+ *
+ * @return The root node, or FOSSIL_MATH_SYM_NONE if the data is malformed or
+ *         allocation fails. Nodes interned before a failure remain in graph.
+ */
+fossil_math_sym_node_t fossil_math_sym_graph_deserialize(fossil_math_sym_graph_t* graph, const void* data, size_t size);
+
+// ============================================================================
+// Parse Cache
+// ============================================================================
+
+/**
+ * @brief Opaque, thread-safe LRU cache of compiled formulas.
+ *
+ * Keyed by formula text, variable list and flags. A hit skips parsing,
+ * simplification and compilation and only decodes the stored program.
+ */
+typedef struct fossil_math_sym_cache fossil_math_sym_cache_t;
+
+/** Simplify the formula before compiling it. */
+#define FOSSIL_MATH_SYM_CACHE_SIMPLIFY 1u
+/** Compile the value followed by its gradient (see fossil_math_sym_compile_gradient()). */
+#define FOSSIL_MATH_SYM_CACHE_GRADIENT 2u
+
+/**
+ * @brief Cache counters.
+ */
+typedef struct {
+    size_t hits;        ///< Lookups served from the cache
+    size_t misses;      ///< Lookups that parsed and compiled
+    size_t evictions;   ///< Entries dropped to stay within the size bound
+    size_t entries;     ///< Entries currently held
+    size_t bytes;       ///< Memory held by entries
+} fossil_math_sym_cache_stats_t;
+
+/**
+ * @brief Creates a cache holding at most max_bytes of entries.
+ *
+ * @param max_bytes Size bound (0 = 1 MiB). The least recently used
+ *                  entries are evicted to stay within it.
+ * @return The cache, or NULL on allocation failure.
+ */
+fossil_math_sym_cache_t* fossil_math_sym_cache_create(size_t max_bytes);
+
+/**
+ * @brief Frees a cache and its entries. Passing NULL is a no-op.
+ */
+void fossil_math_sym_cache_free(fossil_math_sym_cache_t* cache);
+
+/**
+ * @brief Drops every entry; counters other than entries and bytes are kept.
+ */
+void fossil_math_sym_cache_clear(fossil_math_sym_cache_t* cache);
+
+/**
+ * @brief Returns a compiled program for a formula, from the cache if possible.
+ *
+ * On a miss the formula is parsed and compiled without holding the cache
+ * lock, then stored. Formulas that fail to parse or compile are not cached.
+ * May be called from several threads at once.
+ *
+ * @param cache Cache.
+ * @param text Formula text (len bytes, need not be NUL-terminated).
+ * @param len Length of text.
+ * @param vars Variable names; vars[i] is read from slot i at evaluation time.
+ * @param nvars Number of variable names.
+ * @param flags FOSSIL_MATH_SYM_CACHE_* bits.
+ * @param error Receives the parse status (may be NULL); FOSSIL_MATH_SYM_PARSE_INVALID
+ *              if the formula uses a variable missing from vars.
+ * @return A new program owned by the caller, or NULL on failure.
+ */
+fossil_math_sym_compiled_t* fossil_math_sym_cache_compile(fossil_math_sym_cache_t* cache, const char* text, size_t len,
+                                                          const char* const* vars, size_t nvars, unsigned flags,
+                                                          fossil_math_sym_parse_error_t* error);
+
+/**
+ * @brief Copies the cache counters into stats.
+ */
+void fossil_math_sym_cache_stats(fossil_math_sym_cache_t* cache, fossil_math_sym_cache_stats_t* stats);
+
 #ifdef __cplusplus
 }
+#include <new>
 #include <stdexcept>
 #include <functional>
 #include <vector>
@@ -234,6 +1022,30 @@ namespace fossil {
                 return fossil_math_sym_substitute(expr, var.c_str(), value);
             }
 
+            /**
+             * @brief Binds vars[i] to values[i] in a single pass, folding constants.
+             * @throws std::invalid_argument if vars and values differ in size.
+             */
+            static fossil_math_sym_expr_t* substitute(const fossil_math_sym_expr_t* expr, const std::vector<std::string>& vars,
+                                                      const std::vector<double>& values) {
+                if (vars.size() != values.size()) throw std::invalid_argument("wrong number of values");
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return fossil_math_sym_substitute_values(expr, names.data(), values.data(), names.size());
+            }
+
+            /**
+             * @brief Replaces vars[i] with exprs[i] simultaneously, folding constants.
+             * @throws std::invalid_argument if vars and exprs differ in size.
+             */
+            static fossil_math_sym_expr_t* substitute(const fossil_math_sym_expr_t* expr, const std::vector<std::string>& vars,
+                                                      const std::vector<const fossil_math_sym_expr_t*>& exprs) {
+                if (vars.size() != exprs.size()) throw std::invalid_argument("wrong number of expressions");
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return fossil_math_sym_substitute_exprs(expr, names.data(), exprs.data(), names.size());
+            }
+
             /**
              * @brief Evaluates a symbolic expression tree numerically.
              * @param expr Pointer to the root of the symbolic expression tree.
@@ -261,6 +1073,439 @@ namespace fossil {
             };
             return fossil_math_sym_eval(expr, c_lookup);
             }
+
+            /**
+             * @brief Bounds an expression over a box of variable ranges.
+             * @param expr Expression to bound.
+             * @param vars Variable names.
+             * @param ranges Range of each variable, in the order of vars.
+             * @return The enclosure (empty, with NaN bounds, if it is defined nowhere).
+             * @throws std::invalid_argument if vars and ranges differ in size.
+             */
+            static fossil_math_sym_interval_t eval_interval(const fossil_math_sym_expr_t* expr, const std::vector<std::string>& vars,
+                                                            const std::vector<fossil_math_sym_interval_t>& ranges) {
+                if (vars.size() != ranges.size()) throw std::invalid_argument("vars and ranges differ in size");
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return fossil_math_sym_eval_interval(expr, names.data(), ranges.data(), names.size());
+            }
+        };
+
+        /**
+         * @brief Owning C++ wrapper for a compiled symbolic expression.
+         *
+         * Instances are movable but not copyable.
+         */
+        class SymCompiled {
+        public:
+            /**
+             * @brief Compiles expr with variables read in the order of vars.
+             * @throws std::invalid_argument if the expression cannot be compiled.
+             */
+            SymCompiled(const fossil_math_sym_expr_t* expr, const std::vector<std::string>& vars) : prog_(nullptr) {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                prog_ = fossil_math_sym_compile(expr, names.data(), names.size());
+                if (!prog_) throw std::invalid_argument("cannot compile symbolic expression");
+            }
+
+            /**
+             * @brief Takes ownership of a C program.
+             * @throws std::invalid_argument if prog is NULL.
+             */
+            explicit SymCompiled(fossil_math_sym_compiled_t* prog) : prog_(prog) {
+                if (!prog_) throw std::invalid_argument("cannot compile symbolic expression");
+            }
+
+            ~SymCompiled() { fossil_math_sym_compiled_free(prog_); }
+            SymCompiled(const SymCompiled&) = delete;
+            SymCompiled& operator=(const SymCompiled&) = delete;
+            SymCompiled(SymCompiled&& other) noexcept : prog_(other.prog_) { other.prog_ = nullptr; }
+            SymCompiled& operator=(SymCompiled&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_sym_compiled_free(prog_);
+                    prog_ = other.prog_;
+                    other.prog_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Evaluates the program at one point.
+             * @param vars Variable values, one per compiled variable.
+             * @throws std::invalid_argument if vars has the wrong size.
+             */
+            double operator()(const std::vector<double>& vars) const {
+                if (vars.size() != fossil_math_sym_compiled_vars(prog_))
+                    throw std::invalid_argument("wrong number of variables");
+                return fossil_math_sym_eval_compiled(prog_, vars.data());
+            }
+
+            /**
+             * @brief Compiles expr and its gradient with respect to vars.
+             * @throws std::invalid_argument if the expression cannot be compiled.
+             */
+            static SymCompiled gradient(const fossil_math_sym_expr_t* expr, const std::vector<std::string>& vars) {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return SymCompiled(fossil_math_sym_compile_gradient(expr, names.data(), names.size()));
+            }
+
+            /**
+             * @brief Compiles exprs and their Jacobian with respect to vars.
+             * @throws std::invalid_argument if the expressions cannot be compiled.
+             */
+            static SymCompiled jacobian(const std::vector<const fossil_math_sym_expr_t*>& exprs, const std::vector<std::string>& vars) {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return SymCompiled(fossil_math_sym_compile_jacobian(exprs.data(), exprs.size(), names.data(), names.size()));
+            }
+
+            /**
+             * @brief Evaluates every output of the program at one point.
+             * @throws std::invalid_argument if vars has the wrong size.
+             */
+            std::vector<double> eval_all(const std::vector<double>& vars) const {
+                if (vars.size() != fossil_math_sym_compiled_vars(prog_))
+                    throw std::invalid_argument("wrong number of variables");
+                std::vector<double> out(outputs());
+                if (fossil_math_sym_eval_compiled_many(prog_, vars.data(), out.data()) == -2) throw std::bad_alloc();
+                return out;
+            }
+
+            /**
+             * @brief Returns the number of outputs.
+             */
+            size_t outputs() const { return fossil_math_sym_compiled_outputs(prog_); }
+
+            /**
+             * @brief Encodes the program as a portable byte string.
+             */
+            std::vector<unsigned char> serialize() const {
+                std::vector<unsigned char> bytes(fossil_math_sym_compiled_serialize(prog_, nullptr, 0));
+                fossil_math_sym_compiled_serialize(prog_, bytes.data(), bytes.size());
+                return bytes;
+            }
+
+            /**
+             * @brief Decodes a program written by serialize().
+             * @throws std::invalid_argument if the data is malformed.
+             */
+            static SymCompiled deserialize(const std::vector<unsigned char>& bytes) {
+                fossil_math_sym_compiled_t* prog = fossil_math_sym_compiled_deserialize(bytes.data(), bytes.size());
+                if (!prog) throw std::invalid_argument("malformed compiled expression");
+                return SymCompiled(prog);
+            }
+
+            /**
+             * @brief Evaluates the program over columns of variable values.
+             * @param columns One column per compiled variable, all of equal length.
+             * @return One result per row.
+             * @throws std::invalid_argument if the columns do not match the program.
+             */
+            std::vector<double> eval_batch(const std::vector<std::vector<double>>& columns) const {
+                if (columns.size() != fossil_math_sym_compiled_vars(prog_))
+                    throw std::invalid_argument("wrong number of variables");
+                size_t n = columns.empty() ? 0 : columns[0].size();
+                std::vector<const double*> ptrs;
+                for (const std::vector<double>& c : columns) {
+                    if (c.size() != n) throw std::invalid_argument("columns differ in length");
+                    ptrs.push_back(c.data());
+                }
+                std::vector<double> out(n);
+                if (fossil_math_sym_eval_batch(prog_, ptrs.data(), out.data(), n) == -2) throw std::bad_alloc();
+                return out;
+            }
+
+            /**
+             * @brief Bounds the first output over a box.
+             * @param vars Variable ranges, one per compiled variable.
+             * @throws std::invalid_argument if vars has the wrong size.
+             */
+            fossil_math_sym_interval_t eval_interval(const std::vector<fossil_math_sym_interval_t>& vars) const {
+                if (vars.size() != fossil_math_sym_compiled_vars(prog_))
+                    throw std::invalid_argument("wrong number of variables");
+                std::vector<fossil_math_sym_interval_t> out(outputs());
+                if (fossil_math_sym_eval_compiled_interval_many(prog_, vars.data(), out.data()) == -2) throw std::bad_alloc();
+                return out[0];
+            }
+
+            /**
+             * @brief Bounds the first output over columns of variable ranges.
+             * @param columns One column per compiled variable, all of equal length.
+             * @return One enclosure per row.
+             * @throws std::invalid_argument if the columns do not match the program.
+             */
+            std::vector<fossil_math_sym_interval_t> eval_batch_interval(const std::vector<std::vector<fossil_math_sym_interval_t>>& columns) const {
+                if (columns.size() != fossil_math_sym_compiled_vars(prog_))
+                    throw std::invalid_argument("wrong number of variables");
+                size_t n = columns.empty() ? 0 : columns[0].size();
+                std::vector<const fossil_math_sym_interval_t*> ptrs;
+                for (const std::vector<fossil_math_sym_interval_t>& c : columns) {
+                    if (c.size() != n) throw std::invalid_argument("columns differ in length");
+                    ptrs.push_back(c.data());
+                }
+                std::vector<fossil_math_sym_interval_t> out(n);
+                if (fossil_math_sym_eval_batch_interval(prog_, ptrs.data(), out.data(), n) == -2) throw std::bad_alloc();
+                return out;
+            }
+
+            /**
+             * @brief Returns the underlying C program.
+             */
+            const fossil_math_sym_compiled_t* get() const { return prog_; }
+
+        private:
+            fossil_math_sym_compiled_t* prog_;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for a hash-consed expression graph.
+         *
+         * Node handles are plain fossil_math_sym_node_t values valid for the
+         * lifetime of the graph. Instances are movable but not copyable.
+         */
+        class SymGraph {
+        public:
+            /**
+             * @brief Creates an empty graph.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            SymGraph() : g_(fossil_math_sym_graph_create()) {
+                if (!g_) throw std::bad_alloc();
+            }
+
+            ~SymGraph() { fossil_math_sym_graph_free(g_); }
+            SymGraph(const SymGraph&) = delete;
+            SymGraph& operator=(const SymGraph&) = delete;
+            SymGraph(SymGraph&& other) noexcept : g_(other.g_) { other.g_ = nullptr; }
+            SymGraph& operator=(SymGraph&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_sym_graph_free(g_);
+                    g_ = other.g_;
+                    other.g_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Returns the constant node with the given value.
+             */
+            fossil_math_sym_node_t constant(double value) { return fossil_math_sym_graph_const(g_, value); }
+
+            /**
+             * @brief Returns the variable node with the given name.
+             */
+            fossil_math_sym_node_t var(const std::string& name) { return fossil_math_sym_graph_var(g_, name.c_str()); }
+
+            /**
+             * @brief Returns the operator node a op b.
+             */
+            fossil_math_sym_node_t op(char op, fossil_math_sym_node_t a, fossil_math_sym_node_t b) {
+                return fossil_math_sym_graph_op(g_, op, a, b);
+            }
+
+            /**
+             * @brief Interns an expression tree.
+             */
+            fossil_math_sym_node_t intern(const fossil_math_sym_expr_t* expr) { return fossil_math_sym_graph_import(g_, expr); }
+
+            /**
+             * @brief Parses text into the graph.
+             * @throws std::invalid_argument with the error and its offset if text is malformed.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            fossil_math_sym_node_t parse(const std::string& text) {
+                fossil_math_sym_parse_error_t err;
+                fossil_math_sym_node_t node = fossil_math_sym_graph_parse(g_, text.data(), text.size(), &err);
+                if (err.status == FOSSIL_MATH_SYM_PARSE_NO_MEMORY) throw std::bad_alloc();
+                if (err.status != FOSSIL_MATH_SYM_PARSE_OK) {
+                    throw std::invalid_argument(std::string(fossil_math_sym_parse_message(err.status)) +
+                                                " at offset " + std::to_string(err.offset));
+                }
+                return node;
+            }
+
+            /**
+             * @brief Returns the memoized simplification of node.
+             */
+            fossil_math_sym_node_t simplify(fossil_math_sym_node_t node) { return fossil_math_sym_graph_simplify(g_, node); }
+
+            /**
+             * @brief Returns the memoized derivative of node with respect to var.
+             */
+            fossil_math_sym_node_t diff(fossil_math_sym_node_t node, const std::string& var) {
+                return fossil_math_sym_graph_diff(g_, node, var.c_str());
+            }
+
+            /**
+             * @brief Replaces vars[i] with values[i] simultaneously, sharing untouched subgraphs.
+             * @throws std::invalid_argument if vars and values differ in size.
+             */
+            fossil_math_sym_node_t substitute(fossil_math_sym_node_t node, const std::vector<std::string>& vars,
+                                              const std::vector<fossil_math_sym_node_t>& values) {
+                if (vars.size() != values.size()) throw std::invalid_argument("wrong number of values");
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return fossil_math_sym_graph_substitute(g_, node, names.data(), values.data(), names.size());
+            }
+
+            /**
+             * @brief Evaluates node with vars[i] bound to values[i].
+             * @throws std::invalid_argument if vars and values differ in size.
+             */
+            double eval(fossil_math_sym_node_t node, const std::vector<std::string>& vars, const std::vector<double>& values) const {
+                if (vars.size() != values.size()) throw std::invalid_argument("wrong number of values");
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return fossil_math_sym_graph_eval(g_, node, names.data(), values.data(), names.size());
+            }
+
+            /**
+             * @brief Returns the partial derivatives of node with respect to vars.
+             * @throws std::invalid_argument if node is invalid.
+             * @throws std::bad_alloc if the gradient cannot be built.
+             */
+            std::vector<fossil_math_sym_node_t> gradient(fossil_math_sym_node_t node, const std::vector<std::string>& vars) {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                std::vector<fossil_math_sym_node_t> grad(vars.size());
+                int status = fossil_math_sym_graph_gradient(g_, node, names.data(), names.size(), grad.data());
+                if (status == -1) throw std::invalid_argument("invalid node");
+                if (status != 0) throw std::bad_alloc();
+                return grad;
+            }
+
+            /**
+             * @brief Compiles nodes into one program with an output per node.
+             * @throws std::invalid_argument if the nodes cannot be compiled.
+             */
+            SymCompiled compile(const std::vector<fossil_math_sym_node_t>& nodes, const std::vector<std::string>& vars) const {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return SymCompiled(fossil_math_sym_graph_compile_many(g_, nodes.data(), nodes.size(), names.data(), names.size()));
+            }
+
+            /**
+             * @brief Compiles node with variables read in the order of vars.
+             * @throws std::invalid_argument if the node cannot be compiled.
+             */
+            SymCompiled compile(fossil_math_sym_node_t node, const std::vector<std::string>& vars) const {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                return SymCompiled(fossil_math_sym_graph_compile(g_, node, names.data(), names.size()));
+            }
+
+            /**
+             * @brief Encodes the subgraph reachable from node.
+             * @throws std::bad_alloc if the node cannot be encoded.
+             */
+            std::vector<unsigned char> serialize(fossil_math_sym_node_t node) const {
+                size_t size = fossil_math_sym_graph_serialize(g_, node, nullptr, 0);
+                if (size == 0) throw std::bad_alloc();
+                std::vector<unsigned char> bytes(size);
+                fossil_math_sym_graph_serialize(g_, node, bytes.data(), bytes.size());
+                return bytes;
+            }
+
+            /**
+             * @brief Interns an encoded subgraph and returns its root.
+             * @throws std::invalid_argument if the data is malformed.
+             */
+            fossil_math_sym_node_t deserialize(const std::vector<unsigned char>& bytes) {
+                fossil_math_sym_node_t node = fossil_math_sym_graph_deserialize(g_, bytes.data(), bytes.size());
+                if (node == FOSSIL_MATH_SYM_NONE) throw std::invalid_argument("malformed expression graph");
+                return node;
+            }
+
+            /**
+             * @brief Returns the number of distinct nodes in the graph.
+             */
+            size_t size() const { return fossil_math_sym_graph_size(g_); }
+
+            /**
+             * @brief Returns the memory held by the graph in bytes.
+             */
+            size_t bytes() const { return fossil_math_sym_graph_bytes(g_); }
+
+            /**
+             * @brief Returns the number of distinct nodes reachable from node.
+             */
+            size_t count(fossil_math_sym_node_t node) const { return fossil_math_sym_graph_count(g_, node); }
+
+            /**
+             * @brief Returns the underlying C graph.
+             */
+            fossil_math_sym_graph_t* get() const { return g_; }
+
+        private:
+            fossil_math_sym_graph_t* g_;
+        };
+
+        /**
+         * @brief Owning C++ wrapper for a thread-safe cache of compiled formulas.
+         *
+         * Instances are movable but not copyable.
+         */
+        class SymCache {
+        public:
+            /**
+             * @brief Creates a cache bounded to max_bytes (0 = 1 MiB).
+             * @throws std::bad_alloc on allocation failure.
+             */
+            explicit SymCache(size_t max_bytes = 0) : c_(fossil_math_sym_cache_create(max_bytes)) {
+                if (!c_) throw std::bad_alloc();
+            }
+
+            ~SymCache() { fossil_math_sym_cache_free(c_); }
+            SymCache(const SymCache&) = delete;
+            SymCache& operator=(const SymCache&) = delete;
+            SymCache(SymCache&& other) noexcept : c_(other.c_) { other.c_ = nullptr; }
+            SymCache& operator=(SymCache&& other) noexcept {
+                if (this != &other) {
+                    fossil_math_sym_cache_free(c_);
+                    c_ = other.c_;
+                    other.c_ = nullptr;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Returns the compiled program for text, from the cache if possible.
+             * @param flags FOSSIL_MATH_SYM_CACHE_* bits.
+             * @throws std::invalid_argument if the formula cannot be parsed or compiled.
+             * @throws std::bad_alloc on allocation failure.
+             */
+            SymCompiled compile(const std::string& text, const std::vector<std::string>& vars, unsigned flags = 0) {
+                std::vector<const char*> names;
+                for (const std::string& v : vars) names.push_back(v.c_str());
+                fossil_math_sym_parse_error_t err;
+                fossil_math_sym_compiled_t* prog =
+                    fossil_math_sym_cache_compile(c_, text.data(), text.size(), names.data(), names.size(), flags, &err);
+                if (err.status == FOSSIL_MATH_SYM_PARSE_NO_MEMORY) throw std::bad_alloc();
+                if (err.status != FOSSIL_MATH_SYM_PARSE_OK && err.status != FOSSIL_MATH_SYM_PARSE_INVALID) {
+                    throw std::invalid_argument(std::string(fossil_math_sym_parse_message(err.status)) +
+                                                " at offset " + std::to_string(err.offset));
+                }
+                return SymCompiled(prog);
+            }
+
+            /**
+             * @brief Returns the cache counters.
+             */
+            fossil_math_sym_cache_stats_t stats() const {
+                fossil_math_sym_cache_stats_t s;
+                fossil_math_sym_cache_stats(c_, &s);
+                return s;
+            }
+
+            /**
+             * @brief Drops every entry.
+             */
+            void clear() { fossil_math_sym_cache_clear(c_); }
+
+        private:
+            fossil_math_sym_cache_t* c_;
         };
 
     } // namespace math
@@ -0,0 +1,587 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "fossil/math/instrument.h"
+
+#include <stdarg.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <pthread.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+// Counter fields of a kernel
+enum { FOSSIL_MATH_INSTRUMENT_CALLS, FOSSIL_MATH_INSTRUMENT_TICKS, FOSSIL_MATH_INSTRUMENT_BYTES, FOSSIL_MATH_INSTRUMENT_FLOPS, FOSSIL_MATH_INSTRUMENT_FIELDS };
+
+static const char* const fossil_math_instrument_names[FOSSIL_MATH_KERNEL_COUNT] = {
+    "tensor_create",
+    "tensor_add",
+    "tensor_mul",
+    "tensor_dot",
+    "algebra_matrix_mul",
+    "algebra_matrix_inverse",
+    "algebra_lu_decompose",
+    "algebra_solve_linear_system",
+    "calc_integrate_trapezoidal",
+    "calc_integrate_simpson",
+    "calc_integrate_montecarlo",
+    "ode_rk45",
+    "ode_bdf",
+    "ode_solve_batch",
+    "sym_parse",
+    "sym_compile",
+    "sym_eval",
+    "sym_eval_compiled",
+    "sym_eval_batch",
+    "parallel_chunk",
+};
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+static double fossil_math_instrument_wall(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+uint64_t fossil_math_instrument_ticks(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (uint64_t)(fossil_math_instrument_wall() * 1e9);
+#endif
+}
+
+static double fossil_math_instrument_rate = 0.0;
+
+static void fossil_math_instrument_calibrate(void) {
+    double w0 = fossil_math_instrument_wall(), w1;
+    uint64_t t0 = fossil_math_instrument_ticks();
+    do {
+        w1 = fossil_math_instrument_wall();
+    } while (w1 - w0 < 0.01);
+    uint64_t t1 = fossil_math_instrument_ticks();
+    fossil_math_instrument_rate = (double)(t1 - t0) / (w1 - w0);
+}
+
+#if defined(_WIN32)
+static INIT_ONCE fossil_math_instrument_rate_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK fossil_math_instrument_calibrate_once(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once;
+    (void)param;
+    (void)ctx;
+    fossil_math_instrument_calibrate();
+    return TRUE;
+}
+#else
+static pthread_once_t fossil_math_instrument_rate_once = PTHREAD_ONCE_INIT;
+#endif
+
+double fossil_math_instrument_ticks_per_second(void) {
+#if defined(_WIN32)
+    InitOnceExecuteOnce(&fossil_math_instrument_rate_once, fossil_math_instrument_calibrate_once, NULL, NULL);
+#else
+    pthread_once(&fossil_math_instrument_rate_once, fossil_math_instrument_calibrate);
+#endif
+    return fossil_math_instrument_rate;
+}
+
+// ============================================================================
+// Per-Thread Blocks
+// ============================================================================
+//
+// Each thread owns a block of counters and trace events that only it writes,
+// so updates are plain loads and stores with no contention. Blocks are pushed
+// onto a global list once and never freed; when a thread exits its block is
+// released for reuse by the next new thread, so the short-lived workers of
+// fossil_math_parallel_for() do not grow the list without bound. Totals are
+// unaffected by reuse since snapshots only sum blocks.
+//
+// ============================================================================
+
+typedef struct {
+    uint64_t start;
+    uint64_t duration;
+    uint64_t dims[3];
+    uint32_t kernel;
+} fossil_math_trace_event_t;
+
+typedef struct fossil_math_instrument_block {
+#if defined(FOSSIL_MATH_INSTRUMENT)
+    volatile int64_t counters[FOSSIL_MATH_KERNEL_COUNT][FOSSIL_MATH_INSTRUMENT_FIELDS];
+#endif
+    fossil_math_trace_event_t* ring;    // Trace ring buffer (ring_size events)
+    size_t ring_size;
+    volatile int64_t ring_count;        // Events recorded since ring_generation began
+    volatile int64_t ring_generation;   // Trace session the ring belongs to, published last
+    long id;                            // Thread id shown in traces
+    struct fossil_math_instrument_block* volatile next;
+    volatile long in_use;
+} fossil_math_instrument_block_t;
+
+static fossil_math_instrument_block_t* volatile fossil_math_instrument_head = NULL;
+
+// Only the owning thread writes a block, so a load and store suffice; the
+// release store pairs with the acquire load so readers see complete events.
+#if defined(_MSC_VER)
+static int64_t fossil_math_instrument_load(volatile int64_t* p) {
+    return InterlockedCompareExchange64(p, 0, 0);
+}
+
+static void fossil_math_instrument_add(volatile int64_t* p, int64_t v) {
+    InterlockedExchangeAdd64(p, v);
+}
+
+static void fossil_math_instrument_store(volatile int64_t* p, int64_t v) {
+    InterlockedExchange64(p, v);
+}
+
+static int fossil_math_instrument_flag(volatile int* p) {
+    return (int)InterlockedCompareExchange((volatile long*)p, 0, 0);
+}
+
+static void fossil_math_instrument_set_flag(volatile int* p, int v) {
+    InterlockedExchange((volatile long*)p, v);
+}
+
+static int fossil_math_instrument_claim(volatile long* flag) {
+    return InterlockedCompareExchange(flag, 1, 0) == 0;
+}
+
+static void fossil_math_instrument_release(volatile long* flag) {
+    InterlockedExchange(flag, 0);
+}
+
+static int fossil_math_instrument_push(fossil_math_instrument_block_t* block, fossil_math_instrument_block_t* head) {
+    return InterlockedCompareExchangePointer((PVOID volatile*)&fossil_math_instrument_head, block, head) == head;
+}
+#else
+static int64_t fossil_math_instrument_load(volatile int64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void fossil_math_instrument_add(volatile int64_t* p, int64_t v) {
+    __atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + v, __ATOMIC_RELEASE);
+}
+
+static void fossil_math_instrument_store(volatile int64_t* p, int64_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static int fossil_math_instrument_flag(volatile int* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void fossil_math_instrument_set_flag(volatile int* p, int v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static int fossil_math_instrument_claim(volatile long* flag) {
+    long expected = 0;
+    return __atomic_compare_exchange_n(flag, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static void fossil_math_instrument_release(volatile long* flag) {
+    __atomic_store_n(flag, 0, __ATOMIC_RELEASE);
+}
+
+static int fossil_math_instrument_push(fossil_math_instrument_block_t* block, fossil_math_instrument_block_t* head) {
+    return __atomic_compare_exchange_n(&fossil_math_instrument_head, &head, block, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+#endif
+
+static fossil_math_instrument_block_t* fossil_math_instrument_first(void) {
+#if defined(_MSC_VER)
+    return (fossil_math_instrument_block_t*)InterlockedCompareExchangePointer((PVOID volatile*)&fossil_math_instrument_head, NULL, NULL);
+#else
+    return __atomic_load_n(&fossil_math_instrument_head, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// Claims a released block or links a new one
+static fossil_math_instrument_block_t* fossil_math_instrument_acquire(void) {
+    for (fossil_math_instrument_block_t* b = fossil_math_instrument_first(); b; b = b->next) {
+        if (fossil_math_instrument_claim(&b->in_use)) return b;
+    }
+    fossil_math_instrument_block_t* block = calloc(1, sizeof(*block));
+    if (!block) return NULL;
+    block->in_use = 1;
+    fossil_math_instrument_block_t* head;
+    do {
+        head = fossil_math_instrument_first();
+        block->next = head;
+        block->id = head ? head->id + 1 : 1;
+    } while (!fossil_math_instrument_push(block, head));
+    return block;
+}
+
+#if defined(_WIN32)
+static DWORD fossil_math_instrument_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE fossil_math_instrument_key_once = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI fossil_math_instrument_exit(PVOID block) {
+    if (block) fossil_math_instrument_release(&((fossil_math_instrument_block_t*)block)->in_use);
+}
+
+static BOOL CALLBACK fossil_math_instrument_key_init(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once;
+    (void)param;
+    (void)ctx;
+    fossil_math_instrument_key = FlsAlloc(fossil_math_instrument_exit);
+    return TRUE;
+}
+
+static fossil_math_instrument_block_t* fossil_math_instrument_block(void) {
+    InitOnceExecuteOnce(&fossil_math_instrument_key_once, fossil_math_instrument_key_init, NULL, NULL);
+    if (fossil_math_instrument_key == FLS_OUT_OF_INDEXES) return NULL;
+    fossil_math_instrument_block_t* block = (fossil_math_instrument_block_t*)FlsGetValue(fossil_math_instrument_key);
+    if (!block) {
+        block = fossil_math_instrument_acquire();
+        if (block) FlsSetValue(fossil_math_instrument_key, block);
+    }
+    return block;
+}
+#else
+static pthread_key_t fossil_math_instrument_key;
+static int fossil_math_instrument_key_ok = 0;
+static pthread_once_t fossil_math_instrument_key_once = PTHREAD_ONCE_INIT;
+
+static void fossil_math_instrument_exit(void* block) {
+    fossil_math_instrument_release(&((fossil_math_instrument_block_t*)block)->in_use);
+}
+
+static void fossil_math_instrument_key_init(void) {
+    fossil_math_instrument_key_ok = pthread_key_create(&fossil_math_instrument_key, fossil_math_instrument_exit) == 0;
+}
+
+static fossil_math_instrument_block_t* fossil_math_instrument_block(void) {
+    pthread_once(&fossil_math_instrument_key_once, fossil_math_instrument_key_init);
+    if (!fossil_math_instrument_key_ok) return NULL;
+    fossil_math_instrument_block_t* block = (fossil_math_instrument_block_t*)pthread_getspecific(fossil_math_instrument_key);
+    if (!block) {
+        block = fossil_math_instrument_acquire();
+        if (block) pthread_setspecific(fossil_math_instrument_key, block);
+    }
+    return block;
+}
+#endif
+
+// ============================================================================
+// Counters
+// ============================================================================
+
+#if defined(FOSSIL_MATH_INSTRUMENT)
+
+// Totals at the last reset, subtracted from snapshots
+static int64_t fossil_math_instrument_base[FOSSIL_MATH_KERNEL_COUNT][FOSSIL_MATH_INSTRUMENT_FIELDS];
+
+void fossil_math_instrument_record(fossil_math_kernel_t kernel, uint64_t ticks, uint64_t flops) {
+    if ((unsigned)kernel >= FOSSIL_MATH_KERNEL_COUNT) return;
+    fossil_math_instrument_block_t* block = fossil_math_instrument_block();
+    if (!block) return;
+    fossil_math_instrument_add(&block->counters[kernel][FOSSIL_MATH_INSTRUMENT_CALLS], 1);
+    fossil_math_instrument_add(&block->counters[kernel][FOSSIL_MATH_INSTRUMENT_TICKS], (int64_t)ticks);
+    fossil_math_instrument_add(&block->counters[kernel][FOSSIL_MATH_INSTRUMENT_FLOPS], (int64_t)flops);
+}
+
+void fossil_math_instrument_alloc(fossil_math_kernel_t kernel, uint64_t bytes) {
+    if ((unsigned)kernel >= FOSSIL_MATH_KERNEL_COUNT) return;
+    fossil_math_instrument_block_t* block = fossil_math_instrument_block();
+    if (!block) return;
+    fossil_math_instrument_add(&block->counters[kernel][FOSSIL_MATH_INSTRUMENT_BYTES], (int64_t)bytes);
+}
+
+// Sums every block into totals
+static void fossil_math_instrument_totals(int64_t totals[FOSSIL_MATH_KERNEL_COUNT][FOSSIL_MATH_INSTRUMENT_FIELDS]) {
+    memset(totals, 0, sizeof(int64_t) * FOSSIL_MATH_KERNEL_COUNT * FOSSIL_MATH_INSTRUMENT_FIELDS);
+    for (fossil_math_instrument_block_t* b = fossil_math_instrument_first(); b; b = b->next) {
+        for (size_t k = 0; k < FOSSIL_MATH_KERNEL_COUNT; ++k) {
+            for (size_t f = 0; f < FOSSIL_MATH_INSTRUMENT_FIELDS; ++f) totals[k][f] += fossil_math_instrument_load(&b->counters[k][f]);
+        }
+    }
+}
+
+int fossil_math_instrument_enabled(void) {
+    return 1;
+}
+
+void fossil_math_instrument_reset(void) {
+    fossil_math_instrument_totals(fossil_math_instrument_base);
+}
+
+size_t fossil_math_instrument_snapshot(fossil_math_instrument_counter_t* out, size_t max) {
+    int64_t totals[FOSSIL_MATH_KERNEL_COUNT][FOSSIL_MATH_INSTRUMENT_FIELDS];
+    fossil_math_instrument_totals(totals);
+    for (size_t k = 0; k < FOSSIL_MATH_KERNEL_COUNT && out && k < max; ++k) {
+        out[k].name = fossil_math_instrument_names[k];
+        out[k].calls = (uint64_t)(totals[k][FOSSIL_MATH_INSTRUMENT_CALLS] - fossil_math_instrument_base[k][FOSSIL_MATH_INSTRUMENT_CALLS]);
+        out[k].ticks = (uint64_t)(totals[k][FOSSIL_MATH_INSTRUMENT_TICKS] - fossil_math_instrument_base[k][FOSSIL_MATH_INSTRUMENT_TICKS]);
+        out[k].bytes = (uint64_t)(totals[k][FOSSIL_MATH_INSTRUMENT_BYTES] - fossil_math_instrument_base[k][FOSSIL_MATH_INSTRUMENT_BYTES]);
+        out[k].flops = (uint64_t)(totals[k][FOSSIL_MATH_INSTRUMENT_FLOPS] - fossil_math_instrument_base[k][FOSSIL_MATH_INSTRUMENT_FLOPS]);
+    }
+    return FOSSIL_MATH_KERNEL_COUNT;
+}
+
+#else
+
+void fossil_math_instrument_record(fossil_math_kernel_t kernel, uint64_t ticks, uint64_t flops) {
+    (void)kernel;
+    (void)ticks;
+    (void)flops;
+}
+
+void fossil_math_instrument_alloc(fossil_math_kernel_t kernel, uint64_t bytes) {
+    (void)kernel;
+    (void)bytes;
+}
+
+int fossil_math_instrument_enabled(void) {
+    return 0;
+}
+
+void fossil_math_instrument_reset(void) {
+}
+
+size_t fossil_math_instrument_snapshot(fossil_math_instrument_counter_t* out, size_t max) {
+    for (size_t k = 0; k < FOSSIL_MATH_KERNEL_COUNT && out && k < max; ++k) {
+        memset(&out[k], 0, sizeof(out[k]));
+        out[k].name = fossil_math_instrument_names[k];
+    }
+    return FOSSIL_MATH_KERNEL_COUNT;
+}
+
+#endif
+
+// ============================================================================
+// Prometheus Export
+// ============================================================================
+
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t len;
+} fossil_math_instrument_writer_t;
+
+static void fossil_math_instrument_printf(fossil_math_instrument_writer_t* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t room = w->len < w->size ? w->size - w->len : 0;
+    int n = vsnprintf(room ? w->buffer + w->len : NULL, room, fmt, args);
+    va_end(args);
+    if (n > 0) w->len += (size_t)n;
+}
+
+size_t fossil_math_instrument_prometheus(char* buffer, size_t size) {
+    static const struct {
+        const char* name;
+        const char* help;
+    } metrics[] = {
+        {"fossil_math_kernel_calls_total", "Completed calls per kernel."},
+        {"fossil_math_kernel_cycles_total", "Ticks spent in each kernel (TSC cycles on x86)."},
+        {"fossil_math_kernel_seconds_total", "Time spent in each kernel."},
+        {"fossil_math_kernel_bytes_allocated_total", "Bytes allocated by each kernel."},
+        {"fossil_math_kernel_flops_total", "Estimated floating-point operations per kernel."},
+    };
+    fossil_math_instrument_counter_t counters[FOSSIL_MATH_KERNEL_COUNT];
+    fossil_math_instrument_snapshot(counters, FOSSIL_MATH_KERNEL_COUNT);
+    double rate = fossil_math_instrument_enabled() ? fossil_math_instrument_ticks_per_second() : 0.0;
+
+    fossil_math_instrument_writer_t w = {buffer, buffer ? size : 0, 0};
+    for (size_t m = 0; m < sizeof(metrics) / sizeof(metrics[0]); ++m) {
+        fossil_math_instrument_printf(&w, "# HELP %s %s\n# TYPE %s counter\n", metrics[m].name, metrics[m].help, metrics[m].name);
+        for (size_t k = 0; k < FOSSIL_MATH_KERNEL_COUNT; ++k) {
+            const fossil_math_instrument_counter_t* c = &counters[k];
+            fossil_math_instrument_printf(&w, "%s{kernel=\"%s\"} ", metrics[m].name, c->name);
+            switch (m) {
+                case 0: fossil_math_instrument_printf(&w, "%llu\n", (unsigned long long)c->calls); break;
+                case 1: fossil_math_instrument_printf(&w, "%llu\n", (unsigned long long)c->ticks); break;
+                case 2: fossil_math_instrument_printf(&w, "%.9g\n", rate > 0.0 ? (double)c->ticks / rate : 0.0); break;
+                case 3: fossil_math_instrument_printf(&w, "%llu\n", (unsigned long long)c->bytes); break;
+                default: fossil_math_instrument_printf(&w, "%llu\n", (unsigned long long)c->flops); break;
+            }
+        }
+    }
+    if (w.size > 0 && w.len >= w.size) w.buffer[w.size - 1] = '\0';
+    return w.len;
+}
+
+// ============================================================================
+// Tracing
+// ============================================================================
+//
+// Every traced call appends one complete event to its thread's ring buffer.
+// A new session bumps the generation; each thread resets its ring the first
+// time it records under the new generation, so starting a session never
+// touches other threads' blocks. When a ring wraps the oldest events are
+// overwritten and reported as dropped.
+//
+// Session settings are stored before the generation and the generation
+// before the flag, each with release order, so a thread that sees the flag
+// (or a generation) with acquire order also sees the settings behind it.
+// A ring publishes its buffer and reset count before its generation, and
+// each event before the count that includes it; export acquires both.
+// Only export with a wrapped ring still being written can overlap a write.
+//
+// ============================================================================
+
+#define FOSSIL_MATH_TRACE_DEFAULT_EVENTS 65536
+
+volatile int fossil_math_trace_on = 0;
+static volatile int64_t fossil_math_trace_generation = 0;
+static volatile int64_t fossil_math_trace_events = 0;
+static volatile int64_t fossil_math_trace_origin = 0;
+
+int fossil_math_trace_start(size_t events_per_thread) {
+    if (events_per_thread == 0) events_per_thread = FOSSIL_MATH_TRACE_DEFAULT_EVENTS;
+    if (events_per_thread > SIZE_MAX / sizeof(fossil_math_trace_event_t)) return -1;
+    fossil_math_instrument_ticks_per_second();
+    fossil_math_instrument_store(&fossil_math_trace_events, (int64_t)events_per_thread);
+    fossil_math_instrument_store(&fossil_math_trace_origin, (int64_t)fossil_math_instrument_ticks());
+    fossil_math_instrument_store(&fossil_math_trace_generation, fossil_math_instrument_load(&fossil_math_trace_generation) + 1);
+    fossil_math_instrument_set_flag(&fossil_math_trace_on, 1);
+    return 0;
+}
+
+void fossil_math_trace_stop(void) {
+    fossil_math_instrument_set_flag(&fossil_math_trace_on, 0);
+}
+
+int fossil_math_trace_active(void) {
+    return fossil_math_instrument_flag(&fossil_math_trace_on);
+}
+
+void fossil_math_trace_record(fossil_math_kernel_t kernel, uint64_t start, uint64_t d0, uint64_t d1, uint64_t d2) {
+    uint64_t end = fossil_math_instrument_ticks();
+    if ((unsigned)kernel >= FOSSIL_MATH_KERNEL_COUNT) return;
+    fossil_math_instrument_block_t* block = fossil_math_instrument_block();
+    if (!block) return;
+
+    int64_t generation = fossil_math_instrument_load(&fossil_math_trace_generation);
+    if (fossil_math_instrument_load(&block->ring_generation) != generation) {
+        size_t events = (size_t)fossil_math_instrument_load(&fossil_math_trace_events);
+        if (block->ring_size != events) {
+            free(block->ring);
+            block->ring = malloc(events * sizeof(*block->ring));
+            block->ring_size = block->ring ? events : 0;
+        }
+        fossil_math_instrument_store(&block->ring_count, 0);
+        fossil_math_instrument_store(&block->ring_generation, generation);
+    }
+    if (block->ring_size == 0) return;
+
+    int64_t n = fossil_math_instrument_load(&block->ring_count);
+    fossil_math_trace_event_t* e = &block->ring[(size_t)n % block->ring_size];
+    e->start = start;
+    e->duration = end - start;
+    e->dims[0] = d0;
+    e->dims[1] = d1;
+    e->dims[2] = d2;
+    e->kernel = (uint32_t)kernel;
+    fossil_math_instrument_add(&block->ring_count, 1);
+}
+
+// Converts ticks since the session origin to microseconds
+static double fossil_math_trace_micros(uint64_t ticks, double rate) {
+    return rate > 0.0 ? (double)ticks * 1e6 / rate : 0.0;
+}
+
+size_t fossil_math_trace_json(char* buffer, size_t size) {
+    double rate = fossil_math_instrument_ticks_per_second();
+    int64_t generation = fossil_math_instrument_load(&fossil_math_trace_generation);
+    uint64_t origin = (uint64_t)fossil_math_instrument_load(&fossil_math_trace_origin);
+    uint64_t dropped = 0;
+    int first = 1;
+
+    fossil_math_instrument_writer_t w = {buffer, buffer ? size : 0, 0};
+    fossil_math_instrument_printf(&w, "{\"traceEvents\":[");
+    for (fossil_math_instrument_block_t* b = fossil_math_instrument_first(); b && generation > 0; b = b->next) {
+        if (fossil_math_instrument_load(&b->ring_generation) != generation || b->ring_size == 0) continue;
+        uint64_t count = (uint64_t)fossil_math_instrument_load(&b->ring_count);
+        if (count == 0) continue;
+        uint64_t kept = count < b->ring_size ? count : b->ring_size;
+        dropped += count - kept;
+
+        fossil_math_instrument_printf(&w, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"fossil_math %ld\"}}",
+                                      first ? "" : ",", b->id, b->id);
+        first = 0;
+        for (uint64_t i = count - kept; i < count; ++i) {
+            const fossil_math_trace_event_t* e = &b->ring[(size_t)(i % b->ring_size)];
+            const char* name = fossil_math_instrument_names[e->kernel];
+            const char* sep = strchr(name, '_');
+            uint64_t since = e->start > origin ? e->start - origin : 0;
+            fossil_math_instrument_printf(&w, ",\n{\"name\":\"%s\",\"cat\":\"%.*s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%ld,\"args\":{\"dims\":[",
+                                          name, (int)(sep ? (size_t)(sep - name) : strlen(name)), name,
+                                          fossil_math_trace_micros(since, rate), fossil_math_trace_micros(e->duration, rate), b->id);
+            size_t rank = 3;
+            while (rank > 0 && e->dims[rank - 1] == 0) --rank;
+            for (size_t d = 0; d < rank; ++d) fossil_math_instrument_printf(&w, "%s%llu", d ? "," : "", (unsigned long long)e->dims[d]);
+            fossil_math_instrument_printf(&w, "]}}");
+        }
+    }
+    fossil_math_instrument_printf(&w, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":%llu}}\n", (unsigned long long)dropped);
+    if (w.size > 0 && w.len >= w.size) w.buffer[w.size - 1] = '\0';
+    return w.len;
+}
+
+int fossil_math_trace_write(const char* path) {
+    if (!path) return -1;
+    size_t size = fossil_math_trace_json(NULL, 0) + 1;
+    char* text = malloc(size);
+    if (!text) return -2;
+    size_t len = fossil_math_trace_json(text, size);
+    if (len >= size) len = size - 1;
+    FILE* file = fopen(path, "wb");
+    int status = -1;
+    if (file) {
+        status = fwrite(text, 1, len, file) == len ? 0 : -1;
+        if (fclose(file) != 0) status = -1;
+    }
+    free(text);
+    return status;
+}
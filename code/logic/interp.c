@@ -0,0 +1,688 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/interp.h"
+#include "fossil/math/parallel.h"
+#include <math.h>
+#include <float.h>
+
+// Highest supported B-spline degree
+#define FOSSIL_MATH_INTERP_MAX_DEGREE 5
+// Queries located per block by the batch evaluator
+#define FOSSIL_MATH_INTERP_BLOCK 256
+// Grid queries set up per block before their samples are gathered
+#define FOSSIL_MATH_GRID_BLOCK 64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FOSSIL_MATH_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#else
+#define FOSSIL_MATH_PREFETCH(addr) ((void)(addr))
+#endif
+
+struct fossil_math_interp {
+    size_t pieces;   // Number of polynomial pieces
+    size_t order;    // Coefficients per piece (degree + 1)
+    double* breaks;  // pieces + 1 breakpoints
+    double* coef;    // pieces x order, ascending powers of (x - breaks[i])
+    double inv_h;    // 1 / spacing for uniform breakpoints, 0 otherwise
+};
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+static fossil_math_interp_t* fossil_math_interp_alloc(size_t pieces, size_t order) {
+    fossil_math_interp_t* p = malloc(sizeof(*p));
+    if (!p) return NULL;
+    p->pieces = pieces;
+    p->order = order;
+    p->inv_h = 0.0;
+    p->breaks = malloc((pieces + 1) * sizeof(double));
+    p->coef = malloc(pieces * order * sizeof(double));
+    if (!p->breaks || !p->coef) {
+        fossil_math_interp_free(p);
+        return NULL;
+    }
+    return p;
+}
+
+// Enables O(1) lookup when the breakpoints are evenly spaced to rounding
+static void fossil_math_interp_detect_uniform(fossil_math_interp_t* p) {
+    const double* b = p->breaks;
+    size_t m = p->pieces;
+    double h = (b[m] - b[0]) / (double)m;
+    double tol = 1e-12 * (fabs(b[0]) + fabs(b[m]));
+    for (size_t i = 1; i < m; ++i)
+        if (fabs(b[i] - (b[0] + (double)i * h)) > tol) return;
+    p->inv_h = 1.0 / h;
+}
+
+static int fossil_math_interp_check_table(const double* x, const double* y, size_t n, size_t min_n) {
+    if (!x || !y || n < min_n) return -1;
+    for (size_t i = 0; i < n; ++i)
+        if (!isfinite(x[i]) || !isfinite(y[i])) return -1;
+    for (size_t i = 1; i < n; ++i)
+        if (!(x[i] > x[i - 1])) return -1;
+    return 0;
+}
+
+static size_t fossil_math_interp_locate(const fossil_math_interp_t* p, double x) {
+    size_t m = p->pieces;
+    if (p->inv_h > 0.0) {
+        double u = (x - p->breaks[0]) * p->inv_h;
+        if (!(u > 0.0)) return 0;
+        return u >= (double)m ? m - 1 : (size_t)u;
+    }
+    // Last breakpoint among breaks[1..m-1] that is <= x
+    size_t lo = 0, hi = m;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p->breaks[mid] <= x) lo = mid; else hi = mid;
+    }
+    return lo;
+}
+
+// Interval containing x given a previous interval i; only the hint and its right neighbour are tried.
+static size_t fossil_math_interp_locate_hint(const fossil_math_interp_t* p, double x, size_t i) {
+    const double* b = p->breaks;
+    size_t m = p->pieces;
+    if (i < m && (i == 0 || x >= b[i])) {
+        if (i == m - 1 || x < b[i + 1]) return i;
+        if (i + 2 == m || (i + 2 < m && x < b[i + 2])) return i + 1;
+    }
+    return fossil_math_interp_locate(p, x);
+}
+
+static double fossil_math_interp_horner(const double* c, size_t order, double dx) {
+    double v = c[order - 1];
+    for (size_t k = order - 1; k-- > 0;) v = v * dx + c[k];
+    return v;
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+// Second derivatives M of the cubic spline from the tridiagonal system (Thomas algorithm).
+static int fossil_math_interp_spline_moments(const double* x, const double* y, size_t n, int clamped,
+                                             double d0, double dn, double* M) {
+    double* c = malloc(n * sizeof(double));
+    if (!c) return -2;
+    // Row 0
+    double h0 = x[1] - x[0];
+    double s0 = (y[1] - y[0]) / h0;
+    double diag = clamped ? 2.0 * h0 : 1.0;
+    c[0] = (clamped ? h0 : 0.0) / diag;
+    M[0] = (clamped ? 6.0 * (s0 - d0) : 0.0) / diag;
+    for (size_t i = 1; i < n; ++i) {
+        double hl = x[i] - x[i - 1];
+        double sl = (y[i] - y[i - 1]) / hl;
+        double a, b, up, rhs;
+        if (i < n - 1) {
+            double hr = x[i + 1] - x[i];
+            double sr = (y[i + 1] - y[i]) / hr;
+            a = hl; b = 2.0 * (hl + hr); up = hr; rhs = 6.0 * (sr - sl);
+        } else if (clamped) {
+            a = hl; b = 2.0 * hl; up = 0.0; rhs = 6.0 * (dn - sl);
+        } else {
+            a = 0.0; b = 1.0; up = 0.0; rhs = 0.0;
+        }
+        double denom = b - a * c[i - 1];
+        c[i] = up / denom;
+        M[i] = (rhs - a * M[i - 1]) / denom;
+    }
+    for (size_t i = n - 1; i-- > 0;) M[i] -= c[i] * M[i + 1];
+    free(c);
+    return 0;
+}
+
+// PCHIP endpoint slope: three-point formula, limited to preserve shape
+static double fossil_math_interp_pchip_end(double h0, double h1, double s0, double s1) {
+    double d = ((2.0 * h0 + h1) * s0 - h0 * s1) / (h0 + h1);
+    if (d * s0 <= 0.0) return 0.0;
+    if (s0 * s1 <= 0.0 && fabs(d) > 3.0 * fabs(s0)) return 3.0 * s0;
+    return d;
+}
+
+fossil_math_interp_t* fossil_math_interp_create(fossil_math_interp_kind_t kind, const double* x, const double* y,
+                                                size_t n, double d0, double dn) {
+    if (fossil_math_interp_check_table(x, y, n, 2) != 0) return NULL;
+    size_t m = n - 1;
+    size_t order;
+    switch (kind) {
+        case FOSSIL_MATH_INTERP_LINEAR: order = 2; break;
+        case FOSSIL_MATH_INTERP_CUBIC_NATURAL:
+        case FOSSIL_MATH_INTERP_PCHIP: order = 4; break;
+        case FOSSIL_MATH_INTERP_CUBIC_CLAMPED:
+            if (!isfinite(d0) || !isfinite(dn)) return NULL;
+            order = 4;
+            break;
+        default: return NULL;
+    }
+
+    fossil_math_interp_t* p = fossil_math_interp_alloc(m, order);
+    if (!p) return NULL;
+    memcpy(p->breaks, x, n * sizeof(double));
+
+    if (kind == FOSSIL_MATH_INTERP_LINEAR) {
+        for (size_t i = 0; i < m; ++i) {
+            p->coef[2 * i] = y[i];
+            p->coef[2 * i + 1] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+        }
+    } else if (kind == FOSSIL_MATH_INTERP_PCHIP) {
+        // Slopes d[i] are staged in the constant terms, then expanded to Hermite coefficients
+        double* d = malloc(n * sizeof(double));
+        if (!d) {
+            fossil_math_interp_free(p);
+            return NULL;
+        }
+        if (n == 2) {
+            d[0] = d[1] = (y[1] - y[0]) / (x[1] - x[0]);
+        } else {
+            for (size_t k = 1; k < m; ++k) {
+                double hl = x[k] - x[k - 1], hr = x[k + 1] - x[k];
+                double sl = (y[k] - y[k - 1]) / hl, sr = (y[k + 1] - y[k]) / hr;
+                if (sl * sr <= 0.0) {
+                    d[k] = 0.0;
+                } else {
+                    // Weighted harmonic mean (Fritsch-Butland)
+                    double w1 = 2.0 * hr + hl, w2 = hr + 2.0 * hl;
+                    d[k] = (w1 + w2) / (w1 / sl + w2 / sr);
+                }
+            }
+            d[0] = fossil_math_interp_pchip_end(x[1] - x[0], x[2] - x[1],
+                                                (y[1] - y[0]) / (x[1] - x[0]), (y[2] - y[1]) / (x[2] - x[1]));
+            d[m] = fossil_math_interp_pchip_end(x[m] - x[m - 1], x[m - 1] - x[m - 2],
+                                                (y[m] - y[m - 1]) / (x[m] - x[m - 1]),
+                                                (y[m - 1] - y[m - 2]) / (x[m - 1] - x[m - 2]));
+        }
+        for (size_t i = 0; i < m; ++i) {
+            double h = x[i + 1] - x[i];
+            double s = (y[i + 1] - y[i]) / h;
+            double* c = p->coef + 4 * i;
+            c[0] = y[i];
+            c[1] = d[i];
+            c[2] = (3.0 * s - 2.0 * d[i] - d[i + 1]) / h;
+            c[3] = (d[i] + d[i + 1] - 2.0 * s) / (h * h);
+        }
+        free(d);
+    } else {
+        double* M = malloc(n * sizeof(double));
+        if (!M || fossil_math_interp_spline_moments(x, y, n, kind == FOSSIL_MATH_INTERP_CUBIC_CLAMPED,
+                                                    d0, dn, M) != 0) {
+            free(M);
+            fossil_math_interp_free(p);
+            return NULL;
+        }
+        for (size_t i = 0; i < m; ++i) {
+            double h = x[i + 1] - x[i];
+            double* c = p->coef + 4 * i;
+            c[0] = y[i];
+            c[1] = (y[i + 1] - y[i]) / h - h * (2.0 * M[i] + M[i + 1]) / 6.0;
+            c[2] = 0.5 * M[i];
+            c[3] = (M[i + 1] - M[i]) / (6.0 * h);
+        }
+        free(M);
+    }
+
+    fossil_math_interp_detect_uniform(p);
+    return p;
+}
+
+// Values and derivatives of the degree-p B-spline basis functions nonzero on
+// span s at u (The NURBS Book, algorithm A2.3). ders[k][r] is the k-th
+// derivative of N_{s-p+r}.
+static void fossil_math_interp_basis_ders(const double* t, size_t s, double u, int p, int nd,
+                                          double ders[][FOSSIL_MATH_INTERP_MAX_DEGREE + 1]) {
+    double ndu[FOSSIL_MATH_INTERP_MAX_DEGREE + 1][FOSSIL_MATH_INTERP_MAX_DEGREE + 1];
+    double a[2][FOSSIL_MATH_INTERP_MAX_DEGREE + 1];
+    double left[FOSSIL_MATH_INTERP_MAX_DEGREE + 1], right[FOSSIL_MATH_INTERP_MAX_DEGREE + 1];
+
+    ndu[0][0] = 1.0;
+    for (int j = 1; j <= p; ++j) {
+        left[j] = u - t[s + 1 - (size_t)j];
+        right[j] = t[s + (size_t)j] - u;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            ndu[j][r] = right[r + 1] + left[j - r];
+            double temp = ndu[r][j - 1] / ndu[j][r];
+            ndu[r][j] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        ndu[j][j] = saved;
+    }
+    for (int j = 0; j <= p; ++j) ders[0][j] = ndu[j][p];
+
+    for (int r = 0; r <= p; ++r) {
+        int s1 = 0, s2 = 1;
+        a[0][0] = 1.0;
+        for (int k = 1; k <= nd; ++k) {
+            double d = 0.0;
+            int rk = r - k, pk = p - k;
+            if (r >= k) {
+                a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                d = a[s2][0] * ndu[rk][pk];
+            }
+            int j1 = (rk >= -1) ? 1 : -rk;
+            int j2 = (r - 1 <= pk) ? k - 1 : p - r;
+            for (int j = j1; j <= j2; ++j) {
+                a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                d += a[s2][j] * ndu[rk + j][pk];
+            }
+            if (r <= pk) {
+                a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                d += a[s2][k] * ndu[r][pk];
+            }
+            ders[k][r] = d;
+            int tmp = s1; s1 = s2; s2 = tmp;
+        }
+    }
+    double fac = (double)p;
+    for (int k = 1; k <= nd; ++k) {
+        for (int j = 0; j <= p; ++j) ders[k][j] *= fac;
+        fac *= (double)(p - k);
+    }
+}
+
+fossil_math_interp_t* fossil_math_interp_create_bspline(const double* x, const double* y, size_t n, size_t degree) {
+    if (degree < 1 || degree > FOSSIL_MATH_INTERP_MAX_DEGREE) return NULL;
+    if (fossil_math_interp_check_table(x, y, n, degree + 1) != 0) return NULL;
+    size_t k = degree;
+    size_t bw = 2 * k + 1;
+
+    // Knots (n + k + 1), band matrix (n x bw) and right-hand side (n)
+    double* t = malloc((n + k + 1 + n * bw + n) * sizeof(double));
+    if (!t) return NULL;
+    double* A = t + n + k + 1;
+    double* c = A + n * bw;
+
+    // Not-a-knot knot vector
+    for (size_t i = 0; i <= k; ++i) {
+        t[i] = x[0];
+        t[n + i] = x[n - 1];
+    }
+    for (size_t j = 0; j + k + 1 < n; ++j)
+        t[k + 1 + j] = (k % 2) ? x[j + (k + 1) / 2] : 0.5 * (x[j + k / 2] + x[j + k / 2 + 1]);
+
+    // Collocation rows: N_{s-k..s}(x_i) where t[s] <= x_i < t[s+1]
+    memset(A, 0, n * bw * sizeof(double));
+    double ders[FOSSIL_MATH_INTERP_MAX_DEGREE + 1][FOSSIL_MATH_INTERP_MAX_DEGREE + 1];
+    size_t s = k;
+    int ok = 1;
+    for (size_t i = 0; i < n && ok; ++i) {
+        while (s < n - 1 && x[i] >= t[s + 1]) ++s;
+        fossil_math_interp_basis_ders(t, s, x[i], (int)k, 0, ders);
+        for (size_t r = 0; r <= k; ++r) {
+            size_t col = s - k + r;
+            if (col + k < i || col > i + k) { ok = 0; break; }
+            A[i * bw + (col + k - i)] = ders[0][r];
+        }
+        c[i] = y[i];
+    }
+
+    // Banded elimination without pivoting; collocation matrices are totally positive
+    for (size_t j = 0; j < n && ok; ++j) {
+        double piv = A[j * bw + k];
+        if (fabs(piv) < DBL_MIN) { ok = 0; break; }
+        size_t last = FOSSIL_MATH_MIN(n - 1, j + k);
+        for (size_t i = j + 1; i <= last; ++i) {
+            double l = A[i * bw + (j + k - i)] / piv;
+            if (l == 0.0) continue;
+            for (size_t col = j; col <= last; ++col) A[i * bw + (col + k - i)] -= l * A[j * bw + (col + k - j)];
+            c[i] -= l * c[j];
+        }
+    }
+    if (ok) {
+        for (size_t j = n; j-- > 0;) {
+            double acc = c[j];
+            size_t last = FOSSIL_MATH_MIN(n - 1, j + k);
+            for (size_t col = j + 1; col <= last; ++col) acc -= A[j * bw + (col + k - j)] * c[col];
+            c[j] = acc / A[j * bw + k];
+        }
+    }
+    if (!ok) {
+        free(t);
+        return NULL;
+    }
+
+    // Convert to piecewise polynomial form: one piece per nonempty knot span in [x0, x_{n-1}]
+    size_t pieces = 0;
+    for (size_t span = k; span < n; ++span) pieces += t[span] < t[span + 1];
+    fossil_math_interp_t* p = fossil_math_interp_alloc(pieces, k + 1);
+    if (!p) {
+        free(t);
+        return NULL;
+    }
+    size_t piece = 0;
+    for (size_t span = k; span < n; ++span) {
+        if (!(t[span] < t[span + 1])) continue;
+        fossil_math_interp_basis_ders(t, span, t[span], (int)k, (int)k, ders);
+        double* pc = p->coef + piece * (k + 1);
+        double fact = 1.0;
+        for (size_t d = 0; d <= k; ++d) {
+            if (d > 1) fact *= (double)d;
+            double acc = 0.0;
+            for (size_t r = 0; r <= k; ++r) acc += ders[d][r] * c[span - k + r];
+            pc[d] = acc / fact;
+        }
+        p->breaks[piece++] = t[span];
+    }
+    p->breaks[pieces] = x[n - 1];
+    free(t);
+
+    fossil_math_interp_detect_uniform(p);
+    return p;
+}
+
+void fossil_math_interp_free(fossil_math_interp_t* interp) {
+    if (!interp) return;
+    free(interp->breaks);
+    free(interp->coef);
+    free(interp);
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+double fossil_math_interp_eval(const fossil_math_interp_t* interp, double x) {
+    if (!interp) return NAN;
+    size_t i = fossil_math_interp_locate(interp, x);
+    return fossil_math_interp_horner(interp->coef + i * interp->order, interp->order, x - interp->breaks[i]);
+}
+
+double fossil_math_interp_eval_hint(const fossil_math_interp_t* interp, double x, size_t* hint) {
+    if (!interp) return NAN;
+    size_t i = hint ? fossil_math_interp_locate_hint(interp, x, *hint) : fossil_math_interp_locate(interp, x);
+    if (hint) *hint = i;
+    return fossil_math_interp_horner(interp->coef + i * interp->order, interp->order, x - interp->breaks[i]);
+}
+
+double fossil_math_interp_deriv(const fossil_math_interp_t* interp, double x) {
+    if (!interp) return NAN;
+    size_t i = fossil_math_interp_locate(interp, x);
+    const double* c = interp->coef + i * interp->order;
+    double dx = x - interp->breaks[i];
+    double v = 0.0;
+    for (size_t k = interp->order - 1; k >= 1; --k) v = v * dx + (double)k * c[k];
+    return v;
+}
+
+void fossil_math_interp_eval_batch(const fossil_math_interp_t* interp, const double* x, double* y, size_t count) {
+    if (!x || !y) return;
+    if (!interp) {
+        for (size_t j = 0; j < count; ++j) y[j] = NAN;
+        return;
+    }
+    size_t idx[FOSSIL_MATH_INTERP_BLOCK];
+    double dx[FOSSIL_MATH_INTERP_BLOCK];
+    size_t order = interp->order;
+    size_t hint = 0;
+
+    for (size_t lo = 0; lo < count; lo += FOSSIL_MATH_INTERP_BLOCK) {
+        size_t len = FOSSIL_MATH_MIN(count - lo, (size_t)FOSSIL_MATH_INTERP_BLOCK);
+        const double* xb = x + lo;
+        double* yb = y + lo;
+
+        // Pass 1: interval lookup
+        if (interp->inv_h > 0.0) {
+            double x0 = interp->breaks[0], inv_h = interp->inv_h;
+            double top = (double)(interp->pieces - 1);
+            for (size_t j = 0; j < len; ++j) {
+                double u = (xb[j] - x0) * inv_h;
+                u = u > 0.0 ? u : 0.0;
+                u = u < top ? u : top;
+                idx[j] = (size_t)u;
+            }
+        } else {
+            for (size_t j = 0; j < len; ++j) idx[j] = hint = fossil_math_interp_locate_hint(interp, xb[j], hint);
+        }
+        for (size_t j = 0; j < len; ++j) dx[j] = xb[j] - interp->breaks[idx[j]];
+
+        // Pass 2: polynomial evaluation with gathered coefficients
+        const double* cf = interp->coef;
+        if (order == 4) {
+            for (size_t j = 0; j < len; ++j) {
+                const double* c = cf + 4 * idx[j];
+                double t = dx[j];
+                yb[j] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+            }
+        } else if (order == 2) {
+            for (size_t j = 0; j < len; ++j) {
+                const double* c = cf + 2 * idx[j];
+                yb[j] = c[0] + dx[j] * c[1];
+            }
+        } else {
+            for (size_t j = 0; j < len; ++j) yb[j] = fossil_math_interp_horner(cf + order * idx[j], order, dx[j]);
+        }
+    }
+}
+
+// ============================================================================
+// Grid Interpolation
+// ============================================================================
+
+struct fossil_math_grid {
+    const double* data;  // Borrowed tensor samples
+    size_t dims;
+    size_t taps;         // Samples per axis: 2 (linear) or 4 (cubic)
+    fossil_math_grid_boundary_t boundary;
+    size_t shape[FOSSIL_MATH_GRID_MAX_DIMS];
+    size_t stride[FOSSIL_MATH_GRID_MAX_DIMS];
+    double lo[FOSSIL_MATH_GRID_MAX_DIMS];
+    double inv_h[FOSSIL_MATH_GRID_MAX_DIMS];
+};
+
+// Per-axis sample offsets and weights for one query point
+typedef struct {
+    size_t off[FOSSIL_MATH_GRID_MAX_DIMS][4];
+    double w[FOSSIL_MATH_GRID_MAX_DIMS][4];
+} fossil_math_grid_taps_t;
+
+fossil_math_grid_t* fossil_math_grid_create(const fossil_math_tensor_t* table, const double* lo, const double* hi,
+                                            fossil_math_grid_method_t method, fossil_math_grid_boundary_t boundary) {
+    if (!table || !table->data || !table->shape) return NULL;
+    if (table->dims == 0 || table->dims > FOSSIL_MATH_GRID_MAX_DIMS) return NULL;
+    if (method != FOSSIL_MATH_GRID_LINEAR && method != FOSSIL_MATH_GRID_CUBIC) return NULL;
+    if (boundary != FOSSIL_MATH_GRID_CLAMP && boundary != FOSSIL_MATH_GRID_WRAP &&
+        boundary != FOSSIL_MATH_GRID_EXTRAPOLATE) return NULL;
+
+    fossil_math_grid_t* g = malloc(sizeof(*g));
+    if (!g) return NULL;
+    g->data = table->data;
+    g->dims = table->dims;
+    g->taps = method == FOSSIL_MATH_GRID_CUBIC ? 4 : 2;
+    g->boundary = boundary;
+
+    size_t stride = 1;
+    for (size_t d = g->dims; d-- > 0;) {
+        size_t n = table->shape[d];
+        double a = lo ? lo[d] : 0.0;
+        double b = hi ? hi[d] : (double)n - 1.0;
+        if (n < 2 || !isfinite(a) || !isfinite(b) || a == b) {
+            free(g);
+            return NULL;
+        }
+        g->shape[d] = n;
+        g->stride[d] = stride;
+        g->lo[d] = a;
+        g->inv_h[d] = ((double)n - 1.0) / (b - a);
+        stride *= n;
+    }
+    return g;
+}
+
+void fossil_math_grid_free(fossil_math_grid_t* grid) {
+    free(grid);
+}
+
+size_t fossil_math_grid_dims(const fossil_math_grid_t* grid) {
+    return grid ? grid->dims : 0;
+}
+
+// Cell index i and fraction t along one axis for fractional sample position u
+static size_t fossil_math_grid_cell(const fossil_math_grid_t* g, size_t n, double u, double* t) {
+    size_t i;
+    if (g->boundary == FOSSIL_MATH_GRID_WRAP) {
+        u -= (double)n * floor(u / (double)n);
+        i = (u < (double)n) ? (size_t)u : n - 1;
+    } else {
+        if (g->boundary == FOSSIL_MATH_GRID_CLAMP) u = fmin(fmax(u, 0.0), (double)(n - 1));
+        double f = floor(u);
+        i = (f <= 0.0) ? 0 : (f >= (double)(n - 2)) ? n - 2 : (size_t)f;
+    }
+    *t = u - (double)i;
+    return i;
+}
+
+static void fossil_math_grid_setup(const fossil_math_grid_t* g, const double* point, fossil_math_grid_taps_t* tp) {
+    for (size_t d = 0; d < g->dims; ++d) {
+        size_t n = g->shape[d];
+        size_t s = g->stride[d];
+        double u = (point[d] - g->lo[d]) * g->inv_h[d];
+        // NaN coordinates (and infinite ones on periodic axes) yield NaN weights
+        int bad = isnan(u) || (g->boundary == FOSSIL_MATH_GRID_WRAP && isinf(u));
+        if (bad) u = 0.0;
+        double t;
+        size_t i = fossil_math_grid_cell(g, n, u, &t);
+        size_t* off = tp->off[d];
+        double* w = tp->w[d];
+
+        if (g->taps == 2) {
+            off[0] = i * s;
+            off[1] = ((i + 1 < n) ? i + 1 : 0) * s;
+            w[0] = 1.0 - t;
+            w[1] = t;
+            if (bad) w[0] = w[1] = NAN;
+            continue;
+        }
+
+        // Catmull-Rom weights for samples i-1, i, i+1, i+2
+        double t2 = t * t, t3 = t2 * t;
+        w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+        w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+        w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+        w[3] = 0.5 * (t3 - t2);
+        if (bad) w[0] = w[1] = w[2] = w[3] = NAN;
+
+        size_t im1, ip1 = i + 1, ip2 = i + 2;
+        if (g->boundary == FOSSIL_MATH_GRID_WRAP) {
+            im1 = (i == 0) ? n - 1 : i - 1;
+            ip1 %= n;
+            ip2 %= n;
+        } else if (g->boundary == FOSSIL_MATH_GRID_CLAMP) {
+            im1 = (i == 0) ? 0 : i - 1;
+            if (ip2 >= n) ip2 = n - 1;
+        } else {
+            // Linear ghost samples beyond the edges: f(-1) = 2 f(0) - f(1), f(n) = 2 f(n-1) - f(n-2)
+            im1 = (i == 0) ? 0 : i - 1;
+            if (i == 0) {
+                w[1] += 2.0 * w[0];
+                w[2] -= w[0];
+                w[0] = 0.0;
+            }
+            if (ip2 >= n) {
+                ip2 = n - 1;
+                w[2] += 2.0 * w[3];
+                w[1] -= w[3];
+                w[3] = 0.0;
+            }
+        }
+        off[0] = im1 * s;
+        off[1] = i * s;
+        off[2] = ip1 * s;
+        off[3] = ip2 * s;
+    }
+}
+
+// Sums taps^dims weighted samples, walking the corners like an odometer
+static double fossil_math_grid_gather(const fossil_math_grid_t* g, const fossil_math_grid_taps_t* tp) {
+    size_t dims = g->dims, taps = g->taps;
+    size_t digit[FOSSIL_MATH_GRID_MAX_DIMS] = { 0 };
+    // partial_off[d] / partial_w[d] accumulate axes 0..d-1 of the current corner
+    size_t partial_off[FOSSIL_MATH_GRID_MAX_DIMS + 1];
+    double partial_w[FOSSIL_MATH_GRID_MAX_DIMS + 1];
+    partial_off[0] = 0;
+    partial_w[0] = 1.0;
+    for (size_t d = 0; d < dims; ++d) {
+        partial_off[d + 1] = partial_off[d] + tp->off[d][0];
+        partial_w[d + 1] = partial_w[d] * tp->w[d][0];
+    }
+
+    double acc = 0.0;
+    for (;;) {
+        acc += partial_w[dims] * g->data[partial_off[dims]];
+        size_t d = dims;
+        while (d-- > 0 && ++digit[d] == taps) digit[d] = 0;
+        if (d == (size_t)-1) break;
+        for (size_t e = d; e < dims; ++e) {
+            partial_off[e + 1] = partial_off[e] + tp->off[e][digit[e]];
+            partial_w[e + 1] = partial_w[e] * tp->w[e][digit[e]];
+        }
+    }
+    return acc;
+}
+
+double fossil_math_grid_eval(const fossil_math_grid_t* grid, const double* point) {
+    if (!grid || !point) return NAN;
+    fossil_math_grid_taps_t tp;
+    fossil_math_grid_setup(grid, point, &tp);
+    return fossil_math_grid_gather(grid, &tp);
+}
+
+typedef struct {
+    const fossil_math_grid_t* grid;
+    const double* points;
+    double* out;
+} fossil_math_grid_batch_t;
+
+static void fossil_math_grid_batch_range(size_t begin, size_t end, void* ctx) {
+    const fossil_math_grid_batch_t* job = (const fossil_math_grid_batch_t*)ctx;
+    const fossil_math_grid_t* g = job->grid;
+    size_t dims = g->dims;
+    fossil_math_grid_taps_t tp[FOSSIL_MATH_GRID_BLOCK];
+
+    for (size_t lo = begin; lo < end; lo += FOSSIL_MATH_GRID_BLOCK) {
+        size_t len = FOSSIL_MATH_MIN(end - lo, (size_t)FOSSIL_MATH_GRID_BLOCK);
+        // Pass 1: offsets and weights, prefetching each point's first sample row
+        for (size_t j = 0; j < len; ++j) {
+            fossil_math_grid_setup(g, job->points + (lo + j) * dims, &tp[j]);
+            size_t base = 0;
+            for (size_t d = 0; d < dims; ++d) base += tp[j].off[d][0];
+            FOSSIL_MATH_PREFETCH(g->data + base);
+        }
+        // Pass 2: gather and accumulate
+        for (size_t j = 0; j < len; ++j) job->out[lo + j] = fossil_math_grid_gather(g, &tp[j]);
+    }
+}
+
+void fossil_math_grid_eval_batch(const fossil_math_grid_t* grid, const double* points, double* out, size_t count) {
+    if (!points || !out || count == 0) return;
+    if (!grid) {
+        for (size_t j = 0; j < count; ++j) out[j] = NAN;
+        return;
+    }
+    fossil_math_grid_batch_t job = { grid, points, out };
+    fossil_math_parallel_for(count, 16 * FOSSIL_MATH_GRID_BLOCK, fossil_math_grid_batch_range, &job);
+}
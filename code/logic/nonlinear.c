@@ -0,0 +1,530 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/nonlinear.h"
+#include "fossil/math/algebra.h"
+#include <math.h>
+#include <float.h>
+
+// Armijo constant and smallest step fraction tried by the backtracking line search
+#define FOSSIL_MATH_NONLINEAR_ARMIJO    1e-4
+#define FOSSIL_MATH_NONLINEAR_MIN_STEP  1e-10
+// GMRES restart cycles per Newton step
+#define FOSSIL_MATH_NONLINEAR_RESTARTS  5
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+void fossil_math_nonlinear_options_default(fossil_math_nonlinear_options_t* opts) {
+    if (!opts) return;
+    opts->max_iter = 100;
+    opts->tol_f = 1e-10;
+    opts->tol_x = 1e-12;
+    opts->jacobian_reuse = 8;
+    opts->krylov_dim = 30;
+}
+
+static double fossil_math_nonlinear_norm(const double* v, size_t n) {
+    return sqrt(fossil_math_algebra_dot(v, v, n));
+}
+
+static void fossil_math_nonlinear_report(fossil_math_nonlinear_info_t* info, const fossil_math_nonlinear_info_t* s) {
+    if (info) *info = *s;
+}
+
+// Forward-difference Jacobian of f at x (m x n). fx holds f(x); xt and ft are scratch.
+static void fossil_math_nonlinear_fd_jacobian(fossil_math_nonlinear_func_t f, void* ctx,
+                                              const double* x, const double* fx, size_t n, size_t m,
+                                              double* J, double* xt, double* ft, size_t* evals) {
+    memcpy(xt, x, n * sizeof(double));
+    for (size_t j = 0; j < n; ++j) {
+        double h = sqrt(DBL_EPSILON) * FOSSIL_MATH_MAX(fabs(x[j]), 1.0);
+        xt[j] = x[j] + h;
+        h = xt[j] - x[j]; // exactly representable step
+        f(xt, ft, ctx);
+        ++*evals;
+        for (size_t i = 0; i < m; ++i) J[i * n + j] = (ft[i] - fx[i]) / h;
+        xt[j] = x[j];
+    }
+}
+
+// Backtracks from x along d until ||F|| decreases by the Armijo condition.
+// On success xt/ft hold the accepted point and its residual.
+static int fossil_math_nonlinear_line_search(fossil_math_nonlinear_func_t f, void* ctx,
+                                             const double* x, const double* d, double norm_f, size_t n,
+                                             double* xt, double* ft, double* norm_ft, size_t* evals) {
+    for (double t = 1.0; t >= FOSSIL_MATH_NONLINEAR_MIN_STEP; t *= 0.5) {
+        for (size_t i = 0; i < n; ++i) xt[i] = x[i] + t * d[i];
+        f(xt, ft, ctx);
+        ++*evals;
+        double nt = fossil_math_nonlinear_norm(ft, n);
+        if (isfinite(nt) && nt * nt <= (1.0 - 2.0 * FOSSIL_MATH_NONLINEAR_ARMIJO * t) * norm_f * norm_f) {
+            *norm_ft = nt;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// ============================================================================
+// Damped Newton with Broyden updates
+// ============================================================================
+//
+// The inverse Jacobian is represented as H_k = (I + p_{k-1} s_{k-1}^T) ... (I + p_0 s_0^T) J_0^{-1},
+// i.e. the LU factors of the last exact Jacobian plus the stored Broyden pairs.
+// Applying H_k costs one LU solve plus k dot products, so the O(n^3)
+// factorization is amortized over several iterations.
+//
+
+typedef struct {
+    const double* LU;
+    const size_t* piv;
+    const double* P;  // Broyden vectors p_j, one row per update
+    const double* S;  // Broyden steps s_j
+    size_t updates;
+    size_t n;
+} fossil_math_nonlinear_broyden_t;
+
+static void fossil_math_nonlinear_apply_inverse(const fossil_math_nonlinear_broyden_t* B, const double* z, double* w) {
+    fossil_math_algebra_lu_solve(B->LU, B->piv, z, w, B->n);
+    for (size_t j = 0; j < B->updates; ++j) {
+        const double* p = B->P + j * B->n;
+        double c = fossil_math_algebra_dot(B->S + j * B->n, w, B->n);
+        for (size_t i = 0; i < B->n; ++i) w[i] += c * p[i];
+    }
+}
+
+int fossil_math_nonlinear_solve(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                double* x, size_t n, const fossil_math_nonlinear_options_t* opts,
+                                fossil_math_nonlinear_info_t* info) {
+    fossil_math_nonlinear_info_t st = { 0, 0, 0, 0, NAN, 0 };
+    fossil_math_nonlinear_report(info, &st);
+    if (!f || !x || n == 0) return -1;
+
+    fossil_math_nonlinear_options_t o;
+    if (opts) o = *opts; else fossil_math_nonlinear_options_default(&o);
+    size_t reuse = o.jacobian_reuse;
+
+    // Workspace: F, Ft, xt, d, Hy, LU (n x n), Broyden pairs (2 * reuse * n), pivots
+    size_t doubles = 5 * n + n * n + 2 * reuse * n;
+    double* work = malloc(doubles * sizeof(double));
+    size_t* piv = malloc(n * sizeof(size_t));
+    if (!work || !piv) {
+        free(work);
+        free(piv);
+        return -2;
+    }
+    double* F = work;
+    double* Ft = F + n;
+    double* xt = Ft + n;
+    double* d = xt + n;
+    double* Hy = d + n;
+    double* LU = Hy + n;
+    double* P = LU + n * n;
+    double* S = P + reuse * n;
+
+    fossil_math_nonlinear_broyden_t B = { LU, piv, P, S, 0, n };
+    int status = -4;
+    int need_jac = 1;
+
+    f(x, F, ctx);
+    st.evaluations = 1;
+    double norm_f = fossil_math_nonlinear_norm(F, n);
+
+    while (status == -4) {
+        if (norm_f <= o.tol_f) { status = 0; break; }
+        if (st.iterations >= o.max_iter) break;
+
+        if (need_jac) {
+            if (jac) jac(x, LU, ctx);
+            else fossil_math_nonlinear_fd_jacobian(f, ctx, x, F, n, n, LU, xt, Ft, &st.evaluations);
+            ++st.jacobian_evaluations;
+            ++st.factorizations;
+            if (fossil_math_algebra_lu_decompose(LU, n, piv) != 0) { status = -3; break; }
+            B.updates = 0;
+            need_jac = 0;
+        }
+
+        // Newton direction d = -H F
+        fossil_math_nonlinear_apply_inverse(&B, F, d);
+        for (size_t i = 0; i < n; ++i) d[i] = -d[i];
+
+        double norm_ft;
+        if (fossil_math_nonlinear_line_search(f, ctx, x, d, norm_f, n, xt, Ft, &norm_ft, &st.evaluations) != 0) {
+            // A stale quasi-Newton direction may not descend; retry with an exact Jacobian
+            if (B.updates > 0) { need_jac = 1; continue; }
+            break;
+        }
+        ++st.iterations;
+
+        // s = xt - x and y = Ft - F, stored in d and Hy before x and F move
+        double step = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            d[i] = xt[i] - x[i];
+            Hy[i] = Ft[i] - F[i];
+            step += d[i] * d[i];
+        }
+        memcpy(x, xt, n * sizeof(double));
+        memcpy(F, Ft, n * sizeof(double));
+        norm_f = norm_ft;
+
+        if (norm_f <= o.tol_f) { status = 0; break; }
+        if (sqrt(step) <= o.tol_x * (1.0 + fossil_math_nonlinear_norm(x, n))) { status = 0; break; }
+
+        // Broyden update: p = (s - H y) / (s^T H y)
+        if (B.updates < reuse) {
+            double* p = P + B.updates * n;
+            fossil_math_nonlinear_apply_inverse(&B, Hy, p);
+            double denom = fossil_math_algebra_dot(d, p, n);
+            if (fabs(denom) > DBL_EPSILON * step) {
+                for (size_t i = 0; i < n; ++i) p[i] = (d[i] - p[i]) / denom;
+                memcpy(S + B.updates * n, d, n * sizeof(double));
+                ++B.updates;
+            } else {
+                need_jac = 1;
+            }
+        } else {
+            need_jac = 1;
+        }
+    }
+
+    st.residual_norm = norm_f;
+    st.converged = status == 0;
+    fossil_math_nonlinear_report(info, &st);
+    free(work);
+    free(piv);
+    return status;
+}
+
+// ============================================================================
+// Jacobian-free Newton-Krylov
+// ============================================================================
+
+typedef struct {
+    fossil_math_nonlinear_func_t f;
+    void* ctx;
+    const double* x;
+    const double* F;
+    double* xt;
+    double* Ft;
+    size_t n;
+    size_t* evals;
+} fossil_math_nonlinear_jv_t;
+
+// J v ~ (F(x + eps v) - F(x)) / eps
+static void fossil_math_nonlinear_jv(const fossil_math_nonlinear_jv_t* s, const double* v, double* out) {
+    double nv = fossil_math_nonlinear_norm(v, s->n);
+    if (nv == 0.0) {
+        memset(out, 0, s->n * sizeof(double));
+        return;
+    }
+    double eps = sqrt(DBL_EPSILON) * (1.0 + fossil_math_nonlinear_norm(s->x, s->n)) / nv;
+    for (size_t i = 0; i < s->n; ++i) s->xt[i] = s->x[i] + eps * v[i];
+    s->f(s->xt, s->Ft, s->ctx);
+    ++*s->evals;
+    for (size_t i = 0; i < s->n; ++i) out[i] = (s->Ft[i] - s->F[i]) / eps;
+}
+
+// Restarted GMRES for J d = -F with relative tolerance eta. V is (k+1) x n,
+// H is (k+1) x k, and cs/sn/g hold the Givens rotations and rotated residual.
+static void fossil_math_nonlinear_gmres(const fossil_math_nonlinear_jv_t* s, double* d, double eta, size_t k,
+                                        double* V, double* H, double* cs, double* sn, double* g, double* w) {
+    size_t n = s->n;
+    memset(d, 0, n * sizeof(double));
+    double target = eta * fossil_math_nonlinear_norm(s->F, n);
+
+    for (size_t cycle = 0; cycle < FOSSIL_MATH_NONLINEAR_RESTARTS; ++cycle) {
+        // r = -F - J d
+        fossil_math_nonlinear_jv(s, d, w);
+        for (size_t i = 0; i < n; ++i) w[i] = -s->F[i] - w[i];
+        double beta = fossil_math_nonlinear_norm(w, n);
+        if (beta <= target || beta == 0.0) return;
+
+        for (size_t i = 0; i < n; ++i) V[i] = w[i] / beta;
+        memset(g, 0, (k + 1) * sizeof(double));
+        g[0] = beta;
+
+        size_t used = 0;
+        for (size_t j = 0; j < k; ++j) {
+            fossil_math_nonlinear_jv(s, V + j * n, w);
+
+            // Modified Gram-Schmidt against the existing basis
+            for (size_t i = 0; i <= j; ++i) {
+                double h = fossil_math_algebra_dot(w, V + i * n, n);
+                H[i * k + j] = h;
+                for (size_t l = 0; l < n; ++l) w[l] -= h * V[i * n + l];
+            }
+            double hn = fossil_math_nonlinear_norm(w, n);
+            H[(j + 1) * k + j] = hn;
+
+            // Apply previous rotations, then zero the subdiagonal entry
+            for (size_t i = 0; i < j; ++i) {
+                double a = H[i * k + j], b = H[(i + 1) * k + j];
+                H[i * k + j] = cs[i] * a + sn[i] * b;
+                H[(i + 1) * k + j] = -sn[i] * a + cs[i] * b;
+            }
+            double a = H[j * k + j];
+            double r = hypot(a, hn);
+            cs[j] = (r == 0.0) ? 1.0 : a / r;
+            sn[j] = (r == 0.0) ? 0.0 : hn / r;
+            H[j * k + j] = r;
+            H[(j + 1) * k + j] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            used = j + 1;
+            if (fabs(g[j + 1]) <= target || hn == 0.0) break;
+            for (size_t l = 0; l < n; ++l) V[(j + 1) * n + l] = w[l] / hn;
+        }
+
+        // Solve the triangular system H y = g (y overwrites g) and update d
+        for (size_t i = used; i-- > 0;) {
+            double sum = g[i];
+            for (size_t l = i + 1; l < used; ++l) sum -= H[i * k + l] * g[l];
+            g[i] = (H[i * k + i] != 0.0) ? sum / H[i * k + i] : 0.0;
+        }
+        for (size_t i = 0; i < used; ++i)
+            for (size_t l = 0; l < n; ++l) d[l] += g[i] * V[i * n + l];
+    }
+}
+
+int fossil_math_nonlinear_solve_krylov(fossil_math_nonlinear_func_t f, void* ctx,
+                                       double* x, size_t n, const fossil_math_nonlinear_options_t* opts,
+                                       fossil_math_nonlinear_info_t* info) {
+    fossil_math_nonlinear_info_t st = { 0, 0, 0, 0, NAN, 0 };
+    fossil_math_nonlinear_report(info, &st);
+    if (!f || !x || n == 0) return -1;
+
+    fossil_math_nonlinear_options_t o;
+    if (opts) o = *opts; else fossil_math_nonlinear_options_default(&o);
+    size_t k = FOSSIL_MATH_CLAMP(o.krylov_dim, (size_t)1, n);
+
+    // Workspace: F, Ft, xt, xs, Fs, d, w, V ((k+1) x n), H ((k+1) x k), cs, sn, g
+    size_t doubles = 7 * n + (k + 1) * n + (k + 1) * k + 2 * k + (k + 1);
+    double* work = malloc(doubles * sizeof(double));
+    if (!work) return -2;
+    double* F = work;
+    double* Ft = F + n;
+    double* xt = Ft + n;
+    double* xs = xt + n;
+    double* Fs = xs + n;
+    double* d = Fs + n;
+    double* w = d + n;
+    double* V = w + n;
+    double* H = V + (k + 1) * n;
+    double* cs = H + (k + 1) * k;
+    double* sn = cs + k;
+    double* g = sn + k;
+
+    int status = -4;
+    f(x, F, ctx);
+    st.evaluations = 1;
+    double norm_f = fossil_math_nonlinear_norm(F, n);
+
+    while (st.iterations < o.max_iter) {
+        if (norm_f <= o.tol_f) { status = 0; break; }
+
+        // Inexact Newton: solve more accurately as the residual shrinks
+        double eta = FOSSIL_MATH_MIN(0.5, sqrt(norm_f));
+        fossil_math_nonlinear_jv_t jv = { f, ctx, x, F, xs, Fs, n, &st.evaluations };
+        fossil_math_nonlinear_gmres(&jv, d, eta, k, V, H, cs, sn, g, w);
+
+        double norm_ft;
+        if (fossil_math_nonlinear_line_search(f, ctx, x, d, norm_f, n, xt, Ft, &norm_ft, &st.evaluations) != 0)
+            break;
+        ++st.iterations;
+
+        double step = 0.0;
+        for (size_t i = 0; i < n; ++i) step += (xt[i] - x[i]) * (xt[i] - x[i]);
+        memcpy(x, xt, n * sizeof(double));
+        memcpy(F, Ft, n * sizeof(double));
+        norm_f = norm_ft;
+
+        if (norm_f <= o.tol_f) { status = 0; break; }
+        if (sqrt(step) <= o.tol_x * (1.0 + fossil_math_nonlinear_norm(x, n))) { status = 0; break; }
+    }
+
+    st.residual_norm = norm_f;
+    st.converged = status == 0;
+    fossil_math_nonlinear_report(info, &st);
+    free(work);
+    return status;
+}
+
+// ============================================================================
+// Levenberg-Marquardt
+// ============================================================================
+
+// A = J^T J and g = J^T r for an m x n Jacobian
+static void fossil_math_nonlinear_normal_equations(const double* J, const double* r, size_t n, size_t m,
+                                                   double* A, double* g) {
+    memset(A, 0, n * n * sizeof(double));
+    memset(g, 0, n * sizeof(double));
+    for (size_t i = 0; i < m; ++i) {
+        const double* row = J + i * n;
+        for (size_t a = 0; a < n; ++a) {
+            double ja = row[a];
+            if (ja == 0.0) continue;
+            g[a] += ja * r[i];
+            for (size_t b = a; b < n; ++b) A[a * n + b] += ja * row[b];
+        }
+    }
+    for (size_t a = 0; a < n; ++a)
+        for (size_t b = 0; b < a; ++b) A[a * n + b] = A[b * n + a];
+}
+
+static double fossil_math_nonlinear_norm_inf(const double* v, size_t n) {
+    double m = 0.0;
+    for (size_t i = 0; i < n; ++i) m = FOSSIL_MATH_MAX(m, fabs(v[i]));
+    return m;
+}
+
+int fossil_math_nonlinear_least_squares(fossil_math_nonlinear_func_t f, fossil_math_nonlinear_jac_t jac, void* ctx,
+                                        double* x, size_t n, size_t m,
+                                        const fossil_math_nonlinear_options_t* opts,
+                                        fossil_math_nonlinear_info_t* info) {
+    fossil_math_nonlinear_info_t st = { 0, 0, 0, 0, NAN, 0 };
+    fossil_math_nonlinear_report(info, &st);
+    if (!f || !x || n == 0 || m < n) return -1;
+
+    fossil_math_nonlinear_options_t o;
+    if (opts) o = *opts; else fossil_math_nonlinear_options_default(&o);
+
+    // Workspace: r, rt, Jd (m each), xt, g, d, diag (n each), J (m x n), A and M (n x n)
+    size_t doubles = 3 * m + 4 * n + m * n + 2 * n * n;
+    double* work = malloc(doubles * sizeof(double));
+    size_t* piv = malloc(n * sizeof(size_t));
+    if (!work || !piv) {
+        free(work);
+        free(piv);
+        return -2;
+    }
+    double* r = work;
+    double* rt = r + m;
+    double* Jd = rt + m;
+    double* xt = Jd + m;
+    double* g = xt + n;
+    double* d = g + n;
+    double* diag = d + n;
+    double* J = diag + n;
+    double* A = J + m * n;
+    double* M = A + n * n;
+
+    int status = -4;
+    f(x, r, ctx);
+    st.evaluations = 1;
+    double cost = fossil_math_algebra_dot(r, r, m);
+
+    size_t updates = 0;
+    int exact = 1;
+    if (jac) jac(x, J, ctx);
+    else fossil_math_nonlinear_fd_jacobian(f, ctx, x, r, n, m, J, xt, rt, &st.evaluations);
+    st.jacobian_evaluations = 1;
+    fossil_math_nonlinear_normal_equations(J, r, n, m, A, g);
+
+    double lambda = 0.0;
+    for (size_t a = 0; a < n; ++a) lambda = FOSSIL_MATH_MAX(lambda, A[a * n + a]);
+    lambda = 1e-3 * (lambda > 0.0 ? lambda : 1.0);
+    double nu = 2.0;
+
+    while (st.iterations < o.max_iter) {
+        if (fossil_math_nonlinear_norm_inf(g, n) <= o.tol_f) { status = 0; break; }
+        ++st.iterations;
+
+        // (A + lambda * D) d = -g with D = diag(A), floored to keep it positive definite
+        memcpy(M, A, n * n * sizeof(double));
+        for (size_t a = 0; a < n; ++a) {
+            diag[a] = FOSSIL_MATH_MAX(A[a * n + a], 1e-12);
+            M[a * n + a] += lambda * diag[a];
+            d[a] = -g[a];
+        }
+        ++st.factorizations;
+        if (fossil_math_algebra_lu_decompose(M, n, piv) != 0) { status = -3; break; }
+        fossil_math_algebra_lu_solve(M, piv, d, d, n);
+
+        double norm_d = fossil_math_nonlinear_norm(d, n);
+        double norm_x = fossil_math_nonlinear_norm(x, n);
+        if (norm_d <= o.tol_x * (norm_x + o.tol_x)) { status = 0; break; }
+
+        for (size_t a = 0; a < n; ++a) xt[a] = x[a] + d[a];
+        f(xt, rt, ctx);
+        ++st.evaluations;
+        double cost_t = fossil_math_algebra_dot(rt, rt, m);
+
+        // Gain ratio: actual over predicted reduction of 0.5 * ||r||^2
+        double predicted = 0.0;
+        for (size_t a = 0; a < n; ++a) predicted += d[a] * (lambda * diag[a] * d[a] - g[a]);
+        double rho = (isfinite(cost_t) && predicted > 0.0) ? (cost - cost_t) / predicted : -1.0;
+
+        if (rho > 0.0) {
+            int broyden = updates < o.jacobian_reuse;
+            if (broyden) {
+                // Broyden rank-one update: J += ((rt - r - J d) d^T) / (d^T d)
+                double dd = norm_d * norm_d;
+                for (size_t i = 0; i < m; ++i)
+                    Jd[i] = (rt[i] - r[i] - fossil_math_algebra_dot(J + i * n, d, n)) / dd;
+                for (size_t i = 0; i < m; ++i)
+                    for (size_t a = 0; a < n; ++a) J[i * n + a] += Jd[i] * d[a];
+                ++updates;
+                exact = 0;
+            }
+            memcpy(x, xt, n * sizeof(double));
+            memcpy(r, rt, m * sizeof(double));
+            cost = cost_t;
+
+            if (!broyden) {
+                if (jac) jac(x, J, ctx);
+                else fossil_math_nonlinear_fd_jacobian(f, ctx, x, r, n, m, J, xt, rt, &st.evaluations);
+                ++st.jacobian_evaluations;
+                updates = 0;
+                exact = 1;
+            }
+            fossil_math_nonlinear_normal_equations(J, r, n, m, A, g);
+
+            double t = 2.0 * rho - 1.0;
+            lambda *= FOSSIL_MATH_MAX(1.0 / 3.0, 1.0 - t * t * t);
+            nu = 2.0;
+        } else {
+            lambda *= nu;
+            nu *= 2.0;
+            if (!exact) {
+                // The rejection may be the approximation's fault: refresh the Jacobian
+                if (jac) jac(x, J, ctx);
+                else fossil_math_nonlinear_fd_jacobian(f, ctx, x, r, n, m, J, xt, rt, &st.evaluations);
+                ++st.jacobian_evaluations;
+                updates = 0;
+                exact = 1;
+                fossil_math_nonlinear_normal_equations(J, r, n, m, A, g);
+            }
+        }
+    }
+
+    st.residual_norm = sqrt(cost);
+    st.converged = status == 0;
+    fossil_math_nonlinear_report(info, &st);
+    free(work);
+    free(piv);
+    return status;
+}
@@ -0,0 +1,739 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/ode.h"
+#include "fossil/math/algebra.h"
+#include "fossil/math/parallel.h"
+#include "fossil/math/instrument.h"
+#include <math.h>
+#include <float.h>
+
+// Step-size controller limits shared by both integrators
+#define FOSSIL_MATH_ODE_SAFETY      0.9
+#define FOSSIL_MATH_ODE_MIN_FACTOR  0.2
+#define FOSSIL_MATH_ODE_MAX_FACTOR  10.0
+// BDF: highest order and Newton iterations allowed per step
+#define FOSSIL_MATH_ODE_BDF_ORDER   5
+#define FOSSIL_MATH_ODE_NEWTON_MAX  4
+// Systems per work item in batched integration
+#define FOSSIL_MATH_ODE_BATCH_GRAIN 16
+
+typedef struct {
+    fossil_math_ode_func_t f;
+    fossil_math_ode_jac_t jac;
+    void* ctx;
+    size_t n;
+    fossil_math_ode_options_t o;
+    fossil_math_ode_info_t* st;
+} fossil_math_ode_problem_t;
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+void fossil_math_ode_options_default(fossil_math_ode_options_t* opts) {
+    if (!opts) return;
+    opts->rtol = 1e-6;
+    opts->atol = 1e-9;
+    opts->h0 = 0.0;
+    opts->h_max = 0.0;
+    opts->max_steps = 100000;
+}
+
+// RMS norm of v / (atol + rtol * max(|a|, |b|)); b may be NULL
+static double fossil_math_ode_norm(const double* v, const double* a, const double* b, size_t n,
+                                   double rtol, double atol) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double mag = fabs(a[i]);
+        if (b) mag = fmax(mag, fabs(b[i]));
+        double e = v[i] / (atol + rtol * mag);
+        sum += e * e;
+    }
+    return sqrt(sum / (double)n);
+}
+
+static void fossil_math_ode_eval(const fossil_math_ode_problem_t* p, double t, const double* y, double* dydt) {
+    p->f(t, y, dydt, p->ctx);
+    ++p->st->evaluations;
+}
+
+// Validates the output grid and returns the direction of integration (0 if t_out ends at t0).
+static int fossil_math_ode_check_grid(double t0, const double* t_out, size_t n_out, double* dir) {
+    *dir = (t_out[n_out - 1] > t0) ? 1.0 : (t_out[n_out - 1] < t0) ? -1.0 : 0.0;
+    double prev = t0;
+    for (size_t k = 0; k < n_out; ++k) {
+        if (!isfinite(t_out[k]) || *dir * (t_out[k] - prev) < 0.0) return -1;
+        prev = t_out[k];
+    }
+    return 0;
+}
+
+// Empirical starting step (Hairer, Norsett & Wanner, Section II.4), given f0 = f(t0, y0).
+static double fossil_math_ode_initial_step(const fossil_math_ode_problem_t* p, double t0, const double* y0,
+                                           const double* f0, double dir, double order,
+                                           double* y1, double* f1) {
+    size_t n = p->n;
+    double d0 = fossil_math_ode_norm(y0, y0, NULL, n, p->o.rtol, p->o.atol);
+    double d1 = fossil_math_ode_norm(f0, y0, NULL, n, p->o.rtol, p->o.atol);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+
+    for (size_t i = 0; i < n; ++i) y1[i] = y0[i] + dir * h0 * f0[i];
+    fossil_math_ode_eval(p, t0 + dir * h0, y1, f1);
+    for (size_t i = 0; i < n; ++i) f1[i] -= f0[i];
+    double d2 = fossil_math_ode_norm(f1, y0, NULL, n, p->o.rtol, p->o.atol) / h0;
+
+    double h1 = (d1 <= 1e-15 && d2 <= 1e-15) ? fmax(1e-6, h0 * 1e-3)
+                                              : pow(0.01 / fmax(d1, d2), 1.0 / (order + 1.0));
+    return fmin(100.0 * h0, h1);
+}
+
+// Smallest step that still advances t by a meaningful amount
+static double fossil_math_ode_min_step(double t, double dir) {
+    return 10.0 * fabs(nextafter(t, dir * INFINITY) - t);
+}
+
+// ============================================================================
+// Dormand-Prince RK45
+// ============================================================================
+
+static const double fossil_math_ode_dp_c[6] = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0 };
+
+static const double fossil_math_ode_dp_a[6][5] = {
+    { 0.0, 0.0, 0.0, 0.0, 0.0 },
+    { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0 },
+    { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0 },
+    { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0 },
+    { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0 },
+    { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0 }
+};
+
+static const double fossil_math_ode_dp_b[6] = {
+    35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0
+};
+
+// Difference between the fifth- and fourth-order weights (the last stage is f(t + h, y_new))
+static const double fossil_math_ode_dp_e[7] = {
+    -71.0 / 57600.0, 0.0, 71.0 / 16695.0, -71.0 / 1920.0, 17253.0 / 339200.0, -22.0 / 525.0, 1.0 / 40.0
+};
+
+// Continuous extension: y(t + x h) = y + h * sum_j K_j * (P_j1 x + P_j2 x^2 + P_j3 x^3 + P_j4 x^4)
+static const double fossil_math_ode_dp_p[7][4] = {
+    { 1.0, -8048581381.0 / 2820520608.0, 8663915743.0 / 2820520608.0, -12715105075.0 / 11282082432.0 },
+    { 0.0, 0.0, 0.0, 0.0 },
+    { 0.0, 131558114200.0 / 32700410799.0, -68118460800.0 / 10900136933.0, 87487479700.0 / 32700410799.0 },
+    { 0.0, -1754552775.0 / 470086768.0, 14199869525.0 / 1410260304.0, -10690763975.0 / 1880347072.0 },
+    { 0.0, 127303824393.0 / 49829197408.0, -318862633887.0 / 49829197408.0, 701980252875.0 / 199316789632.0 },
+    { 0.0, -282668133.0 / 205662961.0, 2019193451.0 / 616988883.0, -1453857185.0 / 822651844.0 },
+    { 0.0, 40617522.0 / 29380423.0, -110615467.0 / 29380423.0, 69997945.0 / 29380423.0 }
+};
+
+static size_t fossil_math_ode_rk45_work(size_t n) {
+    return 10 * n;
+}
+
+static int fossil_math_ode_rk45_core(const fossil_math_ode_problem_t* p, double t0, const double* y0,
+                                     const double* t_out, size_t n_out, double* y_out, double* work) {
+    size_t n = p->n;
+    double* K = work;       // 7 stages
+    double* y = K + 7 * n;
+    double* y_new = y + n;
+    double* tmp = y_new + n;
+
+    double dir;
+    if (fossil_math_ode_check_grid(t0, t_out, n_out, &dir) != 0) return -1;
+    double t_bound = t_out[n_out - 1];
+    memcpy(y, y0, n * sizeof(double));
+
+    size_t k = 0;
+    while (k < n_out && t_out[k] == t0) memcpy(y_out + k++ * n, y, n * sizeof(double));
+    if (k == n_out) return 0;
+
+    fossil_math_ode_eval(p, t0, y, K);
+    double h_max = p->o.h_max > 0.0 ? p->o.h_max : INFINITY;
+    double h_abs = p->o.h0 > 0.0 ? p->o.h0 : fossil_math_ode_initial_step(p, t0, y, K, dir, 4.0, tmp, K + n);
+    double t = t0;
+
+    while (k < n_out) {
+        if (p->st->steps >= p->o.max_steps) return -4;
+        double min_step = fossil_math_ode_min_step(t, dir);
+        h_abs = fmin(fmax(h_abs, min_step), h_max);
+
+        double h, t_new;
+        int rejected = 0;
+        for (;;) {
+            if (h_abs < min_step) return -4;
+            t_new = t + dir * h_abs;
+            if (dir * (t_new - t_bound) > 0.0) t_new = t_bound;
+            h = t_new - t;
+            h_abs = fabs(h);
+
+            for (size_t s = 1; s < 6; ++s) {
+                for (size_t i = 0; i < n; ++i) {
+                    double acc = 0.0;
+                    for (size_t j = 0; j < s; ++j) acc += fossil_math_ode_dp_a[s][j] * K[j * n + i];
+                    tmp[i] = y[i] + h * acc;
+                }
+                fossil_math_ode_eval(p, t + fossil_math_ode_dp_c[s] * h, tmp, K + s * n);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                double acc = 0.0;
+                for (size_t j = 0; j < 6; ++j) acc += fossil_math_ode_dp_b[j] * K[j * n + i];
+                y_new[i] = y[i] + h * acc;
+            }
+            fossil_math_ode_eval(p, t_new, y_new, K + 6 * n);
+
+            for (size_t i = 0; i < n; ++i) {
+                double acc = 0.0;
+                for (size_t j = 0; j < 7; ++j) acc += fossil_math_ode_dp_e[j] * K[j * n + i];
+                tmp[i] = h * acc;
+            }
+            double err = fossil_math_ode_norm(tmp, y, y_new, n, p->o.rtol, p->o.atol);
+
+            if (err < 1.0) {
+                double factor = (err == 0.0) ? FOSSIL_MATH_ODE_MAX_FACTOR
+                              : fmin(FOSSIL_MATH_ODE_MAX_FACTOR, FOSSIL_MATH_ODE_SAFETY * pow(err, -0.2));
+                if (rejected) factor = fmin(1.0, factor);
+                h_abs *= factor;
+                break;
+            }
+            h_abs *= fmax(FOSSIL_MATH_ODE_MIN_FACTOR, FOSSIL_MATH_ODE_SAFETY * pow(err, -0.2));
+            rejected = 1;
+            ++p->st->rejected;
+        }
+        ++p->st->steps;
+
+        // Dense output for every requested time inside (t, t_new]
+        for (; k < n_out && dir * (t_out[k] - t_new) <= 0.0; ++k) {
+            double* out = y_out + k * n;
+            if (t_out[k] == t_new) {
+                memcpy(out, y_new, n * sizeof(double));
+                continue;
+            }
+            double x = (t_out[k] - t) / h;
+            double w[7];
+            for (size_t j = 0; j < 7; ++j) {
+                const double* c = fossil_math_ode_dp_p[j];
+                w[j] = x * (c[0] + x * (c[1] + x * (c[2] + x * c[3])));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                double acc = 0.0;
+                for (size_t j = 0; j < 7; ++j) acc += w[j] * K[j * n + i];
+                out[i] = y[i] + h * acc;
+            }
+        }
+
+        // First same as last: the final stage is the derivative at the new point
+        memcpy(y, y_new, n * sizeof(double));
+        memcpy(K, K + 6 * n, n * sizeof(double));
+        t = t_new;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Variable-order BDF
+// ============================================================================
+//
+// Quasi-constant step size formulation after Shampine & Reichelt (the ode15s
+// family), using their kappa coefficients, which turn orders 1-4 into the more
+// accurate numerical differentiation formulas. The history is stored as backward differences
+// D[0..order+2]; changing the step rescales them with the R * U transform.
+// Newton iterations solve with LU factors of I - c J that are kept across
+// steps and refreshed only when c changes or convergence fails.
+//
+
+static const double fossil_math_ode_bdf_kappa[FOSSIL_MATH_ODE_BDF_ORDER + 1] = {
+    0.0, -0.1850, -1.0 / 9.0, -0.0823, -0.0415, 0.0
+};
+
+typedef struct {
+    double gamma[FOSSIL_MATH_ODE_BDF_ORDER + 1];
+    double alpha[FOSSIL_MATH_ODE_BDF_ORDER + 1];
+    double error_const[FOSSIL_MATH_ODE_BDF_ORDER + 1];
+} fossil_math_ode_bdf_coef_t;
+
+static void fossil_math_ode_bdf_coefficients(fossil_math_ode_bdf_coef_t* c) {
+    c->gamma[0] = 0.0;
+    for (size_t k = 1; k <= FOSSIL_MATH_ODE_BDF_ORDER; ++k) c->gamma[k] = c->gamma[k - 1] + 1.0 / (double)k;
+    for (size_t k = 0; k <= FOSSIL_MATH_ODE_BDF_ORDER; ++k) {
+        c->alpha[k] = (1.0 - fossil_math_ode_bdf_kappa[k]) * c->gamma[k];
+        c->error_const[k] = fossil_math_ode_bdf_kappa[k] * c->gamma[k] + 1.0 / (double)(k + 1);
+    }
+}
+
+// R[i][j] = prod_{m=1..i} (m - 1 - factor * j) / m for i, j in 0..order
+static void fossil_math_ode_bdf_compute_r(size_t order, double factor,
+                                          double R[FOSSIL_MATH_ODE_BDF_ORDER + 1][FOSSIL_MATH_ODE_BDF_ORDER + 1]) {
+    for (size_t j = 0; j <= order; ++j) R[0][j] = 1.0;
+    for (size_t i = 1; i <= order; ++i) {
+        R[i][0] = 0.0;
+        for (size_t j = 1; j <= order; ++j)
+            R[i][j] = R[i - 1][j] * ((double)i - 1.0 - factor * (double)j) / (double)i;
+    }
+}
+
+// Rescales the differences D[0..order] for a step multiplied by factor. tmp holds (order + 1) x n.
+static void fossil_math_ode_bdf_change_d(double* D, size_t order, double factor, size_t n, double* tmp) {
+    double R[FOSSIL_MATH_ODE_BDF_ORDER + 1][FOSSIL_MATH_ODE_BDF_ORDER + 1];
+    double U[FOSSIL_MATH_ODE_BDF_ORDER + 1][FOSSIL_MATH_ODE_BDF_ORDER + 1];
+    fossil_math_ode_bdf_compute_r(order, factor, R);
+    fossil_math_ode_bdf_compute_r(order, 1.0, U);
+
+    memset(tmp, 0, (order + 1) * n * sizeof(double));
+    for (size_t i = 0; i <= order; ++i) {
+        for (size_t k = 0; k <= order; ++k) {
+            // (R U)[k][i]
+            double ru = 0.0;
+            for (size_t m = 0; m <= order; ++m) ru += R[k][m] * U[m][i];
+            if (ru == 0.0) continue;
+            const double* d = D + k * n;
+            double* out = tmp + i * n;
+            for (size_t c = 0; c < n; ++c) out[c] += ru * d[c];
+        }
+    }
+    memcpy(D, tmp, (order + 1) * n * sizeof(double));
+}
+
+static void fossil_math_ode_jacobian(const fossil_math_ode_problem_t* p, double t, const double* y,
+                                     double* J, double* f0, double* yt, double* ft) {
+    size_t n = p->n;
+    ++p->st->jacobian_evaluations;
+    if (p->jac) {
+        p->jac(t, y, J, p->ctx);
+        return;
+    }
+    fossil_math_ode_eval(p, t, y, f0);
+    memcpy(yt, y, n * sizeof(double));
+    for (size_t j = 0; j < n; ++j) {
+        double h = sqrt(DBL_EPSILON) * fmax(fabs(y[j]), 1.0);
+        yt[j] = y[j] + h;
+        h = yt[j] - y[j];
+        fossil_math_ode_eval(p, t, yt, ft);
+        for (size_t i = 0; i < n; ++i) J[i * n + j] = (ft[i] - f0[i]) / h;
+        yt[j] = y[j];
+    }
+}
+
+typedef struct {
+    double* D;      // (order limit + 3) x n backward differences
+    double* tmp;    // (order limit + 1) x n scratch for change_d
+    double* J;
+    double* LU;
+    size_t* piv;
+    double* y_pred;
+    double* psi;
+    double* y_new;
+    double* d;
+    double* dy;
+    double* scale;
+    double* fbuf;
+    double* ftmp;
+} fossil_math_ode_bdf_ws_t;
+
+static size_t fossil_math_ode_bdf_work(size_t n) {
+    return (FOSSIL_MATH_ODE_BDF_ORDER + 3) * n + (FOSSIL_MATH_ODE_BDF_ORDER + 1) * n + 2 * n * n + 8 * n;
+}
+
+static void fossil_math_ode_bdf_layout(fossil_math_ode_bdf_ws_t* w, double* work, size_t* piv, size_t n) {
+    w->D = work;
+    w->tmp = w->D + (FOSSIL_MATH_ODE_BDF_ORDER + 3) * n;
+    w->J = w->tmp + (FOSSIL_MATH_ODE_BDF_ORDER + 1) * n;
+    w->LU = w->J + n * n;
+    w->y_pred = w->LU + n * n;
+    w->psi = w->y_pred + n;
+    w->y_new = w->psi + n;
+    w->d = w->y_new + n;
+    w->dy = w->d + n;
+    w->scale = w->dy + n;
+    w->fbuf = w->scale + n;
+    w->ftmp = w->fbuf + n;
+    w->piv = piv;
+}
+
+static double fossil_math_ode_rms(const double* v, const double* scale, double c, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double e = c * v[i] / scale[i];
+        sum += e * e;
+    }
+    return sqrt(sum / (double)n);
+}
+
+// Simplified Newton iteration for y = y_pred + d with c f(t, y) - psi - d = 0.
+// Returns 1 on convergence; *iters receives the iterations used.
+static int fossil_math_ode_bdf_newton(const fossil_math_ode_problem_t* p, const fossil_math_ode_bdf_ws_t* w,
+                                      double t, double c, double tol, size_t* iters) {
+    size_t n = p->n;
+    double dy_norm_old = -1.0;
+    memset(w->d, 0, n * sizeof(double));
+    memcpy(w->y_new, w->y_pred, n * sizeof(double));
+
+    for (size_t k = 0; k < FOSSIL_MATH_ODE_NEWTON_MAX; ++k) {
+        *iters = k + 1;
+        fossil_math_ode_eval(p, t, w->y_new, w->fbuf);
+        for (size_t i = 0; i < n; ++i) {
+            if (!isfinite(w->fbuf[i])) return 0;
+            w->dy[i] = c * w->fbuf[i] - w->psi[i] - w->d[i];
+        }
+        fossil_math_algebra_lu_solve(w->LU, w->piv, w->dy, w->dy, n);
+        double dy_norm = fossil_math_ode_rms(w->dy, w->scale, 1.0, n);
+
+        double rate = dy_norm_old < 0.0 ? -1.0 : dy_norm / dy_norm_old;
+        if (rate >= 0.0 &&
+            (rate >= 1.0 || pow(rate, (double)(FOSSIL_MATH_ODE_NEWTON_MAX - k)) / (1.0 - rate) * dy_norm > tol))
+            return 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            w->y_new[i] += w->dy[i];
+            w->d[i] += w->dy[i];
+        }
+        if (dy_norm == 0.0 || (rate >= 0.0 && rate / (1.0 - rate) * dy_norm < tol)) return 1;
+        dy_norm_old = dy_norm;
+    }
+    return 0;
+}
+
+static int fossil_math_ode_bdf_core(const fossil_math_ode_problem_t* p, double t0, const double* y0,
+                                    const double* t_out, size_t n_out, double* y_out,
+                                    double* work, size_t* piv) {
+    size_t n = p->n;
+    double rtol = p->o.rtol, atol = p->o.atol;
+    fossil_math_ode_bdf_ws_t w;
+    fossil_math_ode_bdf_layout(&w, work, piv, n);
+    fossil_math_ode_bdf_coef_t cf;
+    fossil_math_ode_bdf_coefficients(&cf);
+
+    double dir;
+    if (fossil_math_ode_check_grid(t0, t_out, n_out, &dir) != 0) return -1;
+    double t_bound = t_out[n_out - 1];
+
+    size_t k = 0;
+    while (k < n_out && t_out[k] == t0) memcpy(y_out + k++ * n, y0, n * sizeof(double));
+    if (k == n_out) return 0;
+
+    double* D = w.D;
+    memset(D, 0, (FOSSIL_MATH_ODE_BDF_ORDER + 3) * n * sizeof(double));
+    memcpy(D, y0, n * sizeof(double));
+    fossil_math_ode_eval(p, t0, y0, w.fbuf);
+
+    double h_max = p->o.h_max > 0.0 ? p->o.h_max : INFINITY;
+    double h_abs = p->o.h0 > 0.0 ? p->o.h0 : fossil_math_ode_initial_step(p, t0, y0, w.fbuf, dir, 1.0, w.dy, w.ftmp);
+    for (size_t i = 0; i < n; ++i) D[n + i] = w.fbuf[i] * h_abs * dir;
+
+    fossil_math_ode_jacobian(p, t0, y0, w.J, w.fbuf, w.dy, w.ftmp);
+    double newton_tol = fmax(10.0 * DBL_EPSILON / rtol, fmin(0.03, sqrt(rtol)));
+    size_t order = 1, n_equal_steps = 0;
+    int lu_valid = 0;
+    double t = t0;
+
+    while (k < n_out) {
+        if (p->st->steps >= p->o.max_steps) return -4;
+        double min_step = fossil_math_ode_min_step(t, dir);
+        if (h_abs > h_max) {
+            fossil_math_ode_bdf_change_d(D, order, h_max / h_abs, n, w.tmp);
+            h_abs = h_max;
+            n_equal_steps = 0;
+        } else if (h_abs < min_step) {
+            fossil_math_ode_bdf_change_d(D, order, min_step / h_abs, n, w.tmp);
+            h_abs = min_step;
+            n_equal_steps = 0;
+        }
+
+        int current_jac = 0;
+        double h, t_new, safety, error_norm;
+        for (;;) {
+            if (h_abs < min_step) return -4;
+            t_new = t + dir * h_abs;
+            if (dir * (t_new - t_bound) > 0.0) {
+                t_new = t_bound;
+                fossil_math_ode_bdf_change_d(D, order, fabs(t_new - t) / h_abs, n, w.tmp);
+                n_equal_steps = 0;
+                lu_valid = 0;
+            }
+            h = t_new - t;
+            h_abs = fabs(h);
+
+            for (size_t i = 0; i < n; ++i) {
+                double yp = 0.0, ps = 0.0;
+                for (size_t j = 0; j <= order; ++j) yp += D[j * n + i];
+                for (size_t j = 1; j <= order; ++j) ps += cf.gamma[j] * D[j * n + i];
+                w.y_pred[i] = yp;
+                w.psi[i] = ps / cf.alpha[order];
+                w.scale[i] = atol + rtol * fabs(yp);
+            }
+
+            double c = h / cf.alpha[order];
+            size_t iters = 0;
+            int converged = 0;
+            for (;;) {
+                if (!lu_valid) {
+                    for (size_t i = 0; i < n * n; ++i) w.LU[i] = -c * w.J[i];
+                    for (size_t i = 0; i < n; ++i) w.LU[i * n + i] += 1.0;
+                    ++p->st->factorizations;
+                    lu_valid = fossil_math_algebra_lu_decompose(w.LU, n, w.piv) == 0;
+                }
+                converged = lu_valid && fossil_math_ode_bdf_newton(p, &w, t_new, c, newton_tol, &iters);
+                if (converged || current_jac) break;
+                fossil_math_ode_jacobian(p, t_new, w.y_pred, w.J, w.fbuf, w.dy, w.ftmp);
+                current_jac = 1;
+                lu_valid = 0;
+            }
+
+            if (!converged) {
+                h_abs *= 0.5;
+                fossil_math_ode_bdf_change_d(D, order, 0.5, n, w.tmp);
+                n_equal_steps = 0;
+                lu_valid = 0;
+                ++p->st->rejected;
+                continue;
+            }
+
+            safety = FOSSIL_MATH_ODE_SAFETY * (2.0 * FOSSIL_MATH_ODE_NEWTON_MAX + 1.0) /
+                     (2.0 * FOSSIL_MATH_ODE_NEWTON_MAX + (double)iters);
+            for (size_t i = 0; i < n; ++i) w.scale[i] = atol + rtol * fabs(w.y_new[i]);
+            error_norm = fossil_math_ode_rms(w.d, w.scale, cf.error_const[order], n);
+            if (error_norm <= 1.0) break;
+
+            // Reject: the Newton matrix stays usable for the smaller step, so keep the factors
+            double factor = fmax(FOSSIL_MATH_ODE_MIN_FACTOR, safety * pow(error_norm, -1.0 / (double)(order + 1)));
+            h_abs *= factor;
+            fossil_math_ode_bdf_change_d(D, order, factor, n, w.tmp);
+            n_equal_steps = 0;
+            ++p->st->rejected;
+        }
+        ++p->st->steps;
+        ++n_equal_steps;
+
+        // Update the backward differences with the correction d
+        for (size_t i = 0; i < n; ++i) {
+            D[(order + 2) * n + i] = w.d[i] - D[(order + 1) * n + i];
+            D[(order + 1) * n + i] = w.d[i];
+        }
+        for (size_t j = order + 1; j-- > 0;)
+            for (size_t i = 0; i < n; ++i) D[j * n + i] += D[(j + 1) * n + i];
+
+        // Dense output from the interpolating polynomial through the last order + 1 points
+        for (; k < n_out && dir * (t_out[k] - t_new) <= 0.0; ++k) {
+            double* out = y_out + k * n;
+            memcpy(out, D, n * sizeof(double));
+            double prod = 1.0;
+            for (size_t j = 0; j < order; ++j) {
+                prod *= (t_out[k] - (t_new - h * (double)j)) / (h * (double)(j + 1));
+                const double* dj = D + (j + 1) * n;
+                for (size_t i = 0; i < n; ++i) out[i] += prod * dj[i];
+            }
+        }
+        t = t_new;
+
+        if (n_equal_steps < order + 1) continue;
+
+        // Choose the order whose predicted step is largest
+        double norms[3];
+        norms[0] = order > 1 ? fossil_math_ode_rms(D + order * n, w.scale, cf.error_const[order - 1], n) : INFINITY;
+        norms[1] = error_norm;
+        norms[2] = order < FOSSIL_MATH_ODE_BDF_ORDER
+                 ? fossil_math_ode_rms(D + (order + 2) * n, w.scale, cf.error_const[order + 1], n) : INFINITY;
+        size_t best = 1;
+        double best_factor = 0.0;
+        for (size_t j = 0; j < 3; ++j) {
+            double fct = norms[j] == 0.0 ? INFINITY : pow(norms[j], -1.0 / (double)(order + j));
+            if (fct > best_factor || (j == 1 && fct >= best_factor)) {
+                best_factor = fct;
+                best = j;
+            }
+        }
+        order = order + best - 1;
+        double factor = fmin(FOSSIL_MATH_ODE_MAX_FACTOR, safety * best_factor);
+        h_abs *= factor;
+        fossil_math_ode_bdf_change_d(D, order, factor, n, w.tmp);
+        n_equal_steps = 0;
+        lu_valid = 0;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Public Integrators
+// ============================================================================
+
+static int fossil_math_ode_setup(fossil_math_ode_problem_t* p, fossil_math_ode_func_t f, fossil_math_ode_jac_t jac,
+                                 void* ctx, size_t n, const fossil_math_ode_options_t* opts,
+                                 fossil_math_ode_info_t* st) {
+    fossil_math_ode_info_t zero = { 0, 0, 0, 0, 0 };
+    *st = zero;
+    p->f = f;
+    p->jac = jac;
+    p->ctx = ctx;
+    p->n = n;
+    p->st = st;
+    if (opts) p->o = *opts; else fossil_math_ode_options_default(&p->o);
+    if (!f || n == 0 || !(p->o.rtol > 0.0) || !(p->o.atol >= 0.0)) return -1;
+    return 0;
+}
+
+int fossil_math_ode_rk45(fossil_math_ode_func_t f, void* ctx, size_t n, double t0, const double* y0,
+                         const double* t_out, size_t n_out, double* y_out,
+                         const fossil_math_ode_options_t* opts, fossil_math_ode_info_t* info) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_ode_problem_t p;
+    fossil_math_ode_info_t st;
+    int status = -1;
+    if (fossil_math_ode_setup(&p, f, NULL, ctx, n, opts, &st) == 0 && y0 && t_out && n_out > 0 && y_out) {
+        FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_ODE_RK45, fossil_math_ode_rk45_work(n) * sizeof(double));
+        double* work = malloc(fossil_math_ode_rk45_work(n) * sizeof(double));
+        status = work ? fossil_math_ode_rk45_core(&p, t0, y0, t_out, n_out, y_out, work) : -2;
+        free(work);
+    }
+    if (info) *info = st;
+    // Seven stage combinations and the error norm per attempted step
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ODE_RK45, 60.0 * (double)n * (double)(st.steps + st.rejected));
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ODE_RK45, n, n_out, st.steps);
+    return status;
+}
+
+int fossil_math_ode_bdf(fossil_math_ode_func_t f, fossil_math_ode_jac_t jac, void* ctx, size_t n,
+                        double t0, const double* y0, const double* t_out, size_t n_out, double* y_out,
+                        const fossil_math_ode_options_t* opts, fossil_math_ode_info_t* info) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_ode_problem_t p;
+    fossil_math_ode_info_t st;
+    int status = -1;
+    if (fossil_math_ode_setup(&p, f, jac, ctx, n, opts, &st) == 0 && y0 && t_out && n_out > 0 && y_out) {
+        FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_ODE_BDF, fossil_math_ode_bdf_work(n) * sizeof(double) + n * sizeof(size_t));
+        double* work = malloc(fossil_math_ode_bdf_work(n) * sizeof(double));
+        size_t* piv = malloc(n * sizeof(size_t));
+        status = -2;
+        if (work && piv) status = fossil_math_ode_bdf_core(&p, t0, y0, t_out, n_out, y_out, work, piv);
+        free(work);
+        free(piv);
+    }
+    if (info) *info = st;
+    // LU factorizations plus one triangular solve per function evaluation
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ODE_BDF, 2.0 / 3.0 * (double)n * (double)n * (double)n * (double)st.factorizations +
+                                                          2.0 * (double)n * (double)n * (double)st.evaluations);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ODE_BDF, n, n_out, st.steps);
+    return status;
+}
+
+// ============================================================================
+// Batched Integration
+// ============================================================================
+
+typedef struct {
+    fossil_math_ode_method_t method;
+    fossil_math_ode_batch_func_t f;
+    fossil_math_ode_batch_jac_t jac;
+    void* ctx;
+    size_t n;
+    double t0;
+    double t1;
+    double* y;
+    const fossil_math_ode_options_t* opts;
+    int* status;
+} fossil_math_ode_batch_t;
+
+// Binds one system of a batch to the single-system callback signatures
+typedef struct {
+    const fossil_math_ode_batch_t* job;
+    size_t system;
+} fossil_math_ode_thunk_t;
+
+static void fossil_math_ode_thunk_f(double t, const double* y, double* dydt, void* ctx) {
+    const fossil_math_ode_thunk_t* s = (const fossil_math_ode_thunk_t*)ctx;
+    s->job->f(s->system, t, y, dydt, s->job->ctx);
+}
+
+static void fossil_math_ode_thunk_jac(double t, const double* y, double* J, void* ctx) {
+    const fossil_math_ode_thunk_t* s = (const fossil_math_ode_thunk_t*)ctx;
+    s->job->jac(s->system, t, y, J, s->job->ctx);
+}
+
+static void fossil_math_ode_batch_range(size_t begin, size_t end, void* ctx) {
+    const fossil_math_ode_batch_t* job = (const fossil_math_ode_batch_t*)ctx;
+    size_t n = job->n;
+    int bdf = job->method == FOSSIL_MATH_ODE_BDF;
+
+    // One allocation per range, reused by every system in it
+    double* work = malloc((bdf ? fossil_math_ode_bdf_work(n) : fossil_math_ode_rk45_work(n)) * sizeof(double));
+    size_t* piv = bdf ? malloc(n * sizeof(size_t)) : NULL;
+    if (!work || (bdf && !piv)) {
+        for (size_t s = begin; s < end; ++s) job->status[s] = -2;
+        free(work);
+        free(piv);
+        return;
+    }
+
+    for (size_t s = begin; s < end; ++s) {
+        fossil_math_ode_thunk_t thunk = { job, s };
+        fossil_math_ode_problem_t p;
+        fossil_math_ode_info_t st;
+        fossil_math_ode_setup(&p, fossil_math_ode_thunk_f, job->jac ? fossil_math_ode_thunk_jac : NULL,
+                              &thunk, n, job->opts, &st);
+        double* y = job->y + s * n;
+        job->status[s] = bdf ? fossil_math_ode_bdf_core(&p, job->t0, y, &job->t1, 1, y, work, piv)
+                             : fossil_math_ode_rk45_core(&p, job->t0, y, &job->t1, 1, y, work);
+    }
+    free(work);
+    free(piv);
+}
+
+static size_t fossil_math_ode_batch_run(fossil_math_ode_method_t method, fossil_math_ode_batch_func_t f,
+                                        fossil_math_ode_batch_jac_t jac, void* ctx, size_t n, size_t count,
+                                        double t0, double t1, double* y,
+                                        const fossil_math_ode_options_t* opts, int* status) {
+    if (!f || !y || n == 0 || count == 0) return 0;
+    if (method != FOSSIL_MATH_ODE_RK45 && method != FOSSIL_MATH_ODE_BDF) return 0;
+    fossil_math_ode_options_t o;
+    if (opts) o = *opts; else fossil_math_ode_options_default(&o);
+    if (!(o.rtol > 0.0) || !(o.atol >= 0.0)) return 0;
+
+    int* owned = NULL;
+    if (!status) {
+        owned = (int*)malloc(count * sizeof(int));
+        if (!owned) return 0;
+        status = owned;
+    }
+    fossil_math_ode_batch_t job = { method, f, jac, ctx, n, t0, t1, y, &o, status };
+    fossil_math_parallel_for(count, FOSSIL_MATH_ODE_BATCH_GRAIN, fossil_math_ode_batch_range, &job);
+
+    size_t ok = 0;
+    for (size_t s = 0; s < count; ++s) ok += status[s] == 0;
+    free(owned);
+    return ok;
+}
+
+size_t fossil_math_ode_solve_batch(fossil_math_ode_method_t method, fossil_math_ode_batch_func_t f,
+                                   fossil_math_ode_batch_jac_t jac, void* ctx, size_t n, size_t count,
+                                   double t0, double t1, double* y,
+                                   const fossil_math_ode_options_t* opts, int* status) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    size_t ok = fossil_math_ode_batch_run(method, f, jac, ctx, n, count, t0, t1, y, opts, status);
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_ODE_SOLVE_BATCH, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_ODE_SOLVE_BATCH, count, n, 0);
+    return ok;
+}
@@ -0,0 +1,552 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/optim.h"
+#include "fossil/math/algebra.h"
+#include <math.h>
+#include <float.h>
+
+// Wolfe line-search constants: sufficient decrease, and curvature for L-BFGS and CG
+#define FOSSIL_MATH_OPTIM_C1         1e-4
+#define FOSSIL_MATH_OPTIM_C2_LBFGS   0.9
+#define FOSSIL_MATH_OPTIM_C2_CG      0.1
+// Trial steps allowed in the bracketing and zoom phases of the line search
+#define FOSSIL_MATH_OPTIM_BRACKET_MAX 40
+#define FOSSIL_MATH_OPTIM_ZOOM_MAX    30
+
+struct fossil_math_optim_workspace {
+    size_t n;       // Largest supported dimension
+    size_t memory;  // Largest supported L-BFGS history
+    double* buf;
+    size_t* order;  // Nelder-Mead vertex ranking
+};
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void fossil_math_optim_options_default(fossil_math_optim_options_t* opts) {
+    if (!opts) return;
+    opts->max_iter = 1000;
+    opts->tol_grad = 1e-8;
+    opts->tol_f = 1e-14;
+    opts->tol_x = 1e-12;
+    opts->memory = 8;
+    opts->monitor = NULL;
+    opts->monitor_ctx = NULL;
+}
+
+fossil_math_optim_workspace_t* fossil_math_optim_workspace_create(size_t n, size_t memory) {
+    if (n == 0) return NULL;
+    // L-BFGS: g, gt, xt, d, S and Y (memory x n), rho and alpha
+    size_t lbfgs = 4 * n + 2 * memory * n + 2 * memory;
+    // Nelder-Mead: n + 1 vertices, their values, centroid and two trial points
+    size_t simplex = (n + 1) * (n + 1) + 3 * n;
+    fossil_math_optim_workspace_t* ws = malloc(sizeof(*ws));
+    if (!ws) return NULL;
+    ws->n = n;
+    ws->memory = memory;
+    ws->buf = malloc(FOSSIL_MATH_MAX(lbfgs, simplex) * sizeof(double));
+    ws->order = malloc((n + 1) * sizeof(size_t));
+    if (!ws->buf || !ws->order) {
+        fossil_math_optim_workspace_destroy(ws);
+        return NULL;
+    }
+    return ws;
+}
+
+void fossil_math_optim_workspace_destroy(fossil_math_optim_workspace_t* ws) {
+    if (!ws) return;
+    free(ws->buf);
+    free(ws->order);
+    free(ws);
+}
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+// Uses ws when it is large enough, or allocates a temporary one into *owned.
+static int fossil_math_optim_acquire(fossil_math_optim_workspace_t* ws, size_t n, size_t memory,
+                                     fossil_math_optim_workspace_t** out, fossil_math_optim_workspace_t** owned) {
+    *owned = NULL;
+    if (ws) {
+        if (ws->n < n || ws->memory < memory) return -1;
+        *out = ws;
+        return 0;
+    }
+    *owned = fossil_math_optim_workspace_create(n, memory);
+    if (!*owned) return -2;
+    *out = *owned;
+    return 0;
+}
+
+static double fossil_math_optim_norm(const double* v, size_t n) {
+    return sqrt(fossil_math_algebra_dot(v, v, n));
+}
+
+static void fossil_math_optim_report(fossil_math_optim_info_t* info, const fossil_math_optim_info_t* s) {
+    if (info) *info = *s;
+}
+
+static int fossil_math_optim_interrupted(const fossil_math_optim_options_t* o, const fossil_math_optim_info_t* st) {
+    return o->monitor && o->monitor(st, o->monitor_ctx) != 0;
+}
+
+// ============================================================================
+// Strong Wolfe Line Search
+// ============================================================================
+//
+// Bracketing followed by zoom with safeguarded cubic interpolation
+// (Nocedal & Wright, Algorithms 3.5 and 3.6). The trial point and gradient
+// of the accepted step are left in xt and gt.
+//
+
+typedef struct {
+    fossil_math_optim_fdf_t fdf;
+    void* ctx;
+    const double* x;
+    const double* d;
+    double* xt;
+    double* gt;
+    size_t n;
+    size_t* evals;
+} fossil_math_optim_ls_t;
+
+static double fossil_math_optim_ls_eval(const fossil_math_optim_ls_t* s, double a, double* dg) {
+    for (size_t i = 0; i < s->n; ++i) s->xt[i] = s->x[i] + a * s->d[i];
+    double f = s->fdf(s->xt, s->gt, s->ctx);
+    ++*s->evals;
+    *dg = fossil_math_algebra_dot(s->gt, s->d, s->n);
+    return f;
+}
+
+// Minimizer of the cubic interpolating (a, fa, ga) and (b, fb, gb); NAN if none.
+static double fossil_math_optim_cubic(double a, double fa, double ga, double b, double fb, double gb) {
+    double d1 = ga + gb - 3.0 * (fa - fb) / (a - b);
+    double disc = d1 * d1 - ga * gb;
+    if (!(disc >= 0.0)) return NAN;
+    double d2 = copysign(sqrt(disc), b - a);
+    return b - (b - a) * (gb + d2 - d1) / (gb - ga + 2.0 * d2);
+}
+
+static int fossil_math_optim_zoom(const fossil_math_optim_ls_t* s, double f0, double dg0, double c2,
+                                  double lo, double flo, double glo, double hi, double fhi, double ghi,
+                                  double* alpha, double* f_out) {
+    for (size_t k = 0; k < FOSSIL_MATH_OPTIM_ZOOM_MAX; ++k) {
+        double left = FOSSIL_MATH_MIN(lo, hi);
+        double width = fabs(hi - lo);
+        if (width <= DBL_EPSILON * FOSSIL_MATH_MAX(lo, hi)) break;
+
+        double a = fossil_math_optim_cubic(lo, flo, glo, hi, fhi, ghi);
+        if (!isfinite(a) || a < left + 0.1 * width || a > left + 0.9 * width) a = 0.5 * (lo + hi);
+
+        double dga;
+        double fa = fossil_math_optim_ls_eval(s, a, &dga);
+        if (!isfinite(fa) || fa > f0 + FOSSIL_MATH_OPTIM_C1 * a * dg0 || fa >= flo) {
+            hi = a; fhi = fa; ghi = dga;
+        } else {
+            if (fabs(dga) <= -c2 * dg0) {
+                *alpha = a;
+                *f_out = fa;
+                return 0;
+            }
+            if (dga * (hi - lo) >= 0.0) {
+                hi = lo; fhi = flo; ghi = glo;
+            }
+            lo = a; flo = fa; glo = dga;
+        }
+    }
+    // The curvature condition could not be met; settle for the best point with sufficient decrease
+    if (lo > 0.0) {
+        double dga;
+        *f_out = fossil_math_optim_ls_eval(s, lo, &dga);
+        *alpha = lo;
+        return 0;
+    }
+    return -1;
+}
+
+static int fossil_math_optim_line_search(const fossil_math_optim_ls_t* s, double f0, double dg0, double alpha,
+                                         double c2, double* alpha_out, double* f_out) {
+    double a_prev = 0.0, f_prev = f0, g_prev = dg0;
+    for (size_t i = 0; i < FOSSIL_MATH_OPTIM_BRACKET_MAX; ++i) {
+        double dga;
+        double fa = fossil_math_optim_ls_eval(s, alpha, &dga);
+        if (!isfinite(fa) || fa > f0 + FOSSIL_MATH_OPTIM_C1 * alpha * dg0 || (i > 0 && fa >= f_prev))
+            return fossil_math_optim_zoom(s, f0, dg0, c2, a_prev, f_prev, g_prev, alpha, fa, dga, alpha_out, f_out);
+        if (fabs(dga) <= -c2 * dg0) {
+            *alpha_out = alpha;
+            *f_out = fa;
+            return 0;
+        }
+        if (dga >= 0.0)
+            return fossil_math_optim_zoom(s, f0, dg0, c2, alpha, fa, dga, a_prev, f_prev, g_prev, alpha_out, f_out);
+        a_prev = alpha; f_prev = fa; g_prev = dga;
+        alpha *= 2.0;
+    }
+    return -1;
+}
+
+// ============================================================================
+// L-BFGS
+// ============================================================================
+
+int fossil_math_optim_lbfgs(fossil_math_optim_fdf_t fdf, void* ctx, double* x, size_t n,
+                            const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                            fossil_math_optim_info_t* info) {
+    fossil_math_optim_info_t st = { 0, 0, NAN, NAN, NAN, 0 };
+    fossil_math_optim_report(info, &st);
+    if (!fdf || !x || n == 0) return -1;
+
+    fossil_math_optim_options_t o;
+    if (opts) o = *opts; else fossil_math_optim_options_default(&o);
+    size_t m = o.memory;
+    if (m == 0) return -1;
+
+    fossil_math_optim_workspace_t* owned;
+    int status = fossil_math_optim_acquire(ws, n, m, &ws, &owned);
+    if (status != 0) return status;
+
+    double* g = ws->buf;
+    double* gt = g + n;
+    double* xt = gt + n;
+    double* d = xt + n;
+    double* S = d + n;
+    double* Y = S + m * n;
+    double* rho = Y + m * n;
+    double* alpha = rho + m;
+
+    // Ring buffer: the `count` most recent pairs occupy the slots just before `head`
+    size_t head = 0, count = 0;
+    fossil_math_optim_ls_t ls = { fdf, ctx, x, d, xt, gt, n, &st.evaluations };
+
+    double fx = fdf(x, g, ctx);
+    st.evaluations = 1;
+    double gn = fossil_math_optim_norm(g, n);
+    status = isfinite(fx) ? -4 : -1;
+
+    while (status == -4) {
+        st.f = fx;
+        st.grad_norm = gn;
+        if (gn <= o.tol_grad) { status = 0; break; }
+        if (st.iterations >= o.max_iter) break;
+
+        // Two-loop recursion: d = -H g
+        for (size_t i = 0; i < n; ++i) d[i] = -g[i];
+        for (size_t k = 0; k < count; ++k) {
+            size_t j = (head + m - 1 - k) % m;
+            alpha[j] = rho[j] * fossil_math_algebra_dot(S + j * n, d, n);
+            const double* y = Y + j * n;
+            for (size_t i = 0; i < n; ++i) d[i] -= alpha[j] * y[i];
+        }
+        if (count > 0) {
+            size_t j = (head + m - 1) % m;
+            const double* y = Y + j * n;
+            double gamma = 1.0 / (rho[j] * fossil_math_algebra_dot(y, y, n));
+            for (size_t i = 0; i < n; ++i) d[i] *= gamma;
+        }
+        for (size_t k = count; k-- > 0;) {
+            size_t j = (head + m - 1 - k) % m;
+            double beta = rho[j] * fossil_math_algebra_dot(Y + j * n, d, n);
+            const double* s = S + j * n;
+            for (size_t i = 0; i < n; ++i) d[i] += (alpha[j] - beta) * s[i];
+        }
+
+        double dg0 = fossil_math_algebra_dot(g, d, n);
+        if (!(dg0 < 0.0)) {
+            count = 0;
+            for (size_t i = 0; i < n; ++i) d[i] = -g[i];
+            dg0 = -gn * gn;
+        }
+
+        double step0 = count > 0 ? 1.0 : FOSSIL_MATH_MIN(1.0, 1.0 / gn);
+        double a, ft;
+        if (fossil_math_optim_line_search(&ls, fx, dg0, step0, FOSSIL_MATH_OPTIM_C2_LBFGS, &a, &ft) != 0) {
+            // Discard the history and retry once along the steepest descent
+            if (count > 0) { count = 0; continue; }
+            break;
+        }
+        ++st.iterations;
+
+        // Store s = xt - x and y = gt - g in the next ring slot
+        double* s = S + head * n;
+        double* y = Y + head * n;
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = xt[i] - x[i];
+            y[i] = gt[i] - g[i];
+        }
+        double sy = fossil_math_algebra_dot(s, y, n);
+        double yy = fossil_math_algebra_dot(y, y, n);
+        if (sy > DBL_EPSILON * yy) {
+            rho[head] = 1.0 / sy;
+            head = (head + 1) % m;
+            if (count < m) ++count;
+        } else if (count == m) {
+            --count; // the oldest pair was overwritten
+        }
+
+        double f_prev = fx;
+        st.step = a * fossil_math_optim_norm(d, n);
+        memcpy(x, xt, n * sizeof(double));
+        memcpy(g, gt, n * sizeof(double));
+        fx = ft;
+        gn = fossil_math_optim_norm(g, n);
+        st.f = fx;
+        st.grad_norm = gn;
+
+        if (fossil_math_optim_interrupted(&o, &st)) { status = -5; break; }
+        if (gn <= o.tol_grad) status = 0;
+        else if (f_prev - fx <= o.tol_f * (1.0 + fabs(fx))) status = 0;
+        else if (st.step <= o.tol_x * (1.0 + fossil_math_optim_norm(x, n))) status = 0;
+    }
+
+    st.converged = status == 0;
+    fossil_math_optim_report(info, &st);
+    fossil_math_optim_workspace_destroy(owned);
+    return status;
+}
+
+// ============================================================================
+// Nonlinear Conjugate Gradient
+// ============================================================================
+
+int fossil_math_optim_cg(fossil_math_optim_fdf_t fdf, void* ctx, double* x, size_t n,
+                         const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                         fossil_math_optim_info_t* info) {
+    fossil_math_optim_info_t st = { 0, 0, NAN, NAN, NAN, 0 };
+    fossil_math_optim_report(info, &st);
+    if (!fdf || !x || n == 0) return -1;
+
+    fossil_math_optim_options_t o;
+    if (opts) o = *opts; else fossil_math_optim_options_default(&o);
+
+    fossil_math_optim_workspace_t* owned;
+    int status = fossil_math_optim_acquire(ws, n, 0, &ws, &owned);
+    if (status != 0) return status;
+
+    double* g = ws->buf;
+    double* gt = g + n;
+    double* xt = gt + n;
+    double* d = xt + n;
+    fossil_math_optim_ls_t ls = { fdf, ctx, x, d, xt, gt, n, &st.evaluations };
+
+    double fx = fdf(x, g, ctx);
+    st.evaluations = 1;
+    double gn = fossil_math_optim_norm(g, n);
+    status = isfinite(fx) ? -4 : -1;
+
+    for (size_t i = 0; i < n; ++i) d[i] = -g[i];
+    double dg0 = -gn * gn;
+    double step0 = FOSSIL_MATH_MIN(1.0, 1.0 / gn);
+    int restarted = 1;
+
+    while (status == -4) {
+        st.f = fx;
+        st.grad_norm = gn;
+        if (gn <= o.tol_grad) { status = 0; break; }
+        if (st.iterations >= o.max_iter) break;
+
+        double a, ft;
+        if (fossil_math_optim_line_search(&ls, fx, dg0, step0, FOSSIL_MATH_OPTIM_C2_CG, &a, &ft) != 0) {
+            if (restarted) break;
+            for (size_t i = 0; i < n; ++i) d[i] = -g[i];
+            dg0 = -gn * gn;
+            step0 = FOSSIL_MATH_MIN(1.0, 1.0 / gn);
+            restarted = 1;
+            continue;
+        }
+        ++st.iterations;
+        st.step = a * fossil_math_optim_norm(d, n);
+
+        // Polak-Ribiere+ update, restarted every n iterations
+        double gg = fossil_math_algebra_dot(g, g, n);
+        double beta = (fossil_math_algebra_dot(gt, gt, n) - fossil_math_algebra_dot(gt, g, n)) / gg;
+        if (!(beta > 0.0) || st.iterations % n == 0) beta = 0.0;
+        for (size_t i = 0; i < n; ++i) d[i] = -gt[i] + beta * d[i];
+
+        double f_prev = fx;
+        memcpy(x, xt, n * sizeof(double));
+        memcpy(g, gt, n * sizeof(double));
+        fx = ft;
+        gn = fossil_math_optim_norm(g, n);
+        st.f = fx;
+        st.grad_norm = gn;
+
+        double dg = fossil_math_algebra_dot(g, d, n);
+        restarted = beta == 0.0;
+        if (!(dg < 0.0)) {
+            for (size_t i = 0; i < n; ++i) d[i] = -g[i];
+            dg = -gn * gn;
+            restarted = 1;
+        }
+        // Carry the first-order change of the previous step over to the new direction
+        step0 = a * dg0 / dg;
+        if (!isfinite(step0) || step0 <= 0.0) step0 = 1.0;
+        dg0 = dg;
+
+        if (fossil_math_optim_interrupted(&o, &st)) { status = -5; break; }
+        if (gn <= o.tol_grad) status = 0;
+        else if (f_prev - fx <= o.tol_f * (1.0 + fabs(fx))) status = 0;
+        else if (st.step <= o.tol_x * (1.0 + fossil_math_optim_norm(x, n))) status = 0;
+    }
+
+    st.converged = status == 0;
+    fossil_math_optim_report(info, &st);
+    fossil_math_optim_workspace_destroy(owned);
+    return status;
+}
+
+// ============================================================================
+// Nelder-Mead
+// ============================================================================
+
+// NaN objective values rank behind every finite one
+static int fossil_math_optim_less(double a, double b) {
+    return a < b || (isnan(b) && !isnan(a));
+}
+
+int fossil_math_optim_nelder_mead(fossil_math_optim_func_t f, void* ctx, double* x, size_t n,
+                                  const fossil_math_optim_options_t* opts, fossil_math_optim_workspace_t* ws,
+                                  fossil_math_optim_info_t* info) {
+    fossil_math_optim_info_t st = { 0, 0, NAN, NAN, NAN, 0 };
+    fossil_math_optim_report(info, &st);
+    if (!f || !x || n == 0) return -1;
+
+    fossil_math_optim_options_t o;
+    if (opts) o = *opts; else fossil_math_optim_options_default(&o);
+
+    fossil_math_optim_workspace_t* owned;
+    int status = fossil_math_optim_acquire(ws, n, 0, &ws, &owned);
+    if (status != 0) return status;
+
+    double* V = ws->buf;            // (n + 1) x n vertices
+    double* fv = V + (n + 1) * n;   // vertex values
+    double* c = fv + n + 1;         // centroid of the best n vertices
+    double* xr = c + n;             // reflected point
+    double* xe = xr + n;            // expanded or contracted point
+    size_t* order = ws->order;
+
+    // Gao-Han adaptive coefficients; they reduce to the classic 2, 1/2, 1/2 at n = 2,
+    // which are also used for n = 1 where the adaptive shrink would collapse the simplex
+    double dn = (double)FOSSIL_MATH_MAX(n, (size_t)2);
+    double expand = 1.0 + 2.0 / dn;
+    double contract = 0.75 - 0.5 / dn;
+    double shrink = 1.0 - 1.0 / dn;
+
+    for (size_t i = 0; i <= n; ++i) {
+        double* v = V + i * n;
+        memcpy(v, x, n * sizeof(double));
+        if (i > 0) v[i - 1] = (x[i - 1] != 0.0) ? 1.05 * x[i - 1] : 0.00025;
+        fv[i] = f(v, ctx);
+        order[i] = i;
+    }
+    st.evaluations = n + 1;
+    status = -4;
+
+    for (;;) {
+        // Insertion sort keeps the nearly ordered ranking cheap
+        for (size_t i = 1; i <= n; ++i) {
+            size_t k = order[i];
+            size_t j = i;
+            while (j > 0 && fossil_math_optim_less(fv[k], fv[order[j - 1]])) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = k;
+        }
+        const double* best = V + order[0] * n;
+        double* worst = V + order[n] * n;
+        double diameter = 0.0, scale = 0.0;
+        for (size_t i = 1; i <= n; ++i) {
+            const double* v = V + order[i] * n;
+            for (size_t j = 0; j < n; ++j) diameter = FOSSIL_MATH_MAX(diameter, fabs(v[j] - best[j]));
+        }
+        for (size_t j = 0; j < n; ++j) scale = FOSSIL_MATH_MAX(scale, fabs(best[j]));
+        st.f = fv[order[0]];
+        st.step = diameter;
+
+        if (st.iterations > 0 && fossil_math_optim_interrupted(&o, &st)) { status = -5; break; }
+        if (fv[order[n]] - fv[order[0]] <= o.tol_f * (1.0 + fabs(fv[order[0]])) &&
+            diameter <= o.tol_x * (1.0 + scale)) {
+            status = 0;
+            break;
+        }
+        if (st.iterations >= o.max_iter) break;
+        ++st.iterations;
+
+        memset(c, 0, n * sizeof(double));
+        for (size_t i = 0; i < n; ++i) {
+            const double* v = V + order[i] * n;
+            for (size_t j = 0; j < n; ++j) c[j] += v[j];
+        }
+        for (size_t j = 0; j < n; ++j) {
+            c[j] /= (double)n;
+            xr[j] = 2.0 * c[j] - worst[j];
+        }
+        double fr = f(xr, ctx);
+        ++st.evaluations;
+
+        size_t w = order[n];
+        if (fossil_math_optim_less(fr, fv[order[0]])) {
+            for (size_t j = 0; j < n; ++j) xe[j] = c[j] + expand * (xr[j] - c[j]);
+            double fe = f(xe, ctx);
+            ++st.evaluations;
+            int take_e = fossil_math_optim_less(fe, fr);
+            memcpy(worst, take_e ? xe : xr, n * sizeof(double));
+            fv[w] = take_e ? fe : fr;
+            continue;
+        }
+        if (fossil_math_optim_less(fr, fv[order[n - 1]])) {
+            memcpy(worst, xr, n * sizeof(double));
+            fv[w] = fr;
+            continue;
+        }
+
+        // Outside contraction toward xr, or inside contraction toward the worst vertex
+        int outside = fossil_math_optim_less(fr, fv[w]);
+        const double* toward = outside ? xr : worst;
+        for (size_t j = 0; j < n; ++j) xe[j] = c[j] + contract * (toward[j] - c[j]);
+        double fc = f(xe, ctx);
+        ++st.evaluations;
+        if (outside ? !fossil_math_optim_less(fr, fc) : fossil_math_optim_less(fc, fv[w])) {
+            memcpy(worst, xe, n * sizeof(double));
+            fv[w] = fc;
+            continue;
+        }
+
+        for (size_t i = 1; i <= n; ++i) {
+            double* v = V + order[i] * n;
+            for (size_t j = 0; j < n; ++j) v[j] = best[j] + shrink * (v[j] - best[j]);
+            fv[order[i]] = f(v, ctx);
+        }
+        st.evaluations += n;
+    }
+
+    memcpy(x, V + order[0] * n, n * sizeof(double));
+    st.converged = status == 0;
+    fossil_math_optim_report(info, &st);
+    fossil_math_optim_workspace_destroy(owned);
+    return status;
+}
@@ -0,0 +1,205 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "fossil/math/parallel.h"
+#include "fossil/math/instrument.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Upper bound on threads spawned for a single call
+#define FOSSIL_MATH_PARALLEL_MAX_THREADS 64
+
+static size_t fossil_math_parallel_thread_count = 0;
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+static size_t fossil_math_parallel_hardware_threads(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+void fossil_math_parallel_set_threads(size_t threads) {
+    fossil_math_parallel_thread_count = threads;
+}
+
+size_t fossil_math_parallel_threads(void) {
+    size_t n = fossil_math_parallel_thread_count;
+    if (n == 0) n = fossil_math_parallel_hardware_threads();
+    return FOSSIL_MATH_CLAMP(n, (size_t)1, (size_t)FOSSIL_MATH_PARALLEL_MAX_THREADS);
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+typedef struct {
+    fossil_math_parallel_fn_t fn;
+    void* ctx;
+    size_t begin;
+    size_t end;
+} fossil_math_parallel_chunk_t;
+
+// Runs one chunk; traces show it as [begin, begin + length) on its own thread
+static void fossil_math_parallel_run(const fossil_math_parallel_chunk_t* c) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    c->fn(c->begin, c->end, c->ctx);
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_PARALLEL_CHUNK, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_PARALLEL_CHUNK, c->begin, c->end - c->begin, 0);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI fossil_math_parallel_entry(LPVOID arg) {
+    fossil_math_parallel_run((const fossil_math_parallel_chunk_t*)arg);
+    return 0;
+}
+#else
+static void* fossil_math_parallel_entry(void* arg) {
+    fossil_math_parallel_run((const fossil_math_parallel_chunk_t*)arg);
+    return NULL;
+}
+#endif
+
+void fossil_math_parallel_for(size_t count, size_t grain, fossil_math_parallel_fn_t fn, void* ctx) {
+    if (!fn || count == 0) return;
+    if (grain == 0) grain = 1;
+
+    size_t chunks = fossil_math_parallel_threads();
+    if (chunks > count / grain) chunks = count / grain;
+    if (chunks <= 1) {
+        fossil_math_parallel_chunk_t all = {fn, ctx, 0, count};
+        fossil_math_parallel_run(&all);
+        return;
+    }
+
+    fossil_math_parallel_chunk_t work[FOSSIL_MATH_PARALLEL_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE handles[FOSSIL_MATH_PARALLEL_MAX_THREADS];
+#else
+    pthread_t handles[FOSSIL_MATH_PARALLEL_MAX_THREADS];
+#endif
+    int started[FOSSIL_MATH_PARALLEL_MAX_THREADS];
+
+    size_t base = count / chunks, extra = count % chunks, pos = 0;
+    for (size_t i = 0; i < chunks; ++i) {
+        size_t len = base + (i < extra ? 1 : 0);
+        work[i].fn = fn;
+        work[i].ctx = ctx;
+        work[i].begin = pos;
+        work[i].end = pos + len;
+        pos += len;
+    }
+
+    // Chunk 0 runs on the calling thread; the rest get their own thread, falling
+    // back to inline execution if a thread cannot be created.
+    for (size_t i = 1; i < chunks; ++i) {
+#if defined(_WIN32)
+        handles[i] = CreateThread(NULL, 0, fossil_math_parallel_entry, &work[i], 0, NULL);
+        started[i] = handles[i] != NULL;
+#else
+        started[i] = pthread_create(&handles[i], NULL, fossil_math_parallel_entry, &work[i]) == 0;
+#endif
+        if (!started[i]) fossil_math_parallel_run(&work[i]);
+    }
+
+    fossil_math_parallel_run(&work[0]);
+
+    for (size_t i = 1; i < chunks; ++i) {
+        if (!started[i]) continue;
+#if defined(_WIN32)
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#else
+        pthread_join(handles[i], NULL);
+#endif
+    }
+}
+
+// ============================================================================
+// Synchronization
+// ============================================================================
+
+struct fossil_math_mutex {
+#if defined(_WIN32)
+    CRITICAL_SECTION cs;
+#else
+    pthread_mutex_t m;
+#endif
+};
+
+fossil_math_mutex_t* fossil_math_mutex_create(void) {
+    fossil_math_mutex_t* mutex = malloc(sizeof(*mutex));
+    if (!mutex) return NULL;
+#if defined(_WIN32)
+    InitializeCriticalSection(&mutex->cs);
+#else
+    if (pthread_mutex_init(&mutex->m, NULL) != 0) {
+        free(mutex);
+        return NULL;
+    }
+#endif
+    return mutex;
+}
+
+void fossil_math_mutex_free(fossil_math_mutex_t* mutex) {
+    if (!mutex) return;
+#if defined(_WIN32)
+    DeleteCriticalSection(&mutex->cs);
+#else
+    pthread_mutex_destroy(&mutex->m);
+#endif
+    free(mutex);
+}
+
+void fossil_math_mutex_lock(fossil_math_mutex_t* mutex) {
+#if defined(_WIN32)
+    EnterCriticalSection(&mutex->cs);
+#else
+    pthread_mutex_lock(&mutex->m);
+#endif
+}
+
+void fossil_math_mutex_unlock(fossil_math_mutex_t* mutex) {
+#if defined(_WIN32)
+    LeaveCriticalSection(&mutex->cs);
+#else
+    pthread_mutex_unlock(&mutex->m);
+#endif
+}
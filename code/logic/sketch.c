@@ -0,0 +1,853 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/sketch.h"
+#include "fossil/math/parallel.h"
+#include <math.h>
+
+#define FOSSIL_MATH_TDIGEST_DEFAULT_COMPRESSION 100.0
+#define FOSSIL_MATH_KLL_DEFAULT_K 200
+// Largest k; a sketch holds up to about 3k values, so this caps its memory
+#define FOSSIL_MATH_KLL_MAX_K ((size_t)1 << 20)
+// Values per independently sketched chunk in the batch inserts
+#define FOSSIL_MATH_SKETCH_CHUNK 65536
+// Values a per-thread shard buffers before handing them to its sketch
+#define FOSSIL_MATH_SKETCH_HANDOFF 1024
+// Deserialization refuses sketches with more levels than this
+#define FOSSIL_MATH_KLL_MAX_LEVELS 60
+
+static const uint8_t fossil_math_tdigest_magic[4] = {'F', 'T', 'D', '1'};
+static const uint8_t fossil_math_kll_magic[4] = {'F', 'K', 'L', '1'};
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+static void fossil_math_sketch_put_u64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint64_t fossil_math_sketch_get_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static void fossil_math_sketch_put_f64(uint8_t* p, double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    fossil_math_sketch_put_u64(p, u);
+}
+
+static double fossil_math_sketch_get_f64(const uint8_t* p) {
+    uint64_t u = fossil_math_sketch_get_u64(p);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+static int fossil_math_sketch_compare(const void* x, const void* y) {
+    double a = *(const double*)x, b = *(const double*)y;
+    return (a > b) - (a < b);
+}
+
+// ============================================================================
+// t-digest
+// ============================================================================
+
+typedef struct {
+    double mean;
+    double weight;
+} fossil_math_tdigest_centroid_t;
+
+struct fossil_math_tdigest {
+    double compression;
+    double total;  // Weight of centroids and buffer together
+    double min;
+    double max;
+    size_t n;      // Centroids in use
+    size_t cap;
+    size_t nbuf;   // Buffered inserts
+    size_t buf_cap;
+    fossil_math_tdigest_centroid_t* c;
+    fossil_math_tdigest_centroid_t* buf;
+    fossil_math_tdigest_centroid_t* tmp;  // Merge scratch, cap + buf_cap entries
+};
+
+static int fossil_math_tdigest_compare(const void* x, const void* y) {
+    double a = ((const fossil_math_tdigest_centroid_t*)x)->mean, b = ((const fossil_math_tdigest_centroid_t*)y)->mean;
+    return (a > b) - (a < b);
+}
+
+// k1 scale function k(q) = delta / (2 pi) * asin(2q - 1) and its inverse
+static double fossil_math_tdigest_k(double delta, double q) {
+    return delta / (2.0 * FOSSIL_MATH_PI) * asin(2.0 * q - 1.0);
+}
+
+static double fossil_math_tdigest_k_inv(double delta, double k) {
+    if (k >= 0.25 * delta) return 1.0;
+    return 0.5 * (sin(k * 2.0 * FOSSIL_MATH_PI / delta) + 1.0);
+}
+
+// Folds the buffer into the centroids: sort, merge the two sorted runs, then
+// greedily combine neighbours while the cluster spans at most one k unit.
+static void fossil_math_tdigest_compress(fossil_math_tdigest_t* td) {
+    if (td->nbuf == 0) return;
+    qsort(td->buf, td->nbuf, sizeof(*td->buf), fossil_math_tdigest_compare);
+
+    size_t i = 0, j = 0, m = 0;
+    while (i < td->n || j < td->nbuf) {
+        if (j >= td->nbuf || (i < td->n && td->c[i].mean <= td->buf[j].mean))
+            td->tmp[m++] = td->c[i++];
+        else
+            td->tmp[m++] = td->buf[j++];
+    }
+
+    double W = td->total, delta = td->compression;
+    double before = 0.0;
+    double limit = W * fossil_math_tdigest_k_inv(delta, fossil_math_tdigest_k(delta, 0.0) + 1.0);
+    fossil_math_tdigest_centroid_t cur = td->tmp[0];
+    size_t out = 0;
+    for (size_t s = 1; s < m; ++s) {
+        fossil_math_tdigest_centroid_t next = td->tmp[s];
+        if (before + cur.weight + next.weight <= limit || out + 1 >= td->cap) {
+            cur.weight += next.weight;
+            cur.mean += (next.mean - cur.mean) * next.weight / cur.weight;
+        } else {
+            td->c[out++] = cur;
+            before += cur.weight;
+            limit = W * fossil_math_tdigest_k_inv(delta, fossil_math_tdigest_k(delta, before / W) + 1.0);
+            cur = next;
+        }
+    }
+    td->c[out++] = cur;
+    td->n = out;
+    td->nbuf = 0;
+}
+
+static void fossil_math_tdigest_push(fossil_math_tdigest_t* td, double x, double weight) {
+    if (td->nbuf == td->buf_cap) fossil_math_tdigest_compress(td);
+    td->buf[td->nbuf].mean = x;
+    td->buf[td->nbuf].weight = weight;
+    td->nbuf++;
+    td->total += weight;
+    td->min = x < td->min ? x : td->min;
+    td->max = x > td->max ? x : td->max;
+}
+
+fossil_math_tdigest_t* fossil_math_tdigest_create(double compression) {
+    if (!(compression > 0.0)) compression = FOSSIL_MATH_TDIGEST_DEFAULT_COMPRESSION;
+    if (compression < 10.0) compression = 10.0;
+    if (compression > 1e6) compression = 1e6;
+
+    fossil_math_tdigest_t* td = calloc(1, sizeof(*td));
+    if (!td) return NULL;
+    td->compression = compression;
+    td->cap = (size_t)ceil(compression) + 8;
+    td->buf_cap = 4 * td->cap;
+    td->c = malloc((2 * td->cap + 2 * td->buf_cap) * sizeof(*td->c));
+    if (!td->c) {
+        free(td);
+        return NULL;
+    }
+    td->buf = td->c + td->cap;
+    td->tmp = td->buf + td->buf_cap;
+    td->min = INFINITY;
+    td->max = -INFINITY;
+    return td;
+}
+
+void fossil_math_tdigest_free(fossil_math_tdigest_t* td) {
+    if (!td) return;
+    free(td->c);
+    free(td);
+}
+
+int fossil_math_tdigest_add(fossil_math_tdigest_t* td, double x, double weight) {
+    if (!td || isnan(x) || !(weight > 0.0) || !isfinite(weight)) return -1;
+    fossil_math_tdigest_push(td, x, weight);
+    return 0;
+}
+
+typedef struct {
+    double compression;
+    const double* x;
+    size_t count;
+    fossil_math_tdigest_t** part;
+} fossil_math_tdigest_job_t;
+
+static void fossil_math_tdigest_chunk(size_t begin, size_t end, void* ctx) {
+    fossil_math_tdigest_job_t* job = (fossil_math_tdigest_job_t*)ctx;
+    for (size_t c = begin; c < end; ++c) {
+        fossil_math_tdigest_t* td = fossil_math_tdigest_create(job->compression);
+        job->part[c] = td;
+        if (!td) continue;
+        size_t lo = c * FOSSIL_MATH_SKETCH_CHUNK;
+        size_t hi = FOSSIL_MATH_MIN(job->count, lo + FOSSIL_MATH_SKETCH_CHUNK);
+        for (size_t i = lo; i < hi; ++i) {
+            if (!isnan(job->x[i])) fossil_math_tdigest_push(td, job->x[i], 1.0);
+        }
+        fossil_math_tdigest_compress(td);
+    }
+}
+
+int fossil_math_tdigest_add_batch(fossil_math_tdigest_t* td, const double* x, size_t count) {
+    if (!td || (!x && count > 0)) return -1;
+    size_t chunks = (count + FOSSIL_MATH_SKETCH_CHUNK - 1) / FOSSIL_MATH_SKETCH_CHUNK;
+    if (chunks <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!isnan(x[i])) fossil_math_tdigest_push(td, x[i], 1.0);
+        }
+        return 0;
+    }
+
+    fossil_math_tdigest_job_t job = {td->compression, x, count, calloc(chunks, sizeof(fossil_math_tdigest_t*))};
+    if (!job.part) return -2;
+    fossil_math_parallel_for(chunks, 1, fossil_math_tdigest_chunk, &job);
+    int status = 0;
+    for (size_t c = 0; c < chunks; ++c) {
+        if (!job.part[c]) status = -2;
+        else fossil_math_tdigest_merge(td, job.part[c]);
+        fossil_math_tdigest_free(job.part[c]);
+    }
+    free(job.part);
+    return status;
+}
+
+int fossil_math_tdigest_merge(fossil_math_tdigest_t* dst, const fossil_math_tdigest_t* src) {
+    if (!dst || !src || dst == src) return -1;
+    for (size_t i = 0; i < src->n; ++i) fossil_math_tdigest_push(dst, src->c[i].mean, src->c[i].weight);
+    for (size_t i = 0; i < src->nbuf; ++i) fossil_math_tdigest_push(dst, src->buf[i].mean, src->buf[i].weight);
+    // Centroid means lie inside the source range; carry its true extremes over
+    dst->min = fmin(dst->min, src->min);
+    dst->max = fmax(dst->max, src->max);
+    return 0;
+}
+
+double fossil_math_tdigest_count(const fossil_math_tdigest_t* td) {
+    return td ? td->total : 0.0;
+}
+
+double fossil_math_tdigest_min(const fossil_math_tdigest_t* td) {
+    return (td && td->total > 0.0) ? td->min : NAN;
+}
+
+double fossil_math_tdigest_max(const fossil_math_tdigest_t* td) {
+    return (td && td->total > 0.0) ? td->max : NAN;
+}
+
+// Quantiles interpolate linearly between centroid centres, where the centre
+// of centroid i sits at cumulative weight sum_{j<i} w_j + w_i / 2. The first
+// and last half-centroids interpolate towards the exact min and max.
+double fossil_math_tdigest_quantile(fossil_math_tdigest_t* td, double q) {
+    if (!td || td->total <= 0.0 || !(q >= 0.0 && q <= 1.0)) return NAN;
+    fossil_math_tdigest_compress(td);
+    const fossil_math_tdigest_centroid_t* c = td->c;
+    size_t n = td->n;
+    double W = td->total, index = q * W;
+
+    double center = 0.5 * c[0].weight;
+    if (index <= center) return td->min + (c[0].mean - td->min) * index / center;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double next = center + 0.5 * (c[i].weight + c[i + 1].weight);
+        if (index <= next) return c[i].mean + (c[i + 1].mean - c[i].mean) * (index - center) / (next - center);
+        center = next;
+    }
+    double tail = W - center;
+    return c[n - 1].mean + (td->max - c[n - 1].mean) * (tail > 0.0 ? (index - center) / tail : 1.0);
+}
+
+double fossil_math_tdigest_cdf(fossil_math_tdigest_t* td, double x) {
+    if (!td || td->total <= 0.0 || isnan(x)) return NAN;
+    if (x < td->min) return 0.0;
+    if (x >= td->max) return 1.0;
+    fossil_math_tdigest_compress(td);
+    const fossil_math_tdigest_centroid_t* c = td->c;
+    size_t n = td->n;
+    double W = td->total;
+
+    double center = 0.5 * c[0].weight;
+    if (x < c[0].mean) return center * (x - td->min) / (c[0].mean - td->min) / W;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double next = center + 0.5 * (c[i].weight + c[i + 1].weight);
+        if (x < c[i + 1].mean) return (center + (next - center) * (x - c[i].mean) / (c[i + 1].mean - c[i].mean)) / W;
+        center = next;
+    }
+    return (center + (W - center) * (x - c[n - 1].mean) / (td->max - c[n - 1].mean)) / W;
+}
+
+// Layout: magic[4], compression, min, max (f64), centroid count (u64),
+// then (mean, weight) f64 pairs in increasing mean order.
+size_t fossil_math_tdigest_serialize(fossil_math_tdigest_t* td, uint8_t* buf, size_t capacity) {
+    if (!td) return 0;
+    fossil_math_tdigest_compress(td);
+    size_t size = 4 + 4 * 8 + td->n * 16;
+    if (!buf || capacity < size) return size;
+
+    memcpy(buf, fossil_math_tdigest_magic, 4);
+    uint8_t* p = buf + 4;
+    fossil_math_sketch_put_f64(p, td->compression);
+    fossil_math_sketch_put_f64(p + 8, td->min);
+    fossil_math_sketch_put_f64(p + 16, td->max);
+    fossil_math_sketch_put_u64(p + 24, (uint64_t)td->n);
+    p += 32;
+    for (size_t i = 0; i < td->n; ++i, p += 16) {
+        fossil_math_sketch_put_f64(p, td->c[i].mean);
+        fossil_math_sketch_put_f64(p + 8, td->c[i].weight);
+    }
+    return size;
+}
+
+fossil_math_tdigest_t* fossil_math_tdigest_deserialize(const uint8_t* buf, size_t size) {
+    if (!buf || size < 36 || memcmp(buf, fossil_math_tdigest_magic, 4) != 0) return NULL;
+    double compression = fossil_math_sketch_get_f64(buf + 4);
+    uint64_t n = fossil_math_sketch_get_u64(buf + 28);
+    if (!(compression >= 10.0 && compression <= 1e6) || n > (size - 36) / 16 || size != 36 + n * 16) return NULL;
+
+    fossil_math_tdigest_t* td = fossil_math_tdigest_create(compression);
+    if (!td) return NULL;
+    if (n > td->cap) {
+        fossil_math_tdigest_free(td);
+        return NULL;
+    }
+    td->min = fossil_math_sketch_get_f64(buf + 12);
+    td->max = fossil_math_sketch_get_f64(buf + 20);
+    // Infinite extremes are legitimate (add accepts them); NaN or min > max is not
+    if (n > 0 && !(td->min <= td->max)) {
+        fossil_math_tdigest_free(td);
+        return NULL;
+    }
+    const uint8_t* p = buf + 36;
+    for (size_t i = 0; i < n; ++i, p += 16) {
+        double mean = fossil_math_sketch_get_f64(p), weight = fossil_math_sketch_get_f64(p + 8);
+        if (isnan(mean) || !(weight > 0.0) || !isfinite(weight) || mean < td->min || mean > td->max ||
+            (i > 0 && mean < td->c[i - 1].mean)) {
+            fossil_math_tdigest_free(td);
+            return NULL;
+        }
+        td->c[i].mean = mean;
+        td->c[i].weight = weight;
+        td->total += weight;
+    }
+    td->n = (size_t)n;
+    if (n == 0) {
+        td->min = INFINITY;
+        td->max = -INFINITY;
+    }
+    return td;
+}
+
+// ============================================================================
+// KLL
+// ============================================================================
+
+struct fossil_math_kll {
+    size_t k;
+    size_t levels;
+    size_t* size;    // Items held per level
+    size_t* alloc;   // Allocated slots per level
+    double** items;  // An item at level h stands for 2^h inputs
+    size_t held;     // Items across all levels
+    size_t max_held; // Sum of level capacities; reaching it triggers a compaction
+    uint64_t n;
+    double min;
+    double max;
+    uint64_t rng;
+};
+
+typedef struct {
+    double value;
+    uint64_t weight;
+} fossil_math_kll_item_t;
+
+// Capacity of level h: k * (2/3)^depth below the top, at least 2
+static size_t fossil_math_kll_capacity(const fossil_math_kll_t* kll, size_t h) {
+    size_t depth = kll->levels - h - 1;
+    size_t cap = (size_t)ceil((double)kll->k * pow(2.0 / 3.0, (double)depth));
+    return cap < 2 ? 2 : cap;
+}
+
+// xorshift64*; only the top bit is used to pick the surviving half
+static int fossil_math_kll_coin(fossil_math_kll_t* kll) {
+    kll->rng ^= kll->rng >> 12;
+    kll->rng ^= kll->rng << 25;
+    kll->rng ^= kll->rng >> 27;
+    return (int)((kll->rng * 2685821657736338717ULL) >> 63);
+}
+
+static int fossil_math_kll_reserve(fossil_math_kll_t* kll, size_t h, size_t need) {
+    if (kll->alloc[h] >= need) return 0;
+    size_t cap = FOSSIL_MATH_MAX(need, 2 * kll->alloc[h]);
+    cap = FOSSIL_MATH_MAX(cap, (size_t)8);
+    double* items = realloc(kll->items[h], cap * sizeof(double));
+    if (!items) return -2;
+    kll->items[h] = items;
+    kll->alloc[h] = cap;
+    return 0;
+}
+
+static int fossil_math_kll_grow(fossil_math_kll_t* kll) {
+    size_t L = kll->levels + 1;
+    size_t* size = realloc(kll->size, L * sizeof(size_t));
+    if (!size) return -2;
+    kll->size = size;
+    size_t* alloc = realloc(kll->alloc, L * sizeof(size_t));
+    if (!alloc) return -2;
+    kll->alloc = alloc;
+    double** items = realloc(kll->items, L * sizeof(double*));
+    if (!items) return -2;
+    kll->items = items;
+
+    kll->size[L - 1] = 0;
+    kll->alloc[L - 1] = 0;
+    kll->items[L - 1] = NULL;
+    kll->levels = L;
+    kll->max_held = 0;
+    for (size_t h = 0; h < L; ++h) kll->max_held += fossil_math_kll_capacity(kll, h);
+    return 0;
+}
+
+// Compacts the lowest over-full level: sort it and promote every other item
+// (random parity) to the next level. An odd item stays behind.
+static int fossil_math_kll_compress(fossil_math_kll_t* kll) {
+    for (size_t h = 0; h < kll->levels; ++h) {
+        if (kll->size[h] < fossil_math_kll_capacity(kll, h)) continue;
+        if (h + 1 == kll->levels && fossil_math_kll_grow(kll) != 0) return -2;
+
+        size_t len = kll->size[h], odd = len & 1, pairs = len / 2;
+        if (fossil_math_kll_reserve(kll, h + 1, kll->size[h + 1] + pairs) != 0) return -2;
+        double* src = kll->items[h];
+        qsort(src, len, sizeof(double), fossil_math_sketch_compare);
+        size_t offset = odd + (size_t)fossil_math_kll_coin(kll);
+        double* dst = kll->items[h + 1] + kll->size[h + 1];
+        for (size_t p = 0; p < pairs; ++p) dst[p] = src[offset + 2 * p];
+        kll->size[h + 1] += pairs;
+        kll->size[h] = odd;
+        kll->held -= pairs;
+        return 0;
+    }
+    return 0;
+}
+
+static int fossil_math_kll_settle(fossil_math_kll_t* kll) {
+    while (kll->held >= kll->max_held) {
+        if (fossil_math_kll_compress(kll) != 0) return -2;
+    }
+    return 0;
+}
+
+static fossil_math_kll_t* fossil_math_kll_create_seeded(size_t k, uint64_t seed) {
+    fossil_math_kll_t* kll = calloc(1, sizeof(*kll));
+    if (!kll) return NULL;
+    kll->k = k == 0 ? FOSSIL_MATH_KLL_DEFAULT_K : FOSSIL_MATH_MIN(FOSSIL_MATH_MAX(k, (size_t)8), FOSSIL_MATH_KLL_MAX_K);
+    kll->min = INFINITY;
+    kll->max = -INFINITY;
+    kll->rng = (seed + 1) * 0x9E3779B97F4A7C15ULL;
+    if (fossil_math_kll_grow(kll) != 0) {
+        fossil_math_kll_free(kll);
+        return NULL;
+    }
+    return kll;
+}
+
+fossil_math_kll_t* fossil_math_kll_create(size_t k) {
+    return fossil_math_kll_create_seeded(k, 0);
+}
+
+void fossil_math_kll_free(fossil_math_kll_t* kll) {
+    if (!kll) return;
+    for (size_t h = 0; h < kll->levels; ++h) free(kll->items[h]);
+    free(kll->items);
+    free(kll->alloc);
+    free(kll->size);
+    free(kll);
+}
+
+int fossil_math_kll_add(fossil_math_kll_t* kll, double x) {
+    if (!kll || isnan(x)) return -1;
+    if (fossil_math_kll_reserve(kll, 0, kll->size[0] + 1) != 0) return -2;
+    kll->items[0][kll->size[0]++] = x;
+    kll->held++;
+    kll->n++;
+    kll->min = x < kll->min ? x : kll->min;
+    kll->max = x > kll->max ? x : kll->max;
+    return fossil_math_kll_settle(kll);
+}
+
+typedef struct {
+    size_t k;
+    const double* x;
+    size_t count;
+    fossil_math_kll_t** part;
+} fossil_math_kll_job_t;
+
+static void fossil_math_kll_chunk(size_t begin, size_t end, void* ctx) {
+    fossil_math_kll_job_t* job = (fossil_math_kll_job_t*)ctx;
+    for (size_t c = begin; c < end; ++c) {
+        fossil_math_kll_t* kll = fossil_math_kll_create_seeded(job->k, (uint64_t)c + 1);
+        size_t lo = c * FOSSIL_MATH_SKETCH_CHUNK;
+        size_t hi = FOSSIL_MATH_MIN(job->count, lo + FOSSIL_MATH_SKETCH_CHUNK);
+        for (size_t i = lo; kll && i < hi; ++i) {
+            if (fossil_math_kll_add(kll, job->x[i]) == -2) {
+                fossil_math_kll_free(kll);
+                kll = NULL;
+            }
+        }
+        job->part[c] = kll;
+    }
+}
+
+int fossil_math_kll_add_batch(fossil_math_kll_t* kll, const double* x, size_t count) {
+    if (!kll || (!x && count > 0)) return -1;
+    size_t chunks = (count + FOSSIL_MATH_SKETCH_CHUNK - 1) / FOSSIL_MATH_SKETCH_CHUNK;
+    if (chunks <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            if (fossil_math_kll_add(kll, x[i]) == -2) return -2;
+        }
+        return 0;
+    }
+
+    fossil_math_kll_job_t job = {kll->k, x, count, calloc(chunks, sizeof(fossil_math_kll_t*))};
+    if (!job.part) return -2;
+    fossil_math_parallel_for(chunks, 1, fossil_math_kll_chunk, &job);
+    int status = 0;
+    for (size_t c = 0; c < chunks; ++c) {
+        if (!job.part[c] || (status == 0 && fossil_math_kll_merge(kll, job.part[c]) != 0)) status = -2;
+        fossil_math_kll_free(job.part[c]);
+    }
+    free(job.part);
+    return status;
+}
+
+int fossil_math_kll_merge(fossil_math_kll_t* dst, const fossil_math_kll_t* src) {
+    if (!dst || !src || dst == src) return -1;
+    while (dst->levels < src->levels) {
+        if (fossil_math_kll_grow(dst) != 0) return -2;
+    }
+    for (size_t h = 0; h < src->levels; ++h) {
+        if (src->size[h] == 0) continue;
+        if (fossil_math_kll_reserve(dst, h, dst->size[h] + src->size[h]) != 0) return -2;
+        memcpy(dst->items[h] + dst->size[h], src->items[h], src->size[h] * sizeof(double));
+        dst->size[h] += src->size[h];
+        dst->held += src->size[h];
+    }
+    dst->n += src->n;
+    dst->min = fmin(dst->min, src->min);
+    dst->max = fmax(dst->max, src->max);
+    return fossil_math_kll_settle(dst);
+}
+
+uint64_t fossil_math_kll_count(const fossil_math_kll_t* kll) {
+    return kll ? kll->n : 0;
+}
+
+double fossil_math_kll_min(const fossil_math_kll_t* kll) {
+    return (kll && kll->n > 0) ? kll->min : NAN;
+}
+
+double fossil_math_kll_max(const fossil_math_kll_t* kll) {
+    return (kll && kll->n > 0) ? kll->max : NAN;
+}
+
+static int fossil_math_kll_item_compare(const void* x, const void* y) {
+    double a = ((const fossil_math_kll_item_t*)x)->value, b = ((const fossil_math_kll_item_t*)y)->value;
+    return (a > b) - (a < b);
+}
+
+double fossil_math_kll_quantile(const fossil_math_kll_t* kll, double q) {
+    if (!kll || kll->n == 0 || !(q >= 0.0 && q <= 1.0)) return NAN;
+    if (q == 0.0) return kll->min;
+    if (q == 1.0) return kll->max;
+
+    fossil_math_kll_item_t* all = malloc(kll->held * sizeof(*all));
+    if (!all) return NAN;
+    size_t m = 0;
+    for (size_t h = 0; h < kll->levels; ++h) {
+        for (size_t i = 0; i < kll->size[h]; ++i) {
+            all[m].value = kll->items[h][i];
+            all[m].weight = (uint64_t)1 << h;
+            m++;
+        }
+    }
+    qsort(all, m, sizeof(*all), fossil_math_kll_item_compare);
+
+    double target = q * (double)kll->n;
+    double result = kll->max;
+    uint64_t cum = 0;
+    for (size_t i = 0; i < m; ++i) {
+        cum += all[i].weight;
+        if ((double)cum >= target) {
+            result = all[i].value;
+            break;
+        }
+    }
+    free(all);
+    return result;
+}
+
+double fossil_math_kll_cdf(const fossil_math_kll_t* kll, double x) {
+    if (!kll || kll->n == 0 || isnan(x)) return NAN;
+    uint64_t below = 0;
+    for (size_t h = 0; h < kll->levels; ++h) {
+        size_t c = 0;
+        for (size_t i = 0; i < kll->size[h]; ++i) c += kll->items[h][i] <= x;
+        below += (uint64_t)c << h;
+    }
+    return (double)below / (double)kll->n;
+}
+
+// Layout: magic[4], k, n (u64), min, max (f64), rng state, level count (u64),
+// then per level its item count (u64) followed by the items (f64).
+size_t fossil_math_kll_serialize(const fossil_math_kll_t* kll, uint8_t* buf, size_t capacity) {
+    if (!kll) return 0;
+    size_t size = 4 + 6 * 8 + kll->levels * 8 + kll->held * 8;
+    if (!buf || capacity < size) return size;
+
+    memcpy(buf, fossil_math_kll_magic, 4);
+    uint8_t* p = buf + 4;
+    fossil_math_sketch_put_u64(p, (uint64_t)kll->k);
+    fossil_math_sketch_put_u64(p + 8, kll->n);
+    fossil_math_sketch_put_f64(p + 16, kll->min);
+    fossil_math_sketch_put_f64(p + 24, kll->max);
+    fossil_math_sketch_put_u64(p + 32, kll->rng);
+    fossil_math_sketch_put_u64(p + 40, (uint64_t)kll->levels);
+    p += 48;
+    for (size_t h = 0; h < kll->levels; ++h) {
+        fossil_math_sketch_put_u64(p, (uint64_t)kll->size[h]);
+        p += 8;
+        for (size_t i = 0; i < kll->size[h]; ++i, p += 8) fossil_math_sketch_put_f64(p, kll->items[h][i]);
+    }
+    return size;
+}
+
+fossil_math_kll_t* fossil_math_kll_deserialize(const uint8_t* buf, size_t size) {
+    if (!buf || size < 52 || memcmp(buf, fossil_math_kll_magic, 4) != 0) return NULL;
+    uint64_t k = fossil_math_sketch_get_u64(buf + 4);
+    uint64_t levels = fossil_math_sketch_get_u64(buf + 44);
+    if (k < 8 || k > FOSSIL_MATH_KLL_MAX_K || levels == 0 || levels > FOSSIL_MATH_KLL_MAX_LEVELS) return NULL;
+
+    fossil_math_kll_t* kll = fossil_math_kll_create_seeded((size_t)k, 0);
+    if (!kll) return NULL;
+    kll->n = fossil_math_sketch_get_u64(buf + 12);
+    kll->min = fossil_math_sketch_get_f64(buf + 20);
+    kll->max = fossil_math_sketch_get_f64(buf + 28);
+    kll->rng = fossil_math_sketch_get_u64(buf + 36);
+
+    const uint8_t* p = buf + 52;
+    const uint8_t* end = buf + size;
+    uint64_t weight = 0;
+    int ok = kll->rng != 0;
+    for (size_t h = 0; ok && h < levels; ++h) {
+        if ((h >= kll->levels && fossil_math_kll_grow(kll) != 0) || (size_t)(end - p) < 8) {
+            ok = 0;
+            break;
+        }
+        uint64_t len = fossil_math_sketch_get_u64(p);
+        p += 8;
+        if (len > (uint64_t)(end - p) / 8 || fossil_math_kll_reserve(kll, h, (size_t)len) != 0) {
+            ok = 0;
+            break;
+        }
+        for (size_t i = 0; i < len; ++i, p += 8) {
+            double v = fossil_math_sketch_get_f64(p);
+            ok &= !isnan(v) && v >= kll->min && v <= kll->max;
+            kll->items[h][i] = v;
+        }
+        kll->size[h] = (size_t)len;
+        kll->held += (size_t)len;
+        // Checked so that a wrapped total cannot match n
+        if (len > (UINT64_MAX - weight) >> h) {
+            ok = 0;
+            break;
+        }
+        weight += len << h;
+    }
+    ok = ok && p == end && weight == kll->n && kll->held < kll->max_held;
+    if (!ok) {
+        fossil_math_kll_free(kll);
+        return NULL;
+    }
+    return kll;
+}
+
+// ============================================================================
+// Per-thread sets
+// ============================================================================
+//
+// Every shard pairs a value buffer, written only by its producer and never
+// locked, with a sketch guarded by the shard's mutex. A full buffer is handed
+// off by folding it into the sketch under the mutex; readers merge the shard
+// sketches under the same mutexes. The lock is therefore only taken once per
+// FOSSIL_MATH_SKETCH_HANDOFF values and only contended by a concurrent read.
+
+typedef struct {
+    fossil_math_mutex_t* lock;
+    void* sketch;  // fossil_math_tdigest_t or fossil_math_kll_t, guarded by lock
+    size_t nbuf;   // Owned by the producer, like buf
+    double buf[FOSSIL_MATH_SKETCH_HANDOFF];
+} fossil_math_sketch_shard_t;
+
+struct fossil_math_tdigest_shards {
+    size_t count;
+    fossil_math_sketch_shard_t** shard;
+};
+
+struct fossil_math_kll_shards {
+    size_t count;
+    fossil_math_sketch_shard_t** shard;
+};
+
+// Frees the shards and their mutexes; the caller frees the sketches first
+static void fossil_math_sketch_shards_free(fossil_math_sketch_shard_t** shard, size_t count) {
+    if (!shard) return;
+    for (size_t i = 0; i < count; ++i) {
+        if (shard[i]) fossil_math_mutex_free(shard[i]->lock);
+        free(shard[i]);
+    }
+    free(shard);
+}
+
+static fossil_math_sketch_shard_t** fossil_math_sketch_shards_alloc(size_t count) {
+    fossil_math_sketch_shard_t** shard = calloc(count, sizeof(*shard));
+    if (!shard) return NULL;
+    for (size_t i = 0; i < count; ++i) {
+        shard[i] = calloc(1, sizeof(**shard));
+        if (!shard[i] || !(shard[i]->lock = fossil_math_mutex_create())) {
+            fossil_math_sketch_shards_free(shard, count);
+            return NULL;
+        }
+    }
+    return shard;
+}
+
+static void fossil_math_tdigest_handoff(fossil_math_sketch_shard_t* s) {
+    fossil_math_mutex_lock(s->lock);
+    for (size_t i = 0; i < s->nbuf; ++i) fossil_math_tdigest_push((fossil_math_tdigest_t*)s->sketch, s->buf[i], 1.0);
+    fossil_math_mutex_unlock(s->lock);
+    s->nbuf = 0;
+}
+
+fossil_math_tdigest_shards_t* fossil_math_tdigest_shards_create(double compression, size_t shards) {
+    if (shards == 0) return NULL;
+    fossil_math_tdigest_shards_t* set = calloc(1, sizeof(*set));
+    if (!set) return NULL;
+    set->count = shards;
+    set->shard = fossil_math_sketch_shards_alloc(shards);
+    int ok = set->shard != NULL;
+    for (size_t i = 0; ok && i < shards; ++i) ok = (set->shard[i]->sketch = fossil_math_tdigest_create(compression)) != NULL;
+    if (!ok) {
+        fossil_math_tdigest_shards_free(set);
+        return NULL;
+    }
+    return set;
+}
+
+void fossil_math_tdigest_shards_free(fossil_math_tdigest_shards_t* set) {
+    if (!set) return;
+    for (size_t i = 0; set->shard && i < set->count; ++i) fossil_math_tdigest_free((fossil_math_tdigest_t*)set->shard[i]->sketch);
+    fossil_math_sketch_shards_free(set->shard, set->count);
+    free(set);
+}
+
+int fossil_math_tdigest_shards_add(fossil_math_tdigest_shards_t* set, size_t shard, double x) {
+    if (!set || shard >= set->count || isnan(x)) return -1;
+    fossil_math_sketch_shard_t* s = set->shard[shard];
+    s->buf[s->nbuf++] = x;
+    if (s->nbuf == FOSSIL_MATH_SKETCH_HANDOFF) fossil_math_tdigest_handoff(s);
+    return 0;
+}
+
+int fossil_math_tdigest_shards_flush(fossil_math_tdigest_shards_t* set, size_t shard) {
+    if (!set || shard >= set->count) return -1;
+    fossil_math_tdigest_handoff(set->shard[shard]);
+    return 0;
+}
+
+int fossil_math_tdigest_shards_snapshot(fossil_math_tdigest_shards_t* set, fossil_math_tdigest_t* out) {
+    if (!set || !out) return -1;
+    for (size_t i = 0; i < set->count; ++i) {
+        fossil_math_sketch_shard_t* s = set->shard[i];
+        fossil_math_mutex_lock(s->lock);
+        fossil_math_tdigest_merge(out, (const fossil_math_tdigest_t*)s->sketch);
+        fossil_math_mutex_unlock(s->lock);
+    }
+    return 0;
+}
+
+// On allocation failure the rest of the buffer is dropped
+static int fossil_math_kll_handoff(fossil_math_sketch_shard_t* s) {
+    int status = 0;
+    fossil_math_mutex_lock(s->lock);
+    for (size_t i = 0; status == 0 && i < s->nbuf; ++i) status = fossil_math_kll_add((fossil_math_kll_t*)s->sketch, s->buf[i]);
+    fossil_math_mutex_unlock(s->lock);
+    s->nbuf = 0;
+    return status;
+}
+
+fossil_math_kll_shards_t* fossil_math_kll_shards_create(size_t k, size_t shards) {
+    if (shards == 0) return NULL;
+    fossil_math_kll_shards_t* set = calloc(1, sizeof(*set));
+    if (!set) return NULL;
+    set->count = shards;
+    set->shard = fossil_math_sketch_shards_alloc(shards);
+    int ok = set->shard != NULL;
+    // Seeded by shard so that shards do not compact in lockstep
+    for (size_t i = 0; ok && i < shards; ++i) ok = (set->shard[i]->sketch = fossil_math_kll_create_seeded(k, (uint64_t)i)) != NULL;
+    if (!ok) {
+        fossil_math_kll_shards_free(set);
+        return NULL;
+    }
+    return set;
+}
+
+void fossil_math_kll_shards_free(fossil_math_kll_shards_t* set) {
+    if (!set) return;
+    for (size_t i = 0; set->shard && i < set->count; ++i) fossil_math_kll_free((fossil_math_kll_t*)set->shard[i]->sketch);
+    fossil_math_sketch_shards_free(set->shard, set->count);
+    free(set);
+}
+
+int fossil_math_kll_shards_add(fossil_math_kll_shards_t* set, size_t shard, double x) {
+    if (!set || shard >= set->count || isnan(x)) return -1;
+    fossil_math_sketch_shard_t* s = set->shard[shard];
+    s->buf[s->nbuf++] = x;
+    return s->nbuf == FOSSIL_MATH_SKETCH_HANDOFF ? fossil_math_kll_handoff(s) : 0;
+}
+
+int fossil_math_kll_shards_flush(fossil_math_kll_shards_t* set, size_t shard) {
+    if (!set || shard >= set->count) return -1;
+    return fossil_math_kll_handoff(set->shard[shard]);
+}
+
+int fossil_math_kll_shards_snapshot(fossil_math_kll_shards_t* set, fossil_math_kll_t* out) {
+    if (!set || !out) return -1;
+    int status = 0;
+    for (size_t i = 0; status == 0 && i < set->count; ++i) {
+        fossil_math_sketch_shard_t* s = set->shard[i];
+        fossil_math_mutex_lock(s->lock);
+        status = fossil_math_kll_merge(out, (const fossil_math_kll_t*)s->sketch);
+        fossil_math_mutex_unlock(s->lock);
+    }
+    return status;
+}
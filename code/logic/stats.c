@@ -0,0 +1,214 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/stats.h"
+#include "fossil/math/parallel.h"
+#include <math.h>
+
+// Samples per block in push_batch, and per parallel chunk in compute
+#define FOSSIL_MATH_STATS_BLOCK 256
+#define FOSSIL_MATH_STATS_CHUNK 16384
+// Independent accumulator lanes in the block kernel
+#define FOSSIL_MATH_STATS_LANES 4
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+// Moments of one block by two passes over the data, with lane-split sums so
+// the loops carry no serial dependency.
+static void fossil_math_stats_block(const double* x, size_t n, fossil_math_stats_t* out) {
+    double sum[FOSSIL_MATH_STATS_LANES], lo[FOSSIL_MATH_STATS_LANES], hi[FOSSIL_MATH_STATS_LANES];
+    double c2[FOSSIL_MATH_STATS_LANES], c3[FOSSIL_MATH_STATS_LANES], c4[FOSSIL_MATH_STATS_LANES];
+    for (size_t l = 0; l < FOSSIL_MATH_STATS_LANES; ++l) {
+        sum[l] = c2[l] = c3[l] = c4[l] = 0.0;
+        lo[l] = INFINITY;
+        hi[l] = -INFINITY;
+    }
+
+    size_t body = n - n % FOSSIL_MATH_STATS_LANES;
+    for (size_t i = 0; i < body; i += FOSSIL_MATH_STATS_LANES) {
+        for (size_t l = 0; l < FOSSIL_MATH_STATS_LANES; ++l) {
+            double v = x[i + l];
+            sum[l] += v;
+            lo[l] = v < lo[l] ? v : lo[l];
+            hi[l] = v > hi[l] ? v : hi[l];
+        }
+    }
+    for (size_t i = body; i < n; ++i) {
+        sum[0] += x[i];
+        lo[0] = x[i] < lo[0] ? x[i] : lo[0];
+        hi[0] = x[i] > hi[0] ? x[i] : hi[0];
+    }
+    double mean = (sum[0] + sum[1] + sum[2] + sum[3]) / (double)n;
+
+    for (size_t i = 0; i < body; i += FOSSIL_MATH_STATS_LANES) {
+        for (size_t l = 0; l < FOSSIL_MATH_STATS_LANES; ++l) {
+            double d = x[i + l] - mean, d2 = d * d;
+            c2[l] += d2;
+            c3[l] += d2 * d;
+            c4[l] += d2 * d2;
+        }
+    }
+    for (size_t i = body; i < n; ++i) {
+        double d = x[i] - mean, d2 = d * d;
+        c2[0] += d2;
+        c3[0] += d2 * d;
+        c4[0] += d2 * d2;
+    }
+
+    out->count = n;
+    out->mean = mean;
+    out->m2 = c2[0] + c2[1] + c2[2] + c2[3];
+    out->m3 = c3[0] + c3[1] + c3[2] + c3[3];
+    out->m4 = c4[0] + c4[1] + c4[2] + c4[3];
+    out->min = fmin(fmin(lo[0], lo[1]), fmin(lo[2], lo[3]));
+    out->max = fmax(fmax(hi[0], hi[1]), fmax(hi[2], hi[3]));
+}
+
+// ============================================================================
+// Accumulation
+// ============================================================================
+
+void fossil_math_stats_init(fossil_math_stats_t* s) {
+    if (!s) return;
+    s->count = 0;
+    s->mean = 0.0;
+    s->m2 = 0.0;
+    s->m3 = 0.0;
+    s->m4 = 0.0;
+    s->min = INFINITY;
+    s->max = -INFINITY;
+}
+
+void fossil_math_stats_push(fossil_math_stats_t* s, double x) {
+    if (!s) return;
+    double n1 = (double)s->count;
+    double n = n1 + 1.0;
+    double delta = x - s->mean;
+    double dn = delta / n;
+    double dn2 = dn * dn;
+    double term = delta * dn * n1;
+
+    s->count++;
+    s->mean += dn;
+    s->m4 += term * dn2 * (n * n - 3.0 * n + 3.0) + 6.0 * dn2 * s->m2 - 4.0 * dn * s->m3;
+    s->m3 += term * dn * (n - 2.0) - 3.0 * dn * s->m2;
+    s->m2 += term;
+    s->min = x < s->min ? x : s->min;
+    s->max = x > s->max ? x : s->max;
+}
+
+void fossil_math_stats_push_batch(fossil_math_stats_t* s, const double* x, size_t count) {
+    if (!s || !x) return;
+    fossil_math_stats_t block;
+    for (size_t lo = 0; lo < count; lo += FOSSIL_MATH_STATS_BLOCK) {
+        fossil_math_stats_block(x + lo, FOSSIL_MATH_MIN(count - lo, (size_t)FOSSIL_MATH_STATS_BLOCK), &block);
+        fossil_math_stats_merge(s, &block);
+    }
+}
+
+void fossil_math_stats_merge(fossil_math_stats_t* s, const fossil_math_stats_t* other) {
+    if (!s || !other || other->count == 0) return;
+    fossil_math_stats_t b = *other;
+    if (s->count == 0) {
+        *s = b;
+        return;
+    }
+
+    double na = (double)s->count, nb = (double)b.count, n = na + nb;
+    double d = b.mean - s->mean;
+    double d2 = d * d;
+    double m2a = s->m2, m3a = s->m3, m4a = s->m4;
+
+    s->mean += d * nb / n;
+    s->m2 = m2a + b.m2 + d2 * na * nb / n;
+    s->m3 = m3a + b.m3 + d2 * d * na * nb * (na - nb) / (n * n) + 3.0 * d * (na * b.m2 - nb * m2a) / n;
+    s->m4 = m4a + b.m4 + d2 * d2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n) +
+            6.0 * d2 * (na * na * b.m2 + nb * nb * m2a) / (n * n) + 4.0 * d * (na * b.m3 - nb * m3a) / n;
+    s->count += b.count;
+    s->min = fmin(s->min, b.min);
+    s->max = fmax(s->max, b.max);
+}
+
+typedef struct {
+    const double* x;
+    size_t count;
+    fossil_math_stats_t* partial;
+} fossil_math_stats_job_t;
+
+static void fossil_math_stats_chunk(size_t begin, size_t end, void* ctx) {
+    fossil_math_stats_job_t* job = (fossil_math_stats_job_t*)ctx;
+    for (size_t c = begin; c < end; ++c) {
+        size_t lo = c * FOSSIL_MATH_STATS_CHUNK;
+        fossil_math_stats_init(&job->partial[c]);
+        fossil_math_stats_push_batch(&job->partial[c], job->x + lo,
+                                     FOSSIL_MATH_MIN(job->count - lo, (size_t)FOSSIL_MATH_STATS_CHUNK));
+    }
+}
+
+int fossil_math_stats_compute(const double* x, size_t count, fossil_math_stats_t* out) {
+    if (!out || (!x && count > 0)) return -1;
+    fossil_math_stats_init(out);
+    if (count == 0) return 0;
+
+    size_t chunks = (count + FOSSIL_MATH_STATS_CHUNK - 1) / FOSSIL_MATH_STATS_CHUNK;
+    if (chunks == 1) {
+        fossil_math_stats_push_batch(out, x, count);
+        return 0;
+    }
+    fossil_math_stats_job_t job = {x, count, malloc(chunks * sizeof(fossil_math_stats_t))};
+    if (!job.partial) return -2;
+
+    fossil_math_parallel_for(chunks, 1, fossil_math_stats_chunk, &job);
+    for (size_t c = 0; c < chunks; ++c) fossil_math_stats_merge(out, &job.partial[c]);
+    free(job.partial);
+    return 0;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+
+double fossil_math_stats_mean(const fossil_math_stats_t* s) {
+    return (s && s->count > 0) ? s->mean : NAN;
+}
+
+double fossil_math_stats_variance(const fossil_math_stats_t* s) {
+    return (s && s->count > 1) ? s->m2 / (double)(s->count - 1) : NAN;
+}
+
+double fossil_math_stats_stddev(const fossil_math_stats_t* s) {
+    return sqrt(fossil_math_stats_variance(s));
+}
+
+double fossil_math_stats_skewness(const fossil_math_stats_t* s) {
+    if (!s || s->count == 0 || !(s->m2 > 0.0)) return NAN;
+    return sqrt((double)s->count) * s->m3 / pow(s->m2, 1.5);
+}
+
+double fossil_math_stats_kurtosis(const fossil_math_stats_t* s) {
+    if (!s || s->count == 0 || !(s->m2 > 0.0)) return NAN;
+    return (double)s->count * s->m4 / (s->m2 * s->m2) - 3.0;
+}
@@ -22,8 +22,25 @@
  * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
  * -----------------------------------------------------------------------------
  */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "fossil/math/symbolic.h"
+#include "fossil/math/parallel.h"
+#include "fossil/math/instrument.h"
+#include <float.h>
 #include <math.h>
+#include <stdarg.h>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 // ============================================================================
 // Internal Helpers
@@ -32,8 +49,116 @@
 static fossil_math_sym_expr_t* fossil_math_sym_new_const(double value);
 static fossil_math_sym_expr_t* fossil_math_sym_new_var(const char* name);
 static fossil_math_sym_expr_t* fossil_math_sym_new_op(char op, fossil_math_sym_expr_t* left, fossil_math_sym_expr_t* right);
-static const char* fossil_math_sym_parse_expr(const char* s, fossil_math_sym_expr_t** out);
 static double fossil_math_sym_eval_internal(const fossil_math_sym_expr_t* expr, double (*var_lookup)(const char*));
+static fossil_math_sym_node_t fossil_math_sym_graph_var_n(fossil_math_sym_graph_t* g, const char* name, size_t len);
+static int fossil_math_sym_grow(void** data, size_t* cap, size_t need, size_t elem);
+
+// Capacity of a variable name, including the terminator
+#define FOSSIL_MATH_SYM_NAME_MAX sizeof(((fossil_math_sym_expr_t*)0)->name)
+
+// ============================================================================
+// Operators
+// ============================================================================
+
+typedef enum {
+    FOSSIL_MATH_SYM_OP_ADD,
+    FOSSIL_MATH_SYM_OP_SUB,
+    FOSSIL_MATH_SYM_OP_MUL,
+    FOSSIL_MATH_SYM_OP_DIV,
+    FOSSIL_MATH_SYM_OP_POW,
+    FOSSIL_MATH_SYM_OP_NEG,
+    FOSSIL_MATH_SYM_OP_SIN,
+    FOSSIL_MATH_SYM_OP_COS,
+    FOSSIL_MATH_SYM_OP_EXP,
+    FOSSIL_MATH_SYM_OP_LOG,
+    FOSSIL_MATH_SYM_OP_SQRT,
+    FOSSIL_MATH_SYM_OP_ABS,
+    FOSSIL_MATH_SYM_OP_MIN,
+    FOSSIL_MATH_SYM_OP_MAX
+} fossil_math_sym_opcode_t;
+
+typedef struct {
+    char op;             // node operator character
+    const char* name;    // function name in source text, NULL for operators
+    const char* c_name;  // C library function used by emitted code
+    int arity;
+    uint32_t code;       // bytecode opcode
+} fossil_math_sym_opinfo_t;
+
+// Indexed by opcode
+static const fossil_math_sym_opinfo_t fossil_math_sym_ops[] = {
+    { '+',                  NULL,   NULL,    2, FOSSIL_MATH_SYM_OP_ADD  },
+    { '-',                  NULL,   NULL,    2, FOSSIL_MATH_SYM_OP_SUB  },
+    { '*',                  NULL,   NULL,    2, FOSSIL_MATH_SYM_OP_MUL  },
+    { '/',                  NULL,   NULL,    2, FOSSIL_MATH_SYM_OP_DIV  },
+    { '^',                  NULL,   "pow",   2, FOSSIL_MATH_SYM_OP_POW  },
+    { FOSSIL_MATH_SYM_NEG,  NULL,   NULL,    1, FOSSIL_MATH_SYM_OP_NEG  },
+    { FOSSIL_MATH_SYM_SIN,  "sin",  "sin",   1, FOSSIL_MATH_SYM_OP_SIN  },
+    { FOSSIL_MATH_SYM_COS,  "cos",  "cos",   1, FOSSIL_MATH_SYM_OP_COS  },
+    { FOSSIL_MATH_SYM_EXP,  "exp",  "exp",   1, FOSSIL_MATH_SYM_OP_EXP  },
+    { FOSSIL_MATH_SYM_LOG,  "log",  "log",   1, FOSSIL_MATH_SYM_OP_LOG  },
+    { FOSSIL_MATH_SYM_SQRT, "sqrt", "sqrt",  1, FOSSIL_MATH_SYM_OP_SQRT },
+    { FOSSIL_MATH_SYM_ABS,  "abs",  "fabs",  1, FOSSIL_MATH_SYM_OP_ABS  },
+    { FOSSIL_MATH_SYM_MIN,  "min",  "fmin",  2, FOSSIL_MATH_SYM_OP_MIN  },
+    { FOSSIL_MATH_SYM_MAX,  "max",  "fmax",  2, FOSSIL_MATH_SYM_OP_MAX  },
+};
+
+#define FOSSIL_MATH_SYM_NOPS (sizeof(fossil_math_sym_ops) / sizeof(fossil_math_sym_ops[0]))
+
+static const fossil_math_sym_opinfo_t* fossil_math_sym_opinfo(char op) {
+    fossil_math_sym_opcode_t code;
+    switch (op) {
+        case '+': code = FOSSIL_MATH_SYM_OP_ADD; break;
+        case '-': code = FOSSIL_MATH_SYM_OP_SUB; break;
+        case '*': code = FOSSIL_MATH_SYM_OP_MUL; break;
+        case '/': code = FOSSIL_MATH_SYM_OP_DIV; break;
+        case '^': code = FOSSIL_MATH_SYM_OP_POW; break;
+        case FOSSIL_MATH_SYM_NEG: code = FOSSIL_MATH_SYM_OP_NEG; break;
+        case FOSSIL_MATH_SYM_SIN: code = FOSSIL_MATH_SYM_OP_SIN; break;
+        case FOSSIL_MATH_SYM_COS: code = FOSSIL_MATH_SYM_OP_COS; break;
+        case FOSSIL_MATH_SYM_EXP: code = FOSSIL_MATH_SYM_OP_EXP; break;
+        case FOSSIL_MATH_SYM_LOG: code = FOSSIL_MATH_SYM_OP_LOG; break;
+        case FOSSIL_MATH_SYM_SQRT: code = FOSSIL_MATH_SYM_OP_SQRT; break;
+        case FOSSIL_MATH_SYM_ABS: code = FOSSIL_MATH_SYM_OP_ABS; break;
+        case FOSSIL_MATH_SYM_MIN: code = FOSSIL_MATH_SYM_OP_MIN; break;
+        case FOSSIL_MATH_SYM_MAX: code = FOSSIL_MATH_SYM_OP_MAX; break;
+        default: return NULL;
+    }
+    return &fossil_math_sym_ops[code];
+}
+
+// Number of operands of op, or 0 if op is unknown
+static int fossil_math_sym_arity(char op) {
+    const fossil_math_sym_opinfo_t* info = fossil_math_sym_opinfo(op);
+    return info ? info->arity : 0;
+}
+
+// Whether op is written as a function call, name(args)
+static int fossil_math_sym_is_call(char op) {
+    const fossil_math_sym_opinfo_t* info = fossil_math_sym_opinfo(op);
+    return info && info->name;
+}
+
+// Applies op to a and b (b is ignored by unary operators)
+static double fossil_math_sym_apply(char op, double a, double b) {
+    switch (op) {
+        case '+': return a + b;
+        case '-': return a - b;
+        case '*': return a * b;
+        case '/': return (b != 0.0) ? a / b : NAN;
+        case '^': return pow(a, b);
+        case FOSSIL_MATH_SYM_NEG: return -a;
+        case FOSSIL_MATH_SYM_SIN: return sin(a);
+        case FOSSIL_MATH_SYM_COS: return cos(a);
+        case FOSSIL_MATH_SYM_EXP: return exp(a);
+        case FOSSIL_MATH_SYM_LOG: return log(a);
+        case FOSSIL_MATH_SYM_SQRT: return sqrt(a);
+        case FOSSIL_MATH_SYM_ABS: return fabs(a);
+        case FOSSIL_MATH_SYM_MIN: return fmin(a, b);
+        case FOSSIL_MATH_SYM_MAX: return fmax(a, b);
+        default: return NAN;
+    }
+}
 
 // ============================================================================
 // Node Constructors
@@ -77,44 +202,206 @@ void fossil_math_sym_free(fossil_math_sym_expr_t* expr) {
     free(expr);
 }
 
+fossil_math_sym_expr_t* fossil_math_sym_copy(const fossil_math_sym_expr_t* expr) {
+    if (!expr) return NULL;
+    fossil_math_sym_expr_t* e = malloc(sizeof(*e));
+    if (!e) return NULL;
+    *e = *expr;
+    e->left = fossil_math_sym_copy(expr->left);
+    e->right = fossil_math_sym_copy(expr->right);
+    if ((expr->left && !e->left) || (expr->right && !e->right)) {
+        fossil_math_sym_free(e);
+        return NULL;
+    }
+    return e;
+}
+
 // ============================================================================
-// Parser (simple recursive descent)
+// Parser
 // ============================================================================
 //
 // Grammar (lowest → highest precedence):
 //   expr   = term { ('+'|'-') term }
-//   term   = factor { ('*'|'/') factor }
-//   factor = number | variable | '(' expr ')'
+//   term   = unary { ('*'|'/') unary }
+//   unary  = '-' unary | power
+//   power  = factor [ '^' unary ]
+//   factor = number | constant | function '(' expr [ ',' expr ] ')'
+//          | variable | '(' expr ')'
+//
+// The grammar is parsed by precedence climbing over a token stream read in
+// place from a length-delimited buffer. Nodes are built directly in their
+// destination: interned into a graph, or allocated as tree nodes that are
+// also recorded in a flat list, so a failed parse frees them without
+// walking a half-linked tree. Either way operands are plain handles.
 //
 // ============================================================================
 
-static const char* fossil_math_sym_parse_number(const char* s, double* out) {
-    char* end;
-    *out = strtod(s, &end);
-    return (end == s) ? NULL : end;
-}
-
-static int fossil_math_sym_is_const_name(const char* s, size_t* len, double* value) {
-    // Recognize constants: pi, e, ln2, ln10, sqrt2, sqrt1_2, deg2rad, rad2deg, log2e, log10e, two_pi, half_pi
-    struct { const char* name; double val; } table[] = {
-        { "pi",       FOSSIL_MATH_PI },
-        { "e",        FOSSIL_MATH_E },
-        { "ln2",      FOSSIL_MATH_LN2 },
-        { "ln10",     FOSSIL_MATH_LN10 },
-        { "sqrt2",    FOSSIL_MATH_SQRT2 },
-        { "sqrt1_2",  FOSSIL_MATH_SQRT1_2 },
-        { "deg2rad",  FOSSIL_MATH_DEG2RAD },
-        { "rad2deg",  FOSSIL_MATH_RAD2DEG },
-        { "log2e",    FOSSIL_MATH_LOG2E },
-        { "log10e",   FOSSIL_MATH_LOG10E },
-        { "two_pi",   FOSSIL_MATH_TWO_PI },
-        { "half_pi",  FOSSIL_MATH_HALF_PI },
+// Binding powers: operators bind their right operand at their own power
+// (one less for right-associative ^); unary minus sits between * and ^
+#define FOSSIL_MATH_SYM_BP_SUM 10
+#define FOSSIL_MATH_SYM_BP_PRODUCT 20
+#define FOSSIL_MATH_SYM_BP_UNARY 25
+#define FOSSIL_MATH_SYM_BP_POWER 30
+// Longest numeric literal accepted
+#define FOSSIL_MATH_SYM_NUMBER_MAX 64
+
+// Token kinds besides the punctuation characters themselves
+#define FOSSIL_MATH_SYM_TOK_END '\0'
+#define FOSSIL_MATH_SYM_TOK_NUMBER '0'
+#define FOSSIL_MATH_SYM_TOK_NAME 'a'
+
+typedef struct {
+    fossil_math_sym_graph_t* g;         // destination graph, or NULL to build a tree
+    fossil_math_sym_expr_t** nodes;     // tree nodes built so far, indexed by handle
+    size_t count;
+    size_t cap;
+    const char* s;
+    size_t len;
+    size_t pos;      // next unread byte
+    char tok;        // current token kind
+    size_t start;    // current token is s[start, pos)
+    double value;    // value of a number token
+    int depth;
+    fossil_math_sym_parse_error_t err;
+} fossil_math_sym_parser_t;
+
+// Records the first error; the parse unwinds once one is set
+static fossil_math_sym_node_t fossil_math_sym_parse_fail(fossil_math_sym_parser_t* p, fossil_math_sym_parse_status_t status, size_t offset) {
+    if (p->err.status == FOSSIL_MATH_SYM_PARSE_OK) {
+        p->err.status = status;
+        p->err.offset = offset;
+    }
+    return FOSSIL_MATH_SYM_NONE;
+}
+
+// ASCII classes; <ctype.h> would go through the locale for every byte
+static int fossil_math_sym_is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static int fossil_math_sym_is_name_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int fossil_math_sym_is_name_char(char c) {
+    return fossil_math_sym_is_name_start(c) || fossil_math_sym_is_digit(c);
+}
+
+static int fossil_math_sym_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Powers of ten exactly representable as doubles
+static const double fossil_math_sym_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static void fossil_math_sym_lex_number(fossil_math_sym_parser_t* p) {
+    const char* s = p->s;
+    size_t i = p->pos, len = p->len;
+    uint64_t mantissa = 0;
+    int digits = 0, scale = 0, dots = 0, exp10 = 0;
+    for (; i < len && (fossil_math_sym_is_digit(s[i]) || s[i] == '.'); ++i) {
+        if (s[i] == '.') {
+            ++dots;
+        } else if (mantissa || s[i] != '0') {
+            if (++digits <= 19) mantissa = mantissa * 10 + (uint64_t)(s[i] - '0');
+            if (dots) --scale;
+        } else if (dots) {
+            --scale;
+        }
+    }
+    // An exponent needs digits, so 2e reads as 2 followed by the name e
+    if (i < len && (s[i] == 'e' || s[i] == 'E')) {
+        size_t j = i + 1;
+        int negative = j < len && s[j] == '-';
+        if (j < len && (s[j] == '+' || s[j] == '-')) ++j;
+        if (j < len && fossil_math_sym_is_digit(s[j])) {
+            for (i = j; i < len && fossil_math_sym_is_digit(s[i]); ++i) {
+                if (exp10 < 100000) exp10 = exp10 * 10 + (s[i] - '0');
+            }
+            if (negative) exp10 = -exp10;
+        }
+    }
+    p->pos = i;
+    size_t n = i - p->start;
+    if (dots > 1 || n == (size_t)dots) {
+        fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_BAD_NUMBER, p->start);
+        return;
+    }
+
+    // Clinger's fast path: an exact mantissa times an exact power of ten
+    // rounds once, so the result is correctly rounded like strtod's
+    int e = scale + exp10;
+    if (digits <= 15 && e >= -22 && e <= 22) {
+        double m = (double)mantissa;
+        p->value = e < 0 ? m / fossil_math_sym_pow10[-e] : m * fossil_math_sym_pow10[e];
+        return;
+    }
+
+    // strtod needs a terminator, so only long literals are copied
+    char buf[FOSSIL_MATH_SYM_NUMBER_MAX];
+    char* end = buf;
+    if (n < sizeof(buf)) {
+        memcpy(buf, s + p->start, n);
+        buf[n] = '\0';
+        p->value = strtod(buf, &end);
+    }
+    if (end != buf + n) fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_BAD_NUMBER, p->start);
+}
+
+static void fossil_math_sym_lex(fossil_math_sym_parser_t* p) {
+    // Locals: stores through p could alias the text, which would force reloads
+    const char* s = p->s;
+    size_t i = p->pos, len = p->len;
+    while (i < len && fossil_math_sym_is_space(s[i])) ++i;
+    p->start = i;
+    p->pos = i;
+    if (i >= len) {
+        p->tok = FOSSIL_MATH_SYM_TOK_END;
+        return;
+    }
+    char c = s[i];
+    switch (c) {
+        case '+': case '-': case '*': case '/': case '^': case '(': case ')': case ',':
+            p->tok = c;
+            p->pos = i + 1;
+            return;
+        default:
+            break;
+    }
+    if (fossil_math_sym_is_digit(c) || c == '.') {
+        p->tok = FOSSIL_MATH_SYM_TOK_NUMBER;
+        fossil_math_sym_lex_number(p);
+    } else if (fossil_math_sym_is_name_start(c)) {
+        p->tok = FOSSIL_MATH_SYM_TOK_NAME;
+        while (i < len && fossil_math_sym_is_name_char(s[i])) ++i;
+        p->pos = i;
+    } else {
+        p->tok = FOSSIL_MATH_SYM_TOK_END;
+        fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_UNEXPECTED_CHAR, i);
+    }
+}
+
+// Looks up a named constant (pi, e, ln2, ...) by exact name
+static int fossil_math_sym_const_name(const char* s, size_t len, double* value) {
+    static const struct { const char* name; size_t len; double val; } table[] = {
+        { "pi",      2, FOSSIL_MATH_PI },
+        { "e",       1, FOSSIL_MATH_E },
+        { "ln2",     3, FOSSIL_MATH_LN2 },
+        { "ln10",    4, FOSSIL_MATH_LN10 },
+        { "sqrt2",   5, FOSSIL_MATH_SQRT2 },
+        { "sqrt1_2", 7, FOSSIL_MATH_SQRT1_2 },
+        { "deg2rad", 7, FOSSIL_MATH_DEG2RAD },
+        { "rad2deg", 7, FOSSIL_MATH_RAD2DEG },
+        { "log2e",   5, FOSSIL_MATH_LOG2E },
+        { "log10e",  6, FOSSIL_MATH_LOG10E },
+        { "two_pi",  6, FOSSIL_MATH_TWO_PI },
+        { "half_pi", 7, FOSSIL_MATH_HALF_PI },
     };
-    for (size_t i = 0; i < sizeof(table)/sizeof(table[0]); ++i) {
-        size_t nlen = strlen(table[i].name);
-        if (strncmp(s, table[i].name, nlen) == 0 &&
-            !isalnum((unsigned char)s[nlen]) && s[nlen] != '_') {
-            *len = nlen;
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); ++i) {
+        if (table[i].len == len && memcmp(s, table[i].name, len) == 0) {
             *value = table[i].val;
             return 1;
         }
@@ -122,108 +409,242 @@ static int fossil_math_sym_is_const_name(const char* s, size_t* len, double* val
     return 0;
 }
 
-static const char* fossil_math_sym_parse_factor(const char* s, fossil_math_sym_expr_t** out) {
-    while (isspace((unsigned char)*s)) ++s;
+// Maps allocation failure to an error at the current token
+static fossil_math_sym_node_t fossil_math_sym_parse_node(fossil_math_sym_parser_t* p, fossil_math_sym_node_t n) {
+    return n == FOSSIL_MATH_SYM_NONE ? fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_NO_MEMORY, p->start) : n;
+}
+
+// Records a new tree node and returns its handle
+static fossil_math_sym_node_t fossil_math_sym_parse_keep(fossil_math_sym_parser_t* p, fossil_math_sym_expr_t* e) {
+    if (!e || p->count >= FOSSIL_MATH_SYM_NONE ||
+        fossil_math_sym_grow((void**)&p->nodes, &p->cap, p->count + 1, sizeof(*p->nodes)) != 0) {
+        free(e);
+        return fossil_math_sym_parse_node(p, FOSSIL_MATH_SYM_NONE);
+    }
+    p->nodes[p->count] = e;
+    return (fossil_math_sym_node_t)p->count++;
+}
+
+static fossil_math_sym_node_t fossil_math_sym_parse_const(fossil_math_sym_parser_t* p, double value) {
+    if (p->g) return fossil_math_sym_parse_node(p, fossil_math_sym_graph_const(p->g, value));
+    return fossil_math_sym_parse_keep(p, fossil_math_sym_new_const(value));
+}
 
-    if (isdigit((unsigned char)*s) || *s == '.') {
-        double val;
-        const char* end = fossil_math_sym_parse_number(s, &val);
-        if (!end) return NULL;
-        *out = fossil_math_sym_new_const(val);
-        return end;
+static fossil_math_sym_node_t fossil_math_sym_parse_var(fossil_math_sym_parser_t* p, const char* name, size_t len) {
+    if (p->g) return fossil_math_sym_parse_node(p, fossil_math_sym_graph_var_n(p->g, name, len));
+    fossil_math_sym_expr_t* e = calloc(1, sizeof(*e));
+    if (e) {
+        e->type = fossil_math_sym_VAR;
+        memcpy(e->name, name, len);
     }
+    return fossil_math_sym_parse_keep(p, e);
+}
 
-    // Check for known constants
-    size_t clen = 0;
-    double cval = 0.0;
-    if (fossil_math_sym_is_const_name(s, &clen, &cval)) {
-        *out = fossil_math_sym_new_const(cval);
-        return s + clen;
+// Builds a op b; unary operators take a alone
+static fossil_math_sym_node_t fossil_math_sym_parse_op(fossil_math_sym_parser_t* p, char op, fossil_math_sym_node_t a, fossil_math_sym_node_t b) {
+    if (p->g) return fossil_math_sym_parse_node(p, fossil_math_sym_graph_op(p->g, op, a, b));
+    int unary = fossil_math_sym_arity(op) == 1;
+    return fossil_math_sym_parse_keep(p, fossil_math_sym_new_op(op, p->nodes[a], unary ? NULL : p->nodes[b]));
+}
+
+// Negates a constant operand in place of building a negation; returns 0 if a is not constant
+static int fossil_math_sym_parse_negate(fossil_math_sym_parser_t* p, fossil_math_sym_node_t* a) {
+    if (!p->g) {
+        fossil_math_sym_expr_t* e = p->nodes[*a];
+        if (e->type != fossil_math_sym_CONST) return 0;
+        e->value = -e->value;
+        return 1;
     }
+    if (fossil_math_sym_graph_type(p->g, *a) != fossil_math_sym_CONST) return 0;
+    *a = fossil_math_sym_parse_const(p, -fossil_math_sym_graph_value(p->g, *a));
+    return 1;
+}
 
-    if (isalpha((unsigned char)*s)) {
-        char name[32];
-        size_t i = 0;
-        while (isalnum((unsigned char)*s) && i < sizeof(name) - 1)
-            name[i++] = *s++;
-        name[i] = '\0';
-        *out = fossil_math_sym_new_var(name);
-        return s;
+static fossil_math_sym_node_t fossil_math_sym_parse_expr(fossil_math_sym_parser_t* p, int min_bp);
+
+// Parses an operand at a deeper nesting level
+static fossil_math_sym_node_t fossil_math_sym_parse_nested(fossil_math_sym_parser_t* p, int min_bp) {
+    if (++p->depth > FOSSIL_MATH_SYM_PARSE_DEPTH) return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_TOO_DEEP, p->start);
+    fossil_math_sym_node_t n = fossil_math_sym_parse_expr(p, min_bp);
+    --p->depth;
+    return n;
+}
+
+// Parses the arguments of a call; the current token is its '('
+static fossil_math_sym_node_t fossil_math_sym_parse_call(fossil_math_sym_parser_t* p, const fossil_math_sym_opinfo_t* f) {
+    fossil_math_sym_node_t args[2] = {FOSSIL_MATH_SYM_NONE, FOSSIL_MATH_SYM_NONE};
+    for (int i = 0; i < f->arity; ++i) {
+        fossil_math_sym_lex(p);
+        args[i] = fossil_math_sym_parse_nested(p, 0);
+        if (p->err.status) return FOSSIL_MATH_SYM_NONE;
+        char want = i + 1 < f->arity ? ',' : ')';
+        if (p->tok != want) {
+            int is_arg_list = p->tok == ',' || p->tok == ')';
+            return fossil_math_sym_parse_fail(p, is_arg_list ? FOSSIL_MATH_SYM_PARSE_ARGUMENTS : FOSSIL_MATH_SYM_PARSE_UNCLOSED, p->start);
+        }
     }
+    fossil_math_sym_lex(p);
+    return fossil_math_sym_parse_op(p, f->op, args[0], args[f->arity - 1]);
+}
+
+static fossil_math_sym_node_t fossil_math_sym_parse_name(fossil_math_sym_parser_t* p) {
+    const char* name = p->s + p->start;
+    size_t len = p->pos - p->start, at = p->start;
+    fossil_math_sym_lex(p);
+    if (p->err.status) return FOSSIL_MATH_SYM_NONE;
 
-    if (*s == '(') {
-        s = fossil_math_sym_parse_expr(s + 1, out);
-        if (!s || *s != ')') return NULL;
-        return s + 1;
+    if (p->tok == '(') {
+        for (size_t k = 0; k < FOSSIL_MATH_SYM_NOPS; ++k) {
+            const fossil_math_sym_opinfo_t* f = &fossil_math_sym_ops[k];
+            if (f->name && strncmp(f->name, name, len) == 0 && f->name[len] == '\0') return fossil_math_sym_parse_call(p, f);
+        }
+        return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_UNKNOWN_FUNCTION, at);
     }
 
-    return NULL;
+    double value;
+    if (fossil_math_sym_const_name(name, len, &value)) return fossil_math_sym_parse_const(p, value);
+
+    if (len >= FOSSIL_MATH_SYM_NAME_MAX) return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_NAME_TOO_LONG, at);
+    return fossil_math_sym_parse_var(p, name, len);
+}
+
+// Parses an operand: the prefix forms of the grammar
+static fossil_math_sym_node_t fossil_math_sym_parse_operand(fossil_math_sym_parser_t* p) {
+    switch (p->tok) {
+        case FOSSIL_MATH_SYM_TOK_NUMBER: {
+            double value = p->value;
+            fossil_math_sym_lex(p);
+            return fossil_math_sym_parse_const(p, value);
+        }
+        case FOSSIL_MATH_SYM_TOK_NAME:
+            return fossil_math_sym_parse_name(p);
+        case '(': {
+            fossil_math_sym_lex(p);
+            fossil_math_sym_node_t inner = fossil_math_sym_parse_nested(p, 0);
+            if (p->err.status) return FOSSIL_MATH_SYM_NONE;
+            if (p->tok != ')') return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_UNCLOSED, p->start);
+            fossil_math_sym_lex(p);
+            return inner;
+        }
+        case '-': {
+            fossil_math_sym_lex(p);
+            fossil_math_sym_node_t operand = fossil_math_sym_parse_nested(p, FOSSIL_MATH_SYM_BP_UNARY);
+            if (p->err.status) return FOSSIL_MATH_SYM_NONE;
+            // Negative literals are constants, not negations
+            if (fossil_math_sym_parse_negate(p, &operand)) return operand;
+            return fossil_math_sym_parse_op(p, FOSSIL_MATH_SYM_NEG, operand, operand);
+        }
+        default:
+            return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND, p->start);
+    }
 }
 
-static const char* fossil_math_sym_parse_term(const char* s, fossil_math_sym_expr_t** out) {
-    s = fossil_math_sym_parse_factor(s, out);
-    if (!s) return NULL;
+static int fossil_math_sym_binding_power(char tok) {
+    switch (tok) {
+        case '+': case '-': return FOSSIL_MATH_SYM_BP_SUM;
+        case '*': case '/': return FOSSIL_MATH_SYM_BP_PRODUCT;
+        case '^': return FOSSIL_MATH_SYM_BP_POWER;
+        default: return 0;
+    }
+}
 
-    while (1) {
-        while (isspace((unsigned char)*s)) ++s;
-        if (*s == '*' || *s == '/') {
-            char op = *s++;
-            fossil_math_sym_expr_t* rhs = NULL;
-            s = fossil_math_sym_parse_factor(s, &rhs);
-            if (!s || !rhs) return NULL;
-            *out = fossil_math_sym_new_op(op, *out, rhs);
-        } else break;
+// Parses operators binding tighter than min_bp
+static fossil_math_sym_node_t fossil_math_sym_parse_expr(fossil_math_sym_parser_t* p, int min_bp) {
+    fossil_math_sym_node_t lhs = fossil_math_sym_parse_operand(p);
+    while (!p->err.status) {
+        char op = p->tok;
+        int bp = fossil_math_sym_binding_power(op);
+        if (bp <= min_bp) break;
+        fossil_math_sym_lex(p);
+        fossil_math_sym_node_t rhs = op == '^' ? fossil_math_sym_parse_nested(p, bp - 1) : fossil_math_sym_parse_expr(p, bp);
+        if (p->err.status) break;
+        lhs = fossil_math_sym_parse_op(p, op, lhs, rhs);
     }
-    return s;
+    return p->err.status ? FOSSIL_MATH_SYM_NONE : lhs;
+}
+
+// Parses text into p's destination; returns the root handle or NONE with p->err set
+static fossil_math_sym_node_t fossil_math_sym_parse_run(fossil_math_sym_parser_t* p, const char* text, size_t len) {
+    p->s = text;
+    p->len = len;
+    if (!text && len > 0) return fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_INVALID, 0);
+    fossil_math_sym_lex(p);
+    fossil_math_sym_node_t root = fossil_math_sym_parse_expr(p, 0);
+    if (!p->err.status && p->tok != FOSSIL_MATH_SYM_TOK_END) fossil_math_sym_parse_fail(p, FOSSIL_MATH_SYM_PARSE_TRAILING, p->start);
+    return p->err.status ? FOSSIL_MATH_SYM_NONE : root;
 }
 
-static const char* fossil_math_sym_parse_expr(const char* s, fossil_math_sym_expr_t** out) {
-    s = fossil_math_sym_parse_term(s, out);
-    if (!s) return NULL;
+fossil_math_sym_node_t fossil_math_sym_graph_parse(fossil_math_sym_graph_t* graph, const char* text, size_t len,
+                                                   fossil_math_sym_parse_error_t* error) {
+    fossil_math_sym_parser_t p;
+    memset(&p, 0, sizeof(p));
+    p.g = graph;
+    fossil_math_sym_node_t root = graph ? fossil_math_sym_parse_run(&p, text, len)
+                                        : fossil_math_sym_parse_fail(&p, FOSSIL_MATH_SYM_PARSE_INVALID, 0);
+    if (error) *error = p.err;
+    return root;
+}
+
+fossil_math_sym_expr_t* fossil_math_sym_parse_n(const char* text, size_t len, fossil_math_sym_parse_error_t* error) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_sym_parser_t p;
+    memset(&p, 0, sizeof(p));
+    fossil_math_sym_node_t root = fossil_math_sym_parse_run(&p, text, len);
+    if (error) *error = p.err;
 
-    while (1) {
-        while (isspace((unsigned char)*s)) ++s;
-        if (*s == '+' || *s == '-') {
-            char op = *s++;
-            fossil_math_sym_expr_t* rhs = NULL;
-            s = fossil_math_sym_parse_term(s, &rhs);
-            if (!s || !rhs) return NULL;
-            *out = fossil_math_sym_new_op(op, *out, rhs);
-        } else break;
+    // Every node is listed once, so on failure they are freed individually
+    fossil_math_sym_expr_t* tree = root != FOSSIL_MATH_SYM_NONE ? p.nodes[root] : NULL;
+    if (!tree) {
+        for (size_t i = 0; i < p.count; ++i) free(p.nodes[i]);
     }
-    return s;
+    free(p.nodes);
+    FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_SYM_PARSE, p.count * sizeof(fossil_math_sym_expr_t));
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_SYM_PARSE, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_SYM_PARSE, p.count, 0, 0);
+    return tree;
 }
 
 fossil_math_sym_expr_t* fossil_math_sym_parse(const char* expr) {
     if (!expr) return NULL;
-    fossil_math_sym_expr_t* root = NULL;
-    const char* end = fossil_math_sym_parse_expr(expr, &root);
-    return (end && *end == '\0') ? root : root;
+    return fossil_math_sym_parse_n(expr, strlen(expr), NULL);
+}
+
+const char* fossil_math_sym_parse_message(fossil_math_sym_parse_status_t status) {
+    switch (status) {
+        case FOSSIL_MATH_SYM_PARSE_OK: return "ok";
+        case FOSSIL_MATH_SYM_PARSE_INVALID: return "invalid argument";
+        case FOSSIL_MATH_SYM_PARSE_UNEXPECTED_CHAR: return "unexpected character";
+        case FOSSIL_MATH_SYM_PARSE_BAD_NUMBER: return "malformed number";
+        case FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND: return "expected an operand";
+        case FOSSIL_MATH_SYM_PARSE_UNKNOWN_FUNCTION: return "unknown function";
+        case FOSSIL_MATH_SYM_PARSE_ARGUMENTS: return "wrong number of arguments";
+        case FOSSIL_MATH_SYM_PARSE_UNCLOSED: return "missing ')'";
+        case FOSSIL_MATH_SYM_PARSE_TRAILING: return "unexpected input after expression";
+        case FOSSIL_MATH_SYM_PARSE_NAME_TOO_LONG: return "variable name too long";
+        case FOSSIL_MATH_SYM_PARSE_TOO_DEEP: return "expression nested too deeply";
+        case FOSSIL_MATH_SYM_PARSE_NO_MEMORY: return "out of memory";
+    }
+    return "unknown error";
 }
 
 // ============================================================================
 // Simplification
 // ============================================================================
 
-fossil_math_sym_expr_t* fossil_math_sym_simplify(fossil_math_sym_expr_t* expr) {
+// Fallback when the graph cannot be built: folds constant operands in place
+static fossil_math_sym_expr_t* fossil_math_sym_fold_constants(fossil_math_sym_expr_t* expr) {
     if (!expr) return NULL;
 
     if (expr->type == fossil_math_sym_OP) {
-        expr->left = fossil_math_sym_simplify(expr->left);
-        expr->right = fossil_math_sym_simplify(expr->right);
+        expr->left = fossil_math_sym_fold_constants(expr->left);
+        expr->right = fossil_math_sym_fold_constants(expr->right);
 
-        if (expr->left && expr->left->type == fossil_math_sym_CONST &&
-            expr->right && expr->right->type == fossil_math_sym_CONST) {
+        int arity = fossil_math_sym_arity(expr->op);
+        if (arity > 0 && expr->left && expr->left->type == fossil_math_sym_CONST &&
+            (arity == 1 || (expr->right && expr->right->type == fossil_math_sym_CONST))) {
             double a = expr->left->value;
-            double b = expr->right->value;
-            double result = 0.0;
-            switch (expr->op) {
-                case '+': result = a + b; break;
-                case '-': result = a - b; break;
-                case '*': result = a * b; break;
-                case '/': result = (b != 0.0) ? a / b : NAN; break;
-                default: break;
-            }
+            double result = fossil_math_sym_apply(expr->op, a, arity == 2 ? expr->right->value : a);
             fossil_math_sym_free(expr->left);
             fossil_math_sym_free(expr->right);
             expr->type = fossil_math_sym_CONST;
@@ -235,52 +656,40 @@ fossil_math_sym_expr_t* fossil_math_sym_simplify(fossil_math_sym_expr_t* expr) {
     return expr;
 }
 
+fossil_math_sym_expr_t* fossil_math_sym_simplify(fossil_math_sym_expr_t* expr) {
+    if (!expr) return NULL;
+
+    fossil_math_sym_expr_t* out = NULL;
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    if (g) {
+        out = fossil_math_sym_graph_export(g, fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, expr)));
+        fossil_math_sym_graph_free(g);
+    }
+    if (!out) return fossil_math_sym_fold_constants(expr);
+
+    // Keep the caller's root node so existing pointers to it stay valid
+    fossil_math_sym_free(expr->left);
+    fossil_math_sym_free(expr->right);
+    *expr = *out;
+    free(out);
+    return expr;
+}
+
 // ============================================================================
 // Symbolic Differentiation
 // ============================================================================
 
 fossil_math_sym_expr_t* fossil_math_sym_diff(const fossil_math_sym_expr_t* expr, const char* var) {
-    if (!expr) return NULL;
-
-    switch (expr->type) {
-        case fossil_math_sym_CONST:
-            return fossil_math_sym_new_const(0.0);
-
-        case fossil_math_sym_VAR:
-            return fossil_math_sym_new_const(strcmp(expr->name, var) == 0 ? 1.0 : 0.0);
+    if (!expr || !var) return NULL;
 
-        case fossil_math_sym_OP: {
-            fossil_math_sym_expr_t *u = expr->left, *v = expr->right;
-            fossil_math_sym_expr_t *du = fossil_math_sym_diff(u, var);
-            fossil_math_sym_expr_t *dv = fossil_math_sym_diff(v, var);
-
-            switch (expr->op) {
-                case '+':
-                    return fossil_math_sym_new_op('+', du, dv);
-                case '-':
-                    return fossil_math_sym_new_op('-', du, dv);
-                case '*': {
-                    // Product rule: (u*v)' = u'*v + u*v'
-                    fossil_math_sym_expr_t* left = fossil_math_sym_new_op('*', du, (fossil_math_sym_expr_t*)v);
-                    fossil_math_sym_expr_t* right = fossil_math_sym_new_op('*', (fossil_math_sym_expr_t*)u, dv);
-                    return fossil_math_sym_new_op('+', left, right);
-                }
-                case '/': {
-                    // Quotient rule: (u/v)' = (u'*v - u*v') / v^2
-                    fossil_math_sym_expr_t* num_left = fossil_math_sym_new_op('*', du, (fossil_math_sym_expr_t*)v);
-                    fossil_math_sym_expr_t* num_right = fossil_math_sym_new_op('*', (fossil_math_sym_expr_t*)u, dv);
-                    fossil_math_sym_expr_t* num = fossil_math_sym_new_op('-', num_left, num_right);
-                    fossil_math_sym_expr_t* denom = fossil_math_sym_new_op('*', (fossil_math_sym_expr_t*)v, (fossil_math_sym_expr_t*)v);
-                    return fossil_math_sym_new_op('/', num, denom);
-                }
-                default:
-                    fossil_math_sym_free(du);
-                    fossil_math_sym_free(dv);
-                    return NULL;
-            }
-        }
-    }
-    return NULL;
+    // The graph shares the operands the rules reuse (u and v in the product
+    // and quotient rules); exporting copies them into an independent tree.
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    if (!g) return NULL;
+    fossil_math_sym_node_t d = fossil_math_sym_graph_diff(g, fossil_math_sym_graph_import(g, expr), var);
+    fossil_math_sym_expr_t* out = fossil_math_sym_graph_export(g, d);
+    fossil_math_sym_graph_free(g);
+    return out;
 }
 
 // ============================================================================
@@ -288,8 +697,12 @@ fossil_math_sym_expr_t* fossil_math_sym_diff(const fossil_math_sym_expr_t* expr,
 // ============================================================================
 
 double fossil_math_sym_eval(const fossil_math_sym_expr_t* expr, double (*var_lookup)(const char*)) {
-    if (!expr) return NAN;
-    return fossil_math_sym_eval_internal(expr, var_lookup);
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    double result = expr ? fossil_math_sym_eval_internal(expr, var_lookup) : NAN;
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_SYM_EVAL, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_SYM_EVAL, 0, 0, 0);
+    return result;
 }
 
 static double fossil_math_sym_eval_internal(const fossil_math_sym_expr_t* expr, double (*var_lookup)(const char*)) {
@@ -299,16 +712,11 @@ static double fossil_math_sym_eval_internal(const fossil_math_sym_expr_t* expr,
         case fossil_math_sym_VAR:
             return var_lookup ? var_lookup(expr->name) : NAN;
         case fossil_math_sym_OP: {
+            int arity = fossil_math_sym_arity(expr->op);
+            if (arity == 0 || !expr->left || (arity == 2 && !expr->right)) return NAN;
             double a = fossil_math_sym_eval_internal(expr->left, var_lookup);
-            double b = fossil_math_sym_eval_internal(expr->right, var_lookup);
-            switch (expr->op) {
-                case '+': return a + b;
-                case '-': return a - b;
-                case '*': return a * b;
-                case '/': return (b != 0.0) ? a / b : NAN;
-                case '^': return pow(a, b);
-                default: return NAN;
-            }
+            double b = arity == 2 ? fossil_math_sym_eval_internal(expr->right, var_lookup) : a;
+            return fossil_math_sym_apply(expr->op, a, b);
         }
     }
     return NAN;
@@ -329,22 +737,56 @@ size_t fossil_math_sym_to_string(const fossil_math_sym_expr_t* expr, char* buffe
             break;
 
         case fossil_math_sym_OP: {
+            const fossil_math_sym_opinfo_t* info = fossil_math_sym_opinfo(expr->op);
+            if (info && info->name) {
+                pos += snprintf(buffer + pos, bufsize - pos, "%s(", info->name);
+                if (pos < bufsize && expr->left) pos += fossil_math_sym_to_string(expr->left, buffer + pos, bufsize - pos);
+                if (info->arity == 2 && pos < bufsize - 2) {
+                    buffer[pos++] = ',';
+                    buffer[pos++] = ' ';
+                    if (expr->right) pos += fossil_math_sym_to_string(expr->right, buffer + pos, bufsize - pos);
+                }
+                if (pos < bufsize - 1) buffer[pos++] = ')';
+                break;
+            }
+            if (expr->op == FOSSIL_MATH_SYM_NEG) {
+                // Parenthesize infix operands other than powers, which bind tighter, and nested negations
+                const fossil_math_sym_expr_t* x = expr->left;
+                int paren = x && x->type == fossil_math_sym_OP && x->op != '^' &&
+                            (x->op == FOSSIL_MATH_SYM_NEG || (fossil_math_sym_arity(x->op) == 2 && !fossil_math_sym_is_call(x->op)));
+                if (pos < bufsize - 1) buffer[pos++] = '-';
+                if (paren && pos < bufsize - 1) buffer[pos++] = '(';
+                if (pos < bufsize && expr->left) pos += fossil_math_sym_to_string(expr->left, buffer + pos, bufsize - pos);
+                if (paren && pos < bufsize - 1) buffer[pos++] = ')';
+                break;
+            }
+
             int need_paren_left = 0, need_paren_right = 0;
             // Add parentheses for correct precedence
             if (expr->op == '+' || expr->op == '-') {
-                // No parentheses needed for children
+                // Operators are left-associative, so only a difference's right sum needs them
+                if (expr->op == '-' && expr->right && expr->right->type == fossil_math_sym_OP &&
+                    (expr->right->op == '+' || expr->right->op == '-')) {
+                    need_paren_right = 1;
+                }
             } else if (expr->op == '*' || expr->op == '/') {
                 if (expr->left && expr->left->type == fossil_math_sym_OP &&
                     (expr->left->op == '+' || expr->left->op == '-')) {
                     need_paren_left = 1;
                 }
                 if (expr->right && expr->right->type == fossil_math_sym_OP &&
-                    (expr->right->op == '+' || expr->right->op == '-')) {
+                    (expr->right->op == '+' || expr->right->op == '-' ||
+                     (expr->op == '/' && (expr->right->op == '*' || expr->right->op == '/')))) {
                     need_paren_right = 1;
                 }
             } else if (expr->op == '^') {
-                if (expr->left && expr->left->type == fossil_math_sym_OP) need_paren_left = 1;
-                if (expr->right && expr->right->type == fossil_math_sym_OP) need_paren_right = 1;
+                // Function calls are already delimited
+                if (expr->left && expr->left->type == fossil_math_sym_OP &&
+                    !fossil_math_sym_is_call(expr->left->op)) need_paren_left = 1;
+                // "-3 ^ 2" would read back as -(3 ^ 2)
+                if (expr->left && expr->left->type == fossil_math_sym_CONST && signbit(expr->left->value)) need_paren_left = 1;
+                if (expr->right && expr->right->type == fossil_math_sym_OP &&
+                    !fossil_math_sym_is_call(expr->right->op)) need_paren_right = 1;
             }
 
             if (need_paren_left && pos < bufsize - 1) buffer[pos++] = '(';
@@ -405,3 +847,3081 @@ fossil_math_sym_expr_t* fossil_math_sym_substitute(const fossil_math_sym_expr_t*
     }
     return NULL;
 }
+
+// Substitutes through a scratch graph: the input is interned once, rebuilt
+// in one sweep and exported once. values or exprs supplies the bindings.
+static fossil_math_sym_expr_t* fossil_math_sym_substitute_via_graph(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                                    const double* values, const fossil_math_sym_expr_t* const* exprs,
+                                                                    size_t nvars) {
+    if (!expr || (nvars > 0 && (!vars || (!values && !exprs)))) return NULL;
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t* nodes = malloc((nvars + 1) * sizeof(*nodes));
+    fossil_math_sym_expr_t* result = NULL;
+    if (g && nodes) {
+        size_t i = 0;
+        for (; i < nvars; ++i) {
+            nodes[i] = values ? fossil_math_sym_graph_const(g, values[i]) : fossil_math_sym_graph_import(g, exprs[i]);
+            if (nodes[i] == FOSSIL_MATH_SYM_NONE) break;
+        }
+        if (i == nvars) {
+            fossil_math_sym_node_t root = fossil_math_sym_graph_import(g, expr);
+            result = fossil_math_sym_graph_export(g, fossil_math_sym_graph_substitute(g, root, vars, nodes, nvars));
+        }
+    }
+    free(nodes);
+    fossil_math_sym_graph_free(g);
+    return result;
+}
+
+fossil_math_sym_expr_t* fossil_math_sym_substitute_values(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                          const double* values, size_t nvars) {
+    if (nvars > 0 && !values) return NULL;
+    return fossil_math_sym_substitute_via_graph(expr, vars, values, NULL, nvars);
+}
+
+fossil_math_sym_expr_t* fossil_math_sym_substitute_exprs(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                         const fossil_math_sym_expr_t* const* exprs, size_t nvars) {
+    if (nvars > 0 && !exprs) return NULL;
+    return fossil_math_sym_substitute_via_graph(expr, vars, NULL, exprs, nvars);
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+//
+// Programs use a flat register file laid out as
+//   [0, nvars)                     variable slots
+//   [nvars, nvars + nconsts)       constants
+//   [nvars + nconsts, nregs)       temporaries
+// and three-address instructions dst = a OP b. Temporaries are recycled as
+// soon as their value has been consumed, so the register file stays close
+// to the expression depth rather than its size. Output registers are never
+// recycled; they are read once the last instruction has run.
+//
+// ============================================================================
+
+// Registers evaluated on the stack before falling back to the heap
+#define FOSSIL_MATH_SYM_LOCAL_REGS 256
+// Operands tagged with this bit are temporaries, renumbered after the walk
+#define FOSSIL_MATH_SYM_TEMP_BIT 0x80000000u
+#define FOSSIL_MATH_SYM_BAD_REG 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t op;
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+} fossil_math_sym_instr_t;
+
+struct fossil_math_sym_compiled {
+    size_t nvars;
+    size_t nconsts;
+    size_t nregs;
+    size_t ncode;
+    size_t noutputs;
+    uint32_t result;        // first output
+    uint32_t* outputs;
+    fossil_math_sym_instr_t* code;
+    double* consts;
+};
+
+typedef struct {
+    fossil_math_sym_compiled_t* prog;
+    const char* const* names;
+    size_t code_cap;
+    size_t const_cap;
+    uint32_t* free_regs;
+    size_t nfree;
+    size_t free_cap;
+    uint32_t ntemps;
+    int failed;
+} fossil_math_sym_builder_t;
+
+static int fossil_math_sym_grow(void** data, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return 0;
+    size_t cap2 = *cap ? *cap * 2 : 16;
+    while (cap2 < need) cap2 *= 2;
+    void* p = realloc(*data, cap2 * elem);
+    if (!p) return -1;
+    *data = p;
+    *cap = cap2;
+    return 0;
+}
+
+static uint32_t fossil_math_sym_build_const(fossil_math_sym_builder_t* b, double value) {
+    fossil_math_sym_compiled_t* p = b->prog;
+    for (size_t i = 0; i < p->nconsts; ++i) {
+        if (memcmp(&p->consts[i], &value, sizeof(double)) == 0) return (uint32_t)(p->nvars + i);
+    }
+    if (fossil_math_sym_grow((void**)&p->consts, &b->const_cap, p->nconsts + 1, sizeof(double)) != 0) {
+        b->failed = 1;
+        return FOSSIL_MATH_SYM_BAD_REG;
+    }
+    p->consts[p->nconsts] = value;
+    return (uint32_t)(p->nvars + p->nconsts++);
+}
+
+static void fossil_math_sym_build_release(fossil_math_sym_builder_t* b, uint32_t reg) {
+    if (!(reg & FOSSIL_MATH_SYM_TEMP_BIT) || reg == FOSSIL_MATH_SYM_BAD_REG) return;
+    // If the free list cannot grow the register is simply not reused
+    if (fossil_math_sym_grow((void**)&b->free_regs, &b->free_cap, b->nfree + 1, sizeof(uint32_t)) != 0) return;
+    b->free_regs[b->nfree++] = reg;
+}
+
+// Appends dst = x op y. With release set, temporaries x and y are freed first
+// (tree operands are used once); otherwise the caller manages their lifetime.
+static uint32_t fossil_math_sym_build_emit(fossil_math_sym_builder_t* b, uint32_t op, uint32_t x, uint32_t y, int release) {
+    fossil_math_sym_compiled_t* p = b->prog;
+    if (x == FOSSIL_MATH_SYM_BAD_REG || y == FOSSIL_MATH_SYM_BAD_REG ||
+        fossil_math_sym_grow((void**)&p->code, &b->code_cap, p->ncode + 1, sizeof(*p->code)) != 0) {
+        b->failed = 1;
+        return FOSSIL_MATH_SYM_BAD_REG;
+    }
+    if (release) {
+        fossil_math_sym_build_release(b, x);
+        if (y != x) fossil_math_sym_build_release(b, y);
+    }
+    uint32_t dst = b->nfree > 0 ? b->free_regs[--b->nfree] : (FOSSIL_MATH_SYM_TEMP_BIT | b->ntemps++);
+
+    fossil_math_sym_instr_t* in = &p->code[p->ncode++];
+    in->op = op;
+    in->dst = dst;
+    in->a = x;
+    in->b = y;
+    return dst;
+}
+
+static uint32_t fossil_math_sym_build_var(fossil_math_sym_builder_t* b, const char* name) {
+    for (size_t i = 0; i < b->prog->nvars; ++i) {
+        if (b->names[i] && strcmp(b->names[i], name) == 0) return (uint32_t)i;
+    }
+    b->failed = 1;
+    return FOSSIL_MATH_SYM_BAD_REG;
+}
+
+static int fossil_math_sym_opcode(char op, uint32_t* code) {
+    const fossil_math_sym_opinfo_t* info = fossil_math_sym_opinfo(op);
+    if (!info) return -1;
+    *code = info->code;
+    return 0;
+}
+
+static uint32_t fossil_math_sym_build_node(fossil_math_sym_builder_t* b, const fossil_math_sym_expr_t* e) {
+    if (!e || b->failed) {
+        b->failed = 1;
+        return FOSSIL_MATH_SYM_BAD_REG;
+    }
+    switch (e->type) {
+        case fossil_math_sym_CONST:
+            return fossil_math_sym_build_const(b, e->value);
+
+        case fossil_math_sym_VAR:
+            return fossil_math_sym_build_var(b, e->name);
+
+        case fossil_math_sym_OP: {
+            uint32_t op;
+            if (fossil_math_sym_opcode(e->op, &op) != 0) {
+                b->failed = 1;
+                return FOSSIL_MATH_SYM_BAD_REG;
+            }
+            // Unary instructions read their operand as both a and b
+            uint32_t x = fossil_math_sym_build_node(b, e->left);
+            uint32_t y = fossil_math_sym_arity(e->op) == 1 ? x : fossil_math_sym_build_node(b, e->right);
+            return fossil_math_sym_build_emit(b, op, x, y, 1);
+        }
+    }
+    b->failed = 1;
+    return FOSSIL_MATH_SYM_BAD_REG;
+}
+
+// Renumbers tagged temporaries to follow the constants
+static uint32_t fossil_math_sym_build_fix(const fossil_math_sym_compiled_t* p, uint32_t reg) {
+    return (reg & FOSSIL_MATH_SYM_TEMP_BIT) ? (uint32_t)(p->nvars + p->nconsts) + (reg & ~FOSSIL_MATH_SYM_TEMP_BIT) : reg;
+}
+
+static fossil_math_sym_compiled_t* fossil_math_sym_build_begin(fossil_math_sym_builder_t* b, const char* const* vars, size_t nvars) {
+    memset(b, 0, sizeof(*b));
+    if ((!vars && nvars > 0) || nvars >= FOSSIL_MATH_SYM_TEMP_BIT) return NULL;
+    b->prog = calloc(1, sizeof(*b->prog));
+    if (!b->prog) return NULL;
+    b->prog->nvars = nvars;
+    b->names = vars;
+    return b->prog;
+}
+
+// Renumbers temporaries and finalizes the program with the given output
+// registers, or frees it if the build failed
+static fossil_math_sym_compiled_t* fossil_math_sym_build_finish_many(fossil_math_sym_builder_t* b, const uint32_t* results, size_t count) {
+    fossil_math_sym_compiled_t* p = b->prog;
+    free(b->free_regs);
+    p->outputs = b->failed || count == 0 ? NULL : malloc(count * sizeof(uint32_t));
+    if (!p->outputs) {
+        fossil_math_sym_compiled_free(p);
+        return NULL;
+    }
+    for (size_t k = 0; k < count; ++k) {
+        if (results[k] == FOSSIL_MATH_SYM_BAD_REG) {
+            fossil_math_sym_compiled_free(p);
+            return NULL;
+        }
+        p->outputs[k] = fossil_math_sym_build_fix(p, results[k]);
+    }
+    for (size_t i = 0; i < p->ncode; ++i) {
+        p->code[i].dst = fossil_math_sym_build_fix(p, p->code[i].dst);
+        p->code[i].a = fossil_math_sym_build_fix(p, p->code[i].a);
+        p->code[i].b = fossil_math_sym_build_fix(p, p->code[i].b);
+    }
+    p->noutputs = count;
+    p->result = p->outputs[0];
+    p->nregs = p->nvars + p->nconsts + b->ntemps;
+    return p;
+}
+
+static fossil_math_sym_compiled_t* fossil_math_sym_build_finish(fossil_math_sym_builder_t* b, uint32_t result) {
+    return fossil_math_sym_build_finish_many(b, &result, 1);
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_compile(const fossil_math_sym_expr_t* expr, const char* const* vars, size_t nvars) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_sym_builder_t b;
+    fossil_math_sym_compiled_t* prog = NULL;
+    if (expr && fossil_math_sym_build_begin(&b, vars, nvars))
+        prog = fossil_math_sym_build_finish(&b, fossil_math_sym_build_node(&b, expr));
+    if (prog) {
+        FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_SYM_COMPILE, sizeof(*prog) + prog->ncode * sizeof(fossil_math_sym_instr_t) +
+                                                                    prog->nconsts * sizeof(double) + prog->noutputs * sizeof(uint32_t));
+    }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_SYM_COMPILE, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_SYM_COMPILE, prog ? prog->ncode : 0, nvars, 0);
+    return prog;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_compile_jacobian(const fossil_math_sym_expr_t* const* exprs, size_t nexprs,
+                                                             const char* const* vars, size_t nvars) {
+    if (!exprs || nexprs == 0 || (!vars && nvars > 0) || nvars > (SIZE_MAX / nexprs) - 1) return NULL;
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    size_t count = nexprs * (nvars + 1);
+    fossil_math_sym_node_t* out = malloc(count * sizeof(*out));
+    fossil_math_sym_compiled_t* prog = NULL;
+    int ok = g && out;
+    // Values first, then the partials row by row, all in one graph so the
+    // rows share both the primal subexpressions and each other's adjoints
+    for (size_t i = 0; ok && i < nexprs; ++i) {
+        out[i] = exprs[i] ? fossil_math_sym_graph_import(g, exprs[i]) : FOSSIL_MATH_SYM_NONE;
+        ok = out[i] != FOSSIL_MATH_SYM_NONE &&
+             fossil_math_sym_graph_gradient(g, out[i], vars, nvars, out + nexprs + i * nvars) == 0;
+    }
+    if (ok) prog = fossil_math_sym_graph_compile_many(g, out, count, vars, nvars);
+    free(out);
+    fossil_math_sym_graph_free(g);
+    return prog;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_compile_gradient(const fossil_math_sym_expr_t* expr, const char* const* vars, size_t nvars) {
+    return fossil_math_sym_compile_jacobian(&expr, 1, vars, nvars);
+}
+
+void fossil_math_sym_compiled_free(fossil_math_sym_compiled_t* prog) {
+    if (!prog) return;
+    free(prog->code);
+    free(prog->consts);
+    free(prog->outputs);
+    free(prog);
+}
+
+size_t fossil_math_sym_compiled_vars(const fossil_math_sym_compiled_t* prog) {
+    return prog ? prog->nvars : 0;
+}
+
+size_t fossil_math_sym_compiled_length(const fossil_math_sym_compiled_t* prog) {
+    return prog ? prog->ncode : 0;
+}
+
+size_t fossil_math_sym_compiled_outputs(const fossil_math_sym_compiled_t* prog) {
+    return prog ? prog->noutputs : 0;
+}
+
+// Runs the program over the register file r
+static void fossil_math_sym_run(const fossil_math_sym_compiled_t* prog, const double* vars, double* r) {
+    if (prog->nvars) memcpy(r, vars, prog->nvars * sizeof(double));
+    if (prog->nconsts) memcpy(r + prog->nvars, prog->consts, prog->nconsts * sizeof(double));
+
+    const fossil_math_sym_instr_t* in = prog->code;
+    const fossil_math_sym_instr_t* end = in + prog->ncode;
+    for (; in != end; ++in) {
+        double a = r[in->a], b = r[in->b];
+        switch (in->op) {
+            case FOSSIL_MATH_SYM_OP_ADD: r[in->dst] = a + b; break;
+            case FOSSIL_MATH_SYM_OP_SUB: r[in->dst] = a - b; break;
+            case FOSSIL_MATH_SYM_OP_MUL: r[in->dst] = a * b; break;
+            case FOSSIL_MATH_SYM_OP_DIV: r[in->dst] = (b != 0.0) ? a / b : NAN; break;
+            case FOSSIL_MATH_SYM_OP_POW: r[in->dst] = pow(a, b); break;
+            case FOSSIL_MATH_SYM_OP_NEG: r[in->dst] = -a; break;
+            case FOSSIL_MATH_SYM_OP_SIN: r[in->dst] = sin(a); break;
+            case FOSSIL_MATH_SYM_OP_COS: r[in->dst] = cos(a); break;
+            case FOSSIL_MATH_SYM_OP_EXP: r[in->dst] = exp(a); break;
+            case FOSSIL_MATH_SYM_OP_LOG: r[in->dst] = log(a); break;
+            case FOSSIL_MATH_SYM_OP_SQRT: r[in->dst] = sqrt(a); break;
+            case FOSSIL_MATH_SYM_OP_ABS: r[in->dst] = fabs(a); break;
+            case FOSSIL_MATH_SYM_OP_MIN: r[in->dst] = fmin(a, b); break;
+            case FOSSIL_MATH_SYM_OP_MAX: r[in->dst] = fmax(a, b); break;
+            default: r[in->dst] = NAN; break;
+        }
+    }
+}
+
+double fossil_math_sym_eval_compiled(const fossil_math_sym_compiled_t* prog, const double* vars) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    double local[FOSSIL_MATH_SYM_LOCAL_REGS];
+    double* r = NULL;
+    if (prog && (vars || prog->nvars == 0))
+        r = prog->nregs > FOSSIL_MATH_SYM_LOCAL_REGS ? malloc(prog->nregs * sizeof(double)) : local;
+    double result = NAN;
+    size_t ncode = 0;
+    if (r) {
+        fossil_math_sym_run(prog, vars, r);
+        result = r[prog->result];
+        ncode = prog->ncode;
+        if (r != local) free(r);
+    }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_SYM_EVAL_COMPILED, ncode);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_SYM_EVAL_COMPILED, ncode, 0, 0);
+    return result;
+}
+
+int fossil_math_sym_eval_compiled_many(const fossil_math_sym_compiled_t* prog, const double* vars, double* out) {
+    if (!prog || !out || (!vars && prog->nvars > 0)) return -1;
+    double local[FOSSIL_MATH_SYM_LOCAL_REGS];
+    double* r = local;
+    if (prog->nregs > FOSSIL_MATH_SYM_LOCAL_REGS) {
+        r = malloc(prog->nregs * sizeof(double));
+        if (!r) return -2;
+    }
+    fossil_math_sym_run(prog, vars, r);
+    for (size_t k = 0; k < prog->noutputs; ++k) out[k] = r[prog->outputs[k]];
+    if (r != local) free(r);
+    return 0;
+}
+
+// ============================================================================
+// Batch Evaluation
+// ============================================================================
+
+// Points per block in columnar evaluation, and blocks per parallel grain
+#define FOSSIL_MATH_SYM_BLOCK 128
+#define FOSSIL_MATH_SYM_GRAIN 16
+
+typedef struct {
+    const fossil_math_sym_compiled_t* prog;
+    const double* const* columns;
+    double* const* out;     // one column per output read
+    size_t nout;
+    size_t n;
+    unsigned char* failed;  // Per block, set when a chunk cannot allocate scratch
+} fossil_math_sym_batch_job_t;
+
+static void fossil_math_sym_batch_chunk(size_t begin, size_t end, void* ctx) {
+    fossil_math_sym_batch_job_t* job = (fossil_math_sym_batch_job_t*)ctx;
+    const fossil_math_sym_compiled_t* p = job->prog;
+    const size_t B = FOSSIL_MATH_SYM_BLOCK;
+
+    // Constants and temporaries live in scratch; variable registers point straight into the columns
+    double* scratch = malloc((p->nregs - p->nvars) * B * sizeof(double));
+    const double** reg = malloc(p->nregs * sizeof(double*));
+    if ((!scratch && p->nregs > p->nvars) || !reg) {
+        free(scratch);
+        free((void*)reg);
+        for (size_t blk = begin; blk < end; ++blk) job->failed[blk] = 1;
+        return;
+    }
+    for (size_t k = 0; k < p->nconsts; ++k) {
+        double* c = scratch + k * B;
+        for (size_t j = 0; j < B; ++j) c[j] = p->consts[k];
+    }
+    for (size_t k = p->nvars; k < p->nregs; ++k) reg[k] = scratch + (k - p->nvars) * B;
+
+    for (size_t blk = begin; blk < end; ++blk) {
+        size_t lo = blk * B;
+        size_t len = FOSSIL_MATH_MIN(job->n - lo, B);
+        for (size_t v = 0; v < p->nvars; ++v) reg[v] = job->columns[v] + lo;
+
+        for (size_t i = 0; i < p->ncode; ++i) {
+            const fossil_math_sym_instr_t* in = &p->code[i];
+            double* d = (double*)reg[in->dst];
+            const double* a = reg[in->a];
+            const double* b = reg[in->b];
+            switch (in->op) {
+                case FOSSIL_MATH_SYM_OP_ADD:
+                    for (size_t j = 0; j < len; ++j) d[j] = a[j] + b[j];
+                    break;
+                case FOSSIL_MATH_SYM_OP_SUB:
+                    for (size_t j = 0; j < len; ++j) d[j] = a[j] - b[j];
+                    break;
+                case FOSSIL_MATH_SYM_OP_MUL:
+                    for (size_t j = 0; j < len; ++j) d[j] = a[j] * b[j];
+                    break;
+                case FOSSIL_MATH_SYM_OP_DIV:
+                    for (size_t j = 0; j < len; ++j) d[j] = (b[j] != 0.0) ? a[j] / b[j] : NAN;
+                    break;
+                case FOSSIL_MATH_SYM_OP_POW:
+                    for (size_t j = 0; j < len; ++j) d[j] = pow(a[j], b[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_NEG:
+                    for (size_t j = 0; j < len; ++j) d[j] = -a[j];
+                    break;
+                case FOSSIL_MATH_SYM_OP_SIN:
+                    for (size_t j = 0; j < len; ++j) d[j] = sin(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_COS:
+                    for (size_t j = 0; j < len; ++j) d[j] = cos(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_EXP:
+                    for (size_t j = 0; j < len; ++j) d[j] = exp(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_LOG:
+                    for (size_t j = 0; j < len; ++j) d[j] = log(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_SQRT:
+                    for (size_t j = 0; j < len; ++j) d[j] = sqrt(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_ABS:
+                    for (size_t j = 0; j < len; ++j) d[j] = fabs(a[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_MIN:
+                    for (size_t j = 0; j < len; ++j) d[j] = fmin(a[j], b[j]);
+                    break;
+                case FOSSIL_MATH_SYM_OP_MAX:
+                    for (size_t j = 0; j < len; ++j) d[j] = fmax(a[j], b[j]);
+                    break;
+                default:
+                    for (size_t j = 0; j < len; ++j) d[j] = NAN;
+                    break;
+            }
+        }
+        for (size_t k = 0; k < job->nout; ++k) memcpy(job->out[k] + lo, reg[p->outputs[k]], len * sizeof(double));
+    }
+    free(scratch);
+    free((void*)reg);
+}
+
+static int fossil_math_sym_batch_run(const fossil_math_sym_compiled_t* prog, const double* const* var_columns,
+                                     double* const* out, size_t nout, size_t n) {
+    for (size_t v = 0; v < prog->nvars; ++v) {
+        if (!var_columns[v] && n > 0) return -1;
+    }
+    for (size_t k = 0; k < nout; ++k) {
+        if (!out[k] && n > 0) return -1;
+    }
+    if (n == 0) return 0;
+
+    size_t blocks = (n + FOSSIL_MATH_SYM_BLOCK - 1) / FOSSIL_MATH_SYM_BLOCK;
+    fossil_math_sym_batch_job_t job = {prog, var_columns, out, nout, n, calloc(blocks, 1)};
+    if (!job.failed) return -2;
+    fossil_math_parallel_for(blocks, FOSSIL_MATH_SYM_GRAIN, fossil_math_sym_batch_chunk, &job);
+
+    int status = 0;
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        if (job.failed[blk]) status = -2;
+    }
+    free(job.failed);
+    return status;
+}
+
+int fossil_math_sym_eval_batch(const fossil_math_sym_compiled_t* prog, const double* const* var_columns, double* out, size_t n) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    int status = -1;
+    if (prog && out && (var_columns || prog->nvars == 0)) status = fossil_math_sym_batch_run(prog, var_columns, &out, 1, n);
+    size_t ncode = status == 0 ? prog->ncode : 0;
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_SYM_EVAL_BATCH, (double)ncode * (double)n);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_SYM_EVAL_BATCH, ncode, n, 0);
+    return status;
+}
+
+int fossil_math_sym_eval_batch_many(const fossil_math_sym_compiled_t* prog, const double* const* var_columns,
+                                    double* const* out_columns, size_t n) {
+    if (!prog || !out_columns || (!var_columns && prog->nvars > 0)) return -1;
+    return fossil_math_sym_batch_run(prog, var_columns, out_columns, prog->noutputs, n);
+}
+
+// ============================================================================
+// Interval Evaluation
+// ============================================================================
+//
+// Each operation encloses the exact real result and then rounds outward.
+// For +, -, *, / and sqrt the rounding error is recovered exactly (TwoSum
+// or an fma residual), so bounds move by one ulp only when the rounded
+// result is actually on the wrong side. libm functions are assumed
+// faithful to within one ulp and are widened by two. Operations restrict
+// to their domain: the result encloses every defined value, and an
+// operation defined nowhere on its input yields the empty interval
+// (both bounds NaN). min and max follow fmin and fmax and pass the other
+// operand through an empty one.
+//
+// ============================================================================
+
+// Boxes per parallel block in batched interval evaluation
+#define FOSSIL_MATH_SYM_INTERVAL_BLOCK 64
+// Beyond this magnitude sin and cos are bounded by [-1, 1] without range reduction
+#define FOSSIL_MATH_SYM_TRIG_LIMIT 1e9
+
+static fossil_math_sym_interval_t fossil_math_sym_iv(double lo, double hi) {
+    fossil_math_sym_interval_t r;
+    r.lo = lo;
+    r.hi = hi;
+    return r;
+}
+
+#define FOSSIL_MATH_SYM_EMPTY fossil_math_sym_iv(NAN, NAN)
+#define FOSSIL_MATH_SYM_ENTIRE fossil_math_sym_iv(-INFINITY, INFINITY)
+
+// Moves x one ulp towards -inf (dir < 0) or +inf (dir > 0)
+static double fossil_math_sym_step(double x, int dir) {
+    return nextafter(x, dir < 0 ? -INFINITY : INFINITY);
+}
+
+// Rounds x, the computed result of an operation whose residual (exact - x)
+// has sign e, in direction dir. Tiny results may have lost the residual to
+// underflow, so they always move.
+static double fossil_math_sym_round(double x, double e, int dir) {
+    if (isnan(x)) return dir < 0 ? -INFINITY : INFINITY;
+    if (isnan(e) || fabs(x) < DBL_MIN || (dir < 0 ? e < 0.0 : e > 0.0)) return fossil_math_sym_step(x, dir);
+    return x;
+}
+
+static double fossil_math_sym_add_dir(double a, double b, int dir) {
+    double s = a + b;
+    if (isinf(a) || isinf(b)) return isnan(s) ? (dir < 0 ? -INFINITY : INFINITY) : s;
+    if (s == 0.0 && a == -b) return 0.0;
+    double bb = s - a;
+    return fossil_math_sym_round(s, (a - (s - bb)) + (b - bb), dir);
+}
+
+static double fossil_math_sym_mul_dir(double a, double b, int dir) {
+    if (a == 0.0 || b == 0.0) return 0.0;
+    double p = a * b;
+    if (isinf(a) || isinf(b)) return p;
+    return fossil_math_sym_round(p, fma(a, b, -p), dir);
+}
+
+static double fossil_math_sym_div_dir(double a, double b, int dir) {
+    if (a == 0.0) return 0.0;
+    double q = a / b;
+    if (isinf(a) || isinf(b)) return q;
+    // a - q * b carries the sign of the residual times the sign of b
+    double r = fma(-q, b, a);
+    return fossil_math_sym_round(q, b < 0.0 ? -r : r, dir);
+}
+
+// Widens a libm result by two ulps in direction dir
+static double fossil_math_sym_widen(double x, int dir) {
+    return fossil_math_sym_step(fossil_math_sym_step(x, dir), dir);
+}
+
+static int fossil_math_sym_iv_empty(fossil_math_sym_interval_t a) {
+    return isnan(a.lo) || isnan(a.hi);
+}
+
+static fossil_math_sym_interval_t fossil_math_sym_iv_mul(fossil_math_sym_interval_t a, fossil_math_sym_interval_t b) {
+    double lo = fossil_math_sym_mul_dir(a.lo, b.lo, -1), hi = fossil_math_sym_mul_dir(a.lo, b.lo, 1);
+    lo = fmin(lo, fossil_math_sym_mul_dir(a.lo, b.hi, -1));
+    hi = fmax(hi, fossil_math_sym_mul_dir(a.lo, b.hi, 1));
+    lo = fmin(lo, fossil_math_sym_mul_dir(a.hi, b.lo, -1));
+    hi = fmax(hi, fossil_math_sym_mul_dir(a.hi, b.lo, 1));
+    lo = fmin(lo, fossil_math_sym_mul_dir(a.hi, b.hi, -1));
+    hi = fmax(hi, fossil_math_sym_mul_dir(a.hi, b.hi, 1));
+    return fossil_math_sym_iv(lo, hi);
+}
+
+static fossil_math_sym_interval_t fossil_math_sym_iv_div(fossil_math_sym_interval_t a, fossil_math_sym_interval_t b) {
+    if (b.lo == 0.0 && b.hi == 0.0) return FOSSIL_MATH_SYM_EMPTY;
+    if (b.lo <= 0.0 && b.hi >= 0.0) return FOSSIL_MATH_SYM_ENTIRE;
+    // Corners of the form inf / inf are NaN; fmin and fmax skip them
+    double lo = fossil_math_sym_div_dir(a.lo, b.lo, -1), hi = fossil_math_sym_div_dir(a.lo, b.lo, 1);
+    lo = fmin(lo, fossil_math_sym_div_dir(a.lo, b.hi, -1));
+    hi = fmax(hi, fossil_math_sym_div_dir(a.lo, b.hi, 1));
+    lo = fmin(lo, fossil_math_sym_div_dir(a.hi, b.lo, -1));
+    hi = fmax(hi, fossil_math_sym_div_dir(a.hi, b.lo, 1));
+    lo = fmin(lo, fossil_math_sym_div_dir(a.hi, b.hi, -1));
+    hi = fmax(hi, fossil_math_sym_div_dir(a.hi, b.hi, 1));
+    return fossil_math_sym_iv(lo, hi);
+}
+
+// Applies a monotone libm function f, increasing when up is set
+static fossil_math_sym_interval_t fossil_math_sym_iv_monotone(double (*f)(double), double lo, double hi, int up) {
+    double x = f(up ? lo : hi), y = f(up ? hi : lo);
+    return fossil_math_sym_iv(fossil_math_sym_widen(x, -1), fossil_math_sym_widen(y, 1));
+}
+
+static fossil_math_sym_interval_t fossil_math_sym_iv_pow(fossil_math_sym_interval_t a, fossil_math_sym_interval_t b) {
+    double n = b.lo;
+    if (n == b.hi && n == floor(n) && fabs(n) < 9007199254740992.0) {
+        // Integer exponent: x^n is monotone on each side of zero
+        if (n == 0.0) return fossil_math_sym_iv(1.0, 1.0);
+        double m = fabs(n);
+        int even = fmod(m, 2.0) == 0.0;
+        fossil_math_sym_interval_t r;
+        if (!even || a.lo >= 0.0) {
+            r = fossil_math_sym_iv(pow(a.lo, m), pow(a.hi, m));
+        } else if (a.hi <= 0.0) {
+            r = fossil_math_sym_iv(pow(a.hi, m), pow(a.lo, m));
+        } else {
+            r = fossil_math_sym_iv(0.0, pow(fmax(-a.lo, a.hi), m));
+        }
+        // Exact zeros stay put so that even powers keep a lower bound of 0
+        if (r.lo != 0.0) r.lo = fossil_math_sym_widen(r.lo, -1);
+        if (r.hi != 0.0) r.hi = fossil_math_sym_widen(r.hi, 1);
+        if (even) r.lo = fmax(r.lo, 0.0);
+        return n > 0.0 ? r : fossil_math_sym_iv_div(fossil_math_sym_iv(1.0, 1.0), r);
+    }
+    if (a.lo < 0.0) {
+        // Negative bases are defined only at integer exponents
+        if (b.lo < b.hi) return FOSSIL_MATH_SYM_ENTIRE;
+        if (a.hi < 0.0) return FOSSIL_MATH_SYM_EMPTY;
+        a.lo = 0.0;
+    }
+    // For x >= 0, x^y is monotone in each argument, so the corners bound it
+    double c[4] = {pow(a.lo, b.lo), pow(a.lo, b.hi), pow(a.hi, b.lo), pow(a.hi, b.hi)};
+    double lo = fmin(fmin(c[0], c[1]), fmin(c[2], c[3])), hi = fmax(fmax(c[0], c[1]), fmax(c[2], c[3]));
+    return fossil_math_sym_iv(fmax(0.0, fossil_math_sym_widen(lo, -1)), fossil_math_sym_widen(hi, 1));
+}
+
+// Non-zero if phase + 2k pi lies in [lo, hi] for some integer k. Near the
+// ends the answer errs towards yes, which only widens the enclosure.
+static int fossil_math_sym_iv_hits(double lo, double hi, double phase) {
+    double k = ceil((lo - phase) / FOSSIL_MATH_TWO_PI - 1e-9);
+    return phase + k * FOSSIL_MATH_TWO_PI <= hi + 1e-9 * (1.0 + fabs(hi));
+}
+
+// sin (shift 0) or cos (shift pi / 2), whose maxima lie at pi / 2 - shift
+static fossil_math_sym_interval_t fossil_math_sym_iv_trig(fossil_math_sym_interval_t a, int cosine) {
+    if (!(a.hi - a.lo < FOSSIL_MATH_TWO_PI) || fabs(a.lo) > FOSSIL_MATH_SYM_TRIG_LIMIT || fabs(a.hi) > FOSSIL_MATH_SYM_TRIG_LIMIT) {
+        return fossil_math_sym_iv(-1.0, 1.0);
+    }
+    double x = cosine ? cos(a.lo) : sin(a.lo), y = cosine ? cos(a.hi) : sin(a.hi);
+    double top = cosine ? 0.0 : FOSSIL_MATH_HALF_PI;
+    fossil_math_sym_interval_t r = {fmax(-1.0, fossil_math_sym_widen(fmin(x, y), -1)), fmin(1.0, fossil_math_sym_widen(fmax(x, y), 1))};
+    if (fossil_math_sym_iv_hits(a.lo, a.hi, top)) r.hi = 1.0;
+    if (fossil_math_sym_iv_hits(a.lo, a.hi, top - FOSSIL_MATH_PI)) r.lo = -1.0;
+    return r;
+}
+
+// Applies opcode code; b is ignored by unary operations
+static fossil_math_sym_interval_t fossil_math_sym_iv_apply(uint32_t code, fossil_math_sym_interval_t a, fossil_math_sym_interval_t b) {
+    // fmin and fmax return the other operand where one is NaN
+    if (code == FOSSIL_MATH_SYM_OP_MIN || code == FOSSIL_MATH_SYM_OP_MAX) {
+        if (fossil_math_sym_iv_empty(a)) return b;
+        if (fossil_math_sym_iv_empty(b)) return a;
+    }
+    if (fossil_math_sym_iv_empty(a) || (fossil_math_sym_ops[code].arity == 2 && fossil_math_sym_iv_empty(b))) {
+        return FOSSIL_MATH_SYM_EMPTY;
+    }
+    switch (code) {
+        case FOSSIL_MATH_SYM_OP_ADD:
+            return fossil_math_sym_iv(fossil_math_sym_add_dir(a.lo, b.lo, -1), fossil_math_sym_add_dir(a.hi, b.hi, 1));
+        case FOSSIL_MATH_SYM_OP_SUB:
+            return fossil_math_sym_iv(fossil_math_sym_add_dir(a.lo, -b.hi, -1), fossil_math_sym_add_dir(a.hi, -b.lo, 1));
+        case FOSSIL_MATH_SYM_OP_MUL:
+            return fossil_math_sym_iv_mul(a, b);
+        case FOSSIL_MATH_SYM_OP_DIV:
+            return fossil_math_sym_iv_div(a, b);
+        case FOSSIL_MATH_SYM_OP_POW:
+            return fossil_math_sym_iv_pow(a, b);
+        case FOSSIL_MATH_SYM_OP_NEG:
+            return fossil_math_sym_iv(-a.hi, -a.lo);
+        case FOSSIL_MATH_SYM_OP_SIN:
+            return fossil_math_sym_iv_trig(a, 0);
+        case FOSSIL_MATH_SYM_OP_COS:
+            return fossil_math_sym_iv_trig(a, 1);
+        case FOSSIL_MATH_SYM_OP_EXP: {
+            fossil_math_sym_interval_t r = fossil_math_sym_iv_monotone(exp, a.lo, a.hi, 1);
+            r.lo = fmax(r.lo, 0.0);
+            return r;
+        }
+        case FOSSIL_MATH_SYM_OP_LOG:
+            if (a.hi < 0.0) return FOSSIL_MATH_SYM_EMPTY;
+            return fossil_math_sym_iv_monotone(log, fmax(a.lo, 0.0), a.hi, 1);
+        case FOSSIL_MATH_SYM_OP_SQRT: {
+            if (a.hi < 0.0) return FOSSIL_MATH_SYM_EMPTY;
+            double lo = sqrt(fmax(a.lo, 0.0)), hi = sqrt(a.hi);
+            // x - s * s is the residual of the square
+            lo = isinf(lo) ? lo : fossil_math_sym_round(lo, fma(-lo, lo, fmax(a.lo, 0.0)), -1);
+            hi = isinf(hi) ? hi : fossil_math_sym_round(hi, fma(-hi, hi, a.hi), 1);
+            return fossil_math_sym_iv(fmax(lo, 0.0), hi);
+        }
+        case FOSSIL_MATH_SYM_OP_ABS:
+            if (a.lo >= 0.0) return a;
+            if (a.hi <= 0.0) return fossil_math_sym_iv(-a.hi, -a.lo);
+            return fossil_math_sym_iv(0.0, fmax(-a.lo, a.hi));
+        case FOSSIL_MATH_SYM_OP_MIN:
+            return fossil_math_sym_iv(fmin(a.lo, b.lo), fmin(a.hi, b.hi));
+        case FOSSIL_MATH_SYM_OP_MAX:
+            return fossil_math_sym_iv(fmax(a.lo, b.lo), fmax(a.hi, b.hi));
+        default:
+            return FOSSIL_MATH_SYM_EMPTY;
+    }
+}
+
+static fossil_math_sym_interval_t fossil_math_sym_eval_interval_node(const fossil_math_sym_expr_t* e, const char* const* vars,
+                                                                     const fossil_math_sym_interval_t* ranges, size_t nvars) {
+    switch (e->type) {
+        case fossil_math_sym_CONST:
+            return fossil_math_sym_iv(e->value, e->value);
+        case fossil_math_sym_VAR:
+            for (size_t i = 0; i < nvars; ++i) {
+                if (vars[i] && strcmp(vars[i], e->name) == 0) return ranges[i];
+            }
+            return FOSSIL_MATH_SYM_EMPTY;
+        case fossil_math_sym_OP: {
+            const fossil_math_sym_opinfo_t* info = fossil_math_sym_opinfo(e->op);
+            if (!info || !e->left || (info->arity == 2 && !e->right)) return FOSSIL_MATH_SYM_EMPTY;
+            fossil_math_sym_interval_t a = fossil_math_sym_eval_interval_node(e->left, vars, ranges, nvars);
+            fossil_math_sym_interval_t b = info->arity == 2 ? fossil_math_sym_eval_interval_node(e->right, vars, ranges, nvars) : a;
+            return fossil_math_sym_iv_apply(info->code, a, b);
+        }
+    }
+    return FOSSIL_MATH_SYM_EMPTY;
+}
+
+fossil_math_sym_interval_t fossil_math_sym_eval_interval(const fossil_math_sym_expr_t* expr, const char* const* vars,
+                                                         const fossil_math_sym_interval_t* ranges, size_t nvars) {
+    if (!expr || (nvars > 0 && (!vars || !ranges))) return FOSSIL_MATH_SYM_EMPTY;
+    return fossil_math_sym_eval_interval_node(expr, vars, ranges, nvars);
+}
+
+// Runs the program over the interval register file r
+static void fossil_math_sym_run_interval(const fossil_math_sym_compiled_t* prog, const fossil_math_sym_interval_t* vars,
+                                         fossil_math_sym_interval_t* r) {
+    if (prog->nvars) memcpy(r, vars, prog->nvars * sizeof(*r));
+    for (size_t k = 0; k < prog->nconsts; ++k) r[prog->nvars + k] = fossil_math_sym_iv(prog->consts[k], prog->consts[k]);
+    const fossil_math_sym_instr_t* in = prog->code;
+    const fossil_math_sym_instr_t* end = in + prog->ncode;
+    for (; in != end; ++in) r[in->dst] = fossil_math_sym_iv_apply(in->op, r[in->a], r[in->b]);
+}
+
+fossil_math_sym_interval_t fossil_math_sym_eval_compiled_interval(const fossil_math_sym_compiled_t* prog,
+                                                                  const fossil_math_sym_interval_t* vars) {
+    if (!prog || (!vars && prog->nvars > 0)) return FOSSIL_MATH_SYM_EMPTY;
+    fossil_math_sym_interval_t local[FOSSIL_MATH_SYM_LOCAL_REGS];
+    fossil_math_sym_interval_t* r = local;
+    if (prog->nregs > FOSSIL_MATH_SYM_LOCAL_REGS) {
+        r = malloc(prog->nregs * sizeof(*r));
+        if (!r) return FOSSIL_MATH_SYM_EMPTY;
+    }
+    fossil_math_sym_run_interval(prog, vars, r);
+    fossil_math_sym_interval_t result = r[prog->result];
+    if (r != local) free(r);
+    return result;
+}
+
+int fossil_math_sym_eval_compiled_interval_many(const fossil_math_sym_compiled_t* prog, const fossil_math_sym_interval_t* vars,
+                                                fossil_math_sym_interval_t* out) {
+    if (!prog || !out || (!vars && prog->nvars > 0)) return -1;
+    fossil_math_sym_interval_t local[FOSSIL_MATH_SYM_LOCAL_REGS];
+    fossil_math_sym_interval_t* r = local;
+    if (prog->nregs > FOSSIL_MATH_SYM_LOCAL_REGS) {
+        r = malloc(prog->nregs * sizeof(*r));
+        if (!r) return -2;
+    }
+    fossil_math_sym_run_interval(prog, vars, r);
+    for (size_t k = 0; k < prog->noutputs; ++k) out[k] = r[prog->outputs[k]];
+    if (r != local) free(r);
+    return 0;
+}
+
+typedef struct {
+    const fossil_math_sym_compiled_t* prog;
+    const fossil_math_sym_interval_t* const* var_columns;
+    fossil_math_sym_interval_t* out;
+    size_t n;
+    unsigned char* failed;  // Per block, set when a chunk cannot allocate scratch
+} fossil_math_sym_interval_job_t;
+
+static void fossil_math_sym_interval_chunk(size_t begin, size_t end, void* ctx) {
+    fossil_math_sym_interval_job_t* job = (fossil_math_sym_interval_job_t*)ctx;
+    const fossil_math_sym_compiled_t* p = job->prog;
+    // Register file followed by the gathered box
+    fossil_math_sym_interval_t local[FOSSIL_MATH_SYM_LOCAL_REGS];
+    fossil_math_sym_interval_t* r = local;
+    if (p->nregs + p->nvars > FOSSIL_MATH_SYM_LOCAL_REGS) {
+        r = malloc((p->nregs + p->nvars) * sizeof(*r));
+        if (!r) {
+            for (size_t blk = begin; blk < end; ++blk) job->failed[blk] = 1;
+            return;
+        }
+    }
+    fossil_math_sym_interval_t* box = r + p->nregs;
+    size_t stop = FOSSIL_MATH_MIN(end * FOSSIL_MATH_SYM_INTERVAL_BLOCK, job->n);
+    for (size_t i = begin * FOSSIL_MATH_SYM_INTERVAL_BLOCK; i < stop; ++i) {
+        for (size_t v = 0; v < p->nvars; ++v) box[v] = job->var_columns[v][i];
+        fossil_math_sym_run_interval(p, box, r);
+        job->out[i] = r[p->result];
+    }
+    if (r != local) free(r);
+}
+
+int fossil_math_sym_eval_batch_interval(const fossil_math_sym_compiled_t* prog, const fossil_math_sym_interval_t* const* var_columns,
+                                        fossil_math_sym_interval_t* out, size_t n) {
+    if (!prog || (n > 0 && (!out || (!var_columns && prog->nvars > 0)))) return -1;
+    if (n == 0) return 0;
+    for (size_t v = 0; v < prog->nvars; ++v) {
+        if (!var_columns[v]) return -1;
+    }
+    size_t blocks = (n + FOSSIL_MATH_SYM_INTERVAL_BLOCK - 1) / FOSSIL_MATH_SYM_INTERVAL_BLOCK;
+    fossil_math_sym_interval_job_t job = {prog, var_columns, out, n, calloc(blocks, 1)};
+    if (!job.failed) return -2;
+    fossil_math_parallel_for(blocks, 1, fossil_math_sym_interval_chunk, &job);
+    int status = 0;
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        if (job.failed[blk]) status = -2;
+    }
+    free(job.failed);
+    return status;
+}
+
+// ============================================================================
+// Expression Graphs
+// ============================================================================
+//
+// Nodes are 16-byte tagged records in one contiguous array, linked by index:
+//
+//   type | op | reserved | sym      (1 + 1 + 2 + 4 bytes)
+//   value, or left | right          (8 bytes)
+//
+// Unary operators store their operand in both child slots, so traversals
+// need no arity checks. Unused fields are zero, so two nodes are
+// structurally equal exactly when their bytes are, and hashing and
+// comparison work on the raw record.
+// Variable names are interned once into a symbol table backed by a block
+// arena; variable nodes store the symbol id.
+//
+// Nodes are interned through an open-addressing table of node indices.
+// Memoized simplify/diff results live in a second table keyed by
+// (kind, node, aux). Builders never hold node pointers across calls that
+// may grow the array; they work with indices only.
+//
+// ============================================================================
+
+#define FOSSIL_MATH_SYM_MEMO_SIMPLIFY 1u
+#define FOSSIL_MATH_SYM_MEMO_DIFF 2u
+// Size of each block of the symbol name arena
+#define FOSSIL_MATH_SYM_NAME_BLOCK 4096
+
+typedef struct {
+    uint8_t type;       // fossil_math_sym_type_t
+    char op;
+    uint16_t reserved;
+    uint32_t sym;       // symbol id of variable nodes
+    union {
+        double value;
+        uint32_t child[2];
+    } u;
+} fossil_math_sym_gnode_t;
+
+typedef struct {
+    uint32_t kind;
+    uint32_t node;
+    uint32_t aux;
+    uint32_t result;
+} fossil_math_sym_memo_t;
+
+typedef struct fossil_math_sym_name_block {
+    struct fossil_math_sym_name_block* next;
+    size_t used;
+    size_t cap;
+    char* data;         // storage following the header
+} fossil_math_sym_name_block_t;
+
+struct fossil_math_sym_graph {
+    fossil_math_sym_gnode_t* nodes;
+    size_t count;
+    size_t cap;
+    uint32_t* table;      // node indices, FOSSIL_MATH_SYM_NONE when empty
+    size_t table_cap;     // power of two
+    fossil_math_sym_memo_t* memo;  // kind 0 when empty
+    size_t memo_count;
+    size_t memo_cap;      // power of two
+    const char** syms;    // symbol id -> interned name
+    size_t nsyms;
+    size_t syms_cap;
+    uint32_t* sym_table;  // symbol ids, FOSSIL_MATH_SYM_NONE when empty
+    size_t sym_table_cap; // power of two
+    fossil_math_sym_name_block_t* names;
+};
+
+static uint64_t fossil_math_sym_mix(uint64_t h, uint64_t v) {
+    h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h *= 0xFF51AFD7ED558CCDull;
+    // Tables index by the low bits, which the multiply alone leaves blind to high input bits
+    return h ^ (h >> 32);
+}
+
+static int fossil_math_sym_node_equal(const fossil_math_sym_gnode_t* a, const fossil_math_sym_gnode_t* b) {
+    uint64_t x[2], y[2];
+    memcpy(x, a, sizeof(x));
+    memcpy(y, b, sizeof(y));
+    return x[0] == y[0] && x[1] == y[1];
+}
+
+static uint64_t fossil_math_sym_node_hash(const fossil_math_sym_gnode_t* n) {
+    // Two independent multiplies keep this off the critical path of interning
+    uint64_t w[2];
+    memcpy(w, n, sizeof(w));
+    uint64_t h = (w[0] * 0x9E3779B97F4A7C15ull) ^ (w[1] * 0xFF51AFD7ED558CCDull);
+    return h ^ (h >> 32);
+}
+
+static uint64_t fossil_math_sym_name_hash(const char* name, size_t len) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < len; ++i) h = (h ^ (unsigned char)name[i]) * 0x100000001B3ull;
+    return h;
+}
+
+static uint32_t* fossil_math_sym_table_build(size_t cap) {
+    uint32_t* table = malloc(cap * sizeof(uint32_t));
+    if (table) {
+        for (size_t i = 0; i < cap; ++i) table[i] = FOSSIL_MATH_SYM_NONE;
+    }
+    return table;
+}
+
+static int fossil_math_sym_graph_rehash(fossil_math_sym_graph_t* g, size_t cap) {
+    uint32_t* table = fossil_math_sym_table_build(cap);
+    if (!table) return -1;
+    for (size_t i = 0; i < g->count; ++i) {
+        size_t slot = (size_t)fossil_math_sym_node_hash(&g->nodes[i]) & (cap - 1);
+        while (table[slot] != FOSSIL_MATH_SYM_NONE) slot = (slot + 1) & (cap - 1);
+        table[slot] = (uint32_t)i;
+    }
+    free(g->table);
+    g->table = table;
+    g->table_cap = cap;
+    return 0;
+}
+
+static int fossil_math_sym_symbols_rehash(fossil_math_sym_graph_t* g, size_t cap) {
+    uint32_t* table = fossil_math_sym_table_build(cap);
+    if (!table) return -1;
+    for (size_t i = 0; i < g->nsyms; ++i) {
+        size_t slot = (size_t)fossil_math_sym_name_hash(g->syms[i], strlen(g->syms[i])) & (cap - 1);
+        while (table[slot] != FOSSIL_MATH_SYM_NONE) slot = (slot + 1) & (cap - 1);
+        table[slot] = (uint32_t)i;
+    }
+    free(g->sym_table);
+    g->sym_table = table;
+    g->sym_table_cap = cap;
+    return 0;
+}
+
+// Returns the probe slot of the len-byte name: its entry if present, else the empty slot
+static size_t fossil_math_sym_symbol_slot(const fossil_math_sym_graph_t* g, const char* name, size_t len) {
+    size_t slot = (size_t)fossil_math_sym_name_hash(name, len) & (g->sym_table_cap - 1);
+    for (uint32_t id; (id = g->sym_table[slot]) != FOSSIL_MATH_SYM_NONE; slot = (slot + 1) & (g->sym_table_cap - 1)) {
+        // name holds no terminator within len, so the scan stops at the end of shorter symbols
+        const char* sym = g->syms[id];
+        size_t k = 0;
+        while (k < len && sym[k] == name[k]) ++k;
+        if (k == len && sym[len] == '\0') break;
+    }
+    return slot;
+}
+
+static uint32_t fossil_math_sym_symbol_find(const fossil_math_sym_graph_t* g, const char* name) {
+    return g->sym_table[fossil_math_sym_symbol_slot(g, name, strlen(name))];
+}
+
+// Copies a name into the arena; pointers stay valid until the graph is freed
+static const char* fossil_math_sym_name_store(fossil_math_sym_graph_t* g, const char* name, size_t size) {
+    size_t len = size + 1;
+    fossil_math_sym_name_block_t* block = g->names;
+    if (!block || block->cap - block->used < len) {
+        size_t cap = len > FOSSIL_MATH_SYM_NAME_BLOCK ? len : FOSSIL_MATH_SYM_NAME_BLOCK;
+        block = malloc(sizeof(*block) + cap);
+        if (!block) return NULL;
+        block->next = g->names;
+        block->data = (char*)(block + 1);
+        block->used = 0;
+        block->cap = cap;
+        g->names = block;
+    }
+    char* copy = block->data + block->used;
+    memcpy(copy, name, size);
+    copy[size] = '\0';
+    block->used += len;
+    return copy;
+}
+
+static uint32_t fossil_math_sym_symbol_intern(fossil_math_sym_graph_t* g, const char* name, size_t len) {
+    size_t slot = fossil_math_sym_symbol_slot(g, name, len);
+    if (g->sym_table[slot] != FOSSIL_MATH_SYM_NONE) return g->sym_table[slot];
+
+    if (fossil_math_sym_grow((void**)&g->syms, &g->syms_cap, g->nsyms + 1, sizeof(*g->syms)) != 0) return FOSSIL_MATH_SYM_NONE;
+    if ((g->nsyms + 1) * 2 > g->sym_table_cap) {
+        if (fossil_math_sym_symbols_rehash(g, g->sym_table_cap * 2) != 0) return FOSSIL_MATH_SYM_NONE;
+        slot = fossil_math_sym_symbol_slot(g, name, len);
+    }
+    const char* copy = fossil_math_sym_name_store(g, name, len);
+    if (!copy) return FOSSIL_MATH_SYM_NONE;
+
+    uint32_t id = (uint32_t)g->nsyms++;
+    g->syms[id] = copy;
+    g->sym_table[slot] = id;
+    return id;
+}
+
+// Returns the existing node with these bytes, or appends it
+static fossil_math_sym_node_t fossil_math_sym_graph_intern(fossil_math_sym_graph_t* g, const fossil_math_sym_gnode_t* n) {
+    uint64_t hash = fossil_math_sym_node_hash(n);
+    size_t slot = (size_t)hash & (g->table_cap - 1);
+    for (uint32_t id; (id = g->table[slot]) != FOSSIL_MATH_SYM_NONE; slot = (slot + 1) & (g->table_cap - 1)) {
+        if (fossil_math_sym_node_equal(&g->nodes[id], n)) return id;
+    }
+    if (g->count + 1 >= FOSSIL_MATH_SYM_NONE) return FOSSIL_MATH_SYM_NONE;
+    if (fossil_math_sym_grow((void**)&g->nodes, &g->cap, g->count + 1, sizeof(*g->nodes)) != 0) return FOSSIL_MATH_SYM_NONE;
+    if ((g->count + 1) * 2 > g->table_cap) {
+        if (fossil_math_sym_graph_rehash(g, g->table_cap * 2) != 0) return FOSSIL_MATH_SYM_NONE;
+        slot = (size_t)hash & (g->table_cap - 1);
+        while (g->table[slot] != FOSSIL_MATH_SYM_NONE) slot = (slot + 1) & (g->table_cap - 1);
+    }
+
+    uint32_t id = (uint32_t)g->count++;
+    g->nodes[id] = *n;
+    g->table[slot] = id;
+    return id;
+}
+
+static size_t fossil_math_sym_memo_slot(const fossil_math_sym_graph_t* g, uint32_t kind, uint32_t node, uint32_t aux) {
+    uint64_t h = fossil_math_sym_mix(fossil_math_sym_mix(fossil_math_sym_mix(0, kind), node), aux);
+    size_t slot = (size_t)h & (g->memo_cap - 1);
+    while (g->memo[slot].kind != 0 &&
+           (g->memo[slot].kind != kind || g->memo[slot].node != node || g->memo[slot].aux != aux)) {
+        slot = (slot + 1) & (g->memo_cap - 1);
+    }
+    return slot;
+}
+
+static uint32_t fossil_math_sym_memo_get(const fossil_math_sym_graph_t* g, uint32_t kind, uint32_t node, uint32_t aux) {
+    const fossil_math_sym_memo_t* m = &g->memo[fossil_math_sym_memo_slot(g, kind, node, aux)];
+    return m->kind ? m->result : FOSSIL_MATH_SYM_NONE;
+}
+
+// Failures only lose the cache entry, never the result
+static void fossil_math_sym_memo_put(fossil_math_sym_graph_t* g, uint32_t kind, uint32_t node, uint32_t aux, uint32_t result) {
+    if (result == FOSSIL_MATH_SYM_NONE) return;
+    if ((g->memo_count + 1) * 2 > g->memo_cap) {
+        size_t old_cap = g->memo_cap;
+        fossil_math_sym_memo_t* old = g->memo;
+        fossil_math_sym_memo_t* memo = calloc(old_cap * 2, sizeof(*memo));
+        if (!memo) return;
+        g->memo = memo;
+        g->memo_cap = old_cap * 2;
+        for (size_t i = 0; i < old_cap; ++i) {
+            if (old[i].kind) g->memo[fossil_math_sym_memo_slot(g, old[i].kind, old[i].node, old[i].aux)] = old[i];
+        }
+        free(old);
+    }
+    fossil_math_sym_memo_t* m = &g->memo[fossil_math_sym_memo_slot(g, kind, node, aux)];
+    if (!m->kind) g->memo_count++;
+    m->kind = kind;
+    m->node = node;
+    m->aux = aux;
+    m->result = result;
+}
+
+static int fossil_math_sym_graph_valid(const fossil_math_sym_graph_t* g, fossil_math_sym_node_t node) {
+    return g && node < g->count;
+}
+
+fossil_math_sym_graph_t* fossil_math_sym_graph_create(void) {
+    fossil_math_sym_graph_t* g = calloc(1, sizeof(*g));
+    if (!g) return NULL;
+    g->memo_cap = 64;
+    g->memo = calloc(g->memo_cap, sizeof(*g->memo));
+    if (!g->memo || fossil_math_sym_graph_rehash(g, 64) != 0 || fossil_math_sym_symbols_rehash(g, 16) != 0) {
+        fossil_math_sym_graph_free(g);
+        return NULL;
+    }
+    return g;
+}
+
+void fossil_math_sym_graph_free(fossil_math_sym_graph_t* graph) {
+    if (!graph) return;
+    while (graph->names) {
+        fossil_math_sym_name_block_t* next = graph->names->next;
+        free(graph->names);
+        graph->names = next;
+    }
+    free(graph->nodes);
+    free(graph->table);
+    free(graph->memo);
+    free(graph->syms);
+    free(graph->sym_table);
+    free(graph);
+}
+
+size_t fossil_math_sym_graph_size(const fossil_math_sym_graph_t* graph) {
+    return graph ? graph->count : 0;
+}
+
+size_t fossil_math_sym_graph_bytes(const fossil_math_sym_graph_t* graph) {
+    if (!graph) return 0;
+    size_t bytes = sizeof(*graph) +
+                   graph->cap * sizeof(*graph->nodes) +
+                   graph->table_cap * sizeof(*graph->table) +
+                   graph->memo_cap * sizeof(*graph->memo) +
+                   graph->syms_cap * sizeof(*graph->syms) +
+                   graph->sym_table_cap * sizeof(*graph->sym_table);
+    for (const fossil_math_sym_name_block_t* b = graph->names; b; b = b->next) bytes += sizeof(*b) + b->cap;
+    return bytes;
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_const(fossil_math_sym_graph_t* graph, double value) {
+    if (!graph) return FOSSIL_MATH_SYM_NONE;
+    fossil_math_sym_gnode_t n;
+    memset(&n, 0, sizeof(n));
+    n.type = fossil_math_sym_CONST;
+    n.u.value = value;
+    return fossil_math_sym_graph_intern(graph, &n);
+}
+
+// Variable node for the first len bytes of name (len < FOSSIL_MATH_SYM_NAME_MAX)
+static fossil_math_sym_node_t fossil_math_sym_graph_var_n(fossil_math_sym_graph_t* g, const char* name, size_t len) {
+    fossil_math_sym_gnode_t n;
+    memset(&n, 0, sizeof(n));
+    n.type = fossil_math_sym_VAR;
+    n.sym = fossil_math_sym_symbol_intern(g, name, len);
+    if (n.sym == FOSSIL_MATH_SYM_NONE) return FOSSIL_MATH_SYM_NONE;
+    return fossil_math_sym_graph_intern(g, &n);
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_var(fossil_math_sym_graph_t* graph, const char* name) {
+    if (!graph || !name) return FOSSIL_MATH_SYM_NONE;
+    // Same truncation as tree nodes, so imported and exported names agree
+    size_t len = 0;
+    while (len < FOSSIL_MATH_SYM_NAME_MAX - 1 && name[len]) ++len;
+    return fossil_math_sym_graph_var_n(graph, name, len);
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_op(fossil_math_sym_graph_t* graph, char op, fossil_math_sym_node_t a, fossil_math_sym_node_t b) {
+    uint32_t code;
+    if (fossil_math_sym_arity(op) == 1) b = a;
+    if (!fossil_math_sym_graph_valid(graph, a) || !fossil_math_sym_graph_valid(graph, b) ||
+        fossil_math_sym_opcode(op, &code) != 0) {
+        return FOSSIL_MATH_SYM_NONE;
+    }
+    fossil_math_sym_gnode_t n;
+    memset(&n, 0, sizeof(n));
+    n.type = fossil_math_sym_OP;
+    n.op = op;
+    n.u.child[0] = a;
+    n.u.child[1] = b;
+    return fossil_math_sym_graph_intern(graph, &n);
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_import(fossil_math_sym_graph_t* graph, const fossil_math_sym_expr_t* expr) {
+    if (!graph || !expr) return FOSSIL_MATH_SYM_NONE;
+    switch (expr->type) {
+        case fossil_math_sym_CONST:
+            return fossil_math_sym_graph_const(graph, expr->value);
+        case fossil_math_sym_VAR:
+            return fossil_math_sym_graph_var(graph, expr->name);
+        case fossil_math_sym_OP: {
+            fossil_math_sym_node_t a = fossil_math_sym_graph_import(graph, expr->left);
+            if (fossil_math_sym_arity(expr->op) == 1) return fossil_math_sym_graph_op(graph, expr->op, a, a);
+            fossil_math_sym_node_t b = fossil_math_sym_graph_import(graph, expr->right);
+            return fossil_math_sym_graph_op(graph, expr->op, a, b);
+        }
+    }
+    return FOSSIL_MATH_SYM_NONE;
+}
+
+fossil_math_sym_expr_t* fossil_math_sym_graph_export(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(graph, node)) return NULL;
+    const fossil_math_sym_gnode_t* n = &graph->nodes[node];
+    switch (n->type) {
+        case fossil_math_sym_CONST:
+            return fossil_math_sym_new_const(n->u.value);
+        case fossil_math_sym_VAR:
+            return fossil_math_sym_new_var(graph->syms[n->sym]);
+        case fossil_math_sym_OP: {
+            char op = n->op;
+            fossil_math_sym_expr_t* a = fossil_math_sym_graph_export(graph, n->u.child[0]);
+            if (fossil_math_sym_arity(op) == 1) {
+                fossil_math_sym_expr_t* e = a ? fossil_math_sym_new_op(op, a, NULL) : NULL;
+                if (!e) fossil_math_sym_free(a);
+                return e;
+            }
+            fossil_math_sym_expr_t* b = fossil_math_sym_graph_export(graph, n->u.child[1]);
+            fossil_math_sym_expr_t* e = (a && b) ? fossil_math_sym_new_op(op, a, b) : NULL;
+            if (!e) {
+                fossil_math_sym_free(a);
+                fossil_math_sym_free(b);
+            }
+            return e;
+        }
+    }
+    return NULL;
+}
+
+fossil_math_sym_type_t fossil_math_sym_graph_type(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    return fossil_math_sym_graph_valid(graph, node) ? (fossil_math_sym_type_t)graph->nodes[node].type : fossil_math_sym_CONST;
+}
+
+char fossil_math_sym_graph_node_op(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    return fossil_math_sym_graph_valid(graph, node) ? graph->nodes[node].op : 0;
+}
+
+double fossil_math_sym_graph_value(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(graph, node) || graph->nodes[node].type != fossil_math_sym_CONST) return NAN;
+    return graph->nodes[node].u.value;
+}
+
+const char* fossil_math_sym_graph_name(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(graph, node) || graph->nodes[node].type != fossil_math_sym_VAR) return NULL;
+    return graph->syms[graph->nodes[node].sym];
+}
+
+int fossil_math_sym_graph_children(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                   fossil_math_sym_node_t* left, fossil_math_sym_node_t* right) {
+    if (!fossil_math_sym_graph_valid(graph, node) || graph->nodes[node].type != fossil_math_sym_OP) return -1;
+    if (left) *left = graph->nodes[node].u.child[0];
+    if (right) *right = graph->nodes[node].u.child[1];
+    return 0;
+}
+
+// Marks the nodes reachable from any of the roots in mark[0, n), where n
+// exceeds every root. Children precede parents, so one downward sweep
+// suffices. Returns the number of marked nodes.
+static size_t fossil_math_sym_graph_mark_many(const fossil_math_sym_graph_t* g, const fossil_math_sym_node_t* roots, size_t nroots,
+                                              unsigned char* mark, size_t n) {
+    size_t reached = 0;
+    memset(mark, 0, n);
+    for (size_t k = 0; k < nroots; ++k) mark[roots[k]] = 1;
+    for (size_t i = n; i-- > 0;) {
+        if (!mark[i]) continue;
+        ++reached;
+        if (g->nodes[i].type == fossil_math_sym_OP) {
+            mark[g->nodes[i].u.child[0]] = 1;
+            mark[g->nodes[i].u.child[1]] = 1;
+        }
+    }
+    return reached;
+}
+
+static size_t fossil_math_sym_graph_mark(const fossil_math_sym_graph_t* g, fossil_math_sym_node_t root, unsigned char* mark) {
+    return fossil_math_sym_graph_mark_many(g, &root, 1, mark, (size_t)root + 1);
+}
+
+size_t fossil_math_sym_graph_count(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(graph, node)) return 0;
+    unsigned char* mark = malloc((size_t)node + 1);
+    if (!mark) return 0;
+    size_t reached = fossil_math_sym_graph_mark(graph, node, mark);
+    free(mark);
+    return reached;
+}
+
+static int fossil_math_sym_graph_is(const fossil_math_sym_graph_t* g, fossil_math_sym_node_t node, double value) {
+    return g->nodes[node].type == fossil_math_sym_CONST && g->nodes[node].u.value == value;
+}
+
+static int fossil_math_sym_graph_is_op(const fossil_math_sym_graph_t* g, fossil_math_sym_node_t node, char op) {
+    return g->nodes[node].type == fossil_math_sym_OP && g->nodes[node].op == op;
+}
+
+// Builds a op b, folding constants and identities (b is ignored by unary operators)
+static fossil_math_sym_node_t fossil_math_sym_graph_fold(fossil_math_sym_graph_t* g, char op, fossil_math_sym_node_t a, fossil_math_sym_node_t b) {
+    if (fossil_math_sym_arity(op) == 1) b = a;
+    if (!fossil_math_sym_graph_valid(g, a) || !fossil_math_sym_graph_valid(g, b)) return FOSSIL_MATH_SYM_NONE;
+    if (g->nodes[a].type == fossil_math_sym_CONST && g->nodes[b].type == fossil_math_sym_CONST) {
+        return fossil_math_sym_graph_const(g, fossil_math_sym_apply(op, g->nodes[a].u.value, g->nodes[b].u.value));
+    }
+    switch (op) {
+        case '+':
+            if (fossil_math_sym_graph_is(g, a, 0.0)) return b;
+            if (fossil_math_sym_graph_is(g, b, 0.0)) return a;
+            break;
+        case '-':
+            if (fossil_math_sym_graph_is(g, b, 0.0)) return a;
+            if (a == b) return fossil_math_sym_graph_const(g, 0.0);
+            break;
+        case '*':
+            if (fossil_math_sym_graph_is(g, a, 0.0) || fossil_math_sym_graph_is(g, b, 0.0)) return fossil_math_sym_graph_const(g, 0.0);
+            if (fossil_math_sym_graph_is(g, a, 1.0)) return b;
+            if (fossil_math_sym_graph_is(g, b, 1.0)) return a;
+            break;
+        case '/':
+            if (fossil_math_sym_graph_is(g, b, 1.0)) return a;
+            break;
+        case '^':
+            if (fossil_math_sym_graph_is(g, b, 1.0)) return a;
+            if (fossil_math_sym_graph_is(g, b, 0.0)) return fossil_math_sym_graph_const(g, 1.0);
+            break;
+        case FOSSIL_MATH_SYM_NEG:
+            if (fossil_math_sym_graph_is_op(g, a, FOSSIL_MATH_SYM_NEG)) return g->nodes[a].u.child[0];
+            break;
+        case FOSSIL_MATH_SYM_LOG:
+            if (fossil_math_sym_graph_is_op(g, a, FOSSIL_MATH_SYM_EXP)) return g->nodes[a].u.child[0];
+            break;
+        case FOSSIL_MATH_SYM_ABS:
+            if (fossil_math_sym_graph_is_op(g, a, FOSSIL_MATH_SYM_ABS)) return a;
+            if (fossil_math_sym_graph_is_op(g, a, FOSSIL_MATH_SYM_NEG)) {
+                fossil_math_sym_node_t u = g->nodes[a].u.child[0];
+                return fossil_math_sym_graph_fold(g, op, u, u);
+            }
+            break;
+        case FOSSIL_MATH_SYM_MIN:
+        case FOSSIL_MATH_SYM_MAX:
+            if (a == b) return a;
+            break;
+        default:
+            break;
+    }
+    return fossil_math_sym_graph_op(g, op, a, b);
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_fold1(fossil_math_sym_graph_t* g, char op, fossil_math_sym_node_t a) {
+    return fossil_math_sym_graph_fold(g, op, a, a);
+}
+
+// Upper bound on canonicalization passes run by fossil_math_sym_graph_simplify
+#define FOSSIL_MATH_SYM_SIMPLIFY_PASSES 8
+
+// Sums are flattened into (monomial, coefficient) terms and products into a
+// coefficient times (base, exponent) factors. Both lists are sorted in a
+// structural order, like entries are merged and zero entries dropped, and
+// the node is rebuilt as
+//
+//   sum      t1 + t2 - t3 ... + k   (a positive term leads when there is one)
+//   term     M, -M, c * M, or c / D when M = 1 / D
+//   product  N / D, positive-exponent factors over negative-exponent ones
+//
+// Commutative operands thus always appear in the same order, so equal
+// polynomial-like expressions simplify to the same node. Sums nested in
+// products (and vice versa) are kept as opaque factors; nothing is expanded,
+// which keeps each pass linear in the flattened operand lists; the one
+// exception is a numeric coefficient times a single sum, which is
+// distributed so that 2 * (x - y) and 2 * x - 2 * y agree.
+
+typedef struct {
+    uint32_t node;
+    unsigned flags;  // Walk state; unused in term and factor lists
+    double k;
+} fossil_math_sym_pair_t;
+
+typedef struct {
+    fossil_math_sym_pair_t* items;
+    size_t count;
+    size_t cap;
+    int failed;
+} fossil_math_sym_pairs_t;
+
+static void fossil_math_sym_pairs_push(fossil_math_sym_pairs_t* l, uint32_t node, double k) {
+    if (node == FOSSIL_MATH_SYM_NONE ||
+        fossil_math_sym_grow((void**)&l->items, &l->cap, l->count + 1, sizeof(*l->items)) != 0) {
+        l->failed = 1;
+        return;
+    }
+    l->items[l->count].node = node;
+    l->items[l->count].flags = 0;
+    l->items[l->count].k = k;
+    l->count++;
+}
+
+// Total structural order: constants < variables < operators, then by value,
+// name, or operator and children
+static int fossil_math_sym_graph_order(const fossil_math_sym_graph_t* g, uint32_t a, uint32_t b) {
+    while (a != b) {
+        const fossil_math_sym_gnode_t* x = &g->nodes[a];
+        const fossil_math_sym_gnode_t* y = &g->nodes[b];
+        if (x->type != y->type) return x->type < y->type ? -1 : 1;
+        switch (x->type) {
+            case fossil_math_sym_CONST:
+                if (x->u.value < y->u.value) return -1;
+                if (x->u.value > y->u.value) return 1;
+                return memcmp(&x->u.value, &y->u.value, sizeof(double));
+            case fossil_math_sym_VAR:
+                return strcmp(g->syms[x->sym], g->syms[y->sym]);
+            default:
+                if (x->op != y->op) return x->op < y->op ? -1 : 1;
+                if (x->u.child[0] != y->u.child[0]) {
+                    int c = fossil_math_sym_graph_order(g, x->u.child[0], y->u.child[0]);
+                    if (c != 0) return c;
+                }
+                a = x->u.child[1];
+                b = y->u.child[1];
+                break;
+        }
+    }
+    return 0;
+}
+
+// Stable bottom-up merge sort by node order
+static void fossil_math_sym_pairs_sort(const fossil_math_sym_graph_t* g, fossil_math_sym_pairs_t* l) {
+    size_t n = l->count;
+    if (n < 2) return;
+    fossil_math_sym_pair_t* tmp = malloc(n * sizeof(*tmp));
+    if (!tmp) {
+        l->failed = 1;
+        return;
+    }
+    fossil_math_sym_pair_t* src = l->items;
+    fossil_math_sym_pair_t* dst = tmp;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                dst[k++] = fossil_math_sym_graph_order(g, src[i].node, src[j].node) <= 0 ? src[i++] : src[j++];
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        fossil_math_sym_pair_t* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != l->items) memcpy(l->items, src, n * sizeof(*tmp));
+    free(tmp);
+}
+
+// Combines adjacent equal nodes and drops zero weights
+static void fossil_math_sym_pairs_merge(fossil_math_sym_pairs_t* l) {
+    size_t out = 0;
+    for (size_t i = 0; i < l->count; ++i) {
+        if (out > 0 && l->items[out - 1].node == l->items[i].node) {
+            l->items[out - 1].k += l->items[i].k;
+        } else {
+            l->items[out++] = l->items[i];
+        }
+    }
+    l->count = 0;
+    for (size_t i = 0; i < out; ++i) {
+        if (l->items[i].k != 0.0) l->items[l->count++] = l->items[i];
+    }
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_canon(fossil_math_sym_graph_t* g, fossil_math_sym_node_t node);
+
+// Worklist flags for the flattening walks below
+#define FOSSIL_MATH_SYM_WALK_CANONICAL 1u
+#define FOSSIL_MATH_SYM_WALK_DIVIDED 2u
+
+static void fossil_math_sym_walk_push(fossil_math_sym_pairs_t* l, uint32_t node, double k, unsigned flags) {
+    fossil_math_sym_pairs_push(l, node, k);
+    if (!l->failed) l->items[l->count - 1].flags = flags;
+}
+
+// Both collectors walk operands with an explicit stack, pushing the right
+// operand first so terms keep their left-to-right order; a left-nested
+// chain such as x + x + ... + x is as long as its operand count
+static void fossil_math_sym_collect_sum(fossil_math_sym_graph_t* g, fossil_math_sym_node_t node, double scale,
+                                        fossil_math_sym_pairs_t* terms, int canonical) {
+    fossil_math_sym_pairs_t stack = {0};
+    fossil_math_sym_walk_push(&stack, node, scale, canonical ? FOSSIL_MATH_SYM_WALK_CANONICAL : 0u);
+    while (stack.count > 0 && !stack.failed && !terms->failed) {
+        fossil_math_sym_pair_t top = stack.items[--stack.count];
+        node = top.node;
+        scale = top.k;
+        if (!fossil_math_sym_graph_valid(g, node)) {
+            terms->failed = 1;
+            break;
+        }
+        // Copied: canonicalizing a child may grow the node array
+        fossil_math_sym_gnode_t n = g->nodes[node];
+        if (n.type == fossil_math_sym_OP && (n.op == '+' || n.op == '-')) {
+            fossil_math_sym_walk_push(&stack, n.u.child[1], n.op == '-' ? -scale : scale, top.flags);
+            fossil_math_sym_walk_push(&stack, n.u.child[0], scale, top.flags);
+            continue;
+        }
+        if (n.type == fossil_math_sym_OP && n.op == FOSSIL_MATH_SYM_NEG) {
+            fossil_math_sym_walk_push(&stack, n.u.child[0], -scale, top.flags);
+            continue;
+        }
+        if (!(top.flags & FOSSIL_MATH_SYM_WALK_CANONICAL)) {
+            fossil_math_sym_walk_push(&stack, fossil_math_sym_graph_canon(g, node), scale, FOSSIL_MATH_SYM_WALK_CANONICAL);
+            continue;
+        }
+
+        fossil_math_sym_node_t one = fossil_math_sym_graph_const(g, 1.0);
+        if (n.type == fossil_math_sym_CONST) {
+            fossil_math_sym_pairs_push(terms, one, scale * n.u.value);
+        } else if (n.type == fossil_math_sym_OP && (n.op == '*' || n.op == '/') &&
+                   g->nodes[n.u.child[0]].type == fossil_math_sym_CONST) {
+            // c * M, or c / D with monomial 1 / D
+            double c = g->nodes[n.u.child[0]].u.value;
+            fossil_math_sym_node_t m = n.op == '*' ? n.u.child[1] : fossil_math_sym_graph_op(g, '/', one, n.u.child[1]);
+            fossil_math_sym_pairs_push(terms, m, scale * c);
+        } else {
+            fossil_math_sym_pairs_push(terms, node, scale);
+        }
+    }
+    if (stack.failed) terms->failed = 1;
+    free(stack.items);
+}
+
+// A zero anywhere under a divisor leaves the product undefined: flattening
+// y / (2 / 0) into y * 0 / 2 would otherwise turn it into 0
+static double fossil_math_sym_scale(double coef, double v, double sign, unsigned flags) {
+    if (v == 0.0 && (sign < 0.0 || (flags & FOSSIL_MATH_SYM_WALK_DIVIDED))) return NAN;
+    return sign > 0.0 ? coef * v : coef / v;
+}
+
+static void fossil_math_sym_collect_product(fossil_math_sym_graph_t* g, fossil_math_sym_node_t node, double sign, double* coef,
+                                            fossil_math_sym_pairs_t* factors, int canonical) {
+    fossil_math_sym_pairs_t stack = {0};
+    fossil_math_sym_walk_push(&stack, node, sign, canonical ? FOSSIL_MATH_SYM_WALK_CANONICAL : 0u);
+    while (stack.count > 0 && !stack.failed && !factors->failed) {
+        fossil_math_sym_pair_t top = stack.items[--stack.count];
+        node = top.node;
+        sign = top.k;
+        canonical = (top.flags & FOSSIL_MATH_SYM_WALK_CANONICAL) != 0;
+        if (!fossil_math_sym_graph_valid(g, node)) {
+            factors->failed = 1;
+            break;
+        }
+        fossil_math_sym_gnode_t n = g->nodes[node];
+        if (n.type == fossil_math_sym_OP && (n.op == '*' || n.op == '/')) {
+            if (n.op == '/') {
+                fossil_math_sym_walk_push(&stack, n.u.child[1], -sign, top.flags | FOSSIL_MATH_SYM_WALK_DIVIDED);
+            } else {
+                fossil_math_sym_walk_push(&stack, n.u.child[1], sign, top.flags);
+            }
+            fossil_math_sym_walk_push(&stack, n.u.child[0], sign, top.flags);
+            continue;
+        }
+        if (n.type == fossil_math_sym_OP && n.op == FOSSIL_MATH_SYM_NEG) {
+            *coef = -*coef;
+            fossil_math_sym_walk_push(&stack, n.u.child[0], sign, top.flags);
+            continue;
+        }
+        if (n.type == fossil_math_sym_OP && n.op == '^') {
+            fossil_math_sym_node_t e = canonical ? n.u.child[1] : fossil_math_sym_graph_canon(g, n.u.child[1]);
+            if (e != FOSSIL_MATH_SYM_NONE && g->nodes[e].type == fossil_math_sym_CONST) {
+                double k = g->nodes[e].u.value;
+                fossil_math_sym_node_t base = canonical ? n.u.child[0] : fossil_math_sym_graph_canon(g, n.u.child[0]);
+                if (base != FOSSIL_MATH_SYM_NONE && g->nodes[base].type == fossil_math_sym_CONST) {
+                    *coef = fossil_math_sym_scale(*coef, pow(g->nodes[base].u.value, k), sign, top.flags);
+                } else {
+                    fossil_math_sym_pairs_push(factors, base, sign * k);
+                }
+                continue;
+            }
+        }
+        if (!canonical) {
+            fossil_math_sym_walk_push(&stack, fossil_math_sym_graph_canon(g, node), sign,
+                                      top.flags | FOSSIL_MATH_SYM_WALK_CANONICAL);
+            continue;
+        }
+        if (n.type == fossil_math_sym_CONST) {
+            *coef = fossil_math_sym_scale(*coef, n.u.value, sign, top.flags);
+        } else {
+            fossil_math_sym_pairs_push(factors, node, sign);
+        }
+    }
+    if (stack.failed) factors->failed = 1;
+    free(stack.items);
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_chain(fossil_math_sym_graph_t* g, char op, fossil_math_sym_node_t acc, fossil_math_sym_node_t next) {
+    return acc == FOSSIL_MATH_SYM_NONE ? next : fossil_math_sym_graph_op(g, op, acc, next);
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_power(fossil_math_sym_graph_t* g, fossil_math_sym_node_t base, double k) {
+    return k == 1.0 ? base : fossil_math_sym_graph_op(g, '^', base, fossil_math_sym_graph_const(g, k));
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_term(fossil_math_sym_graph_t* g, fossil_math_sym_node_t m, double c) {
+    if (c == 1.0 || m == FOSSIL_MATH_SYM_NONE) return m;
+    if (c == -1.0) return fossil_math_sym_graph_op(g, FOSSIL_MATH_SYM_NEG, m, m);
+    const fossil_math_sym_gnode_t* n = &g->nodes[m];
+    if (n->type == fossil_math_sym_OP && n->op == '/' && fossil_math_sym_graph_is(g, n->u.child[0], 1.0)) {
+        fossil_math_sym_node_t den = n->u.child[1];
+        return fossil_math_sym_graph_op(g, '/', fossil_math_sym_graph_const(g, c), den);
+    }
+    return fossil_math_sym_graph_op(g, '*', fossil_math_sym_graph_const(g, c), m);
+}
+
+static fossil_math_sym_node_t fossil_math_sym_build_sum(fossil_math_sym_graph_t* g, const fossil_math_sym_pairs_t* terms) {
+    fossil_math_sym_node_t one = fossil_math_sym_graph_const(g, 1.0);
+    double k0 = 0.0;
+    size_t lead = terms->count;
+    for (size_t i = 0; i < terms->count; ++i) {
+        if (terms->items[i].node == one) {
+            k0 = terms->items[i].k;
+        } else if (lead == terms->count || (!(terms->items[lead].k > 0.0) && terms->items[i].k > 0.0)) {
+            lead = i;
+        }
+    }
+    if (lead == terms->count) return fossil_math_sym_graph_const(g, k0);
+
+    // A positive constant leads when every other term is negative: 3 - x
+    fossil_math_sym_node_t acc;
+    if (!(terms->items[lead].k > 0.0) && k0 > 0.0) {
+        acc = fossil_math_sym_graph_const(g, k0);
+        lead = terms->count;
+        k0 = 0.0;
+    } else {
+        acc = fossil_math_sym_graph_term(g, terms->items[lead].node, terms->items[lead].k);
+    }
+    for (size_t i = 0; i < terms->count; ++i) {
+        const fossil_math_sym_pair_t* t = &terms->items[i];
+        if (i == lead || t->node == one) continue;
+        if (t->k > 0.0) {
+            acc = fossil_math_sym_graph_op(g, '+', acc, fossil_math_sym_graph_term(g, t->node, t->k));
+        } else {
+            acc = fossil_math_sym_graph_op(g, '-', acc, fossil_math_sym_graph_term(g, t->node, -t->k));
+        }
+    }
+    if (k0 < 0.0) return fossil_math_sym_graph_op(g, '-', acc, fossil_math_sym_graph_const(g, -k0));
+    if (k0 != 0.0) return fossil_math_sym_graph_op(g, '+', acc, fossil_math_sym_graph_const(g, k0));
+    return acc;
+}
+
+static fossil_math_sym_node_t fossil_math_sym_build_product(fossil_math_sym_graph_t* g, double coef, const fossil_math_sym_pairs_t* factors) {
+    if (coef == 0.0 || factors->count == 0) return fossil_math_sym_graph_const(g, coef);
+
+    // A numeric coefficient is distributed over a lone sum: 2 * (x - y) = 2 * x - 2 * y
+    const fossil_math_sym_gnode_t* f = &g->nodes[factors->items[0].node];
+    if (factors->count == 1 && factors->items[0].k == 1.0 && coef != 1.0 &&
+        f->type == fossil_math_sym_OP && (f->op == '+' || f->op == '-')) {
+        fossil_math_sym_pairs_t terms = {0};
+        fossil_math_sym_node_t result = FOSSIL_MATH_SYM_NONE;
+        fossil_math_sym_collect_sum(g, factors->items[0].node, coef, &terms, 1);
+        fossil_math_sym_pairs_merge(&terms);
+        if (!terms.failed) result = fossil_math_sym_build_sum(g, &terms);
+        free(terms.items);
+        return result;
+    }
+
+    fossil_math_sym_node_t num = FOSSIL_MATH_SYM_NONE, den = FOSSIL_MATH_SYM_NONE;
+    for (size_t i = 0; i < factors->count; ++i) {
+        const fossil_math_sym_pair_t* f = &factors->items[i];
+        if (f->k > 0.0) {
+            num = fossil_math_sym_graph_chain(g, '*', num, fossil_math_sym_graph_power(g, f->node, f->k));
+        } else {
+            den = fossil_math_sym_graph_chain(g, '*', den, fossil_math_sym_graph_power(g, f->node, -f->k));
+        }
+    }
+    fossil_math_sym_node_t m;
+    if (num == FOSSIL_MATH_SYM_NONE) {
+        m = fossil_math_sym_graph_op(g, '/', fossil_math_sym_graph_const(g, 1.0), den);
+    } else {
+        m = den == FOSSIL_MATH_SYM_NONE ? num : fossil_math_sym_graph_op(g, '/', num, den);
+    }
+    return fossil_math_sym_graph_term(g, m, coef);
+}
+
+// One canonicalization pass; memoized per node
+static fossil_math_sym_node_t fossil_math_sym_graph_canon(fossil_math_sym_graph_t* g, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(g, node)) return FOSSIL_MATH_SYM_NONE;
+    if (g->nodes[node].type != fossil_math_sym_OP) return node;
+
+    fossil_math_sym_node_t done = fossil_math_sym_memo_get(g, FOSSIL_MATH_SYM_MEMO_SIMPLIFY, node, 0);
+    if (done != FOSSIL_MATH_SYM_NONE) return done;
+
+    fossil_math_sym_gnode_t n = g->nodes[node];
+    fossil_math_sym_node_t result = FOSSIL_MATH_SYM_NONE;
+    fossil_math_sym_pairs_t list = {0};
+    switch (n.op) {
+        case '+':
+        case '-':
+        case FOSSIL_MATH_SYM_NEG:
+            fossil_math_sym_collect_sum(g, node, 1.0, &list, 0);
+            fossil_math_sym_pairs_sort(g, &list);
+            fossil_math_sym_pairs_merge(&list);
+            if (!list.failed) result = fossil_math_sym_build_sum(g, &list);
+            break;
+        case '*':
+        case '/': {
+            double coef = 1.0;
+            fossil_math_sym_collect_product(g, node, 1.0, &coef, &list, 0);
+            fossil_math_sym_pairs_sort(g, &list);
+            fossil_math_sym_pairs_merge(&list);
+            if (!list.failed) result = fossil_math_sym_build_product(g, coef, &list);
+            break;
+        }
+        default: {
+            fossil_math_sym_node_t a = fossil_math_sym_graph_canon(g, n.u.child[0]);
+            fossil_math_sym_node_t b = fossil_math_sym_graph_canon(g, n.u.child[1]);
+            result = fossil_math_sym_graph_fold(g, n.op, a, b);
+            break;
+        }
+    }
+    free(list.items);
+    fossil_math_sym_memo_put(g, FOSSIL_MATH_SYM_MEMO_SIMPLIFY, node, 0, result);
+    return result;
+}
+
+// Operator classes the collectors walk through; NEG belongs to both
+static unsigned fossil_math_sym_graph_class(const fossil_math_sym_gnode_t* n) {
+    if (n->type != fossil_math_sym_OP) return 0;
+    switch (n->op) {
+        case '+':
+        case '-':
+            return 1;
+        case '*':
+        case '/':
+            return 2;
+        case FOSSIL_MATH_SYM_NEG:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+// Canonicalizes, children first, each node below root that some parent
+// hands to canon as a whole rather than walking through, so the final
+// canon call only recurses into memoized results however deep the graph.
+// Walked-through nodes are skipped: canonicalizing every prefix of a long
+// sum separately would be quadratic. Without memory the recursion remains.
+static void fossil_math_sym_graph_canon_operands(fossil_math_sym_graph_t* g, fossil_math_sym_node_t root) {
+    unsigned char* mark = malloc((size_t)root + 1);
+    if (!mark) return;
+    fossil_math_sym_graph_mark(g, root, mark);
+    for (size_t i = root + 1; i-- > 0;) {
+        const fossil_math_sym_gnode_t* n = &g->nodes[i];
+        if (!mark[i] || n->type != fossil_math_sym_OP) continue;
+        unsigned cls = fossil_math_sym_graph_class(n);
+        for (int c = 0; c < 2; ++c) {
+            if (!(cls & fossil_math_sym_graph_class(&g->nodes[n->u.child[c]]))) mark[n->u.child[c]] |= 2;
+        }
+    }
+    for (size_t i = 0; i < root; ++i) {
+        if ((mark[i] & 2) && g->nodes[i].type == fossil_math_sym_OP) fossil_math_sym_graph_canon(g, (fossil_math_sym_node_t)i);
+    }
+    free(mark);
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_simplify(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node) {
+    if (!fossil_math_sym_graph_valid(graph, node)) return FOSSIL_MATH_SYM_NONE;
+    for (int pass = 0; pass < FOSSIL_MATH_SYM_SIMPLIFY_PASSES; ++pass) {
+        fossil_math_sym_graph_canon_operands(graph, node);
+        fossil_math_sym_node_t next = fossil_math_sym_graph_canon(graph, node);
+        if (next == node || next == FOSSIL_MATH_SYM_NONE) return next;
+        node = next;
+    }
+    return node;
+}
+
+static fossil_math_sym_node_t fossil_math_sym_graph_diff_node(fossil_math_sym_graph_t* g, fossil_math_sym_node_t node, fossil_math_sym_node_t var) {
+    if (!fossil_math_sym_graph_valid(g, node)) return FOSSIL_MATH_SYM_NONE;
+    switch (g->nodes[node].type) {
+        case fossil_math_sym_CONST:
+            return fossil_math_sym_graph_const(g, 0.0);
+        case fossil_math_sym_VAR:
+            return fossil_math_sym_graph_const(g, node == var ? 1.0 : 0.0);
+        case fossil_math_sym_OP:
+            break;
+    }
+
+    fossil_math_sym_node_t done = fossil_math_sym_memo_get(g, FOSSIL_MATH_SYM_MEMO_DIFF, node, var);
+    if (done != FOSSIL_MATH_SYM_NONE) return done;
+
+    char op = g->nodes[node].op;
+    fossil_math_sym_node_t u = g->nodes[node].u.child[0], v = g->nodes[node].u.child[1];
+    fossil_math_sym_node_t du = fossil_math_sym_graph_diff_node(g, u, var);
+    fossil_math_sym_node_t dv = fossil_math_sym_graph_diff_node(g, v, var);
+    fossil_math_sym_node_t result = FOSSIL_MATH_SYM_NONE;
+
+    switch (op) {
+        case '+':
+        case '-':
+            result = fossil_math_sym_graph_fold(g, op, du, dv);
+            break;
+        case '*':
+            // Product rule: (u*v)' = u'*v + u*v'
+            result = fossil_math_sym_graph_fold(g, '+', fossil_math_sym_graph_fold(g, '*', du, v), fossil_math_sym_graph_fold(g, '*', u, dv));
+            break;
+        case '/': {
+            // Quotient rule: (u/v)' = (u'*v - u*v') / (v*v)
+            fossil_math_sym_node_t num = fossil_math_sym_graph_fold(g, '-', fossil_math_sym_graph_fold(g, '*', du, v), fossil_math_sym_graph_fold(g, '*', u, dv));
+            result = fossil_math_sym_graph_fold(g, '/', num, fossil_math_sym_graph_fold(g, '*', v, v));
+            break;
+        }
+        case '^':
+            if (dv != FOSSIL_MATH_SYM_NONE && fossil_math_sym_graph_is(g, dv, 0.0)) {
+                // Power rule for exponents independent of var: (u^c)' = c*u^(c-1)*u'
+                fossil_math_sym_node_t lower = fossil_math_sym_graph_fold(g, '-', v, fossil_math_sym_graph_const(g, 1.0));
+                fossil_math_sym_node_t scale = fossil_math_sym_graph_fold(g, '*', v, fossil_math_sym_graph_fold(g, '^', u, lower));
+                result = fossil_math_sym_graph_fold(g, '*', scale, du);
+            } else {
+                // General rule: (u^v)' = u^v * (v'*log(u) + v*u'/u)
+                fossil_math_sym_node_t t1 = fossil_math_sym_graph_fold(g, '*', dv, fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_LOG, u));
+                fossil_math_sym_node_t t2 = fossil_math_sym_graph_fold(g, '/', fossil_math_sym_graph_fold(g, '*', v, du), u);
+                result = fossil_math_sym_graph_fold(g, '*', node, fossil_math_sym_graph_fold(g, '+', t1, t2));
+            }
+            break;
+        case FOSSIL_MATH_SYM_NEG:
+            result = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, du);
+            break;
+        case FOSSIL_MATH_SYM_SIN:
+            result = fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_COS, u), du);
+            break;
+        case FOSSIL_MATH_SYM_COS: {
+            fossil_math_sym_node_t s = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_SIN, u);
+            result = fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, s), du);
+            break;
+        }
+        case FOSSIL_MATH_SYM_EXP:
+            result = fossil_math_sym_graph_fold(g, '*', node, du);
+            break;
+        case FOSSIL_MATH_SYM_LOG:
+            result = fossil_math_sym_graph_fold(g, '/', du, u);
+            break;
+        case FOSSIL_MATH_SYM_SQRT: {
+            fossil_math_sym_node_t twice = fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_const(g, 2.0), node);
+            result = fossil_math_sym_graph_fold(g, '/', du, twice);
+            break;
+        }
+        case FOSSIL_MATH_SYM_ABS:
+            // |u|' = u' * u / |u|, undefined at u = 0
+            result = fossil_math_sym_graph_fold(g, '*', du, fossil_math_sym_graph_fold(g, '/', u, node));
+            break;
+        case FOSSIL_MATH_SYM_MIN:
+        case FOSSIL_MATH_SYM_MAX: {
+            // min/max(u, v) = (u + v -/+ |u - v|) / 2, so the slope follows the
+            // smaller/larger operand and is undefined where they cross
+            fossil_math_sym_node_t w = fossil_math_sym_graph_fold(g, '-', u, v);
+            fossil_math_sym_node_t sgn = fossil_math_sym_graph_fold(g, '/', w, fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_ABS, w));
+            fossil_math_sym_node_t skew = fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_fold(g, '-', du, dv), sgn);
+            fossil_math_sym_node_t both = fossil_math_sym_graph_fold(g, '+', du, dv);
+            fossil_math_sym_node_t sum = fossil_math_sym_graph_fold(g, op == FOSSIL_MATH_SYM_MIN ? '-' : '+', both, skew);
+            result = fossil_math_sym_graph_fold(g, '/', sum, fossil_math_sym_graph_const(g, 2.0));
+            break;
+        }
+        default:
+            break;
+    }
+    fossil_math_sym_memo_put(g, FOSSIL_MATH_SYM_MEMO_DIFF, node, var, result);
+    return result;
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_diff(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node, const char* var) {
+    if (!fossil_math_sym_graph_valid(graph, node) || !var) return FOSSIL_MATH_SYM_NONE;
+    fossil_math_sym_node_t v = fossil_math_sym_graph_var(graph, var);
+    if (v == FOSSIL_MATH_SYM_NONE) return FOSSIL_MATH_SYM_NONE;
+
+    // Children precede parents, so differentiating the reachable nodes in
+    // index order leaves every recursive call a memo hit; without memory
+    // the plain recursion remains
+    unsigned char* mark = malloc((size_t)node + 1);
+    if (mark) {
+        fossil_math_sym_graph_mark(graph, node, mark);
+        for (size_t i = 0; i < node; ++i) {
+            if (mark[i] && graph->nodes[i].type == fossil_math_sym_OP) fossil_math_sym_graph_diff_node(graph, (fossil_math_sym_node_t)i, v);
+        }
+        free(mark);
+    }
+    return fossil_math_sym_graph_diff_node(graph, node, v);
+}
+
+// Maps each symbol to the index of its name in vars (first match), or NONE
+static uint32_t* fossil_math_sym_graph_slots(const fossil_math_sym_graph_t* g, const char* const* vars, size_t nvars) {
+    uint32_t* slots = malloc((g->nsyms + 1) * sizeof(uint32_t));
+    if (!slots) return NULL;
+    for (size_t i = 0; i < g->nsyms; ++i) slots[i] = FOSSIL_MATH_SYM_NONE;
+    for (size_t k = 0; k < nvars; ++k) {
+        uint32_t id = vars[k] ? fossil_math_sym_symbol_find(g, vars[k]) : FOSSIL_MATH_SYM_NONE;
+        if (id != FOSSIL_MATH_SYM_NONE && slots[id] == FOSSIL_MATH_SYM_NONE) slots[id] = (uint32_t)k;
+    }
+    return slots;
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_substitute(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                                        const char* const* vars, const fossil_math_sym_node_t* values, size_t nvars) {
+    if (!fossil_math_sym_graph_valid(graph, node) || (nvars > 0 && (!vars || !values))) return FOSSIL_MATH_SYM_NONE;
+    for (size_t k = 0; k < nvars; ++k) {
+        if (!fossil_math_sym_graph_valid(graph, values[k])) return FOSSIL_MATH_SYM_NONE;
+    }
+
+    // Children precede parents, so one upward sweep over the reachable nodes
+    // sees every operand rewritten before its users. Nodes created by folding
+    // land past node and never disturb the sweep.
+    size_t n = (size_t)node + 1;
+    unsigned char* mark = malloc(n);
+    uint32_t* out = malloc(n * sizeof(uint32_t));
+    uint32_t* slots = fossil_math_sym_graph_slots(graph, vars, nvars);
+    fossil_math_sym_node_t result = FOSSIL_MATH_SYM_NONE;
+    if (mark && out && slots) {
+        fossil_math_sym_graph_mark(graph, node, mark);
+        size_t i = 0;
+        for (; i < n; ++i) {
+            if (!mark[i]) continue;
+            fossil_math_sym_gnode_t g = graph->nodes[i];
+            out[i] = (uint32_t)i;
+            if (g.type == fossil_math_sym_VAR) {
+                if (slots[g.sym] != FOSSIL_MATH_SYM_NONE) out[i] = values[slots[g.sym]];
+            } else if (g.type == fossil_math_sym_OP) {
+                uint32_t a = out[g.u.child[0]], b = out[g.u.child[1]];
+                if (a != g.u.child[0] || b != g.u.child[1]) {
+                    out[i] = fossil_math_sym_graph_fold(graph, g.op, a, b);
+                    if (out[i] == FOSSIL_MATH_SYM_NONE) break;
+                }
+            }
+        }
+        if (i == n) result = out[node];
+    }
+    free(mark);
+    free(out);
+    free(slots);
+    return result;
+}
+
+double fossil_math_sym_graph_eval(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                  const char* const* vars, const double* values, size_t nvars) {
+    if (!fossil_math_sym_graph_valid(graph, node) || (nvars > 0 && (!vars || !values))) return NAN;
+
+    size_t n = (size_t)node + 1;
+    unsigned char* mark = malloc(n);
+    double* val = malloc(n * sizeof(double));
+    uint32_t* slots = fossil_math_sym_graph_slots(graph, vars, nvars);
+    double result = NAN;
+    if (!mark || !val || !slots) goto done;
+
+    fossil_math_sym_graph_mark(graph, node, mark);
+    for (size_t i = 0; i < n; ++i) {
+        if (!mark[i]) continue;
+        const fossil_math_sym_gnode_t* g = &graph->nodes[i];
+        switch (g->type) {
+            case fossil_math_sym_CONST:
+                val[i] = g->u.value;
+                break;
+            case fossil_math_sym_VAR:
+                val[i] = slots[g->sym] != FOSSIL_MATH_SYM_NONE ? values[slots[g->sym]] : NAN;
+                break;
+            case fossil_math_sym_OP:
+                val[i] = fossil_math_sym_apply(g->op, val[g->u.child[0]], val[g->u.child[1]]);
+                break;
+        }
+    }
+    result = val[node];
+
+done:
+    free(mark);
+    free(val);
+    free(slots);
+    return result;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_graph_compile_many(const fossil_math_sym_graph_t* graph, const fossil_math_sym_node_t* nodes,
+                                                               size_t count, const char* const* vars, size_t nvars) {
+    if (!graph || !nodes || count == 0) return NULL;
+    size_t n = 0;
+    for (size_t k = 0; k < count; ++k) {
+        if (!fossil_math_sym_graph_valid(graph, nodes[k])) return NULL;
+        n = FOSSIL_MATH_MAX(n, (size_t)nodes[k] + 1);
+    }
+    fossil_math_sym_builder_t b;
+    if (!fossil_math_sym_build_begin(&b, vars, nvars)) return NULL;
+
+    unsigned char* mark = malloc(n);
+    uint32_t* uses = calloc(n, sizeof(uint32_t));
+    uint32_t* reg = malloc(n * sizeof(uint32_t));
+    uint32_t* slots = fossil_math_sym_graph_slots(graph, vars, nvars);
+    uint32_t* results = malloc(count * sizeof(uint32_t));
+    if (!mark || !uses || !reg || !slots || !results) {
+        b.failed = 1;
+        goto done;
+    }
+
+    // A node's register is released once its last consumer has been emitted;
+    // outputs are pinned by an extra use so their registers survive.
+    fossil_math_sym_graph_mark_many(graph, nodes, count, mark, n);
+    for (size_t i = 0; i < n; ++i) {
+        if (mark[i] && graph->nodes[i].type == fossil_math_sym_OP) {
+            uses[graph->nodes[i].u.child[0]]++;
+            uses[graph->nodes[i].u.child[1]]++;
+        }
+    }
+    for (size_t k = 0; k < count; ++k) uses[nodes[k]]++;
+
+    for (size_t i = 0; i < n && !b.failed; ++i) {
+        if (!mark[i]) continue;
+        const fossil_math_sym_gnode_t* g = &graph->nodes[i];
+        switch (g->type) {
+            case fossil_math_sym_CONST:
+                reg[i] = fossil_math_sym_build_const(&b, g->u.value);
+                break;
+            case fossil_math_sym_VAR:
+                // Variable registers are the slots themselves
+                reg[i] = slots[g->sym];
+                if (reg[i] == FOSSIL_MATH_SYM_NONE) b.failed = 1;
+                break;
+            case fossil_math_sym_OP: {
+                uint32_t op;
+                if (fossil_math_sym_opcode(g->op, &op) != 0) {
+                    b.failed = 1;
+                    break;
+                }
+                if (--uses[g->u.child[0]] == 0) fossil_math_sym_build_release(&b, reg[g->u.child[0]]);
+                if (--uses[g->u.child[1]] == 0) fossil_math_sym_build_release(&b, reg[g->u.child[1]]);
+                reg[i] = fossil_math_sym_build_emit(&b, op, reg[g->u.child[0]], reg[g->u.child[1]], 0);
+                break;
+            }
+        }
+    }
+    if (!b.failed) {
+        for (size_t k = 0; k < count; ++k) results[k] = reg[nodes[k]];
+    }
+
+done:;
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_build_finish_many(&b, results, count);
+    free(mark);
+    free(uses);
+    free(reg);
+    free(slots);
+    free(results);
+    return prog;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_graph_compile(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                                          const char* const* vars, size_t nvars) {
+    return fossil_math_sym_graph_compile_many(graph, &node, 1, vars, nvars);
+}
+
+// Adds contribution c to the adjoint of node; constants need no adjoint
+static void fossil_math_sym_adjoint_add(fossil_math_sym_graph_t* g, uint32_t* adj, fossil_math_sym_node_t node,
+                                        fossil_math_sym_node_t c, int* failed) {
+    if (g->nodes[node].type == fossil_math_sym_CONST) return;
+    if (c == FOSSIL_MATH_SYM_NONE) {
+        *failed = 1;
+        return;
+    }
+    adj[node] = adj[node] == FOSSIL_MATH_SYM_NONE ? c : fossil_math_sym_graph_fold(g, '+', adj[node], c);
+    if (adj[node] == FOSSIL_MATH_SYM_NONE) *failed = 1;
+}
+
+// Pushes the adjoint a of node i onto its operands (reverse accumulation)
+static void fossil_math_sym_adjoint_step(fossil_math_sym_graph_t* g, uint32_t* adj, fossil_math_sym_node_t i, int* failed) {
+    fossil_math_sym_gnode_t n = g->nodes[i];
+    fossil_math_sym_node_t a = adj[i], u = n.u.child[0], v = n.u.child[1];
+    fossil_math_sym_node_t du = FOSSIL_MATH_SYM_NONE, dv = FOSSIL_MATH_SYM_NONE;
+    switch (n.op) {
+        case '+':
+            du = a;
+            dv = a;
+            break;
+        case '-':
+            du = a;
+            dv = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, a);
+            break;
+        case '*':
+            du = fossil_math_sym_graph_fold(g, '*', a, v);
+            dv = fossil_math_sym_graph_fold(g, '*', a, u);
+            break;
+        case '/':
+            // d(u/v)/dv = -(u/v)/v
+            du = fossil_math_sym_graph_fold(g, '/', a, v);
+            dv = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, fossil_math_sym_graph_fold(g, '/', fossil_math_sym_graph_fold(g, '*', a, i), v));
+            break;
+        case '^': {
+            fossil_math_sym_node_t lower = fossil_math_sym_graph_fold(g, '-', v, fossil_math_sym_graph_const(g, 1.0));
+            du = fossil_math_sym_graph_fold(g, '*', a, fossil_math_sym_graph_fold(g, '*', v, fossil_math_sym_graph_fold(g, '^', u, lower)));
+            if (g->nodes[v].type != fossil_math_sym_CONST) {
+                dv = fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_fold(g, '*', a, i), fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_LOG, u));
+            }
+            break;
+        }
+        case FOSSIL_MATH_SYM_NEG:
+            du = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, a);
+            break;
+        case FOSSIL_MATH_SYM_SIN:
+            du = fossil_math_sym_graph_fold(g, '*', a, fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_COS, u));
+            break;
+        case FOSSIL_MATH_SYM_COS:
+            du = fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_NEG, fossil_math_sym_graph_fold(g, '*', a, fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_SIN, u)));
+            break;
+        case FOSSIL_MATH_SYM_EXP:
+            du = fossil_math_sym_graph_fold(g, '*', a, i);
+            break;
+        case FOSSIL_MATH_SYM_LOG:
+            du = fossil_math_sym_graph_fold(g, '/', a, u);
+            break;
+        case FOSSIL_MATH_SYM_SQRT:
+            du = fossil_math_sym_graph_fold(g, '/', a, fossil_math_sym_graph_fold(g, '*', fossil_math_sym_graph_const(g, 2.0), i));
+            break;
+        case FOSSIL_MATH_SYM_ABS:
+            du = fossil_math_sym_graph_fold(g, '*', a, fossil_math_sym_graph_fold(g, '/', u, i));
+            break;
+        case FOSSIL_MATH_SYM_MIN:
+        case FOSSIL_MATH_SYM_MAX: {
+            // Same convention as the forward rule: (1 +- sign(u - v)) / 2
+            fossil_math_sym_node_t w = fossil_math_sym_graph_fold(g, '-', u, v);
+            fossil_math_sym_node_t sgn = fossil_math_sym_graph_fold(g, '/', w, fossil_math_sym_graph_fold1(g, FOSSIL_MATH_SYM_ABS, w));
+            fossil_math_sym_node_t one = fossil_math_sym_graph_const(g, 1.0);
+            fossil_math_sym_node_t half = fossil_math_sym_graph_fold(g, '/', a, fossil_math_sym_graph_const(g, 2.0));
+            fossil_math_sym_node_t up = fossil_math_sym_graph_fold(g, '*', half, fossil_math_sym_graph_fold(g, '+', one, sgn));
+            fossil_math_sym_node_t down = fossil_math_sym_graph_fold(g, '*', half, fossil_math_sym_graph_fold(g, '-', one, sgn));
+            du = n.op == FOSSIL_MATH_SYM_MAX ? up : down;
+            dv = n.op == FOSSIL_MATH_SYM_MAX ? down : up;
+            break;
+        }
+        default:
+            *failed = 1;
+            return;
+    }
+    fossil_math_sym_adjoint_add(g, adj, u, du, failed);
+    if (fossil_math_sym_arity(n.op) == 2) fossil_math_sym_adjoint_add(g, adj, v, dv, failed);
+}
+
+int fossil_math_sym_graph_gradient(fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node,
+                                   const char* const* vars, size_t nvars, fossil_math_sym_node_t* grad) {
+    if (!fossil_math_sym_graph_valid(graph, node) || (nvars > 0 && (!vars || !grad))) return -1;
+
+    // Operands precede their users, so a downward sweep from the root sees
+    // each node after all of its users have pushed their adjoint onto it.
+    // Adjoint nodes created along the way land past node.
+    size_t n = (size_t)node + 1;
+    unsigned char* mark = malloc(n);
+    uint32_t* adj = malloc(n * sizeof(uint32_t));
+    uint32_t* sym_adj = malloc((graph->nsyms + 1) * sizeof(uint32_t));
+    fossil_math_sym_node_t zero = fossil_math_sym_graph_const(graph, 0.0);
+    fossil_math_sym_node_t one = fossil_math_sym_graph_const(graph, 1.0);
+    int failed = !mark || !adj || !sym_adj || zero == FOSSIL_MATH_SYM_NONE || one == FOSSIL_MATH_SYM_NONE;
+    if (!failed) {
+        fossil_math_sym_graph_mark(graph, node, mark);
+        for (size_t i = 0; i < n; ++i) adj[i] = FOSSIL_MATH_SYM_NONE;
+        for (size_t s = 0; s < graph->nsyms; ++s) sym_adj[s] = FOSSIL_MATH_SYM_NONE;
+        adj[node] = one;
+        for (size_t i = n; i-- > 0 && !failed;) {
+            if (!mark[i] || adj[i] == FOSSIL_MATH_SYM_NONE) continue;
+            if (graph->nodes[i].type == fossil_math_sym_OP) {
+                fossil_math_sym_adjoint_step(graph, adj, (fossil_math_sym_node_t)i, &failed);
+            } else if (graph->nodes[i].type == fossil_math_sym_VAR) {
+                sym_adj[graph->nodes[i].sym] = adj[i];
+            }
+        }
+        for (size_t k = 0; k < nvars && !failed; ++k) {
+            uint32_t id = vars[k] ? fossil_math_sym_symbol_find(graph, vars[k]) : FOSSIL_MATH_SYM_NONE;
+            grad[k] = id != FOSSIL_MATH_SYM_NONE && sym_adj[id] != FOSSIL_MATH_SYM_NONE ? sym_adj[id] : zero;
+        }
+    }
+    free(mark);
+    free(adj);
+    free(sym_adj);
+    return failed ? -2 : 0;
+}
+
+// ============================================================================
+// Native Code Generation
+// ============================================================================
+
+typedef double (*fossil_math_sym_native_fn_t)(const double* vars);
+typedef void (*fossil_math_sym_native_batch_fn_t)(const double* const* var_columns, double* out, size_t n);
+
+struct fossil_math_sym_native {
+    void* handle;
+    fossil_math_sym_native_fn_t fn;
+    fossil_math_sym_native_batch_fn_t batch;
+    size_t nvars;
+    int cached;
+};
+
+// Appends to a bounded buffer while counting the full length, like snprintf
+typedef struct {
+    char* buf;
+    size_t cap;
+    size_t len;
+} fossil_math_sym_writer_t;
+
+static void fossil_math_sym_write(fossil_math_sym_writer_t* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    char* dst = (w->buf && w->len < w->cap) ? w->buf + w->len : NULL;
+    int n = vsnprintf(dst, dst ? w->cap - w->len : 0, fmt, args);
+    va_end(args);
+    if (n > 0) w->len += (size_t)n;
+}
+
+// Formats a register as a C operand: a variable, a double literal, or a temporary
+static void fossil_math_sym_write_operand(fossil_math_sym_writer_t* w, const fossil_math_sym_compiled_t* p, uint32_t reg, int batch) {
+    if (reg < p->nvars) {
+        fossil_math_sym_write(w, batch ? "cols[%u][i]" : "v[%u]", (unsigned)reg);
+    } else if (reg < p->nvars + p->nconsts) {
+        double c = p->consts[reg - p->nvars];
+        if (isnan(c)) {
+            fossil_math_sym_write(w, "NAN");
+        } else if (isinf(c)) {
+            fossil_math_sym_write(w, c > 0 ? "HUGE_VAL" : "(-HUGE_VAL)");
+        } else {
+            char lit[40];
+            snprintf(lit, sizeof(lit), "%.17g", c);
+            int is_double = strpbrk(lit, ".e") != NULL;
+            // signbit, not c < 0: -0.0 also prints with a leading minus
+            fossil_math_sym_write(w, signbit(c) ? "(%s%s)" : "%s%s", lit, is_double ? "" : ".0");
+        }
+    } else {
+        fossil_math_sym_write(w, "t%u", (unsigned)(reg - p->nvars - p->nconsts));
+    }
+}
+
+static void fossil_math_sym_write_body(fossil_math_sym_writer_t* w, const fossil_math_sym_compiled_t* p, int batch, const char* indent) {
+    size_t ntemps = p->nregs - p->nvars - p->nconsts;
+    for (size_t k = 0; k < ntemps; ++k) fossil_math_sym_write(w, "%sdouble t%u;\n", indent, (unsigned)k);
+    for (size_t i = 0; i < p->ncode; ++i) {
+        const fossil_math_sym_instr_t* in = &p->code[i];
+        fossil_math_sym_write(w, "%s", indent);
+        fossil_math_sym_write_operand(w, p, in->dst, batch);
+        fossil_math_sym_write(w, " = ");
+        switch (in->op) {
+            case FOSSIL_MATH_SYM_OP_DIV:
+                fossil_math_sym_write(w, "(");
+                fossil_math_sym_write_operand(w, p, in->b, batch);
+                fossil_math_sym_write(w, " != 0.0) ? ");
+                fossil_math_sym_write_operand(w, p, in->a, batch);
+                fossil_math_sym_write(w, " / ");
+                fossil_math_sym_write_operand(w, p, in->b, batch);
+                fossil_math_sym_write(w, " : NAN");
+                break;
+            case FOSSIL_MATH_SYM_OP_ADD:
+            case FOSSIL_MATH_SYM_OP_SUB:
+            case FOSSIL_MATH_SYM_OP_MUL:
+                fossil_math_sym_write_operand(w, p, in->a, batch);
+                fossil_math_sym_write(w, in->op == FOSSIL_MATH_SYM_OP_ADD ? " + " : in->op == FOSSIL_MATH_SYM_OP_SUB ? " - " : " * ");
+                fossil_math_sym_write_operand(w, p, in->b, batch);
+                break;
+            case FOSSIL_MATH_SYM_OP_NEG:
+                fossil_math_sym_write(w, "-");
+                fossil_math_sym_write_operand(w, p, in->a, batch);
+                break;
+            default: {
+                // Everything else maps onto a <math.h> call
+                const fossil_math_sym_opinfo_t* f = NULL;
+                for (size_t k = 0; k < FOSSIL_MATH_SYM_NOPS && !f; ++k) {
+                    if (fossil_math_sym_ops[k].code == in->op) f = &fossil_math_sym_ops[k];
+                }
+                if (!f || !f->c_name) {
+                    fossil_math_sym_write(w, "NAN");
+                    break;
+                }
+                fossil_math_sym_write(w, "%s(", f->c_name);
+                fossil_math_sym_write_operand(w, p, in->a, batch);
+                if (f->arity == 2) {
+                    fossil_math_sym_write(w, ", ");
+                    fossil_math_sym_write_operand(w, p, in->b, batch);
+                }
+                fossil_math_sym_write(w, ")");
+                break;
+            }
+        }
+        fossil_math_sym_write(w, ";\n");
+    }
+}
+
+static int fossil_math_sym_is_identifier(const char* s) {
+    if (!s || !(isalpha((unsigned char)*s) || *s == '_')) return 0;
+    for (; *s; ++s) {
+        if (!isalnum((unsigned char)*s) && *s != '_') return 0;
+    }
+    return 1;
+}
+
+size_t fossil_math_sym_emit_c(const fossil_math_sym_compiled_t* prog, const char* name, char* buffer, size_t bufsize) {
+    if (!prog || !fossil_math_sym_is_identifier(name)) return 0;
+    fossil_math_sym_writer_t w = {buffer, bufsize, 0};
+    if (buffer && bufsize) buffer[0] = '\0';
+
+    fossil_math_sym_write(&w,
+        "/* Generated by fossil-math from a compiled symbolic expression. */\n"
+        "#include <math.h>\n"
+        "#include <stddef.h>\n"
+        "\n"
+        "#if defined(_WIN32)\n"
+        "#define FOSSIL_SYM_EXPORT __declspec(dllexport)\n"
+        "#else\n"
+        "#define FOSSIL_SYM_EXPORT\n"
+        "#endif\n"
+        "\n"
+        "FOSSIL_SYM_EXPORT double %s(const double* v) {\n"
+        "    (void)v;\n", name);
+    fossil_math_sym_write_body(&w, prog, 0, "    ");
+    fossil_math_sym_write(&w, "    return ");
+    fossil_math_sym_write_operand(&w, prog, prog->result, 0);
+    fossil_math_sym_write(&w, ";\n}\n\n"
+        "FOSSIL_SYM_EXPORT void %s_batch(const double* const* cols, double* out, size_t n) {\n"
+        "    for (size_t i = 0; i < n; ++i) {\n", name);
+    fossil_math_sym_write_body(&w, prog, 1, "        ");
+    fossil_math_sym_write(&w, "        out[i] = ");
+    fossil_math_sym_write_operand(&w, prog, prog->result, 1);
+    fossil_math_sym_write(&w, ";\n    }\n    (void)cols;\n}\n");
+    return w.len;
+}
+
+// FNV-1a, used to key the native library cache
+static uint64_t fossil_math_sym_hash_bytes(uint64_t h, const char* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+#if !defined(_WIN32)
+// Upper bound on words in the compiler command
+#define FOSSIL_MATH_SYM_MAX_CC_ARGS 32
+
+static fossil_math_sym_native_t* fossil_math_sym_native_load(const char* path, size_t nvars) {
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) return NULL;
+    void* fn = dlsym(handle, "fossil_sym_eval");
+    void* batch = dlsym(handle, "fossil_sym_eval_batch");
+    fossil_math_sym_native_t* native = (fn && batch) ? calloc(1, sizeof(*native)) : NULL;
+    if (!native) {
+        dlclose(handle);
+        return NULL;
+    }
+    native->handle = handle;
+    // dlsym returns object pointers; copy the bits into function pointers
+    memcpy(&native->fn, &fn, sizeof(native->fn));
+    memcpy(&native->batch, &batch, sizeof(native->batch));
+    native->nvars = nvars;
+    return native;
+}
+
+// Returns a new string formatted like snprintf, or NULL on allocation failure
+static char* fossil_math_sym_native_path(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    char* path = n >= 0 ? malloc((size_t)n + 1) : NULL;
+    if (!path) return NULL;
+    va_start(args, fmt);
+    vsnprintf(path, (size_t)n + 1, fmt, args);
+    va_end(args);
+    return path;
+}
+
+// Non-zero if path is a directory (or regular file) that only the effective
+// user can modify; symbolic links are rejected
+static int fossil_math_sym_native_private(const char* path, int dir) {
+    struct stat st;
+    if (lstat(path, &st) != 0) return 0;
+    if (dir ? !S_ISDIR(st.st_mode) : !S_ISREG(st.st_mode)) return 0;
+    return st.st_uid == geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// Resolves and creates the cache directory, or returns NULL if it is not private
+static char* fossil_math_sym_native_dir(const char* cache_dir) {
+    char* dir;
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (cache_dir) {
+        dir = fossil_math_sym_native_path("%s", cache_dir);
+    } else if (xdg && xdg[0] == '/') {
+        dir = fossil_math_sym_native_path("%s/fossil_math", xdg);
+    } else if (home && home[0] == '/') {
+        char* parent = fossil_math_sym_native_path("%s/.cache", home);
+        if (parent) mkdir(parent, 0700);
+        free(parent);
+        dir = fossil_math_sym_native_path("%s/.cache/fossil_math", home);
+    } else {
+        const char* tmp = getenv("TMPDIR");
+        dir = fossil_math_sym_native_path("%s/fossil_math-%ld", tmp && *tmp ? tmp : "/tmp", (long)geteuid());
+    }
+    if (dir && mkdir(dir, 0700) != 0 && errno != EEXIST) {
+        free(dir);
+        return NULL;
+    }
+    if (dir && !fossil_math_sym_native_private(dir, 1)) {
+        free(dir);
+        return NULL;
+    }
+    return dir;
+}
+
+// Writes the source to a new file that no other process can have opened
+static int fossil_math_sym_native_write_source(const char* path, const char* src, size_t len) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST && unlink(path) == 0) fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return -1;
+    FILE* f = fdopen(fd, "w");
+    if (!f) {
+        close(fd);
+        return -1;
+    }
+    int ok = fwrite(src, 1, len, f) == len;
+    ok &= fclose(f) == 0;
+    return ok ? 0 : -1;
+}
+
+// Runs the compiler without a shell; the command is split on whitespace
+static int fossil_math_sym_native_run(const char* compiler, const char* out_path, const char* c_path) {
+    char* words = fossil_math_sym_native_path("%s", compiler);
+    char* argv[FOSSIL_MATH_SYM_MAX_CC_ARGS + 8];
+    size_t argc = 0;
+    if (!words) return -1;
+    for (char* p = words; *p && argc < FOSSIL_MATH_SYM_MAX_CC_ARGS;) {
+        while (fossil_math_sym_is_space(*p)) *p++ = '\0';
+        if (!*p) break;
+        argv[argc++] = p;
+        while (*p && !fossil_math_sym_is_space(*p)) ++p;
+    }
+    if (argc == 0) {
+        free(words);
+        return -1;
+    }
+    argv[argc++] = "-O2";
+    argv[argc++] = "-shared";
+    argv[argc++] = "-fPIC";
+    argv[argc++] = "-o";
+    argv[argc++] = (char*)out_path;
+    argv[argc++] = (char*)c_path;
+    argv[argc++] = "-lm";
+    argv[argc] = NULL;
+
+    int status = -1;
+    pid_t pid = fork();
+    if (pid == 0) {
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    if (pid > 0) {
+        int wstatus;
+        pid_t r;
+        do {
+            r = waitpid(pid, &wstatus, 0);
+        } while (r < 0 && errno == EINTR);
+        if (r == pid && WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0) status = 0;
+    }
+    free(words);
+    return status;
+}
+#endif
+
+fossil_math_sym_native_t* fossil_math_sym_native_compile(const fossil_math_sym_compiled_t* prog, const char* cache_dir, const char* compiler) {
+    if (!prog) return NULL;
+#if defined(_WIN32)
+    (void)cache_dir;
+    (void)compiler;
+    return NULL;
+#else
+    if (!compiler) compiler = getenv("CC");
+    if (!compiler || !*compiler) compiler = "cc";
+
+    size_t len = fossil_math_sym_emit_c(prog, "fossil_sym_eval", NULL, 0);
+    char* src = malloc(len + 1);
+    char* dir = fossil_math_sym_native_dir(cache_dir);
+    char* so_path = NULL;
+    char* c_path = NULL;
+    char* tmp_path = NULL;
+    fossil_math_sym_native_t* native = NULL;
+    if (!src || !dir) goto done;
+    fossil_math_sym_emit_c(prog, "fossil_sym_eval", src, len + 1);
+
+    uint64_t h = fossil_math_sym_hash_bytes(14695981039346656037ULL, src, len);
+    h = fossil_math_sym_hash_bytes(h, compiler, strlen(compiler));
+    unsigned long long key = (unsigned long long)h;
+    long pid = (long)getpid();
+    so_path = fossil_math_sym_native_path("%s/fossil_sym_%016llx.so", dir, key);
+    c_path = fossil_math_sym_native_path("%s/fossil_sym_%016llx.%ld.c", dir, key, pid);
+    tmp_path = fossil_math_sym_native_path("%s/fossil_sym_%016llx.%ld.tmp", dir, key, pid);
+    if (!so_path || !c_path || !tmp_path) goto done;
+
+    if (fossil_math_sym_native_private(so_path, 0)) {
+        native = fossil_math_sym_native_load(so_path, prog->nvars);
+        if (native) {
+            native->cached = 1;
+            goto done;
+        }
+    }
+
+    if (fossil_math_sym_native_write_source(c_path, src, len) != 0) {
+        remove(c_path);
+        goto done;
+    }
+    remove(tmp_path);
+    int built = fossil_math_sym_native_run(compiler, tmp_path, c_path) == 0 && rename(tmp_path, so_path) == 0;
+    remove(c_path);
+    if (!built) {
+        remove(tmp_path);
+        goto done;
+    }
+    native = fossil_math_sym_native_load(so_path, prog->nvars);
+
+done:
+    free(src);
+    free(dir);
+    free(so_path);
+    free(c_path);
+    free(tmp_path);
+    return native;
+#endif
+}
+
+void fossil_math_sym_native_free(fossil_math_sym_native_t* native) {
+    if (!native) return;
+#if !defined(_WIN32)
+    dlclose(native->handle);
+#endif
+    free(native);
+}
+
+int fossil_math_sym_native_cached(const fossil_math_sym_native_t* native) {
+    return native ? native->cached : 0;
+}
+
+double fossil_math_sym_native_eval(const fossil_math_sym_native_t* native, const double* vars) {
+    if (!native || (!vars && native->nvars > 0)) return NAN;
+    return native->fn(vars);
+}
+
+int fossil_math_sym_native_eval_batch(const fossil_math_sym_native_t* native, const double* const* var_columns, double* out, size_t n) {
+    if (!native || !out || (!var_columns && native->nvars > 0)) return -1;
+    native->batch(var_columns, out, n);
+    return 0;
+}
+
+// ============================================================================
+// Serialization
+// ============================================================================
+//
+// Encodings are little-endian regardless of the host:
+//
+//   program  "FSMC" version:u8 nvars nconsts ntemps ncode noutputs:u32
+//            consts:f64[nconsts] (op:u8 dst a b:u32)[ncode] outputs:u32[noutputs]
+//   graph    "FSMG" version:u8 nsyms:u32 (len:u8 name)[nsyms] nnodes:u32
+//            nodes[nnodes], each type:u8 then value:f64 | sym:u32 | op:u8 a b:u32
+//
+// Graph nodes are numbered in encoding order, children before parents, and
+// the last node is the root. Decoders validate every count and index before
+// use, so malformed input is rejected rather than trusted.
+//
+// ============================================================================
+
+#define FOSSIL_MATH_SYM_FORMAT_VERSION 1
+// Encoded sizes of one instruction and of the smallest graph node
+#define FOSSIL_MATH_SYM_INSTR_BYTES 13
+#define FOSSIL_MATH_SYM_MIN_NODE_BYTES 5
+
+typedef struct {
+    unsigned char* buf;
+    size_t cap;
+    size_t len;     // bytes that would have been written
+} fossil_math_sym_out_t;
+
+typedef struct {
+    const unsigned char* p;
+    size_t len;
+    size_t pos;
+    int bad;
+} fossil_math_sym_in_t;
+
+static void fossil_math_sym_put(fossil_math_sym_out_t* o, const void* data, size_t n) {
+    if (o->len < o->cap) memcpy(o->buf + o->len, data, FOSSIL_MATH_MIN(n, o->cap - o->len));
+    o->len += n;
+}
+
+static void fossil_math_sym_put_u8(fossil_math_sym_out_t* o, unsigned v) {
+    unsigned char b = (unsigned char)v;
+    fossil_math_sym_put(o, &b, 1);
+}
+
+static void fossil_math_sym_put_u32(fossil_math_sym_out_t* o, uint32_t v) {
+    unsigned char b[4];
+    for (int i = 0; i < 4; ++i) b[i] = (unsigned char)(v >> (8 * i));
+    fossil_math_sym_put(o, b, 4);
+}
+
+static void fossil_math_sym_put_f64(fossil_math_sym_out_t* o, double v) {
+    uint64_t bits;
+    unsigned char b[8];
+    memcpy(&bits, &v, sizeof(bits));
+    for (int i = 0; i < 8; ++i) b[i] = (unsigned char)(bits >> (8 * i));
+    fossil_math_sym_put(o, b, 8);
+}
+
+static const unsigned char* fossil_math_sym_take(fossil_math_sym_in_t* in, size_t n) {
+    if (in->bad || in->len - in->pos < n) {
+        in->bad = 1;
+        return NULL;
+    }
+    const unsigned char* p = in->p + in->pos;
+    in->pos += n;
+    return p;
+}
+
+static unsigned fossil_math_sym_get_u8(fossil_math_sym_in_t* in) {
+    const unsigned char* b = fossil_math_sym_take(in, 1);
+    return b ? b[0] : 0;
+}
+
+static uint32_t fossil_math_sym_get_u32(fossil_math_sym_in_t* in) {
+    const unsigned char* b = fossil_math_sym_take(in, 4);
+    if (!b) return 0;
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static double fossil_math_sym_get_f64(fossil_math_sym_in_t* in) {
+    const unsigned char* b = fossil_math_sym_take(in, 8);
+    uint64_t bits = 0;
+    double v = 0.0;
+    if (b) {
+        for (int i = 0; i < 8; ++i) bits |= (uint64_t)b[i] << (8 * i);
+    }
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Reads and checks the four-byte magic and the version
+static int fossil_math_sym_get_header(fossil_math_sym_in_t* in, const char* magic) {
+    const unsigned char* m = fossil_math_sym_take(in, 4);
+    if (!m || memcmp(m, magic, 4) != 0 || fossil_math_sym_get_u8(in) != FOSSIL_MATH_SYM_FORMAT_VERSION) in->bad = 1;
+    return !in->bad;
+}
+
+size_t fossil_math_sym_compiled_serialize(const fossil_math_sym_compiled_t* prog, void* buffer, size_t bufsize) {
+    if (!prog) return 0;
+    fossil_math_sym_out_t o = {(unsigned char*)buffer, buffer ? bufsize : 0, 0};
+    fossil_math_sym_put(&o, "FSMC", 4);
+    fossil_math_sym_put_u8(&o, FOSSIL_MATH_SYM_FORMAT_VERSION);
+    fossil_math_sym_put_u32(&o, (uint32_t)prog->nvars);
+    fossil_math_sym_put_u32(&o, (uint32_t)prog->nconsts);
+    fossil_math_sym_put_u32(&o, (uint32_t)(prog->nregs - prog->nvars - prog->nconsts));
+    fossil_math_sym_put_u32(&o, (uint32_t)prog->ncode);
+    fossil_math_sym_put_u32(&o, (uint32_t)prog->noutputs);
+    for (size_t i = 0; i < prog->nconsts; ++i) fossil_math_sym_put_f64(&o, prog->consts[i]);
+    for (size_t i = 0; i < prog->ncode; ++i) {
+        fossil_math_sym_put_u8(&o, prog->code[i].op);
+        fossil_math_sym_put_u32(&o, prog->code[i].dst);
+        fossil_math_sym_put_u32(&o, prog->code[i].a);
+        fossil_math_sym_put_u32(&o, prog->code[i].b);
+    }
+    for (size_t i = 0; i < prog->noutputs; ++i) fossil_math_sym_put_u32(&o, prog->outputs[i]);
+    return o.len;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_compiled_deserialize(const void* data, size_t size) {
+    fossil_math_sym_in_t in = {(const unsigned char*)data, data ? size : 0, 0, 0};
+    if (!fossil_math_sym_get_header(&in, "FSMC")) return NULL;
+    uint64_t nvars = fossil_math_sym_get_u32(&in), nconsts = fossil_math_sym_get_u32(&in), ntemps = fossil_math_sym_get_u32(&in);
+    uint64_t ncode = fossil_math_sym_get_u32(&in), noutputs = fossil_math_sym_get_u32(&in);
+    uint64_t nregs = nvars + nconsts + ntemps;
+    // The remaining size must match the counts exactly, which bounds every count but
+    // nvars and ntemps; each temporary is written by some instruction, so ntemps <= ncode
+    if (in.bad || noutputs == 0 || ntemps > ncode || nregs >= FOSSIL_MATH_SYM_TEMP_BIT ||
+        in.len - in.pos != nconsts * 8 + ncode * FOSSIL_MATH_SYM_INSTR_BYTES + noutputs * 4) {
+        return NULL;
+    }
+
+    fossil_math_sym_compiled_t* p = calloc(1, sizeof(*p));
+    unsigned char* defined = calloc((size_t)nregs + 1, 1);
+    if (!p || !defined) goto fail;
+    p->nvars = (size_t)nvars;
+    p->nconsts = (size_t)nconsts;
+    p->nregs = (size_t)nregs;
+    p->ncode = (size_t)ncode;
+    p->noutputs = (size_t)noutputs;
+    p->consts = malloc((size_t)nconsts * sizeof(double) + 1);
+    p->code = malloc((size_t)ncode * sizeof(*p->code) + 1);
+    p->outputs = malloc((size_t)noutputs * sizeof(uint32_t));
+    if (!p->consts || !p->code || !p->outputs) goto fail;
+
+    // Variables and constants are defined on entry; every other register
+    // must be written before it is read
+    memset(defined, 1, (size_t)(nvars + nconsts));
+    for (size_t i = 0; i < p->nconsts; ++i) p->consts[i] = fossil_math_sym_get_f64(&in);
+    for (size_t i = 0; i < p->ncode; ++i) {
+        fossil_math_sym_instr_t* c = &p->code[i];
+        c->op = fossil_math_sym_get_u8(&in);
+        c->dst = fossil_math_sym_get_u32(&in);
+        c->a = fossil_math_sym_get_u32(&in);
+        c->b = fossil_math_sym_get_u32(&in);
+        if (c->op >= FOSSIL_MATH_SYM_NOPS || c->dst < nvars + nconsts || c->dst >= nregs ||
+            c->a >= nregs || c->b >= nregs || !defined[c->a] || !defined[c->b]) {
+            goto fail;
+        }
+        defined[c->dst] = 1;
+    }
+    for (size_t i = 0; i < p->noutputs; ++i) {
+        p->outputs[i] = fossil_math_sym_get_u32(&in);
+        if (p->outputs[i] >= nregs || !defined[p->outputs[i]]) goto fail;
+    }
+    p->result = p->outputs[0];
+    free(defined);
+    return p;
+
+fail:
+    free(defined);
+    fossil_math_sym_compiled_free(p);
+    return NULL;
+}
+
+size_t fossil_math_sym_graph_serialize(const fossil_math_sym_graph_t* graph, fossil_math_sym_node_t node, void* buffer, size_t bufsize) {
+    if (!fossil_math_sym_graph_valid(graph, node)) return 0;
+    size_t n = (size_t)node + 1;
+    unsigned char* mark = malloc(n);
+    uint32_t* local = malloc(n * sizeof(uint32_t));
+    uint32_t* sym_local = malloc((graph->nsyms + 1) * sizeof(uint32_t));
+    fossil_math_sym_out_t o = {(unsigned char*)buffer, buffer ? bufsize : 0, 0};
+    if (!mark || !local || !sym_local) goto done;
+
+    // Number the reachable nodes and the symbols they use in index order
+    size_t nnodes = fossil_math_sym_graph_mark(graph, node, mark);
+    uint32_t nsyms = 0, next = 0;
+    for (size_t s = 0; s < graph->nsyms; ++s) sym_local[s] = FOSSIL_MATH_SYM_NONE;
+    for (size_t i = 0; i < n; ++i) {
+        if (!mark[i]) continue;
+        local[i] = next++;
+        if (graph->nodes[i].type == fossil_math_sym_VAR && sym_local[graph->nodes[i].sym] == FOSSIL_MATH_SYM_NONE) {
+            sym_local[graph->nodes[i].sym] = nsyms++;
+        }
+    }
+
+    fossil_math_sym_put(&o, "FSMG", 4);
+    fossil_math_sym_put_u8(&o, FOSSIL_MATH_SYM_FORMAT_VERSION);
+    fossil_math_sym_put_u32(&o, nsyms);
+    for (size_t s = 0; s < graph->nsyms; ++s) {
+        if (sym_local[s] == FOSSIL_MATH_SYM_NONE) continue;
+        size_t len = strlen(graph->syms[s]);
+        fossil_math_sym_put_u8(&o, (unsigned)len);
+        fossil_math_sym_put(&o, graph->syms[s], len);
+    }
+    fossil_math_sym_put_u32(&o, (uint32_t)nnodes);
+    for (size_t i = 0; i < n; ++i) {
+        if (!mark[i]) continue;
+        const fossil_math_sym_gnode_t* g = &graph->nodes[i];
+        fossil_math_sym_put_u8(&o, g->type);
+        switch (g->type) {
+            case fossil_math_sym_CONST:
+                fossil_math_sym_put_f64(&o, g->u.value);
+                break;
+            case fossil_math_sym_VAR:
+                fossil_math_sym_put_u32(&o, sym_local[g->sym]);
+                break;
+            case fossil_math_sym_OP:
+                fossil_math_sym_put_u8(&o, (unsigned char)g->op);
+                fossil_math_sym_put_u32(&o, local[g->u.child[0]]);
+                fossil_math_sym_put_u32(&o, local[g->u.child[1]]);
+                break;
+        }
+    }
+
+done:;
+    size_t len = mark && local && sym_local ? o.len : 0;
+    free(mark);
+    free(local);
+    free(sym_local);
+    return len;
+}
+
+fossil_math_sym_node_t fossil_math_sym_graph_deserialize(fossil_math_sym_graph_t* graph, const void* data, size_t size) {
+    fossil_math_sym_in_t in = {(const unsigned char*)data, data ? size : 0, 0, 0};
+    if (!graph || !fossil_math_sym_get_header(&in, "FSMG")) return FOSSIL_MATH_SYM_NONE;
+
+    // Symbols become variable nodes up front; each name takes at least two bytes
+    uint32_t nsyms = fossil_math_sym_get_u32(&in);
+    if (in.bad || nsyms > (in.len - in.pos) / 2) return FOSSIL_MATH_SYM_NONE;
+    fossil_math_sym_node_t* vars = malloc(((size_t)nsyms + 1) * sizeof(*vars));
+    fossil_math_sym_node_t* nodes = NULL;
+    fossil_math_sym_node_t root = FOSSIL_MATH_SYM_NONE;
+    if (!vars) return FOSSIL_MATH_SYM_NONE;
+    for (uint32_t s = 0; s < nsyms && !in.bad; ++s) {
+        size_t len = fossil_math_sym_get_u8(&in);
+        const unsigned char* name = fossil_math_sym_take(&in, len);
+        if (!name || len == 0 || len >= FOSSIL_MATH_SYM_NAME_MAX) {
+            in.bad = 1;
+            break;
+        }
+        vars[s] = fossil_math_sym_graph_var_n(graph, (const char*)name, len);
+        if (vars[s] == FOSSIL_MATH_SYM_NONE) in.bad = 1;
+    }
+
+    uint32_t nnodes = fossil_math_sym_get_u32(&in);
+    if (in.bad || nnodes == 0 || nnodes > (in.len - in.pos) / FOSSIL_MATH_SYM_MIN_NODE_BYTES) goto done;
+    nodes = malloc((size_t)nnodes * sizeof(*nodes));
+    if (!nodes) goto done;
+    for (uint32_t i = 0; i < nnodes; ++i) {
+        fossil_math_sym_node_t made = FOSSIL_MATH_SYM_NONE;
+        switch (fossil_math_sym_get_u8(&in)) {
+            case fossil_math_sym_CONST:
+                made = fossil_math_sym_graph_const(graph, fossil_math_sym_get_f64(&in));
+                break;
+            case fossil_math_sym_VAR: {
+                uint32_t s = fossil_math_sym_get_u32(&in);
+                if (s < nsyms) made = vars[s];
+                break;
+            }
+            case fossil_math_sym_OP: {
+                char op = (char)fossil_math_sym_get_u8(&in);
+                uint32_t a = fossil_math_sym_get_u32(&in), b = fossil_math_sym_get_u32(&in);
+                if (a < i && b < i) made = fossil_math_sym_graph_op(graph, op, nodes[a], nodes[b]);
+                break;
+            }
+            default:
+                break;
+        }
+        if (in.bad || made == FOSSIL_MATH_SYM_NONE) goto done;
+        nodes[i] = made;
+    }
+    if (in.pos == in.len) root = nodes[nnodes - 1];
+
+done:
+    free(vars);
+    free(nodes);
+    return root;
+}
+
+// ============================================================================
+// Parse Cache
+// ============================================================================
+//
+// Entries hold the serialized program, keyed by the formula text, the
+// variable list and the flags. They are chained into hash buckets and into
+// a recency list whose tail is evicted first. Lookups hand out a fresh
+// program decoded from the entry, so eviction never invalidates a program
+// held by a caller. Compilation on a miss runs without the lock.
+//
+// ============================================================================
+
+#define FOSSIL_MATH_SYM_CACHE_DEFAULT_BYTES ((size_t)1 << 20)
+
+typedef struct fossil_math_sym_cache_entry {
+    struct fossil_math_sym_cache_entry* chain;  // next in bucket
+    struct fossil_math_sym_cache_entry* prev;   // more recently used
+    struct fossil_math_sym_cache_entry* next;   // less recently used
+    uint64_t hash;
+    size_t key_len;
+    size_t blob_len;
+    unsigned char data[];                       // key, then the serialized program
+} fossil_math_sym_cache_entry_t;
+
+struct fossil_math_sym_cache {
+    fossil_math_mutex_t* lock;
+    fossil_math_sym_cache_entry_t** buckets;
+    size_t nbuckets;        // power of two
+    fossil_math_sym_cache_entry_t* head;  // most recently used
+    fossil_math_sym_cache_entry_t* tail;
+    size_t max_bytes;
+    fossil_math_sym_cache_stats_t stats;
+};
+
+fossil_math_sym_cache_t* fossil_math_sym_cache_create(size_t max_bytes) {
+    fossil_math_sym_cache_t* cache = calloc(1, sizeof(*cache));
+    if (!cache) return NULL;
+    cache->max_bytes = max_bytes ? max_bytes : FOSSIL_MATH_SYM_CACHE_DEFAULT_BYTES;
+    cache->nbuckets = 64;
+    cache->buckets = calloc(cache->nbuckets, sizeof(*cache->buckets));
+    cache->lock = fossil_math_mutex_create();
+    if (!cache->buckets || !cache->lock) {
+        fossil_math_sym_cache_free(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void fossil_math_sym_cache_clear(fossil_math_sym_cache_t* cache) {
+    if (!cache) return;
+    fossil_math_mutex_lock(cache->lock);
+    for (fossil_math_sym_cache_entry_t* e = cache->head; e;) {
+        fossil_math_sym_cache_entry_t* next = e->next;
+        free(e);
+        e = next;
+    }
+    memset(cache->buckets, 0, cache->nbuckets * sizeof(*cache->buckets));
+    cache->head = cache->tail = NULL;
+    cache->stats.entries = 0;
+    cache->stats.bytes = 0;
+    fossil_math_mutex_unlock(cache->lock);
+}
+
+void fossil_math_sym_cache_free(fossil_math_sym_cache_t* cache) {
+    if (!cache) return;
+    if (cache->lock && cache->buckets) fossil_math_sym_cache_clear(cache);
+    fossil_math_mutex_free(cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+void fossil_math_sym_cache_stats(fossil_math_sym_cache_t* cache, fossil_math_sym_cache_stats_t* stats) {
+    if (!cache || !stats) return;
+    fossil_math_mutex_lock(cache->lock);
+    *stats = cache->stats;
+    fossil_math_mutex_unlock(cache->lock);
+}
+
+static size_t fossil_math_sym_cache_entry_bytes(const fossil_math_sym_cache_entry_t* e) {
+    return sizeof(*e) + e->key_len + e->blob_len;
+}
+
+static void fossil_math_sym_cache_unlink(fossil_math_sym_cache_t* cache, fossil_math_sym_cache_entry_t* e) {
+    if (e->prev) e->prev->next = e->next; else cache->head = e->next;
+    if (e->next) e->next->prev = e->prev; else cache->tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void fossil_math_sym_cache_push_front(fossil_math_sym_cache_t* cache, fossil_math_sym_cache_entry_t* e) {
+    e->prev = NULL;
+    e->next = cache->head;
+    if (cache->head) cache->head->prev = e; else cache->tail = e;
+    cache->head = e;
+}
+
+static fossil_math_sym_cache_entry_t** fossil_math_sym_cache_slot(fossil_math_sym_cache_t* cache, uint64_t hash,
+                                                                  const unsigned char* key, size_t key_len) {
+    fossil_math_sym_cache_entry_t** slot = &cache->buckets[hash & (cache->nbuckets - 1)];
+    while (*slot && ((*slot)->hash != hash || (*slot)->key_len != key_len || memcmp((*slot)->data, key, key_len) != 0)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void fossil_math_sym_cache_evict(fossil_math_sym_cache_t* cache) {
+    fossil_math_sym_cache_entry_t* e = cache->tail;
+    fossil_math_sym_cache_entry_t** slot = fossil_math_sym_cache_slot(cache, e->hash, e->data, e->key_len);
+    *slot = e->chain;
+    fossil_math_sym_cache_unlink(cache, e);
+    cache->stats.entries--;
+    cache->stats.bytes -= fossil_math_sym_cache_entry_bytes(e);
+    cache->stats.evictions++;
+    free(e);
+}
+
+// Doubles the bucket array; on allocation failure chains just get longer
+static void fossil_math_sym_cache_grow(fossil_math_sym_cache_t* cache) {
+    size_t nbuckets = cache->nbuckets * 2;
+    fossil_math_sym_cache_entry_t** buckets = calloc(nbuckets, sizeof(*buckets));
+    if (!buckets) return;
+    for (fossil_math_sym_cache_entry_t* e = cache->head; e; e = e->next) {
+        size_t b = (size_t)(e->hash & (nbuckets - 1));
+        e->chain = buckets[b];
+        buckets[b] = e;
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->nbuckets = nbuckets;
+}
+
+// Inserts a copy of blob under key unless an equal key is already present
+static void fossil_math_sym_cache_insert(fossil_math_sym_cache_t* cache, uint64_t hash, const unsigned char* key, size_t key_len,
+                                         const unsigned char* blob, size_t blob_len) {
+    fossil_math_sym_cache_entry_t* e = malloc(sizeof(*e) + key_len + blob_len);
+    if (!e) return;
+    e->chain = NULL;
+    e->hash = hash;
+    e->key_len = key_len;
+    e->blob_len = blob_len;
+    memcpy(e->data, key, key_len);
+    memcpy(e->data + key_len, blob, blob_len);
+    size_t bytes = fossil_math_sym_cache_entry_bytes(e);
+
+    fossil_math_mutex_lock(cache->lock);
+    fossil_math_sym_cache_entry_t** slot = fossil_math_sym_cache_slot(cache, hash, key, key_len);
+    if (*slot || bytes > cache->max_bytes) {
+        // Another thread compiled the same formula first, or it can never fit
+        fossil_math_mutex_unlock(cache->lock);
+        free(e);
+        return;
+    }
+    while (cache->tail && cache->stats.bytes + bytes > cache->max_bytes) fossil_math_sym_cache_evict(cache);
+    if (cache->stats.entries >= cache->nbuckets) fossil_math_sym_cache_grow(cache);
+    slot = fossil_math_sym_cache_slot(cache, hash, key, key_len);
+    *slot = e;
+    fossil_math_sym_cache_push_front(cache, e);
+    cache->stats.entries++;
+    cache->stats.bytes += bytes;
+    fossil_math_mutex_unlock(cache->lock);
+}
+
+// Builds the program for a cache miss
+static fossil_math_sym_compiled_t* fossil_math_sym_cache_build(const char* text, size_t len, const char* const* vars, size_t nvars,
+                                                               unsigned flags, fossil_math_sym_parse_error_t* error) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t* out = malloc((nvars + 1) * sizeof(*out));
+    fossil_math_sym_compiled_t* prog = NULL;
+    if (!g || !out) {
+        if (error) {
+            error->status = FOSSIL_MATH_SYM_PARSE_NO_MEMORY;
+            error->offset = 0;
+        }
+    } else {
+        out[0] = fossil_math_sym_graph_parse(g, text, len, error);
+        if (out[0] != FOSSIL_MATH_SYM_NONE && (flags & FOSSIL_MATH_SYM_CACHE_SIMPLIFY)) out[0] = fossil_math_sym_graph_simplify(g, out[0]);
+        size_t count = 1;
+        if (out[0] != FOSSIL_MATH_SYM_NONE && (flags & FOSSIL_MATH_SYM_CACHE_GRADIENT)) {
+            count = fossil_math_sym_graph_gradient(g, out[0], vars, nvars, out + 1) == 0 ? nvars + 1 : 0;
+        }
+        if (out[0] != FOSSIL_MATH_SYM_NONE && count > 0) prog = fossil_math_sym_graph_compile_many(g, out, count, vars, nvars);
+    }
+    free(out);
+    fossil_math_sym_graph_free(g);
+    return prog;
+}
+
+fossil_math_sym_compiled_t* fossil_math_sym_cache_compile(fossil_math_sym_cache_t* cache, const char* text, size_t len,
+                                                          const char* const* vars, size_t nvars, unsigned flags,
+                                                          fossil_math_sym_parse_error_t* error) {
+    if (error) {
+        error->status = FOSSIL_MATH_SYM_PARSE_OK;
+        error->offset = 0;
+    }
+    if (!cache || (!text && len > 0) || (!vars && nvars > 0)) {
+        if (error) error->status = FOSSIL_MATH_SYM_PARSE_INVALID;
+        return NULL;
+    }
+
+    // Key: flags, text length, text, then each variable name with its terminator
+    size_t key_len = 1 + sizeof(uint64_t) + len;
+    for (size_t k = 0; k < nvars; ++k) {
+        if (!vars[k]) {
+            if (error) error->status = FOSSIL_MATH_SYM_PARSE_INVALID;
+            return NULL;
+        }
+        key_len += strlen(vars[k]) + 1;
+    }
+    unsigned char local[256];
+    unsigned char* key = key_len <= sizeof(local) ? local : malloc(key_len);
+    if (!key) {
+        if (error) error->status = FOSSIL_MATH_SYM_PARSE_NO_MEMORY;
+        return NULL;
+    }
+    uint64_t text_len = (uint64_t)len;
+    size_t pos = 0;
+    key[pos++] = (unsigned char)flags;
+    memcpy(key + pos, &text_len, sizeof(text_len));
+    pos += sizeof(text_len);
+    if (len) memcpy(key + pos, text, len);
+    pos += len;
+    for (size_t k = 0; k < nvars; ++k) {
+        size_t n = strlen(vars[k]) + 1;
+        memcpy(key + pos, vars[k], n);
+        pos += n;
+    }
+    uint64_t hash = fossil_math_sym_hash_bytes(14695981039346656037ULL, (const char*)key, key_len);
+
+    fossil_math_sym_compiled_t* prog = NULL;
+    fossil_math_mutex_lock(cache->lock);
+    fossil_math_sym_cache_entry_t* hit = *fossil_math_sym_cache_slot(cache, hash, key, key_len);
+    if (hit) {
+        fossil_math_sym_cache_unlink(cache, hit);
+        fossil_math_sym_cache_push_front(cache, hit);
+        prog = fossil_math_sym_compiled_deserialize(hit->data + hit->key_len, hit->blob_len);
+        cache->stats.hits++;
+    } else {
+        cache->stats.misses++;
+    }
+    fossil_math_mutex_unlock(cache->lock);
+
+    if (!hit) {
+        prog = fossil_math_sym_cache_build(text, len, vars, nvars, flags, error);
+        size_t blob_len = fossil_math_sym_compiled_serialize(prog, NULL, 0);
+        unsigned char* blob = blob_len ? malloc(blob_len) : NULL;
+        if (blob) {
+            fossil_math_sym_compiled_serialize(prog, blob, blob_len);
+            fossil_math_sym_cache_insert(cache, hash, key, key_len, blob, blob_len);
+        }
+        free(blob);
+        if (!prog && error && error->status == FOSSIL_MATH_SYM_PARSE_OK) {
+            // Parsed, but a variable is missing from vars
+            error->status = FOSSIL_MATH_SYM_PARSE_INVALID;
+        }
+    } else if (!prog && error) {
+        error->status = FOSSIL_MATH_SYM_PARSE_NO_MEMORY;
+    }
+    if (key != local) free(key);
+    return prog;
+}
@@ -23,6 +23,7 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/tensor.h"
+#include "fossil/math/instrument.h"
 
 // ============================================================================
 // Internal Helpers
@@ -58,9 +59,7 @@ static int fossil_math_tensor_shape_equal(const fossil_math_tensor_t* a, const f
 // Tensor Creation & Deletion
 // ============================================================================
 
-fossil_math_tensor_t* fossil_math_tensor_create(const size_t* shape, size_t dims) {
-    if (!shape || dims == 0) return NULL;
-
+static fossil_math_tensor_t* fossil_math_tensor_alloc(const size_t* shape, size_t dims) {
     fossil_math_tensor_t* t = calloc(1, sizeof(fossil_math_tensor_t));
     if (!t) return NULL;
 
@@ -80,6 +79,16 @@ fossil_math_tensor_t* fossil_math_tensor_create(const size_t* shape, size_t dims
         return NULL;
     }
 
+    FOSSIL_MATH_INSTRUMENT_ALLOC(FOSSIL_MATH_KERNEL_TENSOR_CREATE, sizeof(*t) + dims * sizeof(size_t) + total * sizeof(double));
+    return t;
+}
+
+fossil_math_tensor_t* fossil_math_tensor_create(const size_t* shape, size_t dims) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_tensor_t* t = (shape && dims > 0) ? fossil_math_tensor_alloc(shape, dims) : NULL;
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_TENSOR_CREATE, 0);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_TENSOR_CREATE, t ? shape[0] : 0, t && dims > 1 ? shape[1] : 0, t && dims > 2 ? shape[2] : 0);
     return t;
 }
 
@@ -111,30 +120,32 @@ void fossil_math_tensor_set(fossil_math_tensor_t* t, const size_t* idx, double v
 // ============================================================================
 
 fossil_math_tensor_t* fossil_math_tensor_add(const fossil_math_tensor_t* a, const fossil_math_tensor_t* b) {
-    if (!a || !b || !a->data || !b->data) return NULL;
-    if (!fossil_math_tensor_shape_equal(a, b)) return NULL;
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_tensor_t* r = NULL;
+    if (a && b && a->data && b->data && fossil_math_tensor_shape_equal(a, b)) r = fossil_math_tensor_create(a->shape, a->dims);
 
-    fossil_math_tensor_t* r = fossil_math_tensor_create(a->shape, a->dims);
-    if (!r) return NULL;
-
-    size_t total = fossil_math_tensor_size(a->shape, a->dims);
+    size_t total = r ? fossil_math_tensor_size(a->shape, a->dims) : 0;
     for (size_t i = 0; i < total; ++i) {
         r->data[i] = a->data[i] + b->data[i];
     }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_TENSOR_ADD, total);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_TENSOR_ADD, total, 0, 0);
     return r;
 }
 
 fossil_math_tensor_t* fossil_math_tensor_mul(const fossil_math_tensor_t* a, const fossil_math_tensor_t* b) {
-    if (!a || !b || !a->data || !b->data) return NULL;
-    if (!fossil_math_tensor_shape_equal(a, b)) return NULL;
-
-    fossil_math_tensor_t* r = fossil_math_tensor_create(a->shape, a->dims);
-    if (!r) return NULL;
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_tensor_t* r = NULL;
+    if (a && b && a->data && b->data && fossil_math_tensor_shape_equal(a, b)) r = fossil_math_tensor_create(a->shape, a->dims);
 
-    size_t total = fossil_math_tensor_size(a->shape, a->dims);
+    size_t total = r ? fossil_math_tensor_size(a->shape, a->dims) : 0;
     for (size_t i = 0; i < total; ++i) {
         r->data[i] = a->data[i] * b->data[i];
     }
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_TENSOR_MUL, total);
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_TENSOR_MUL, total, 0, 0);
     return r;
 }
 
@@ -147,37 +158,41 @@ fossil_math_tensor_t* fossil_math_tensor_mul(const fossil_math_tensor_t* a, cons
 //
 
 fossil_math_tensor_t* fossil_math_tensor_dot(const fossil_math_tensor_t* a, const fossil_math_tensor_t* b) {
-    if (!a || !b) return NULL;
-
-    // 1D dot product
-    if (a->dims == 1 && b->dims == 1 && a->shape[0] == b->shape[0]) {
-        double sum = 0.0;
-        for (size_t i = 0; i < a->shape[0]; ++i)
-            sum += a->data[i] * b->data[i];
-        fossil_math_tensor_t* r = fossil_math_tensor_create((size_t[]){1}, 1);
-        r->data[0] = sum;
-        return r;
-    }
-
-    // 2D matrix multiplication (m×n) × (n×p)
-    if (a->dims == 2 && b->dims == 2 && a->shape[1] == b->shape[0]) {
+    FOSSIL_MATH_INSTRUMENT_BEGIN();
+    FOSSIL_MATH_TRACE_BEGIN();
+    fossil_math_tensor_t* r = NULL;
+
+    if (a && b && a->dims == 1 && b->dims == 1 && a->shape[0] == b->shape[0]) {
+        // 1D dot product
+        r = fossil_math_tensor_create((size_t[]){1}, 1);
+        if (r) {
+            double sum = 0.0;
+            for (size_t i = 0; i < a->shape[0]; ++i)
+                sum += a->data[i] * b->data[i];
+            r->data[0] = sum;
+        }
+    } else if (a && b && a->dims == 2 && b->dims == 2 && a->shape[1] == b->shape[0]) {
+        // 2D matrix multiplication (m×n) × (n×p)
         size_t m = a->shape[0], n = a->shape[1], p = b->shape[1];
-        fossil_math_tensor_t* r = fossil_math_tensor_create((size_t[]){m, p}, 2);
-        if (!r) return NULL;
-
-        for (size_t i = 0; i < m; ++i) {
-            for (size_t j = 0; j < p; ++j) {
-                double sum = 0.0;
-                for (size_t k = 0; k < n; ++k)
-                    sum += a->data[i * n + k] * b->data[k * p + j];
-                r->data[i * p + j] = sum;
+        r = fossil_math_tensor_create((size_t[]){m, p}, 2);
+        if (r) {
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < p; ++j) {
+                    double sum = 0.0;
+                    for (size_t k = 0; k < n; ++k)
+                        sum += a->data[i * n + k] * b->data[k * p + j];
+                    r->data[i * p + j] = sum;
+                }
             }
         }
-        return r;
     }
 
-    // Unsupported dimension
-    return NULL;
+    // Unsupported shapes return NULL but are still counted
+    FOSSIL_MATH_INSTRUMENT_END(FOSSIL_MATH_KERNEL_TENSOR_DOT,
+                               !r ? 0.0 : 2.0 * (double)a->shape[0] * (a->dims == 2 ? (double)a->shape[1] * (double)b->shape[1] : 1.0));
+    FOSSIL_MATH_TRACE_END(FOSSIL_MATH_KERNEL_TENSOR_DOT, r ? a->shape[0] : 0, r && a->dims == 2 ? a->shape[1] : 0,
+                          r && a->dims == 2 ? b->shape[1] : 0);
+    return r;
 }
 
 // ============================================================================
@@ -189,6 +189,50 @@ FOSSIL_TEST(c_math_test_solve_quadratic_complex) {
     ASSUME_ITS_TRUE(ret == -2);
 }
 
+FOSSIL_TEST(c_math_test_lu_solve) {
+    double A[] = {2, 1, 1,
+                  4, -6, 0,
+                  -2, 7, 2};
+    size_t piv[3];
+    double b[] = {5, -2, 9};
+    double x[3];
+    ASSUME_ITS_TRUE(fossil_math_algebra_lu_decompose(A, 3, piv) == 0);
+    fossil_math_algebra_lu_solve(A, piv, b, x, 3);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[2], 2.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST(c_math_test_lu_singular) {
+    double A[] = {1, 2,
+                  2, 4};
+    size_t piv[2];
+    ASSUME_ITS_TRUE(fossil_math_algebra_lu_decompose(A, 2, piv) == -3);
+}
+
+FOSSIL_TEST(c_math_test_solve_linear_system) {
+    double A[] = {4, 1,
+                  1, 3};
+    double b[] = {1, 2};
+    double x[2];
+    int ret = fossil_math_algebra_solve_linear_system(A, b, x, 2);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0 / 11.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[1], 7.0 / 11.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST(c_math_test_matrix_inverse) {
+    double M[] = {4, 7,
+                  2, 6};
+    double Inv[4];
+    int ret = fossil_math_algebra_matrix_inverse(M, 2, Inv);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_EQUAL_F64(Inv[0], 0.6, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[1], -0.7, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[2], -0.2, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[3], 0.4, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -207,6 +251,10 @@ FOSSIL_TEST_GROUP(c_algebra_tests) {
     FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_vector_add);
     FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_vector_sub);
     FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_dot_product);
+    FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_lu_solve);
+    FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_lu_singular);
+    FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_solve_linear_system);
+    FOSSIL_ADD_TEST(c_algebra_fixture, c_math_test_matrix_inverse);
 
     FOSSIL_ADD_SUITE(c_algebra_fixture);
 } // end of tests
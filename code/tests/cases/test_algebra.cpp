@@ -165,6 +165,33 @@ FOSSIL_TEST(cpp_math_test_solve_quadratic_real) {
     );
 }
 
+FOSSIL_TEST(cpp_math_test_lu_solve) {
+    std::vector<double> A{2, 1, 1,
+                          4, -6, 0,
+                          -2, 7, 2};
+    std::vector<size_t> piv = fossil::math::Algebra::lu_decompose(A, 3);
+    std::vector<double> x = fossil::math::Algebra::lu_solve(A, piv, {5, -2, 9});
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[2], 2.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST(cpp_math_test_solve_linear_system) {
+    std::vector<double> A{4, 1,
+                          1, 3};
+    std::vector<double> x = fossil::math::Algebra::solve_linear_system(A, {1, 2}, 2);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0 / 11.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(x[1], 7.0 / 11.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST(cpp_math_test_matrix_inverse) {
+    std::vector<double> Inv = fossil::math::Algebra::matrix_inverse({4, 7, 2, 6}, 2);
+    ASSUME_ITS_EQUAL_F64(Inv[0], 0.6, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[1], -0.7, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[2], -0.2, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(Inv[3], 0.4, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -182,6 +209,9 @@ FOSSIL_TEST_GROUP(cpp_algebra_tests) {
     FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_vector_add);
     FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_vector_sub);
     FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_dot_product);
+    FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_lu_solve);
+    FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_solve_linear_system);
+    FOSSIL_ADD_TEST(cpp_algebra_fixture, cpp_math_test_matrix_inverse);
 
     FOSSIL_ADD_SUITE(cpp_algebra_fixture);
 } // end of tests
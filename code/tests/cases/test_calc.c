@@ -131,6 +131,85 @@ FOSSIL_TEST(c_math_test_calc_root_bisection) {
     ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-6);
 }
 
+static double test_func_cos_minus_x(double x) { return cos(x) - x; }
+
+FOSSIL_TEST(c_math_test_calc_root_brent) {
+    fossil_math_calc_root_info_t info;
+    double root = fossil_math_calc_root_brent(test_func_root, 0.0, 2.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-10);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_TRUE(info.evaluations < 20);
+
+    root = fossil_math_calc_root_brent(test_func_cos_minus_x, 0.0, 1.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, 0.7390851332151607, 1e-10);
+}
+
+FOSSIL_TEST(c_math_test_calc_root_toms748) {
+    fossil_math_calc_root_info_t info;
+    double root = fossil_math_calc_root_toms748(test_func_root, 0.0, 2.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-10);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_TRUE(info.evaluations < 20);
+
+    root = fossil_math_calc_root_toms748(test_func_cos_minus_x, 1.0, 0.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, 0.7390851332151607, 1e-10);
+}
+
+FOSSIL_TEST(c_math_test_calc_root_bracket_invalid) {
+    fossil_math_calc_root_info_t info;
+    ASSUME_ITS_TRUE(isnan(fossil_math_calc_root_brent(test_func_root, 2.0, 3.0, 1e-12, 100, &info)));
+    ASSUME_ITS_TRUE(!info.converged);
+    ASSUME_ITS_TRUE(isnan(fossil_math_calc_root_toms748(test_func_root, 2.0, 3.0, 1e-12, 100, &info)));
+    ASSUME_ITS_TRUE(!info.converged);
+}
+
+// ==========================================================
+// Batched Root Finding Test Cases
+// ==========================================================
+
+// Item i solves x^2 - (i + 1) = 0
+static void test_func_batch_sqr(const size_t* index, const double* x, double* fx, size_t count, void* ctx) {
+    (void)ctx;
+    for (size_t k = 0; k < count; ++k) fx[k] = x[k] * x[k] - (double)(index[k] + 1);
+}
+
+static void test_func_batch_sqr_fdf(const size_t* index, const double* x, double* fx, double* dfx, size_t count, void* ctx) {
+    (void)ctx;
+    for (size_t k = 0; k < count; ++k) {
+        fx[k] = x[k] * x[k] - (double)(index[k] + 1);
+        dfx[k] = 2.0 * x[k];
+    }
+}
+
+FOSSIL_TEST(c_math_test_calc_root_brent_batch) {
+    enum { N = 1000 };
+    static double a[N], b[N], roots[N];
+    static int flags[N];
+    for (size_t i = 0; i < N; ++i) { a[i] = 0.0; b[i] = (double)i + 2.0; }
+    b[7] = 0.5; // invalid bracket for item 7
+
+    fossil_math_parallel_set_threads(4);
+    size_t ok = fossil_math_calc_root_brent_batch(test_func_batch_sqr, NULL, a, b, roots, N, 1e-12, 100, flags);
+    fossil_math_parallel_set_threads(0);
+
+    ASSUME_ITS_TRUE(ok == N - 1);
+    ASSUME_ITS_TRUE(flags[7] == 0 && isnan(roots[7]));
+    ASSUME_ITS_EQUAL_F64(roots[0], 1.0, 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[1], sqrt(2.0), 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[N - 1], sqrt((double)N), 1e-10);
+}
+
+FOSSIL_TEST(c_math_test_calc_root_newton_batch) {
+    enum { N = 600 };
+    static double x0[N], roots[N];
+    for (size_t i = 0; i < N; ++i) x0[i] = 1.0;
+
+    size_t ok = fossil_math_calc_root_newton_batch(test_func_batch_sqr_fdf, NULL, x0, roots, N, 1e-12, 100, NULL);
+    ASSUME_ITS_TRUE(ok == N);
+    ASSUME_ITS_EQUAL_F64(roots[2], sqrt(3.0), 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[N - 1], sqrt((double)N), 1e-10);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -143,6 +222,11 @@ FOSSIL_TEST_GROUP(c_calc_tests) {
     FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_limit);
     FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_newton);
     FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_bisection);
+    FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_brent);
+    FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_toms748);
+    FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_bracket_invalid);
+    FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_brent_batch);
+    FOSSIL_ADD_TEST(c_calc_fixture, c_math_test_calc_root_newton_batch);
 
     FOSSIL_ADD_SUITE(c_calc_fixture);
 } // end of tests
@@ -130,6 +130,76 @@ FOSSIL_TEST(cpp_math_test_calc_root_bisection) {
     ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-6);
 }
 
+static double test_funcpp_cos_minus_x(double x) { return cos(x) - x; }
+
+FOSSIL_TEST(cpp_math_test_calc_root_brent) {
+    fossil_math_calc_root_info_t info;
+    double root = fossil::math::Calc::root_brent(test_funcpp_root, 0.0, 2.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-10);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_TRUE(info.evaluations < 20);
+
+    root = fossil::math::Calc::root_brent(test_funcpp_cos_minus_x, 0.0, 1.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, 0.7390851332151607, 1e-10);
+}
+
+FOSSIL_TEST(cpp_math_test_calc_root_toms748) {
+    fossil_math_calc_root_info_t info;
+    double root = fossil::math::Calc::root_toms748(test_funcpp_root, 0.0, 2.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, sqrt(2.0), 1e-10);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_TRUE(info.evaluations < 20);
+
+    root = fossil::math::Calc::root_toms748(test_funcpp_cos_minus_x, 1.0, 0.0, 1e-12, 100, &info);
+    ASSUME_ITS_EQUAL_F64(root, 0.7390851332151607, 1e-10);
+}
+
+FOSSIL_TEST(cpp_math_test_calc_root_bracket_invalid) {
+    fossil_math_calc_root_info_t info;
+    ASSUME_ITS_TRUE(isnan(fossil::math::Calc::root_brent(test_funcpp_root, 2.0, 3.0, 1e-12, 100, &info)));
+    ASSUME_ITS_TRUE(!info.converged);
+    ASSUME_ITS_TRUE(isnan(fossil::math::Calc::root_toms748(test_funcpp_root, 2.0, 3.0, 1e-12, 100, &info)));
+    ASSUME_ITS_TRUE(!info.converged);
+}
+
+// ==========================================================
+// Batched Root Finding Test Cases
+// ==========================================================
+
+// Item i solves x^2 - (i + 1) = 0
+static void test_funcpp_batch_sqr(const size_t* index, const double* x, double* fx, size_t count, void* ctx) {
+    (void)ctx;
+    for (size_t k = 0; k < count; ++k) fx[k] = x[k] * x[k] - (double)(index[k] + 1);
+}
+
+static void test_funcpp_batch_sqr_fdf(const size_t* index, const double* x, double* fx, double* dfx, size_t count, void* ctx) {
+    (void)ctx;
+    for (size_t k = 0; k < count; ++k) {
+        fx[k] = x[k] * x[k] - (double)(index[k] + 1);
+        dfx[k] = 2.0 * x[k];
+    }
+}
+
+FOSSIL_TEST(cpp_math_test_calc_root_brent_batch) {
+    std::vector<double> a(1000, 0.0), b(1000);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = (double)i + 2.0;
+
+    fossil::math::Parallel::set_threads(4);
+    std::vector<double> roots = fossil::math::Calc::root_brent_batch(test_funcpp_batch_sqr, nullptr, a, b, 1e-12, 100);
+    fossil::math::Parallel::set_threads(0);
+
+    ASSUME_ITS_EQUAL_F64(roots[0], 1.0, 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[1], sqrt(2.0), 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[999], sqrt(1000.0), 1e-10);
+}
+
+FOSSIL_TEST(cpp_math_test_calc_root_newton_batch) {
+    std::vector<double> x0(600, 1.0);
+    std::vector<double> roots = fossil::math::Calc::root_newton_batch(test_funcpp_batch_sqr_fdf, nullptr, x0, 1e-12, 100);
+    ASSUME_ITS_EQUAL_F64(roots[2], sqrt(3.0), 1e-10);
+    ASSUME_ITS_EQUAL_F64(roots[599], sqrt(600.0), 1e-10);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -142,6 +212,11 @@ FOSSIL_TEST_GROUP(cpp_calc_tests) {
     FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_limit);
     FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_newton);
     FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_bisection);
+    FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_brent);
+    FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_toms748);
+    FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_bracket_invalid);
+    FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_brent_batch);
+    FOSSIL_ADD_TEST(cpp_calc_fixture, cpp_math_test_calc_root_newton_batch);
 
     FOSSIL_ADD_SUITE(cpp_calc_fixture);
 } // end of tests
@@ -0,0 +1,132 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_cheb_fixture);
+
+FOSSIL_SETUP(c_cheb_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_cheb_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static double c_cheb_neg_cos(const double x) { return -cos(x); }
+static double c_cheb_square(const double x) { return (x - 0.5) * (x - 0.5); }
+
+FOSSIL_TEST(c_math_test_cheb_accuracy) {
+    fossil_math_cheb_t* p = fossil_math_cheb_create(exp, -1.0, 2.0, 0.0, 0);
+    ASSUME_ITS_TRUE(p != NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_degree(p) < 32);
+    for (int i = 0; i <= 30; ++i) {
+        double x = -1.0 + 0.1 * i;
+        ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(p, x), exp(x), 1e-13);
+    }
+    fossil_math_cheb_free(p);
+}
+
+FOSSIL_TEST(c_math_test_cheb_batch) {
+    fossil_math_cheb_t* p = fossil_math_cheb_create(sin, 0.0, 10.0, 0.0, 0);
+    ASSUME_ITS_TRUE(p != NULL);
+    double x[150], y[150];
+    for (int i = 0; i < 150; ++i) x[i] = 10.0 * i / 149.0;
+    fossil_math_cheb_eval_batch(p, x, y, 150);
+    for (int i = 0; i < 150; ++i) {
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_cheb_eval(p, x[i]), 1e-14);
+        ASSUME_ITS_EQUAL_F64(y[i], sin(x[i]), 1e-12);
+    }
+    fossil_math_cheb_free(p);
+}
+
+FOSSIL_TEST(c_math_test_cheb_calculus) {
+    fossil_math_cheb_t* p = fossil_math_cheb_create(sin, 0.0, 3.0, 0.0, 0);
+    fossil_math_cheb_t* d = fossil_math_cheb_derivative(p);
+    fossil_math_cheb_t* q = fossil_math_cheb_integral(p);
+    ASSUME_ITS_TRUE(p && d && q);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(d, 1.2), cos(1.2), 1e-11);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(q, 0.0), 0.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(q, 2.0), 1.0 - cos(2.0), 1e-13);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_integrate(p), 1.0 - cos(3.0), 1e-13);
+    fossil_math_cheb_free(p);
+    fossil_math_cheb_free(d);
+    fossil_math_cheb_free(q);
+}
+
+FOSSIL_TEST(c_math_test_cheb_roots) {
+    fossil_math_cheb_t* p = fossil_math_cheb_create(c_cheb_neg_cos, 0.0, 10.0, 0.0, 0);
+    double r[8];
+    ASSUME_ITS_TRUE(fossil_math_cheb_roots(p, r, 8) == 3);
+    for (int k = 0; k < 3; ++k) ASSUME_ITS_EQUAL_F64(r[k], FOSSIL_MATH_PI / 2.0 + k * FOSSIL_MATH_PI, 1e-12);
+    fossil_math_cheb_free(p);
+
+    p = fossil_math_cheb_create(c_cheb_square, 0.0, 1.0, 0.0, 0);
+    ASSUME_ITS_TRUE(fossil_math_cheb_degree(p) == 2);
+    ASSUME_ITS_TRUE(fossil_math_cheb_roots(p, r, 8) == 1);
+    ASSUME_ITS_EQUAL_F64(r[0], 0.5, 1e-7);
+    fossil_math_cheb_free(p);
+}
+
+FOSSIL_TEST(c_math_test_cheb_from_coeffs) {
+    // T_0 + 2 T_1 + 3 T_2 on [0, 2]: at x = 2, u = 1
+    const double c[] = {1.0, 2.0, 3.0};
+    fossil_math_cheb_t* p = fossil_math_cheb_from_coeffs(c, 3, 0.0, 2.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(p, 2.0), 6.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(p, 1.0), -2.0, 1e-15);
+    fossil_math_cheb_free(p);
+    ASSUME_ITS_TRUE(fossil_math_cheb_from_coeffs(c, 0, 0.0, 1.0) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_create(exp, 1.0, 1.0, 0.0, 0) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_create(fabs, -1.0, 1.0, 0.0, 64) == NULL);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_cheb_tests) {
+    FOSSIL_ADD_TEST(c_cheb_fixture, c_math_test_cheb_accuracy);
+    FOSSIL_ADD_TEST(c_cheb_fixture, c_math_test_cheb_batch);
+    FOSSIL_ADD_TEST(c_cheb_fixture, c_math_test_cheb_calculus);
+    FOSSIL_ADD_TEST(c_cheb_fixture, c_math_test_cheb_roots);
+    FOSSIL_ADD_TEST(c_cheb_fixture, c_math_test_cheb_from_coeffs);
+
+    FOSSIL_ADD_SUITE(c_cheb_fixture);
+} // end of tests
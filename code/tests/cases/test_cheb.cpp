@@ -0,0 +1,94 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_cheb_fixture);
+
+FOSSIL_SETUP(cpp_cheb_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_cheb_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <cmath>
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_cheb_approx) {
+    fossil::math::Cheb p(std::exp, 0.0, 1.0);
+    ASSUME_ITS_EQUAL_F64(p(0.3), std::exp(0.3), 1e-13);
+    std::vector<double> y = p.eval_batch({0.0, 0.5, 1.0});
+    ASSUME_ITS_EQUAL_F64(y[1], std::exp(0.5), 1e-13);
+    ASSUME_ITS_EQUAL_F64(p.integrate(), std::exp(1.0) - 1.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(p.derivative()(0.7), std::exp(0.7), 1e-12);
+    ASSUME_ITS_EQUAL_F64(p.integral()(1.0), std::exp(1.0) - 1.0, 1e-14);
+}
+
+FOSSIL_TEST(cpp_math_test_cheb_roots) {
+    fossil::math::Cheb p(std::sin, 1.0, 7.0);
+    std::vector<double> r = p.roots();
+    ASSUME_ITS_TRUE(r.size() == 2);
+    ASSUME_ITS_EQUAL_F64(r[0], FOSSIL_MATH_PI, 1e-12);
+    ASSUME_ITS_EQUAL_F64(r[1], 2.0 * FOSSIL_MATH_PI, 1e-12);
+}
+
+FOSSIL_TEST(cpp_math_test_cheb_invalid) {
+    bool thrown = false;
+    try {
+        fossil::math::Cheb p(std::exp, 2.0, 1.0);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_cheb_tests) {
+    FOSSIL_ADD_TEST(cpp_cheb_fixture, cpp_math_test_cheb_approx);
+    FOSSIL_ADD_TEST(cpp_cheb_fixture, cpp_math_test_cheb_roots);
+    FOSSIL_ADD_TEST(cpp_cheb_fixture, cpp_math_test_cheb_invalid);
+
+    FOSSIL_ADD_SUITE(cpp_cheb_fixture);
+} // end of tests
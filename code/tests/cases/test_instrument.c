@@ -0,0 +1,261 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_instrument_fixture);
+
+FOSSIL_SETUP(c_instrument_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_instrument_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static void test_instrument_square(size_t begin, size_t end, void* ctx) {
+    fossil_math_tensor_t* const* t = (fossil_math_tensor_t* const*)ctx;
+    for (size_t i = begin; i < end; ++i) fossil_math_tensor_free(fossil_math_tensor_mul(t[0], t[0]));
+}
+
+FOSSIL_TEST(c_math_test_instrument_snapshot) {
+    fossil_math_instrument_counter_t before[FOSSIL_MATH_KERNEL_COUNT], after[FOSSIL_MATH_KERNEL_COUNT];
+    ASSUME_ITS_TRUE(fossil_math_instrument_snapshot(before, FOSSIL_MATH_KERNEL_COUNT) == FOSSIL_MATH_KERNEL_COUNT);
+    ASSUME_ITS_TRUE(strcmp(before[FOSSIL_MATH_KERNEL_TENSOR_DOT].name, "tensor_dot") == 0);
+
+    size_t shape[2] = {4, 4};
+    fossil_math_tensor_t* a = fossil_math_tensor_create(shape, 2);
+    fossil_math_tensor_fill(a, 1.0);
+    fossil_math_tensor_t* c = fossil_math_tensor_dot(a, a);
+    fossil_math_instrument_snapshot(after, FOSSIL_MATH_KERNEL_COUNT);
+
+    const fossil_math_instrument_counter_t* dot0 = &before[FOSSIL_MATH_KERNEL_TENSOR_DOT];
+    const fossil_math_instrument_counter_t* dot1 = &after[FOSSIL_MATH_KERNEL_TENSOR_DOT];
+    const fossil_math_instrument_counter_t* create0 = &before[FOSSIL_MATH_KERNEL_TENSOR_CREATE];
+    const fossil_math_instrument_counter_t* create1 = &after[FOSSIL_MATH_KERNEL_TENSOR_CREATE];
+    if (fossil_math_instrument_enabled()) {
+        ASSUME_ITS_TRUE(dot1->calls == dot0->calls + 1 && dot1->flops == dot0->flops + 128);
+        // The input and the result
+        ASSUME_ITS_TRUE(create1->calls == create0->calls + 2);
+        ASSUME_ITS_TRUE(create1->bytes >= create0->bytes + 2 * 16 * sizeof(double));
+    } else {
+        ASSUME_ITS_TRUE(dot1->calls == 0 && create1->bytes == 0);
+    }
+    fossil_math_tensor_free(a);
+    fossil_math_tensor_free(c);
+}
+
+FOSSIL_TEST(c_math_test_instrument_threads) {
+    size_t shape[1] = {8};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 1);
+    fossil_math_instrument_reset();
+    // Worker threads are created and joined once per call; every call must be counted
+    fossil_math_parallel_set_threads(4);
+    for (int round = 0; round < 5; ++round) fossil_math_parallel_for(400, 10, test_instrument_square, &t);
+    fossil_math_parallel_set_threads(0);
+    fossil_math_instrument_counter_t counters[FOSSIL_MATH_KERNEL_COUNT];
+    fossil_math_instrument_snapshot(counters, FOSSIL_MATH_KERNEL_COUNT);
+    uint64_t expected = fossil_math_instrument_enabled() ? 2000 : 0;
+    ASSUME_ITS_TRUE(counters[FOSSIL_MATH_KERNEL_TENSOR_MUL].calls == expected);
+    ASSUME_ITS_TRUE(counters[FOSSIL_MATH_KERNEL_TENSOR_MUL].flops == 8 * expected);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_instrument_prometheus) {
+    size_t n = fossil_math_instrument_prometheus(NULL, 0);
+    char* text = malloc(n + 1);
+    ASSUME_ITS_TRUE(text && fossil_math_instrument_prometheus(text, n + 1) == n && strlen(text) == n);
+    ASSUME_ITS_TRUE(strstr(text, "# TYPE fossil_math_kernel_calls_total counter\n") != NULL);
+    ASSUME_ITS_TRUE(strstr(text, "fossil_math_kernel_flops_total{kernel=\"sym_eval_batch\"} ") != NULL);
+    // Truncation keeps the result terminated
+    char small[16];
+    ASSUME_ITS_TRUE(fossil_math_instrument_prometheus(small, sizeof(small)) == n && strlen(small) == sizeof(small) - 1);
+    free(text);
+}
+
+static size_t test_instrument_count(const char* text, const char* needle) {
+    size_t n = 0;
+    for (const char* p = strstr(text, needle); p; p = strstr(p + 1, needle)) ++n;
+    return n;
+}
+
+static char* test_instrument_trace(void) {
+    size_t n = fossil_math_trace_json(NULL, 0);
+    char* text = malloc(n + 1);
+    if (text && fossil_math_trace_json(text, n + 1) != n) {
+        free(text);
+        return NULL;
+    }
+    return text;
+}
+
+FOSSIL_TEST(c_math_test_instrument_trace) {
+    size_t shape[2] = {4, 3};
+    fossil_math_tensor_t* a = fossil_math_tensor_create(shape, 2);
+    fossil_math_tensor_t* b = fossil_math_tensor_create((size_t[]){3, 5}, 2);
+    ASSUME_ITS_TRUE(fossil_math_trace_start(0) == 0);
+    fossil_math_tensor_t* c = fossil_math_tensor_dot(a, b);
+    fossil_math_parallel_set_threads(4);
+    fossil_math_parallel_for(400, 10, test_instrument_square, &a);
+    fossil_math_parallel_set_threads(0);
+    fossil_math_trace_stop();
+    // Nothing is recorded once stopped
+    fossil_math_tensor_free(fossil_math_tensor_dot(a, b));
+
+    char* text = test_instrument_trace();
+    ASSUME_ITS_TRUE(text != NULL);
+    ASSUME_ITS_TRUE(strncmp(text, "{\"traceEvents\":[", 16) == 0);
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"name\":\"tensor_dot\",\"cat\":\"tensor\",\"ph\":\"X\"") == 1);
+    ASSUME_ITS_TRUE(strstr(text, "\"args\":{\"dims\":[4,3,5]}") != NULL);
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"name\":\"tensor_mul\"") == 400);
+    // Chunks run on the caller and on workers; an exited worker may hand its lane to the next
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"name\":\"parallel_chunk\"") == 4);
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"thread_name\"") >= 2);
+    ASSUME_ITS_TRUE(strstr(text, "\"otherData\":{\"dropped_events\":0}") != NULL);
+    free(text);
+    fossil_math_tensor_free(a);
+    fossil_math_tensor_free(b);
+    fossil_math_tensor_free(c);
+}
+
+FOSSIL_TEST(c_math_test_instrument_trace_dropped) {
+    size_t shape[1] = {8};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 1);
+    ASSUME_ITS_TRUE(fossil_math_trace_start(4) == 0);
+    // Each call records the add and the create of its result
+    for (int i = 0; i < 10; ++i) fossil_math_tensor_free(fossil_math_tensor_add(t, t));
+    fossil_math_trace_stop();
+
+    char* text = test_instrument_trace();
+    ASSUME_ITS_TRUE(text != NULL);
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"ph\":\"X\"") == 4);
+    ASSUME_ITS_TRUE(strstr(text, "\"dropped_events\":16}") != NULL);
+    // A new session discards the previous events
+    ASSUME_ITS_TRUE(fossil_math_trace_start(0) == 0);
+    fossil_math_trace_stop();
+    free(text);
+    text = test_instrument_trace();
+    ASSUME_ITS_TRUE(text && test_instrument_count(text, "\"ph\":\"X\"") == 0);
+    ASSUME_ITS_TRUE(fossil_math_trace_write(NULL) == -1);
+    free(text);
+    fossil_math_tensor_free(t);
+}
+
+// Chunk 0 toggles sessions while the other chunk keeps running kernels
+static void test_instrument_toggle(size_t begin, size_t end, void* ctx) {
+    fossil_math_tensor_t* const* t = (fossil_math_tensor_t* const*)ctx;
+    (void)end;
+    if (begin == 0) {
+        for (int i = 0; i < 50; ++i) {
+            fossil_math_trace_start(0);
+            fossil_math_trace_stop();
+        }
+        fossil_math_trace_start(0);
+    } else {
+        for (int i = 0; i < 2000; ++i) fossil_math_tensor_free(fossil_math_tensor_add(t[0], t[0]));
+    }
+}
+
+FOSSIL_TEST(c_math_test_instrument_trace_concurrent) {
+    size_t shape[1] = {8};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 1);
+    fossil_math_parallel_set_threads(2);
+    fossil_math_parallel_for(2, 1, test_instrument_toggle, &t);
+    fossil_math_parallel_set_threads(0);
+    ASSUME_ITS_TRUE(fossil_math_trace_active());
+    fossil_math_trace_stop();
+    ASSUME_ITS_TRUE(!fossil_math_trace_active());
+
+    // Export once every kernel has returned
+    char* text = test_instrument_trace();
+    ASSUME_ITS_TRUE(text && strncmp(text, "{\"traceEvents\":[", 16) == 0);
+    ASSUME_ITS_TRUE(test_instrument_count(text, "\"name\":\"tensor_add\"") <= 2000);
+    ASSUME_ITS_TRUE(strstr(text, "\"dropped_events\":0}") != NULL);
+    free(text);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_instrument_rejected_calls) {
+    fossil_math_instrument_counter_t before[FOSSIL_MATH_KERNEL_COUNT], after[FOSSIL_MATH_KERNEL_COUNT];
+    size_t shape[2] = {2, 3};
+    fossil_math_tensor_t* v = fossil_math_tensor_create(shape, 1);
+    fossil_math_tensor_t* m = fossil_math_tensor_create(shape, 2);
+    double A[4] = {1.0, 2.0, 2.0, 4.0}, b[2] = {1.0, 1.0}, x[2];
+    fossil_math_instrument_snapshot(before, FOSSIL_MATH_KERNEL_COUNT);
+
+    // Rejected arguments, an unsupported shape and a singular system
+    ASSUME_ITS_TRUE(fossil_math_tensor_create(NULL, 0) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_tensor_dot(v, m) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_tensor_add(v, m) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_algebra_solve_linear_system(A, b, x, 2) == -3);
+    ASSUME_ITS_TRUE(fossil_math_sym_compile(NULL, NULL, 0) == NULL);
+    fossil_math_instrument_snapshot(after, FOSSIL_MATH_KERNEL_COUNT);
+
+    static const fossil_math_kernel_t kernels[] = {
+        FOSSIL_MATH_KERNEL_TENSOR_CREATE, FOSSIL_MATH_KERNEL_TENSOR_DOT, FOSSIL_MATH_KERNEL_TENSOR_ADD,
+        FOSSIL_MATH_KERNEL_ALGEBRA_SOLVE_LINEAR_SYSTEM, FOSSIL_MATH_KERNEL_SYM_COMPILE
+    };
+    uint64_t expected = fossil_math_instrument_enabled() ? 1 : 0;
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); ++i) {
+        const fossil_math_instrument_counter_t* c0 = &before[kernels[i]];
+        const fossil_math_instrument_counter_t* c1 = &after[kernels[i]];
+        ASSUME_ITS_TRUE(c1->calls == c0->calls + expected);
+        // Calls that did no work add no flops
+        ASSUME_ITS_TRUE(c1->flops == c0->flops);
+    }
+    fossil_math_tensor_free(v);
+    fossil_math_tensor_free(m);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_instrument_tests) {
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_snapshot);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_threads);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_prometheus);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_trace);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_trace_dropped);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_trace_concurrent);
+    FOSSIL_ADD_TEST(c_instrument_fixture, c_math_test_instrument_rejected_calls);
+
+    FOSSIL_ADD_SUITE(c_instrument_fixture);
+} // end of tests
@@ -0,0 +1,97 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_instrument_fixture);
+
+FOSSIL_SETUP(cpp_instrument_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_instrument_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <string>
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_instrument) {
+    fossil::math::Instrument::reset();
+    std::vector<double> A = {1.0, 2.0, 3.0, 4.0}, B = {1.0, 0.0, 0.0, 1.0}, C(4);
+    fossil_math_algebra_matrix_mul(A.data(), 2, 2, B.data(), 2, 2, C.data());
+    std::vector<fossil_math_instrument_counter_t> counters = fossil::math::Instrument::snapshot();
+    ASSUME_ITS_TRUE(counters.size() == FOSSIL_MATH_KERNEL_COUNT);
+    const fossil_math_instrument_counter_t& mul = counters[FOSSIL_MATH_KERNEL_ALGEBRA_MATRIX_MUL];
+    ASSUME_ITS_TRUE(std::string(mul.name) == "algebra_matrix_mul");
+    ASSUME_ITS_TRUE(mul.calls == (fossil::math::Instrument::enabled() ? 1u : 0u));
+    std::string text = fossil::math::Instrument::prometheus();
+    ASSUME_ITS_TRUE(text.find("fossil_math_kernel_calls_total{kernel=\"algebra_matrix_mul\"} ") != std::string::npos);
+    ASSUME_ITS_TRUE(text.size() == fossil_math_instrument_prometheus(nullptr, 0));
+}
+
+FOSSIL_TEST(cpp_math_test_trace) {
+    fossil::math::Trace::start();
+    std::vector<double> A = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, B = {1.0, 0.0, 0.0, 1.0}, C(6);
+    fossil_math_algebra_matrix_mul(A.data(), 3, 2, B.data(), 2, 2, C.data());
+    fossil::math::Trace::stop();
+    std::string text = fossil::math::Trace::json();
+    ASSUME_ITS_TRUE(text.size() == fossil_math_trace_json(nullptr, 0));
+    ASSUME_ITS_TRUE(text.find("\"name\":\"algebra_matrix_mul\",\"cat\":\"algebra\"") != std::string::npos);
+    ASSUME_ITS_TRUE(text.find("\"dims\":[3,2,2]") != std::string::npos);
+    bool threw = false;
+    try {
+        fossil::math::Trace::write("");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_instrument_tests) {
+    FOSSIL_ADD_TEST(cpp_instrument_fixture, cpp_math_test_instrument);
+    FOSSIL_ADD_TEST(cpp_instrument_fixture, cpp_math_test_trace);
+
+    FOSSIL_ADD_SUITE(cpp_instrument_fixture);
+} // end of tests
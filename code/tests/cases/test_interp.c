@@ -0,0 +1,314 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_interp_fixture);
+
+FOSSIL_SETUP(c_interp_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_interp_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static double test_cubic(double x) {
+    return x * x * x - 2.0 * x + 1.0;
+}
+
+FOSSIL_TEST(c_math_test_interp_linear) {
+    double x[] = {0.0, 1.0, 3.0};
+    double y[] = {0.0, 2.0, 0.0};
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_LINEAR, x, y, 3, 0.0, 0.0);
+    ASSUME_ITS_TRUE(p != NULL);
+    ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, 0.5), 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, 2.0), 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, 3.0), 0.0, FOSSIL_TEST_FLOAT_EPSILON);
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_cubic_natural) {
+    enum { N = 21 };
+    double x[N], y[N];
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = FOSSIL_MATH_PI * (double)i / (N - 1);
+        y[i] = sin(x[i]);
+    }
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_CUBIC_NATURAL, x, y, N, 0.0, 0.0);
+    ASSUME_ITS_TRUE(p != NULL);
+    for (double t = 0.05; t < 3.1; t += 0.1) ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, t), sin(t), 1e-4);
+    ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, x[7]), y[7], 1e-12);
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_cubic_clamped_exact) {
+    // A clamped spline reproduces cubics exactly, also on an uneven grid
+    double x[] = {-2.0, -1.5, 0.0, 0.3, 1.0, 2.5};
+    double y[6];
+    for (size_t i = 0; i < 6; ++i) y[i] = test_cubic(x[i]);
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_CUBIC_CLAMPED, x, y, 6, 10.0, 16.75);
+    ASSUME_ITS_TRUE(p != NULL);
+    for (double t = -2.0; t <= 2.5; t += 0.37) {
+        ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, t), test_cubic(t), 1e-10);
+        ASSUME_ITS_EQUAL_F64(fossil_math_interp_deriv(p, t), 3.0 * t * t - 2.0, 1e-9);
+    }
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_pchip_monotone) {
+    double x[] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    double y[] = {0.0, 0.0, 0.1, 5.0, 5.0, 5.1};
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_PCHIP, x, y, 6, 0.0, 0.0);
+    ASSUME_ITS_TRUE(p != NULL);
+    double prev = fossil_math_interp_eval(p, 0.0);
+    for (double t = 0.01; t <= 5.0; t += 0.01) {
+        double v = fossil_math_interp_eval(p, t);
+        ASSUME_ITS_TRUE(v >= prev - 1e-12);
+        ASSUME_ITS_TRUE(v >= 0.0 && v <= 5.1 + 1e-12);
+        prev = v;
+    }
+    ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, 3.0), 5.0, 1e-12);
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_bspline_exact) {
+    // Not-a-knot B-splines reproduce polynomials up to their degree
+    enum { N = 12 };
+    double x[N], y2[N], y5[N];
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = (double)i + 0.1 * (double)(i % 3);
+        y2[i] = 1.0 - 3.0 * x[i] + 0.5 * x[i] * x[i];
+        y5[i] = pow(x[i] - 5.0, 5.0) / 1000.0;
+    }
+    fossil_math_interp_t* q = fossil_math_interp_create_bspline(x, y2, N, 2);
+    fossil_math_interp_t* p = fossil_math_interp_create_bspline(x, y5, N, 5);
+    ASSUME_ITS_TRUE(p != NULL && q != NULL);
+    for (double t = 0.0; t <= x[N - 1]; t += 0.23) {
+        ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(q, t), 1.0 - 3.0 * t + 0.5 * t * t, 1e-9);
+        ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval(p, t), pow(t - 5.0, 5.0) / 1000.0, 1e-8);
+    }
+    fossil_math_interp_free(p);
+    fossil_math_interp_free(q);
+}
+
+FOSSIL_TEST(c_math_test_interp_hint_and_batch) {
+    enum { N = 50, Q = 1000 };
+    double x[N], y[N], xq[Q], yq[Q];
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = (double)i * (double)i / 10.0; // non-uniform
+        y[i] = sqrt(x[i]);
+    }
+    for (size_t j = 0; j < Q; ++j) xq[j] = x[N - 1] * (double)j / (Q - 1);
+
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_PCHIP, x, y, N, 0.0, 0.0);
+    ASSUME_ITS_TRUE(p != NULL);
+    fossil_math_interp_eval_batch(p, xq, yq, Q);
+    size_t hint = 0;
+    for (size_t j = 0; j < Q; ++j) {
+        double v = fossil_math_interp_eval(p, xq[j]);
+        ASSUME_ITS_EQUAL_F64(fossil_math_interp_eval_hint(p, xq[j], &hint), v, 1e-15);
+        ASSUME_ITS_EQUAL_F64(yq[j], v, 1e-15);
+    }
+    ASSUME_ITS_TRUE(hint == N - 2);
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_uniform_batch) {
+    enum { N = 101, Q = 777 };
+    double x[N], y[N], xq[Q], yq[Q];
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = -1.0 + 0.02 * (double)i;
+        y[i] = exp(x[i]);
+    }
+    // Includes points outside the table, which extrapolate the end pieces
+    for (size_t j = 0; j < Q; ++j) xq[j] = -1.1 + 2.2 * (double)((j * 37) % Q) / (Q - 1);
+
+    fossil_math_interp_t* p = fossil_math_interp_create(FOSSIL_MATH_INTERP_CUBIC_NATURAL, x, y, N, 0.0, 0.0);
+    ASSUME_ITS_TRUE(p != NULL);
+    fossil_math_interp_eval_batch(p, xq, yq, Q);
+    for (size_t j = 0; j < Q; ++j) {
+        ASSUME_ITS_EQUAL_F64(yq[j], fossil_math_interp_eval(p, xq[j]), 1e-14);
+        if (fabs(xq[j]) <= 0.9) ASSUME_ITS_EQUAL_F64(yq[j], exp(xq[j]), 1e-7);
+    }
+    fossil_math_interp_free(p);
+}
+
+FOSSIL_TEST(c_math_test_interp_invalid) {
+    double x[] = {0.0, 1.0, 1.0};
+    double y[] = {0.0, 1.0, 2.0};
+    ASSUME_ITS_TRUE(fossil_math_interp_create(FOSSIL_MATH_INTERP_LINEAR, x, y, 3, 0.0, 0.0) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_interp_create(FOSSIL_MATH_INTERP_LINEAR, x, y, 1, 0.0, 0.0) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_interp_create_bspline(x, y, 2, 3) == NULL);
+    ASSUME_ITS_TRUE(isnan(fossil_math_interp_eval(NULL, 0.5)));
+}
+
+static fossil_math_tensor_t* test_linear_table(const size_t* shape, size_t dims, const double* lo, const double* hi) {
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, dims);
+    size_t idx[3] = {0, 0, 0};
+    size_t total = 1;
+    for (size_t d = 0; d < dims; ++d) total *= shape[d];
+    for (size_t k = 0; k < total; ++k) {
+        size_t rem = k;
+        double v = 1.0;
+        for (size_t d = dims; d-- > 0;) {
+            idx[d] = rem % shape[d];
+            rem /= shape[d];
+            double x = lo[d] + (hi[d] - lo[d]) * (double)idx[d] / (double)(shape[d] - 1);
+            v += (double)(d + 2) * x;
+        }
+        fossil_math_tensor_set(t, idx, v);
+    }
+    return t;
+}
+
+FOSSIL_TEST(c_math_test_grid_bilinear_exact) {
+    size_t shape[2] = {5, 9};
+    double lo[2] = {0.0, -1.0}, hi[2] = {1.0, 1.0};
+    fossil_math_tensor_t* t = test_linear_table(shape, 2, lo, hi);
+    fossil_math_grid_t* lin = fossil_math_grid_create(t, lo, hi, FOSSIL_MATH_GRID_LINEAR, FOSSIL_MATH_GRID_EXTRAPOLATE);
+    fossil_math_grid_t* cub = fossil_math_grid_create(t, lo, hi, FOSSIL_MATH_GRID_CUBIC, FOSSIL_MATH_GRID_EXTRAPOLATE);
+    ASSUME_ITS_TRUE(lin != NULL && cub != NULL);
+    ASSUME_ITS_TRUE(fossil_math_grid_dims(lin) == 2);
+    // Linear data is reproduced inside and outside the grid
+    for (double x = -0.3; x <= 1.3; x += 0.17) {
+        for (double y = -1.4; y <= 1.4; y += 0.23) {
+            double p[2] = {x, y};
+            double expect = 1.0 + 2.0 * x + 3.0 * y;
+            ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(lin, p), expect, 1e-12);
+            ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(cub, p), expect, 1e-12);
+        }
+    }
+    fossil_math_grid_free(lin);
+    fossil_math_grid_free(cub);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_grid_tricubic_smooth) {
+    enum { N = 17 };
+    size_t shape[3] = {N, N, N};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 3);
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+            for (size_t k = 0; k < N; ++k) {
+                size_t idx[3] = {i, j, k};
+                double x = (double)i / (N - 1), y = (double)j / (N - 1), z = (double)k / (N - 1);
+                fossil_math_tensor_set(t, idx, sin(x) * cos(y) + z * z);
+            }
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {1.0, 1.0, 1.0};
+    fossil_math_grid_t* cub = fossil_math_grid_create(t, lo, hi, FOSSIL_MATH_GRID_CUBIC, FOSSIL_MATH_GRID_CLAMP);
+    fossil_math_grid_t* lin = fossil_math_grid_create(t, lo, hi, FOSSIL_MATH_GRID_LINEAR, FOSSIL_MATH_GRID_CLAMP);
+    double p[3] = {0.33, 0.71, 0.52};
+    double expect = sin(0.33) * cos(0.71) + 0.52 * 0.52;
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(cub, p), expect, 1e-5);
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(lin, p), expect, 1e-3);
+    // Clamped queries take the edge value
+    double q[3] = {2.0, 0.0, -5.0};
+    double edge[3] = {1.0, 0.0, 0.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(lin, q), fossil_math_grid_eval(lin, edge), 1e-15);
+    fossil_math_grid_free(cub);
+    fossil_math_grid_free(lin);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_grid_wrap) {
+    size_t shape[1] = {8};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 1);
+    for (size_t i = 0; i < 8; ++i) t->data[i] = (double)(i * i);
+    fossil_math_grid_t* g = fossil_math_grid_create(t, NULL, NULL, FOSSIL_MATH_GRID_LINEAR, FOSSIL_MATH_GRID_WRAP);
+    double p0[1] = {8.0}, p1[1] = {-1.0}, p2[1] = {7.5}, p3[1] = {19.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(g, p0), 0.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(g, p1), 49.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(g, p2), 24.5, 1e-12);
+    ASSUME_ITS_EQUAL_F64(fossil_math_grid_eval(g, p3), 9.0, 1e-12);
+    fossil_math_grid_free(g);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_grid_batch) {
+    enum { Q = 5000 };
+    size_t shape[3] = {6, 7, 8};
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {5.0, 6.0, 7.0};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 3);
+    for (size_t k = 0; k < 6 * 7 * 8; ++k) t->data[k] = sin((double)k);
+    fossil_math_grid_t* g = fossil_math_grid_create(t, lo, hi, FOSSIL_MATH_GRID_CUBIC, FOSSIL_MATH_GRID_WRAP);
+
+    double* pts = malloc(3 * Q * sizeof(double));
+    double* out = malloc(Q * sizeof(double));
+    for (size_t j = 0; j < 3 * Q; ++j) pts[j] = 10.0 * sin(0.37 * (double)j);
+    fossil_math_grid_eval_batch(g, pts, out, Q);
+    for (size_t j = 0; j < Q; ++j) ASSUME_ITS_EQUAL_F64(out[j], fossil_math_grid_eval(g, pts + 3 * j), 1e-15);
+
+    free(pts);
+    free(out);
+    fossil_math_grid_free(g);
+    fossil_math_tensor_free(t);
+}
+
+FOSSIL_TEST(c_math_test_grid_invalid) {
+    size_t shape[2] = {1, 4};
+    fossil_math_tensor_t* t = fossil_math_tensor_create(shape, 2);
+    ASSUME_ITS_TRUE(fossil_math_grid_create(t, NULL, NULL, FOSSIL_MATH_GRID_LINEAR, FOSSIL_MATH_GRID_CLAMP) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_grid_create(NULL, NULL, NULL, FOSSIL_MATH_GRID_LINEAR, FOSSIL_MATH_GRID_CLAMP) == NULL);
+    ASSUME_ITS_TRUE(isnan(fossil_math_grid_eval(NULL, NULL)));
+    fossil_math_tensor_free(t);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_interp_tests) {
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_linear);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_cubic_natural);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_cubic_clamped_exact);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_pchip_monotone);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_bspline_exact);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_hint_and_batch);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_uniform_batch);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_interp_invalid);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_grid_bilinear_exact);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_grid_tricubic_smooth);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_grid_wrap);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_grid_batch);
+    FOSSIL_ADD_TEST(c_interp_fixture, c_math_test_grid_invalid);
+
+    FOSSIL_ADD_SUITE(c_interp_fixture);
+} // end of tests
@@ -0,0 +1,116 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_interp_fixture);
+
+FOSSIL_SETUP(cpp_interp_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_interp_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <cmath>
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_interp_spline) {
+    std::vector<double> x{0.0, 1.0, 2.0, 3.0};
+    std::vector<double> y{0.0, 1.0, 8.0, 27.0};
+    fossil::math::Interp p(FOSSIL_MATH_INTERP_CUBIC_CLAMPED, x, y, 0.0, 27.0);
+    ASSUME_ITS_EQUAL_F64(p(1.5), 3.375, 1e-12);
+    ASSUME_ITS_EQUAL_F64(p.deriv(2.0), 12.0, 1e-12);
+}
+
+FOSSIL_TEST(cpp_math_test_interp_bspline_batch) {
+    std::vector<double> x, y;
+    for (int i = 0; i < 10; ++i) {
+        x.push_back(i);
+        y.push_back(2.0 * i * i);
+    }
+    fossil::math::Interp p = fossil::math::Interp::bspline(x, y, 3);
+    std::vector<double> v = p.eval_batch({0.5, 4.25, 8.75});
+    ASSUME_ITS_EQUAL_F64(v[0], 0.5, 1e-12);
+    ASSUME_ITS_EQUAL_F64(v[1], 36.125, 1e-12);
+    ASSUME_ITS_EQUAL_F64(v[2], 153.125, 1e-12);
+    size_t hint = 0;
+    ASSUME_ITS_EQUAL_F64(p.eval(8.75, hint), 153.125, 1e-12);
+}
+
+FOSSIL_TEST(cpp_math_test_interp_invalid) {
+    bool thrown = false;
+    try {
+        fossil::math::Interp p(FOSSIL_MATH_INTERP_PCHIP, {1.0, 0.0}, {0.0, 1.0});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+}
+
+FOSSIL_TEST(cpp_math_test_grid_bilinear) {
+    fossil_math_tensor_t* t = fossil::math::Tensor::create({2, 2});
+    fossil::math::Tensor::set(t, {0, 0}, 0.0);
+    fossil::math::Tensor::set(t, {0, 1}, 1.0);
+    fossil::math::Tensor::set(t, {1, 0}, 2.0);
+    fossil::math::Tensor::set(t, {1, 1}, 3.0);
+    {
+        fossil::math::Grid g(t, {0.0, 0.0}, {1.0, 1.0});
+        ASSUME_ITS_EQUAL_F64(g({0.5, 0.5}), 1.5, 1e-15);
+        std::vector<double> v = g.eval_batch({0.25, 0.0, 1.0, 0.75});
+        ASSUME_ITS_EQUAL_F64(v[0], 0.5, 1e-15);
+        ASSUME_ITS_EQUAL_F64(v[1], 2.75, 1e-15);
+    }
+    fossil::math::Tensor::free(t);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_interp_tests) {
+    FOSSIL_ADD_TEST(cpp_interp_fixture, cpp_math_test_interp_spline);
+    FOSSIL_ADD_TEST(cpp_interp_fixture, cpp_math_test_interp_bspline_batch);
+    FOSSIL_ADD_TEST(cpp_interp_fixture, cpp_math_test_interp_invalid);
+    FOSSIL_ADD_TEST(cpp_interp_fixture, cpp_math_test_grid_bilinear);
+
+    FOSSIL_ADD_SUITE(cpp_interp_fixture);
+} // end of tests
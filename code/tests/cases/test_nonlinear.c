@@ -0,0 +1,149 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_nonlinear_fixture);
+
+FOSSIL_SETUP(c_nonlinear_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_nonlinear_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Rosenbrock system: F(x) = [10 (x1 - x0^2), 1 - x0], root at (1, 1)
+static void test_rosenbrock(const double* x, double* fx, void* ctx) {
+    (void)ctx;
+    fx[0] = 10.0 * (x[1] - x[0] * x[0]);
+    fx[1] = 1.0 - x[0];
+}
+
+static void test_rosenbrock_jac(const double* x, double* J, void* ctx) {
+    (void)ctx;
+    J[0] = -20.0 * x[0]; J[1] = 10.0;
+    J[2] = -1.0;         J[3] = 0.0;
+}
+
+// Broyden tridiagonal problem: F_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1
+static void test_broyden_tridiag(const double* x, double* fx, void* ctx) {
+    size_t n = *(const size_t*)ctx;
+    for (size_t i = 0; i < n; ++i) {
+        double left = (i > 0) ? x[i - 1] : 0.0;
+        double right = (i + 1 < n) ? x[i + 1] : 0.0;
+        fx[i] = (3.0 - 2.0 * x[i]) * x[i] - left - 2.0 * right + 1.0;
+    }
+}
+
+// Residuals of y = a * exp(b * t) against samples generated with a = 2, b = -0.5
+static void test_exp_residuals(const double* p, double* r, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < 10; ++i) {
+        double t = 0.5 * (double)i;
+        r[i] = p[0] * exp(p[1] * t) - 2.0 * exp(-0.5 * t);
+    }
+}
+
+FOSSIL_TEST(c_math_test_nonlinear_solve_jacobian) {
+    double x[2] = {-1.2, 1.0};
+    fossil_math_nonlinear_info_t info;
+    int ret = fossil_math_nonlinear_solve(test_rosenbrock, test_rosenbrock_jac, NULL, x, 2, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-8);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-8);
+}
+
+FOSSIL_TEST(c_math_test_nonlinear_solve_broyden) {
+    enum { N = 50 };
+    size_t n = N;
+    double x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = -1.0;
+
+    fossil_math_nonlinear_info_t info;
+    int ret = fossil_math_nonlinear_solve(test_broyden_tridiag, NULL, &n, x, N, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_TRUE(info.residual_norm < 1e-9);
+    // Broyden updates reuse factorizations across iterations
+    ASSUME_ITS_TRUE(info.factorizations < info.iterations);
+}
+
+FOSSIL_TEST(c_math_test_nonlinear_solve_krylov) {
+    enum { N = 200 };
+    size_t n = N;
+    double x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = -1.0;
+
+    fossil_math_nonlinear_info_t info;
+    int ret = fossil_math_nonlinear_solve_krylov(test_broyden_tridiag, &n, x, N, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_TRUE(info.residual_norm < 1e-9);
+    ASSUME_ITS_TRUE(info.jacobian_evaluations == 0);
+}
+
+FOSSIL_TEST(c_math_test_nonlinear_least_squares) {
+    double p[2] = {1.0, 0.0};
+    fossil_math_nonlinear_info_t info;
+    int ret = fossil_math_nonlinear_least_squares(test_exp_residuals, NULL, NULL, p, 2, 10, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_EQUAL_F64(p[0], 2.0, 1e-6);
+    ASSUME_ITS_EQUAL_F64(p[1], -0.5, 1e-6);
+}
+
+FOSSIL_TEST(c_math_test_nonlinear_invalid) {
+    double x[2] = {0.0, 0.0};
+    ASSUME_ITS_TRUE(fossil_math_nonlinear_solve(NULL, NULL, NULL, x, 2, NULL, NULL) == -1);
+    ASSUME_ITS_TRUE(fossil_math_nonlinear_least_squares(test_exp_residuals, NULL, NULL, x, 2, 1, NULL, NULL) == -1);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_nonlinear_tests) {
+    FOSSIL_ADD_TEST(c_nonlinear_fixture, c_math_test_nonlinear_solve_jacobian);
+    FOSSIL_ADD_TEST(c_nonlinear_fixture, c_math_test_nonlinear_solve_broyden);
+    FOSSIL_ADD_TEST(c_nonlinear_fixture, c_math_test_nonlinear_solve_krylov);
+    FOSSIL_ADD_TEST(c_nonlinear_fixture, c_math_test_nonlinear_least_squares);
+    FOSSIL_ADD_TEST(c_nonlinear_fixture, c_math_test_nonlinear_invalid);
+
+    FOSSIL_ADD_SUITE(c_nonlinear_fixture);
+} // end of tests
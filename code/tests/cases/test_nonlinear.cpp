@@ -0,0 +1,102 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_nonlinear_fixture);
+
+FOSSIL_SETUP(cpp_nonlinear_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_nonlinear_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <cmath>
+#include <vector>
+
+// Rosenbrock system: F(x) = [10 (x1 - x0^2), 1 - x0], root at (1, 1)
+static void test_cpp_rosenbrock(const double* x, double* fx, void* ctx) {
+    (void)ctx;
+    fx[0] = 10.0 * (x[1] - x[0] * x[0]);
+    fx[1] = 1.0 - x[0];
+}
+
+// Residuals of y = a * exp(b * t) against samples generated with a = 2, b = -0.5
+static void test_cpp_exp_residuals(const double* p, double* r, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < 10; ++i) {
+        double t = 0.5 * (double)i;
+        r[i] = p[0] * std::exp(p[1] * t) - 2.0 * std::exp(-0.5 * t);
+    }
+}
+
+FOSSIL_TEST(cpp_math_test_nonlinear_solve) {
+    std::vector<double> x = fossil::math::Nonlinear::solve(test_cpp_rosenbrock, nullptr, nullptr, {-1.2, 1.0});
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-8);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-8);
+}
+
+FOSSIL_TEST(cpp_math_test_nonlinear_solve_krylov) {
+    fossil_math_nonlinear_options_t opts = fossil::math::Nonlinear::default_options();
+    opts.max_iter = 200;
+    std::vector<double> x = fossil::math::Nonlinear::solve_krylov(test_cpp_rosenbrock, nullptr, {-1.2, 1.0}, &opts);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-8);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-8);
+}
+
+FOSSIL_TEST(cpp_math_test_nonlinear_least_squares) {
+    std::vector<double> p = fossil::math::Nonlinear::least_squares(test_cpp_exp_residuals, nullptr, nullptr, {1.0, 0.0}, 10);
+    ASSUME_ITS_EQUAL_F64(p[0], 2.0, 1e-6);
+    ASSUME_ITS_EQUAL_F64(p[1], -0.5, 1e-6);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_nonlinear_tests) {
+    FOSSIL_ADD_TEST(cpp_nonlinear_fixture, cpp_math_test_nonlinear_solve);
+    FOSSIL_ADD_TEST(cpp_nonlinear_fixture, cpp_math_test_nonlinear_solve_krylov);
+    FOSSIL_ADD_TEST(cpp_nonlinear_fixture, cpp_math_test_nonlinear_least_squares);
+
+    FOSSIL_ADD_SUITE(cpp_nonlinear_fixture);
+} // end of tests
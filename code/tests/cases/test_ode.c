@@ -0,0 +1,185 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_ode_fixture);
+
+FOSSIL_SETUP(c_ode_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_ode_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static void test_decay(double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = -y[0];
+}
+
+static void test_oscillator(double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = y[1];
+    dydt[1] = -y[0];
+}
+
+// Robertson's stiff chemical kinetics problem
+static void test_robertson(double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = -0.04 * y[0] + 1e4 * y[1] * y[2];
+    dydt[1] = 0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1];
+    dydt[2] = 3e7 * y[1] * y[1];
+}
+
+static void test_robertson_jac(double t, const double* y, double* J, void* ctx) {
+    (void)t; (void)ctx;
+    J[0] = -0.04; J[1] = 1e4 * y[2];                 J[2] = 1e4 * y[1];
+    J[3] = 0.04;  J[4] = -1e4 * y[2] - 6e7 * y[1];   J[5] = -1e4 * y[1];
+    J[6] = 0.0;   J[7] = 6e7 * y[1];                 J[8] = 0.0;
+}
+
+// System s decays at rate s + 1
+static void test_batch_decay(size_t system, double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = -(double)(system + 1) * y[0];
+}
+
+FOSSIL_TEST(c_math_test_ode_rk45_decay) {
+    double y0 = 1.0;
+    double t_out[] = {0.0, 0.5, 1.0, 2.0, 5.0};
+    double y_out[5];
+    fossil_math_ode_info_t info;
+    int ret = fossil_math_ode_rk45(test_decay, NULL, 1, 0.0, &y0, t_out, 5, y_out, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    for (size_t k = 0; k < 5; ++k) ASSUME_ITS_EQUAL_F64(y_out[k], exp(-t_out[k]), 1e-6);
+    ASSUME_ITS_TRUE(info.steps > 0);
+}
+
+FOSSIL_TEST(c_math_test_ode_rk45_dense_output) {
+    enum { M = 101 };
+    double y0[2] = {0.0, 1.0};
+    double t_out[M];
+    double y_out[2 * M];
+    for (size_t k = 0; k < M; ++k) t_out[k] = 0.1 * (double)k;
+
+    fossil_math_ode_options_t opts;
+    fossil_math_ode_options_default(&opts);
+    opts.rtol = 1e-9;
+    opts.atol = 1e-12;
+    fossil_math_ode_info_t info;
+    int ret = fossil_math_ode_rk45(test_oscillator, NULL, 2, 0.0, y0, t_out, M, y_out, &opts, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    // The output grid does not change the steps taken
+    double y_end[2];
+    fossil_math_ode_info_t end_info;
+    ASSUME_ITS_TRUE(fossil_math_ode_rk45(test_oscillator, NULL, 2, 0.0, y0, &t_out[M - 1], 1, y_end, &opts, &end_info) == 0);
+    ASSUME_ITS_TRUE(info.steps == end_info.steps);
+    for (size_t k = 0; k < M; ++k) {
+        ASSUME_ITS_EQUAL_F64(y_out[2 * k], sin(t_out[k]), 1e-7);
+        ASSUME_ITS_EQUAL_F64(y_out[2 * k + 1], cos(t_out[k]), 1e-7);
+    }
+}
+
+FOSSIL_TEST(c_math_test_ode_bdf_robertson) {
+    double y0[3] = {1.0, 0.0, 0.0};
+    double t_out[] = {40.0};
+    double y[3];
+    fossil_math_ode_info_t info;
+    int ret = fossil_math_ode_bdf(test_robertson, test_robertson_jac, NULL, 3, 0.0, y0, t_out, 1, y, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_EQUAL_F64(y[0], 0.7158270687, 1e-4);
+    ASSUME_ITS_EQUAL_F64(y[1], 9.185534764e-6, 1e-7);
+    ASSUME_ITS_EQUAL_F64(y[2], 0.2841637457, 1e-4);
+    ASSUME_ITS_EQUAL_F64(y[0] + y[1] + y[2], 1.0, 1e-9);
+    // LU factors are reused across steps
+    ASSUME_ITS_TRUE(info.factorizations < info.steps);
+    ASSUME_ITS_TRUE(info.steps < 1000);
+}
+
+FOSSIL_TEST(c_math_test_ode_bdf_finite_difference) {
+    double y0 = 1.0;
+    double t_out[] = {0.5, 1.0, 3.0};
+    double y_out[3];
+    int ret = fossil_math_ode_bdf(test_decay, NULL, NULL, 1, 0.0, &y0, t_out, 3, y_out, NULL, NULL);
+    ASSUME_ITS_TRUE(ret == 0);
+    for (size_t k = 0; k < 3; ++k) ASSUME_ITS_EQUAL_F64(y_out[k], exp(-t_out[k]), 1e-5);
+}
+
+FOSSIL_TEST(c_math_test_ode_solve_batch) {
+    enum { COUNT = 100 };
+    double y[COUNT];
+    int status[COUNT];
+    for (size_t s = 0; s < COUNT; ++s) y[s] = 1.0;
+
+    size_t ok = fossil_math_ode_solve_batch(FOSSIL_MATH_ODE_RK45, test_batch_decay, NULL, NULL, 1, COUNT,
+                                            0.0, 1.0, y, NULL, status);
+    ASSUME_ITS_TRUE(ok == COUNT);
+    for (size_t s = 0; s < COUNT; ++s) ASSUME_ITS_EQUAL_F64(y[s], exp(-(double)(s + 1)), 1e-6);
+
+    for (size_t s = 0; s < COUNT; ++s) y[s] = 1.0;
+    ok = fossil_math_ode_solve_batch(FOSSIL_MATH_ODE_BDF, test_batch_decay, NULL, NULL, 1, COUNT,
+                                     0.0, 1.0, y, NULL, NULL);
+    ASSUME_ITS_TRUE(ok == COUNT);
+    for (size_t s = 0; s < COUNT; ++s) ASSUME_ITS_EQUAL_F64(y[s], exp(-(double)(s + 1)), 1e-5);
+}
+
+FOSSIL_TEST(c_math_test_ode_invalid) {
+    double y0 = 1.0;
+    double t_out[] = {1.0, 0.5};
+    double y_out[2];
+    ASSUME_ITS_TRUE(fossil_math_ode_rk45(test_decay, NULL, 1, 0.0, &y0, t_out, 2, y_out, NULL, NULL) == -1);
+    ASSUME_ITS_TRUE(fossil_math_ode_bdf(NULL, NULL, NULL, 1, 0.0, &y0, t_out, 1, y_out, NULL, NULL) == -1);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_ode_tests) {
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_rk45_decay);
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_rk45_dense_output);
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_bdf_robertson);
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_bdf_finite_difference);
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_solve_batch);
+    FOSSIL_ADD_TEST(c_ode_fixture, c_math_test_ode_invalid);
+
+    FOSSIL_ADD_SUITE(c_ode_fixture);
+} // end of tests
@@ -0,0 +1,97 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_ode_fixture);
+
+FOSSIL_SETUP(cpp_ode_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_ode_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <cmath>
+#include <vector>
+
+static void test_cpp_decay(double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = -y[0];
+}
+
+static void test_cpp_batch_decay(size_t system, double t, const double* y, double* dydt, void* ctx) {
+    (void)t; (void)ctx;
+    dydt[0] = -(double)(system + 1) * y[0];
+}
+
+FOSSIL_TEST(cpp_math_test_ode_rk45) {
+    std::vector<double> y = fossil::math::Ode::rk45(test_cpp_decay, nullptr, 0.0, {1.0}, {1.0, 2.0});
+    ASSUME_ITS_EQUAL_F64(y[0], std::exp(-1.0), 1e-6);
+    ASSUME_ITS_EQUAL_F64(y[1], std::exp(-2.0), 1e-6);
+}
+
+FOSSIL_TEST(cpp_math_test_ode_bdf) {
+    std::vector<double> y = fossil::math::Ode::bdf(test_cpp_decay, nullptr, nullptr, 0.0, {1.0}, {1.0});
+    ASSUME_ITS_EQUAL_F64(y[0], std::exp(-1.0), 1e-5);
+}
+
+FOSSIL_TEST(cpp_math_test_ode_solve_batch) {
+    std::vector<double> y(32, 1.0);
+    std::vector<int> status;
+    size_t ok = fossil::math::Ode::solve_batch(FOSSIL_MATH_ODE_RK45, test_cpp_batch_decay, nullptr, nullptr,
+                                               1, 0.0, 1.0, y, nullptr, &status);
+    ASSUME_ITS_TRUE(ok == 32);
+    ASSUME_ITS_TRUE(status.size() == 32);
+    ASSUME_ITS_EQUAL_F64(y[31], std::exp(-32.0), 1e-9);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_ode_tests) {
+    FOSSIL_ADD_TEST(cpp_ode_fixture, cpp_math_test_ode_rk45);
+    FOSSIL_ADD_TEST(cpp_ode_fixture, cpp_math_test_ode_bdf);
+    FOSSIL_ADD_TEST(cpp_ode_fixture, cpp_math_test_ode_solve_batch);
+
+    FOSSIL_ADD_SUITE(cpp_ode_fixture);
+} // end of tests
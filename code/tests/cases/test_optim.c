@@ -0,0 +1,170 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_optim_fixture);
+
+FOSSIL_SETUP(c_optim_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_optim_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Extended Rosenbrock function in n dimensions, minimum 0 at (1, ..., 1)
+typedef struct {
+    size_t n;
+    size_t calls;
+} test_optim_ctx_t;
+
+static double test_rosenbrock_fdf(const double* x, double* grad, void* ctx) {
+    test_optim_ctx_t* c = (test_optim_ctx_t*)ctx;
+    double f = 0.0;
+    ++c->calls;
+    for (size_t i = 0; i < c->n; ++i) grad[i] = 0.0;
+    for (size_t i = 0; i + 1 < c->n; ++i) {
+        double a = x[i + 1] - x[i] * x[i];
+        double b = 1.0 - x[i];
+        f += 100.0 * a * a + b * b;
+        grad[i] += -400.0 * x[i] * a - 2.0 * b;
+        grad[i + 1] += 200.0 * a;
+    }
+    return f;
+}
+
+static double test_rosenbrock_f(const double* x, void* ctx) {
+    double grad[2];
+    return test_rosenbrock_fdf(x, grad, ctx);
+}
+
+static int test_stop_after_three(const fossil_math_optim_info_t* it, void* ctx) {
+    (void)ctx;
+    return it->iterations >= 3;
+}
+
+FOSSIL_TEST(c_math_test_optim_lbfgs) {
+    enum { N = 20 };
+    test_optim_ctx_t ctx = { N, 0 };
+    double x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = (i % 2 == 0) ? -1.2 : 1.0;
+
+    fossil_math_optim_info_t info;
+    int ret = fossil_math_optim_lbfgs(test_rosenbrock_fdf, &ctx, x, N, NULL, NULL, &info);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_TRUE(info.converged);
+    ASSUME_ITS_TRUE(info.evaluations == ctx.calls);
+    for (size_t i = 0; i < N; ++i) ASSUME_ITS_EQUAL_F64(x[i], 1.0, 1e-6);
+}
+
+FOSSIL_TEST(c_math_test_optim_cg) {
+    enum { N = 10 };
+    test_optim_ctx_t ctx = { N, 0 };
+    double x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = 0.0;
+
+    fossil_math_optim_options_t opts;
+    fossil_math_optim_options_default(&opts);
+    opts.max_iter = 5000;
+    int ret = fossil_math_optim_cg(test_rosenbrock_fdf, &ctx, x, N, &opts, NULL, NULL);
+    ASSUME_ITS_TRUE(ret == 0);
+    for (size_t i = 0; i < N; ++i) ASSUME_ITS_EQUAL_F64(x[i], 1.0, 1e-5);
+}
+
+FOSSIL_TEST(c_math_test_optim_nelder_mead) {
+    test_optim_ctx_t ctx = { 2, 0 };
+    double x[2] = {-1.2, 1.0};
+
+    fossil_math_optim_options_t opts;
+    fossil_math_optim_options_default(&opts);
+    opts.tol_f = 1e-12;
+    opts.tol_x = 1e-8;
+    int ret = fossil_math_optim_nelder_mead(test_rosenbrock_f, &ctx, x, 2, &opts, NULL, NULL);
+    ASSUME_ITS_TRUE(ret == 0);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-5);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-5);
+}
+
+FOSSIL_TEST(c_math_test_optim_workspace_reuse) {
+    fossil_math_optim_workspace_t* ws = fossil_math_optim_workspace_create(4, 8);
+    ASSUME_ITS_TRUE(ws != NULL);
+
+    for (size_t n = 2; n <= 4; ++n) {
+        test_optim_ctx_t ctx = { n, 0 };
+        double x[4] = {-1.0, -1.0, -1.0, -1.0};
+        ASSUME_ITS_TRUE(fossil_math_optim_lbfgs(test_rosenbrock_fdf, &ctx, x, n, NULL, ws, NULL) == 0);
+        ASSUME_ITS_EQUAL_F64(x[n - 1], 1.0, 1e-6);
+    }
+
+    // Too small for five unknowns
+    test_optim_ctx_t ctx = { 5, 0 };
+    double y[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    ASSUME_ITS_TRUE(fossil_math_optim_cg(test_rosenbrock_fdf, &ctx, y, 5, NULL, ws, NULL) == -1);
+    fossil_math_optim_workspace_destroy(ws);
+}
+
+FOSSIL_TEST(c_math_test_optim_monitor) {
+    test_optim_ctx_t ctx = { 2, 0 };
+    double x[2] = {-1.2, 1.0};
+
+    fossil_math_optim_options_t opts;
+    fossil_math_optim_options_default(&opts);
+    opts.monitor = test_stop_after_three;
+    fossil_math_optim_info_t info;
+    int ret = fossil_math_optim_lbfgs(test_rosenbrock_fdf, &ctx, x, 2, &opts, NULL, &info);
+    ASSUME_ITS_TRUE(ret == -5);
+    ASSUME_ITS_TRUE(info.iterations == 3);
+    ASSUME_ITS_TRUE(info.f < 24.2);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_optim_tests) {
+    FOSSIL_ADD_TEST(c_optim_fixture, c_math_test_optim_lbfgs);
+    FOSSIL_ADD_TEST(c_optim_fixture, c_math_test_optim_cg);
+    FOSSIL_ADD_TEST(c_optim_fixture, c_math_test_optim_nelder_mead);
+    FOSSIL_ADD_TEST(c_optim_fixture, c_math_test_optim_workspace_reuse);
+    FOSSIL_ADD_TEST(c_optim_fixture, c_math_test_optim_monitor);
+
+    FOSSIL_ADD_SUITE(c_optim_fixture);
+} // end of tests
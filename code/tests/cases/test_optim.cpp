@@ -0,0 +1,102 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_optim_fixture);
+
+FOSSIL_SETUP(cpp_optim_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_optim_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <vector>
+
+// Rosenbrock function, minimum 0 at (1, 1)
+static double test_cpp_rosenbrock_fdf(const double* x, double* grad, void* ctx) {
+    (void)ctx;
+    double a = x[1] - x[0] * x[0];
+    double b = 1.0 - x[0];
+    grad[0] = -400.0 * x[0] * a - 2.0 * b;
+    grad[1] = 200.0 * a;
+    return 100.0 * a * a + b * b;
+}
+
+static double test_cpp_rosenbrock_f(const double* x, void* ctx) {
+    double grad[2];
+    return test_cpp_rosenbrock_fdf(x, grad, ctx);
+}
+
+FOSSIL_TEST(cpp_math_test_optim_lbfgs) {
+    fossil::math::Optim::Workspace ws(2);
+    std::vector<double> x = fossil::math::Optim::lbfgs(test_cpp_rosenbrock_fdf, nullptr, {-1.2, 1.0}, nullptr, nullptr, &ws);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-6);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-6);
+}
+
+FOSSIL_TEST(cpp_math_test_optim_cg) {
+    std::vector<double> x = fossil::math::Optim::cg(test_cpp_rosenbrock_fdf, nullptr, {-1.2, 1.0});
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-5);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-5);
+}
+
+FOSSIL_TEST(cpp_math_test_optim_nelder_mead) {
+    fossil_math_optim_options_t opts = fossil::math::Optim::default_options();
+    opts.tol_f = 1e-12;
+    opts.tol_x = 1e-8;
+    std::vector<double> x = fossil::math::Optim::nelder_mead(test_cpp_rosenbrock_f, nullptr, {-1.2, 1.0}, &opts);
+    ASSUME_ITS_EQUAL_F64(x[0], 1.0, 1e-5);
+    ASSUME_ITS_EQUAL_F64(x[1], 1.0, 1e-5);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_optim_tests) {
+    FOSSIL_ADD_TEST(cpp_optim_fixture, cpp_math_test_optim_lbfgs);
+    FOSSIL_ADD_TEST(cpp_optim_fixture, cpp_math_test_optim_cg);
+    FOSSIL_ADD_TEST(cpp_optim_fixture, cpp_math_test_optim_nelder_mead);
+
+    FOSSIL_ADD_SUITE(cpp_optim_fixture);
+} // end of tests
@@ -0,0 +1,129 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_parallel_fixture);
+
+FOSSIL_SETUP(c_parallel_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_parallel_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+typedef struct {
+    const double* values;
+    double* partial;
+} test_parallel_sum_t;
+
+static void test_parallel_square(size_t begin, size_t end, void* ctx) {
+    test_parallel_sum_t* job = (test_parallel_sum_t*)ctx;
+    for (size_t i = begin; i < end; ++i) job->partial[i] = job->values[i] * job->values[i];
+}
+
+FOSSIL_TEST(c_math_test_parallel_threads) {
+    fossil_math_parallel_set_threads(3);
+    ASSUME_ITS_TRUE(fossil_math_parallel_threads() == 3);
+    fossil_math_parallel_set_threads(0);
+    ASSUME_ITS_TRUE(fossil_math_parallel_threads() >= 1);
+}
+
+FOSSIL_TEST(c_math_test_parallel_for_covers_range) {
+    enum { N = 10000 };
+    static double values[N], squares[N];
+    for (size_t i = 0; i < N; ++i) { values[i] = (double)i; squares[i] = -1.0; }
+    test_parallel_sum_t job = { values, squares };
+
+    fossil_math_parallel_set_threads(4);
+    fossil_math_parallel_for(N, 100, test_parallel_square, &job);
+    fossil_math_parallel_set_threads(0);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < N; ++i) sum += squares[i];
+    // sum of i^2 for i < N
+    ASSUME_ITS_EQUAL_F64(sum, (double)(N - 1) * N * (2.0 * N - 1) / 6.0, 1e-3);
+}
+
+FOSSIL_TEST(c_math_test_parallel_for_small_range) {
+    double values[3] = { 1.0, 2.0, 3.0 }, squares[3] = { 0.0, 0.0, 0.0 };
+    test_parallel_sum_t job = { values, squares };
+    fossil_math_parallel_for(3, 1000, test_parallel_square, &job);
+    ASSUME_ITS_EQUAL_F64(squares[2], 9.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+typedef struct {
+    fossil_math_mutex_t* lock;
+    size_t total;
+} test_parallel_counter_t;
+
+static void test_parallel_count(size_t begin, size_t end, void* ctx) {
+    test_parallel_counter_t* c = (test_parallel_counter_t*)ctx;
+    for (size_t i = begin; i < end; ++i) {
+        fossil_math_mutex_lock(c->lock);
+        c->total += i;
+        fossil_math_mutex_unlock(c->lock);
+    }
+}
+
+FOSSIL_TEST(c_math_test_parallel_mutex) {
+    test_parallel_counter_t c = { fossil_math_mutex_create(), 0 };
+    ASSUME_ITS_TRUE(c.lock != NULL);
+    fossil_math_parallel_set_threads(4);
+    fossil_math_parallel_for(20000, 100, test_parallel_count, &c);
+    fossil_math_parallel_set_threads(0);
+    ASSUME_ITS_TRUE(c.total == (size_t)20000 * 19999 / 2);
+    fossil_math_mutex_free(c.lock);
+    fossil_math_mutex_free(NULL);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_parallel_tests) {
+    FOSSIL_ADD_TEST(c_parallel_fixture, c_math_test_parallel_threads);
+    FOSSIL_ADD_TEST(c_parallel_fixture, c_math_test_parallel_for_covers_range);
+    FOSSIL_ADD_TEST(c_parallel_fixture, c_math_test_parallel_for_small_range);
+    FOSSIL_ADD_TEST(c_parallel_fixture, c_math_test_parallel_mutex);
+
+    FOSSIL_ADD_SUITE(c_parallel_fixture);
+} // end of tests
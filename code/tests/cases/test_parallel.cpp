@@ -0,0 +1,87 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_parallel_fixture);
+
+FOSSIL_SETUP(cpp_parallel_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_parallel_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <atomic>
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_parallel_threads) {
+    fossil::math::Parallel::set_threads(3);
+    ASSUME_ITS_TRUE(fossil::math::Parallel::threads() == 3);
+    fossil::math::Parallel::set_threads(0);
+    ASSUME_ITS_TRUE(fossil::math::Parallel::threads() >= 1);
+}
+
+FOSSIL_TEST(cpp_math_test_parallel_for_range) {
+    std::vector<double> squares(10000, -1.0);
+    std::atomic<size_t> visited(0);
+
+    fossil::math::Parallel::set_threads(4);
+    fossil::math::Parallel::for_range(squares.size(), 100, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) squares[i] = (double)i * (double)i;
+        visited += end - begin;
+    });
+    fossil::math::Parallel::set_threads(0);
+
+    ASSUME_ITS_TRUE(visited.load() == squares.size());
+    ASSUME_ITS_EQUAL_F64(squares[9999], 9999.0 * 9999.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_parallel_tests) {
+    FOSSIL_ADD_TEST(cpp_parallel_fixture, cpp_math_test_parallel_threads);
+    FOSSIL_ADD_TEST(cpp_parallel_fixture, cpp_math_test_parallel_for_range);
+
+    FOSSIL_ADD_SUITE(cpp_parallel_fixture);
+} // end of tests
@@ -0,0 +1,274 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_sketch_fixture);
+
+FOSSIL_SETUP(c_sketch_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_sketch_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static double c_sketch_uniform(uint64_t* state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+FOSSIL_TEST(c_math_test_tdigest_quantiles) {
+    size_t n = 200000;
+    double* x = malloc(n * sizeof(double));
+    uint64_t state = 42;
+    for (size_t i = 0; i < n; ++i) x[i] = c_sketch_uniform(&state);
+    fossil_math_tdigest_t* td = fossil_math_tdigest_create(0.0);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_add_batch(td, x, n) == 0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_count(td), (double)n, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 0.5), 0.5, 1e-2);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 0.99), 0.99, 1e-3);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 0.999), 0.999, 2e-4);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_cdf(td, 0.25), 0.25, 1e-2);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 1.0), fossil_math_tdigest_max(td), 0.0);
+    fossil_math_tdigest_free(td);
+    free(x);
+}
+
+FOSSIL_TEST(c_math_test_tdigest_merge_serialize) {
+    fossil_math_tdigest_t* a = fossil_math_tdigest_create(100.0);
+    fossil_math_tdigest_t* b = fossil_math_tdigest_create(100.0);
+    for (int i = 0; i < 5000; ++i) fossil_math_tdigest_add(a, (double)i, 1.0);
+    for (int i = 5000; i < 10000; ++i) fossil_math_tdigest_add(b, (double)i, 1.0);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_merge(a, b) == 0);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_merge(a, a) == -1);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(a, 0.9), 9000.0, 20.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_min(a), 0.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_max(a), 9999.0, 0.0);
+
+    size_t size = fossil_math_tdigest_serialize(a, NULL, 0);
+    uint8_t* bytes = malloc(size);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_serialize(a, bytes, size) == size);
+    fossil_math_tdigest_t* c = fossil_math_tdigest_deserialize(bytes, size);
+    ASSUME_ITS_TRUE(c != NULL);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(c, 0.99), fossil_math_tdigest_quantile(a, 0.99), 0.0);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_deserialize(bytes, size - 1) == NULL);
+    // A NaN bound passes every range check on the means, so the bounds are checked themselves
+    uint8_t saved[8];
+    memcpy(saved, bytes + 12, 8);
+    memset(bytes + 12, 0xFF, 8);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_deserialize(bytes, size) == NULL);
+    memcpy(bytes + 12, bytes + 20, 8);
+    memcpy(bytes + 20, saved, 8);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_deserialize(bytes, size) == NULL);
+    free(bytes);
+    fossil_math_tdigest_free(a);
+    fossil_math_tdigest_free(b);
+    fossil_math_tdigest_free(c);
+}
+
+FOSSIL_TEST(c_math_test_kll_quantiles) {
+    size_t n = 200000;
+    double* x = malloc(n * sizeof(double));
+    uint64_t state = 7;
+    for (size_t i = 0; i < n; ++i) x[i] = c_sketch_uniform(&state);
+    fossil_math_kll_t* kll = fossil_math_kll_create(0);
+    ASSUME_ITS_TRUE(fossil_math_kll_add_batch(kll, x, n) == 0);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(kll) == n);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(kll, 0.5), 0.5, 2e-2);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(kll, 0.99), 0.99, 2e-2);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_cdf(kll, 0.25), 0.25, 2e-2);
+    ASSUME_ITS_TRUE(fossil_math_kll_serialize(kll, NULL, 0) < 8192);
+
+    // Sequential inserts into one sketch agree with the chunked batch
+    fossil_math_kll_t* seq = fossil_math_kll_create(0);
+    for (size_t i = 0; i < n; ++i) fossil_math_kll_add(seq, x[i]);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(seq, 0.5), fossil_math_kll_quantile(kll, 0.5), 3e-2);
+    fossil_math_kll_free(seq);
+    fossil_math_kll_free(kll);
+    free(x);
+}
+
+FOSSIL_TEST(c_math_test_kll_merge_serialize) {
+    fossil_math_kll_t* a = fossil_math_kll_create(64);
+    fossil_math_kll_t* b = fossil_math_kll_create(64);
+    for (int i = 0; i < 30000; ++i) fossil_math_kll_add(i % 2 ? a : b, (double)i);
+    ASSUME_ITS_TRUE(fossil_math_kll_merge(a, b) == 0);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(a) == 30000);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(a, 0.5), 15000.0, 1500.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(a, 0.0), 0.0, 0.0);
+
+    size_t size = fossil_math_kll_serialize(a, NULL, 0);
+    uint8_t* bytes = malloc(size);
+    ASSUME_ITS_TRUE(fossil_math_kll_serialize(a, bytes, size) == size);
+    fossil_math_kll_t* c = fossil_math_kll_deserialize(bytes, size);
+    ASSUME_ITS_TRUE(c != NULL);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(c) == 30000);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(c, 0.75), fossil_math_kll_quantile(a, 0.75), 0.0);
+    ASSUME_ITS_TRUE(fossil_math_kll_deserialize(bytes, size - 8) == NULL);
+    bytes[12] ^= 1; // corrupt the count
+    ASSUME_ITS_TRUE(fossil_math_kll_deserialize(bytes, size) == NULL);
+    bytes[12] ^= 1;
+    bytes[7] = 1; // k = 2^24 + 64
+    ASSUME_ITS_TRUE(fossil_math_kll_deserialize(bytes, size) == NULL);
+    free(bytes);
+
+    // 32 items at level 59 weigh 2^64, which wraps to the claimed count of 0
+    size = 52 + 60 * 8 + 32 * 8;
+    bytes = calloc(size, 1);
+    memcpy(bytes, "FKL1", 4);
+    bytes[4] = 8;           // k
+    bytes[28 + 6] = 0xF0;   // max = 1.0
+    bytes[28 + 7] = 0x3F;
+    bytes[36] = 1;          // rng
+    bytes[44] = 60;         // levels
+    bytes[52 + 59 * 8] = 32;
+    ASSUME_ITS_TRUE(fossil_math_kll_deserialize(bytes, size) == NULL);
+    free(bytes);
+    fossil_math_kll_free(a);
+    fossil_math_kll_free(b);
+    fossil_math_kll_free(c);
+}
+
+FOSSIL_TEST(c_math_test_sketch_empty) {
+    fossil_math_tdigest_t* td = fossil_math_tdigest_create(0.0);
+    fossil_math_kll_t* kll = fossil_math_kll_create(0);
+    ASSUME_ITS_TRUE(isnan(fossil_math_tdigest_quantile(td, 0.5)));
+    ASSUME_ITS_TRUE(isnan(fossil_math_kll_quantile(kll, 0.5)));
+    ASSUME_ITS_TRUE(fossil_math_tdigest_add(td, NAN, 1.0) == -1);
+    ASSUME_ITS_TRUE(fossil_math_kll_add(kll, NAN) == -1);
+    fossil_math_tdigest_add(td, 3.0, 1.0);
+    fossil_math_kll_add(kll, 3.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 0.5), 3.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(kll, 0.5), 3.0, 0.0);
+    fossil_math_tdigest_free(td);
+    fossil_math_kll_free(kll);
+}
+
+typedef struct {
+    fossil_math_tdigest_shards_t* td;
+    fossil_math_kll_shards_t* kll;
+    size_t per_shard;
+    int monotonic;
+} c_sketch_shards_job_t;
+
+// Chunk 0 takes readings while every other chunk c feeds shard c - 1
+static void c_sketch_shards_work(size_t begin, size_t end, void* ctx) {
+    c_sketch_shards_job_t* job = (c_sketch_shards_job_t*)ctx;
+    for (size_t c = begin; c < end; ++c) {
+        if (c == 0) {
+            double last = 0.0;
+            for (int r = 0; r < 50; ++r) {
+                fossil_math_tdigest_t* td = fossil_math_tdigest_create(0.0);
+                fossil_math_kll_t* kll = fossil_math_kll_create(0);
+                fossil_math_tdigest_shards_snapshot(job->td, td);
+                fossil_math_kll_shards_snapshot(job->kll, kll);
+                if (fossil_math_tdigest_count(td) < last) job->monotonic = 0;
+                last = fossil_math_tdigest_count(td);
+                fossil_math_tdigest_free(td);
+                fossil_math_kll_free(kll);
+            }
+            continue;
+        }
+        uint64_t state = c;
+        for (size_t i = 0; i < job->per_shard; ++i) {
+            double x = c_sketch_uniform(&state);
+            fossil_math_tdigest_shards_add(job->td, c - 1, x);
+            fossil_math_kll_shards_add(job->kll, c - 1, x);
+        }
+        fossil_math_tdigest_shards_flush(job->td, c - 1);
+        fossil_math_kll_shards_flush(job->kll, c - 1);
+    }
+}
+
+FOSSIL_TEST(c_math_test_sketch_shards) {
+    c_sketch_shards_job_t job = {fossil_math_tdigest_shards_create(0.0, 3), fossil_math_kll_shards_create(0, 3), 100000, 1};
+    ASSUME_ITS_TRUE(job.td != NULL && job.kll != NULL);
+    // One thread per chunk, so the reader overlaps the producers even on one core
+    fossil_math_parallel_set_threads(4);
+    fossil_math_parallel_for(4, 1, c_sketch_shards_work, &job);
+    fossil_math_parallel_set_threads(0);
+    ASSUME_ITS_TRUE(job.monotonic);
+
+    fossil_math_tdigest_t* td = fossil_math_tdigest_create(0.0);
+    fossil_math_kll_t* kll = fossil_math_kll_create(0);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_shards_snapshot(job.td, td) == 0);
+    ASSUME_ITS_TRUE(fossil_math_kll_shards_snapshot(job.kll, kll) == 0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_count(td), 300000.0, 0.0);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(kll) == 300000);
+    ASSUME_ITS_EQUAL_F64(fossil_math_tdigest_quantile(td, 0.99), 0.99, 1e-3);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_quantile(kll, 0.5), 0.5, 2e-2);
+    fossil_math_tdigest_free(td);
+    fossil_math_kll_free(kll);
+
+    // Buffered values reach readers at a handoff
+    ASSUME_ITS_TRUE(fossil_math_kll_shards_add(job.kll, 0, 2.0) == 0);
+    kll = fossil_math_kll_create(0);
+    fossil_math_kll_shards_snapshot(job.kll, kll);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(kll) == 300000);
+    fossil_math_kll_free(kll);
+    ASSUME_ITS_TRUE(fossil_math_kll_shards_flush(job.kll, 0) == 0);
+    kll = fossil_math_kll_create(0);
+    fossil_math_kll_shards_snapshot(job.kll, kll);
+    ASSUME_ITS_TRUE(fossil_math_kll_count(kll) == 300001);
+    ASSUME_ITS_EQUAL_F64(fossil_math_kll_max(kll), 2.0, 0.0);
+    fossil_math_kll_free(kll);
+
+    ASSUME_ITS_TRUE(fossil_math_tdigest_shards_add(job.td, 3, 1.0) == -1);
+    ASSUME_ITS_TRUE(fossil_math_kll_shards_add(job.kll, 0, NAN) == -1);
+    ASSUME_ITS_TRUE(fossil_math_tdigest_shards_create(0.0, 0) == NULL);
+    fossil_math_tdigest_shards_free(job.td);
+    fossil_math_kll_shards_free(job.kll);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_sketch_tests) {
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_tdigest_quantiles);
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_tdigest_merge_serialize);
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_kll_quantiles);
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_kll_merge_serialize);
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_sketch_empty);
+    FOSSIL_ADD_TEST(c_sketch_fixture, c_math_test_sketch_shards);
+
+    FOSSIL_ADD_SUITE(c_sketch_fixture);
+} // end of tests
@@ -0,0 +1,119 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_sketch_fixture);
+
+FOSSIL_SETUP(cpp_sketch_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_sketch_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_tdigest) {
+    fossil::math::TDigest a, b;
+    std::vector<double> x;
+    for (int i = 0; i < 1000; ++i) x.push_back(i);
+    a.add(x);
+    for (int i = 1000; i < 2000; ++i) b.add(i);
+    a.merge(b);
+    ASSUME_ITS_EQUAL_F64(a.count(), 2000.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(a.quantile(0.5), 1000.0, 10.0);
+    fossil::math::TDigest c = fossil::math::TDigest::deserialize(a.serialize());
+    ASSUME_ITS_EQUAL_F64(c.quantile(0.99), a.quantile(0.99), 0.0);
+    ASSUME_ITS_EQUAL_F64(c.maximum(), 1999.0, 0.0);
+}
+
+FOSSIL_TEST(cpp_math_test_kll) {
+    fossil::math::Kll a(100);
+    for (int i = 0; i < 10000; ++i) a.add(i);
+    ASSUME_ITS_TRUE(a.count() == 10000);
+    ASSUME_ITS_EQUAL_F64(a.quantile(0.5), 5000.0, 300.0);
+    fossil::math::Kll c = fossil::math::Kll::deserialize(a.serialize());
+    ASSUME_ITS_EQUAL_F64(c.quantile(0.25), a.quantile(0.25), 0.0);
+    bool thrown = false;
+    try {
+        fossil::math::Kll::deserialize(std::vector<uint8_t>{1, 2, 3});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+}
+
+FOSSIL_TEST(cpp_math_test_sketch_shards) {
+    fossil::math::TDigestShards td(2);
+    fossil::math::KllShards kll(2);
+    for (int i = 0; i < 3000; ++i) {
+        td.add(i % 2, i);
+        kll.add(i % 2, i);
+    }
+    td.flush(0);
+    td.flush(1);
+    kll.flush(0);
+    kll.flush(1);
+    ASSUME_ITS_EQUAL_F64(td.snapshot().count(), 3000.0, 0.0);
+    ASSUME_ITS_TRUE(kll.snapshot().count() == 3000);
+    ASSUME_ITS_EQUAL_F64(kll.snapshot().maximum(), 2999.0, 0.0);
+
+    bool threw = false;
+    try {
+        fossil::math::KllShards none(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_sketch_tests) {
+    FOSSIL_ADD_TEST(cpp_sketch_fixture, cpp_math_test_tdigest);
+    FOSSIL_ADD_TEST(cpp_sketch_fixture, cpp_math_test_kll);
+    FOSSIL_ADD_TEST(cpp_sketch_fixture, cpp_math_test_sketch_shards);
+
+    FOSSIL_ADD_SUITE(cpp_sketch_fixture);
+} // end of tests
@@ -0,0 +1,140 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(c_stats_fixture);
+
+FOSSIL_SETUP(c_stats_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_stats_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST(c_math_test_stats_moments) {
+    const double x[] = {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0};
+    fossil_math_stats_t s;
+    fossil_math_stats_init(&s);
+    for (int i = 0; i < 8; ++i) fossil_math_stats_push(&s, x[i]);
+    ASSUME_ITS_TRUE(s.count == 8);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_mean(&s), 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_variance(&s), 32.0 / 7.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_skewness(&s), 0.65625, 1e-14);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_kurtosis(&s), -0.21875, 1e-14);
+    ASSUME_ITS_EQUAL_F64(s.min, 2.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(s.max, 9.0, 0.0);
+
+    fossil_math_stats_t b;
+    fossil_math_stats_init(&b);
+    fossil_math_stats_push_batch(&b, x, 8);
+    ASSUME_ITS_EQUAL_F64(b.m2, s.m2, 1e-12);
+    ASSUME_ITS_EQUAL_F64(b.m3, s.m3, 1e-12);
+    ASSUME_ITS_EQUAL_F64(b.m4, s.m4, 1e-12);
+}
+
+FOSSIL_TEST(c_math_test_stats_merge) {
+    double x[1000];
+    for (int i = 0; i < 1000; ++i) x[i] = sin(0.37 * i) * (1.0 + 0.001 * i) + 0.5 * (i % 7);
+    fossil_math_stats_t all, a, b;
+    fossil_math_stats_init(&all);
+    fossil_math_stats_init(&a);
+    fossil_math_stats_init(&b);
+    for (int i = 0; i < 1000; ++i) fossil_math_stats_push(&all, x[i]);
+    fossil_math_stats_push_batch(&a, x, 313);
+    fossil_math_stats_push_batch(&b, x + 313, 687);
+    fossil_math_stats_merge(&a, &b);
+    ASSUME_ITS_TRUE(a.count == 1000);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_mean(&a), fossil_math_stats_mean(&all), 1e-13);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_variance(&a), fossil_math_stats_variance(&all), 1e-12);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_skewness(&a), fossil_math_stats_skewness(&all), 1e-12);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_kurtosis(&a), fossil_math_stats_kurtosis(&all), 1e-12);
+    ASSUME_ITS_EQUAL_F64(a.min, all.min, 0.0);
+    ASSUME_ITS_EQUAL_F64(a.max, all.max, 0.0);
+}
+
+FOSSIL_TEST(c_math_test_stats_compute_parallel) {
+    size_t n = 100003;
+    double* x = malloc(n * sizeof(double));
+    // Large offset with small spread: naive sum-of-squares would lose all precision
+    for (size_t i = 0; i < n; ++i) x[i] = 1e9 + (double)(i % 10);
+    fossil_math_parallel_set_threads(4);
+    fossil_math_stats_t s;
+    ASSUME_ITS_TRUE(fossil_math_stats_compute(x, n, &s) == 0);
+    fossil_math_parallel_set_threads(1);
+    fossil_math_stats_t t;
+    ASSUME_ITS_TRUE(fossil_math_stats_compute(x, n, &t) == 0);
+    fossil_math_parallel_set_threads(0);
+
+    ASSUME_ITS_TRUE(s.count == n);
+    ASSUME_ITS_EQUAL_F64(s.mean, t.mean, 0.0);
+    ASSUME_ITS_EQUAL_F64(s.m2, t.m2, 0.0);
+    double mean = 1e9 + 450003.0 / (double)n; // 10000 full cycles, then 0, 1, 2
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_mean(&s), mean, 1e-6);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_variance(&s), 8.25, 1e-3);
+    ASSUME_ITS_EQUAL_F64(s.min, 1e9, 0.0);
+    ASSUME_ITS_EQUAL_F64(s.max, 1e9 + 9.0, 0.0);
+    free(x);
+}
+
+FOSSIL_TEST(c_math_test_stats_empty) {
+    fossil_math_stats_t s;
+    ASSUME_ITS_TRUE(fossil_math_stats_compute(NULL, 0, &s) == 0);
+    ASSUME_ITS_TRUE(isnan(fossil_math_stats_mean(&s)));
+    fossil_math_stats_push(&s, 3.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_stats_mean(&s), 3.0, 0.0);
+    ASSUME_ITS_TRUE(isnan(fossil_math_stats_variance(&s)));
+    ASSUME_ITS_TRUE(isnan(fossil_math_stats_skewness(&s)));
+    ASSUME_ITS_TRUE(fossil_math_stats_compute(NULL, 5, &s) == -1);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_stats_tests) {
+    FOSSIL_ADD_TEST(c_stats_fixture, c_math_test_stats_moments);
+    FOSSIL_ADD_TEST(c_stats_fixture, c_math_test_stats_merge);
+    FOSSIL_ADD_TEST(c_stats_fixture, c_math_test_stats_compute_parallel);
+    FOSSIL_ADD_TEST(c_stats_fixture, c_math_test_stats_empty);
+
+    FOSSIL_ADD_SUITE(c_stats_fixture);
+} // end of tests
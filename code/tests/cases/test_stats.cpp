@@ -0,0 +1,87 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/maip/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_SUITE(cpp_stats_fixture);
+
+FOSSIL_SETUP(cpp_stats_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_stats_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#include <vector>
+
+FOSSIL_TEST(cpp_math_test_stats_accumulate) {
+    fossil::math::Stats a, b;
+    a.push(std::vector<double>{2.0, 4.0, 4.0, 4.0});
+    b.push(5.0);
+    b.push(5.0);
+    b.push(std::vector<double>{7.0, 9.0});
+    a += b;
+    ASSUME_ITS_TRUE(a.count() == 8);
+    ASSUME_ITS_EQUAL_F64(a.mean(), 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(a.variance(), 32.0 / 7.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(a.minimum(), 2.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(a.maximum(), 9.0, 0.0);
+}
+
+FOSSIL_TEST(cpp_math_test_stats_compute) {
+    std::vector<double> x(50000);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = (double)(i % 2);
+    fossil::math::Stats s = fossil::math::Stats::compute(x);
+    ASSUME_ITS_EQUAL_F64(s.mean(), 0.5, 1e-15);
+    ASSUME_ITS_EQUAL_F64(s.skewness(), 0.0, 1e-12);
+    ASSUME_ITS_EQUAL_F64(s.kurtosis(), -2.0, 1e-12);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_stats_tests) {
+    FOSSIL_ADD_TEST(cpp_stats_fixture, cpp_math_test_stats_accumulate);
+    FOSSIL_ADD_TEST(cpp_stats_fixture, cpp_math_test_stats_compute);
+
+    FOSSIL_ADD_SUITE(cpp_stats_fixture);
+} // end of tests
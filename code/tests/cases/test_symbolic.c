@@ -22,9 +22,17 @@
  * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
  * -----------------------------------------------------------------------------
  */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include <fossil/maip/framework.h>
 #include "fossil/math/framework.h"
 
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Utilities
@@ -109,6 +117,24 @@ FOSSIL_TEST(c_math_test_sym_to_string_parens) {
     fossil_math_sym_free(expr);
 }
 
+FOSSIL_TEST(c_math_test_sym_to_string_negative_base) {
+    // Negative constants appear through substitution and must keep their sign under ^
+    const char* sources[] = {"x ^ 2", "-(x ^ 0)", "2 ^ x ^ 2", "x ^ x", "1 - x * x"};
+    int same = 1;
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); ++i) {
+        fossil_math_sym_expr_t* expr = fossil_math_sym_parse(sources[i]);
+        fossil_math_sym_expr_t* sub = fossil_math_sym_substitute(expr, "x", -3.0);
+        char buf[64];
+        fossil_math_sym_to_string(sub, buf, sizeof(buf));
+        fossil_math_sym_expr_t* back = fossil_math_sym_parse(buf);
+        if (!back || fossil_math_sym_eval(back, NULL) != fossil_math_sym_eval(sub, NULL)) same = 0;
+        fossil_math_sym_free(back);
+        fossil_math_sym_free(sub);
+        fossil_math_sym_free(expr);
+    }
+    ASSUME_ITS_TRUE(same);
+}
+
 FOSSIL_TEST(c_math_test_sym_eval_division_by_zero) {
     fossil_math_sym_expr_t* expr = fossil_math_sym_parse("1 / 0");
     double val = fossil_math_sym_eval(expr, NULL);
@@ -127,6 +153,1008 @@ FOSSIL_TEST(c_math_test_sym_substitute_all_vars) {
     fossil_math_sym_free(sub2);
 }
 
+FOSSIL_TEST(c_math_test_sym_compile_eval) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("(x + 1) * (y - 2) / x + 3");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    ASSUME_ITS_TRUE(prog != NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_vars(prog) == 2);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_length(prog) == 5);
+    double v[2] = {2.0, 3.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, v), fossil_math_sym_eval(expr, test_var_lookup), 0.0);
+    v[0] = 0.0;
+    ASSUME_ITS_TRUE(isnan(fossil_math_sym_eval_compiled(prog, v)));
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_compile_unknown_var) {
+    const char* names[] = {"x"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x + y");
+    ASSUME_ITS_TRUE(fossil_math_sym_compile(expr, names, 1) == NULL);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_compile_deep) {
+    // Each level keeps x * x live while the right operand is computed
+    char text[8192];
+    size_t pos = 0;
+    for (int i = 0; i < 300; ++i) pos += (size_t)snprintf(text + pos, sizeof(text) - pos, "x * x + (");
+    pos += (size_t)snprintf(text + pos, sizeof(text) - pos, "1");
+    for (int i = 0; i < 300; ++i) text[pos++] = ')';
+    text[pos] = '\0';
+
+    const char* names[] = {"x"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse(text);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 1);
+    ASSUME_ITS_TRUE(prog != NULL);
+    double x = 2.0;
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, &x), 1201.0, 0.0);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_eval_batch) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("(x * x - y) / (x + 2) + 0.5");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    size_t n = 5000;
+    double* x = malloc(n * sizeof(double));
+    double* y = malloc(n * sizeof(double));
+    double* out = malloc(n * sizeof(double));
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = -3.0 + 0.0013 * (double)i;
+        y[i] = sin((double)i);
+    }
+    x[17] = -2.0; // division by zero yields NaN as in scalar evaluation
+    const double* cols[] = {x, y};
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch(prog, cols, out, n) == 0);
+    for (size_t i = 0; i < n; i += 97) {
+        double v[2] = {x[i], y[i]};
+        ASSUME_ITS_EQUAL_F64(out[i], fossil_math_sym_eval_compiled(prog, v), 0.0);
+    }
+    ASSUME_ITS_TRUE(isnan(out[17]));
+    double v[2] = {x[n - 1], y[n - 1]};
+    ASSUME_ITS_EQUAL_F64(out[n - 1], fossil_math_sym_eval_compiled(prog, v), 0.0);
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch(prog, NULL, out, n) == -1);
+    free(x);
+    free(y);
+    free(out);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_eval_batch_leaf) {
+    // Programs without instructions return a variable or constant directly
+    const char* names[] = {"x"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 1);
+    double x[3] = {1.0, 2.0, 3.0}, out[3];
+    const double* cols[] = {x};
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch(prog, cols, out, 3) == 0);
+    ASSUME_ITS_EQUAL_F64(out[2], 3.0, 0.0);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+
+    expr = fossil_math_sym_parse("4");
+    prog = fossil_math_sym_compile(expr, NULL, 0);
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch(prog, NULL, out, 3) == 0);
+    ASSUME_ITS_EQUAL_F64(out[1], 4.0, 0.0);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_emit_c) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x / y + 2");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    size_t len = fossil_math_sym_emit_c(prog, "model", NULL, 0);
+    ASSUME_ITS_TRUE(len > 0);
+    char* src = malloc(len + 1);
+    ASSUME_ITS_TRUE(fossil_math_sym_emit_c(prog, "model", src, len + 1) == len);
+    ASSUME_ITS_TRUE(strlen(src) == len);
+    ASSUME_ITS_TRUE(strstr(src, "double model(const double* v)") != NULL);
+    ASSUME_ITS_TRUE(strstr(src, "void model_batch(") != NULL);
+    ASSUME_ITS_TRUE(strstr(src, "2.0") != NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_emit_c(prog, "1bad", src, len + 1) == 0);
+    free(src);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+// A private cache directory, so native tests never touch the user's cache
+static char* c_math_test_sym_cache_dir(char* buf) {
+#if defined(_WIN32)
+    (void)buf;
+    return NULL;
+#else
+    strcpy(buf, "/tmp/fossil_math_test.XXXXXX");
+    return mkdtemp(buf);
+#endif
+}
+
+static void c_math_test_sym_cache_remove(const char* dir) {
+#if !defined(_WIN32)
+    if (!dir) return;
+    DIR* d = opendir(dir);
+    if (d) {
+        for (struct dirent* e; (e = readdir(d)) != NULL;) {
+            if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) unlinkat(dirfd(d), e->d_name, 0);
+        }
+        closedir(d);
+    }
+    rmdir(dir);
+#else
+    (void)dir;
+#endif
+}
+
+FOSSIL_TEST(c_math_test_sym_native_compile) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("(x * x + 1) / (y - 1) - 0.25");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    char buf[64];
+    const char* cache = c_math_test_sym_cache_dir(buf);
+    fossil_math_sym_native_t* native = fossil_math_sym_native_compile(prog, cache, NULL);
+    // Runtime compilation needs a host compiler; without one the bytecode path is the fallback
+    if (native) {
+        double v[2] = {3.0, 5.0};
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_native_eval(native, v), fossil_math_sym_eval_compiled(prog, v), 0.0);
+        v[1] = 1.0;
+        ASSUME_ITS_TRUE(isnan(fossil_math_sym_native_eval(native, v)));
+
+        double x[4] = {0.0, 1.0, 2.0, 3.0}, y[4] = {2.0, 3.0, 4.0, 5.0}, out[4];
+        const double* cols[] = {x, y};
+        ASSUME_ITS_TRUE(fossil_math_sym_native_eval_batch(native, cols, out, 4) == 0);
+        ASSUME_ITS_EQUAL_F64(out[3], 2.25, 0.0);
+
+        fossil_math_sym_native_t* again = fossil_math_sym_native_compile(prog, cache, NULL);
+        ASSUME_ITS_TRUE(again != NULL);
+        ASSUME_ITS_TRUE(fossil_math_sym_native_cached(again));
+        fossil_math_sym_native_free(again);
+        fossil_math_sym_native_free(native);
+    }
+    // Libraries are never loaded from a directory other users can write to
+    ASSUME_ITS_TRUE(fossil_math_sym_native_compile(prog, "/tmp", NULL) == NULL);
+    c_math_test_sym_cache_remove(cache);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_diff_free) {
+    // Derivative trees own their nodes and can be freed alongside the input
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("(x * y) / (x + 1)");
+    fossil_math_sym_expr_t* d = fossil_math_sym_diff(expr, "x");
+    fossil_math_sym_free(expr);
+    ASSUME_ITS_TRUE(d != NULL);
+    // d/dx at x = 2, y = 3: y / (x + 1)^2 = 1/3
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(d, test_var_lookup), 1.0 / 3.0, 1e-15);
+    fossil_math_sym_free(d);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_hash_consing) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * y + x * y");
+    fossil_math_sym_node_t root = fossil_math_sym_graph_import(g, expr);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_size(g) == 4);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_count(g, root) == 4);
+    fossil_math_sym_node_t l, r;
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_children(g, root, &l, &r) == 0);
+    ASSUME_ITS_TRUE(l == r);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_op(g, '*', fossil_math_sym_graph_var(g, "x"), fossil_math_sym_graph_var(g, "y")) == l);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_size(g) == 4);
+
+    fossil_math_sym_expr_t* back = fossil_math_sym_graph_export(g, root);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(back, test_var_lookup), 12.0, 0.0);
+    fossil_math_sym_free(back);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_simplify) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * 1 + 0 * y - (y - y) + (2 + 3) / 5");
+    fossil_math_sym_node_t s = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, expr));
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_node_op(g, s) == '+');
+    fossil_math_sym_node_t l, r;
+    fossil_math_sym_graph_children(g, s, &l, &r);
+    ASSUME_ITS_TRUE(l == fossil_math_sym_graph_var(g, "x"));
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_value(g, r), 1.0, 0.0);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_diff_shared) {
+    // d/dx of (x+1)(x+2)...(x+20): the tree form grows quadratically with
+    // copies of every prefix, the graph shares them
+    char text[512];
+    size_t pos = 0;
+    for (int k = 1; k <= 20; ++k) pos += (size_t)snprintf(text + pos, sizeof(text) - pos, k == 1 ? "(x + %d)" : " * (x + %d)", k);
+
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse(text);
+    fossil_math_sym_node_t f = fossil_math_sym_graph_import(g, expr);
+    fossil_math_sym_node_t d = fossil_math_sym_graph_diff(g, f, "x");
+    ASSUME_ITS_TRUE(d != FOSSIL_MATH_SYM_NONE);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_count(g, d) < 150);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_diff(g, f, "x") == d);
+
+    const char* names[] = {"x"};
+    double x = 0.5, p = 1.0, s = 0.0;
+    for (int k = 1; k <= 20; ++k) {
+        p *= x + k;
+        s += 1.0 / (x + k);
+    }
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, d, names, &x, 1) / (p * s), 1.0, 1e-13);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_graph_compile(g, d, names, 1);
+    ASSUME_ITS_TRUE(prog != NULL);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, &x) / (p * s), 1.0, 1e-13);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_compile_cse) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("(x * y + 1) * (x * y + 1) - x * y");
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t root = fossil_math_sym_graph_import(g, expr);
+    fossil_math_sym_compiled_t* tree = fossil_math_sym_compile(expr, names, 2);
+    fossil_math_sym_compiled_t* dag = fossil_math_sym_graph_compile(g, root, names, 2);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_length(tree) == 7);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_length(dag) == 4);
+    double v[2] = {1.5, -2.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(dag, v), fossil_math_sym_eval_compiled(tree, v), 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, root, names, v, 2), 7.0, 0.0);
+    ASSUME_ITS_TRUE(isnan(fossil_math_sym_graph_eval(g, root, names, v, 1)));
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_compile(g, root, names, 1) == NULL);
+    fossil_math_sym_compiled_free(tree);
+    fossil_math_sym_compiled_free(dag);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_compact) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t first = fossil_math_sym_graph_var(g, "v0");
+    const char* first_name = fossil_math_sym_graph_name(g, first);
+
+    // sum_i (i + 1) * v(i % 200), with 200 interned names
+    char names[200][8];
+    const char* vars[200];
+    double values[200];
+    for (int k = 0; k < 200; ++k) {
+        snprintf(names[k], sizeof(names[k]), "v%d", k);
+        vars[k] = names[k];
+        values[k] = 0.5 * k;
+    }
+    fossil_math_sym_node_t sum = fossil_math_sym_graph_const(g, 0.0);
+    double expect = 0.0;
+    for (int i = 0; i < 5000; ++i) {
+        fossil_math_sym_node_t term = fossil_math_sym_graph_op(g, '*', fossil_math_sym_graph_const(g, i + 1.0), fossil_math_sym_graph_var(g, vars[i % 200]));
+        sum = fossil_math_sym_graph_op(g, '+', sum, term);
+        expect += (i + 1.0) * values[i % 200];
+    }
+    size_t size = fossil_math_sym_graph_size(g);
+    ASSUME_ITS_TRUE(size == 1 + 200 + 3 * 5000);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_bytes(g) < size * 64);
+
+    // Names are interned once and stay put as the symbol table grows
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_name(g, first) == first_name);
+    ASSUME_ITS_TRUE(strcmp(first_name, "v0") == 0);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_var(g, "v0") == first);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_name(g, sum) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_var(g, "abcdefghijklmnopqrstuvwxyz0123456789") ==
+                    fossil_math_sym_graph_var(g, "abcdefghijklmnopqrstuvwxyz01234"));
+
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, sum, vars, values, 200), expect, 0.0);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_graph_compile(g, sum, vars, 200);
+    ASSUME_ITS_TRUE(prog != NULL);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, values), expect, 0.0);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_simplify_canonical) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    const char* pairs[][2] = {
+        {"y * x + x * y - x * 2", "2 * (x * y - x)"},
+        {"x * y - y * x", "0"},
+        {"(x + 1) * (x + 1) / (x + 1)", "1 + x"},
+        {"y + x + 2 + 3 + x", "5 + 2 * x + y"},
+        {"x * x * x / x", "x * x"},
+        {"1 / x + 2 / x", "3 / x"},
+        {"3 - x", "0 - x + 3"},
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i) {
+        fossil_math_sym_expr_t* a = fossil_math_sym_parse(pairs[i][0]);
+        fossil_math_sym_expr_t* b = fossil_math_sym_parse(pairs[i][1]);
+        fossil_math_sym_node_t sa = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, a));
+        fossil_math_sym_node_t sb = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, b));
+        ASSUME_ITS_TRUE(sa != FOSSIL_MATH_SYM_NONE);
+        ASSUME_ITS_TRUE(sa == sb);
+        ASSUME_ITS_TRUE(fossil_math_sym_graph_simplify(g, sa) == sa);
+        fossil_math_sym_free(a);
+        fossil_math_sym_free(b);
+    }
+    fossil_math_sym_graph_free(g);
+
+    fossil_math_sym_expr_t* e = fossil_math_sym_parse("3 - x");
+    char buf[32];
+    fossil_math_sym_to_string(fossil_math_sym_simplify(e), buf, sizeof(buf));
+    ASSUME_ITS_TRUE(strcmp(buf, "3 - x") == 0);
+    fossil_math_sym_free(e);
+}
+
+FOSSIL_TEST(c_math_test_sym_simplify_derivative) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * x * y / (x + 1)");
+    fossil_math_sym_expr_t* d = fossil_math_sym_diff(expr, "x");
+    fossil_math_sym_compiled_t* raw = fossil_math_sym_compile(d, names, 2);
+    fossil_math_sym_expr_t* root = d;
+    ASSUME_ITS_TRUE(fossil_math_sym_simplify(d) == root);
+    fossil_math_sym_compiled_t* simple = fossil_math_sym_compile(d, names, 2);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_length(simple) < fossil_math_sym_compiled_length(raw));
+    double v[2] = {2.0, 3.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(simple, v), fossil_math_sym_eval_compiled(raw, v), 1e-14);
+    fossil_math_sym_compiled_free(raw);
+    fossil_math_sym_compiled_free(simple);
+    fossil_math_sym_free(d);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_parse_functions) {
+    const char* cases[][2] = {
+        {"-x^2", "-4"},
+        {"2^-1", "0.5"},
+        {"2^3^2", "512"},
+        {"-(x - y)", "1"},
+        {"sin(x) * sin(x) + cos(x) * cos(x)", "1"},
+        {"log(exp(x + y))", "5"},
+        {"sqrt(x * 8)", "4"},
+        {"abs(x - y)", "1"},
+        {"min(x, y) + max(x, y)", "5"},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        fossil_math_sym_expr_t* e = fossil_math_sym_parse(cases[i][0]);
+        ASSUME_ITS_TRUE(e != NULL);
+        double want = strtod(cases[i][1], NULL);
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(e, test_var_lookup), want, 1e-12);
+
+        // Printing round-trips through the parser
+        char buf[128];
+        fossil_math_sym_to_string(e, buf, sizeof(buf));
+        fossil_math_sym_expr_t* again = fossil_math_sym_parse(buf);
+        ASSUME_ITS_TRUE(again != NULL);
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(again, test_var_lookup), want, 1e-12);
+        fossil_math_sym_free(again);
+        fossil_math_sym_free(e);
+    }
+    ASSUME_ITS_TRUE(fossil_math_sym_parse("min(x)") == NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_parse("sin(x, y)") == NULL);
+}
+
+FOSSIL_TEST(c_math_test_sym_diff_functions) {
+    // Each derivative is checked against a central difference at x = 2, y = 3
+    const char* exprs[] = {
+        "sin(x * y)", "cos(x) * exp(x)", "log(x * x + 1)", "sqrt(x + y)",
+        "x^3", "x^y", "2^x", "-x / y", "abs(y - x * x)", "min(x * x, y)", "max(x * x, y)",
+    };
+    const char* names[] = {"x", "y"};
+    for (size_t i = 0; i < sizeof(exprs) / sizeof(exprs[0]); ++i) {
+        fossil_math_sym_expr_t* e = fossil_math_sym_parse(exprs[i]);
+        fossil_math_sym_expr_t* d = fossil_math_sym_diff(e, "x");
+        ASSUME_ITS_TRUE(d != NULL);
+        fossil_math_sym_compiled_t* f = fossil_math_sym_compile(e, names, 2);
+        const double h = 1e-6;
+        double lo[2] = {2.0 - h, 3.0}, hi[2] = {2.0 + h, 3.0};
+        double numeric = (fossil_math_sym_eval_compiled(f, hi) - fossil_math_sym_eval_compiled(f, lo)) / (2.0 * h);
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(d, test_var_lookup), numeric, 1e-6 * (1.0 + fabs(numeric)));
+        fossil_math_sym_compiled_free(f);
+        fossil_math_sym_free(d);
+        fossil_math_sym_free(e);
+    }
+}
+
+FOSSIL_TEST(c_math_test_sym_functions_compiled) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* e = fossil_math_sym_parse("-sin(x) * exp(-y) + sqrt(abs(x - y)) - log(max(x, y)) / min(x, y)");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(e, names, 2);
+    ASSUME_ITS_TRUE(prog != NULL);
+
+    double xs[300], ys[300], out[300];
+    for (size_t i = 0; i < 300; ++i) {
+        xs[i] = 0.1 + 0.03 * (double)i;
+        ys[i] = 4.0 - 0.02 * (double)i;
+    }
+    const double* cols[2] = {xs, ys};
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch(prog, cols, out, 300) == 0);
+
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t root = fossil_math_sym_graph_import(g, e);
+    for (size_t i = 0; i < 300; i += 37) {
+        double v[2] = {xs[i], ys[i]};
+        double want = -sin(xs[i]) * exp(-ys[i]) + sqrt(fabs(xs[i] - ys[i])) - log(fmax(xs[i], ys[i])) / fmin(xs[i], ys[i]);
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, v), want, 1e-12);
+        ASSUME_ITS_EQUAL_F64(out[i], want, 1e-12);
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, root, names, v, 2), want, 1e-12);
+    }
+    fossil_math_sym_graph_free(g);
+
+    char src[2048];
+    ASSUME_ITS_TRUE(fossil_math_sym_emit_c(prog, "f", src, sizeof(src)) < sizeof(src));
+    ASSUME_ITS_TRUE(strstr(src, "sin(") != NULL);
+    ASSUME_ITS_TRUE(strstr(src, "fmax(") != NULL);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(e);
+}
+
+FOSSIL_TEST(c_math_test_sym_simplify_functions) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    const char* pairs[][2] = {
+        {"-(-x)", "x"},
+        {"-x + 2 * x", "x"},
+        {"log(exp(x * y))", "y * x"},
+        {"abs(-abs(x))", "abs(x)"},
+        {"max(sin(x), sin(x))", "sin(x)"},
+        {"-(x * y) * -1", "x * y"},
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i) {
+        fossil_math_sym_expr_t* a = fossil_math_sym_parse(pairs[i][0]);
+        fossil_math_sym_expr_t* b = fossil_math_sym_parse(pairs[i][1]);
+        fossil_math_sym_node_t sa = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, a));
+        ASSUME_ITS_TRUE(sa != FOSSIL_MATH_SYM_NONE);
+        ASSUME_ITS_TRUE(sa == fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_import(g, b)));
+        fossil_math_sym_free(a);
+        fossil_math_sym_free(b);
+    }
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_parse_errors) {
+    struct { const char* text; fossil_math_sym_parse_status_t status; size_t offset; } cases[] = {
+        {"x + 2 * y", FOSSIL_MATH_SYM_PARSE_OK, 0},
+        {"x + ", FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND, 4},
+        {"x + * y", FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND, 4},
+        {"(x + 1", FOSSIL_MATH_SYM_PARSE_UNCLOSED, 6},
+        {"x + 1)", FOSSIL_MATH_SYM_PARSE_TRAILING, 5},
+        {"x y", FOSSIL_MATH_SYM_PARSE_TRAILING, 2},
+        {"x $ y", FOSSIL_MATH_SYM_PARSE_UNEXPECTED_CHAR, 2},
+        {"1.2.3 + x", FOSSIL_MATH_SYM_PARSE_BAD_NUMBER, 0},
+        {"foo(x)", FOSSIL_MATH_SYM_PARSE_UNKNOWN_FUNCTION, 0},
+        {"2 * min(x)", FOSSIL_MATH_SYM_PARSE_ARGUMENTS, 9},
+        {"sin(x, y)", FOSSIL_MATH_SYM_PARSE_ARGUMENTS, 5},
+        {"abcdefghijklmnopqrstuvwxyz_0123456789", FOSSIL_MATH_SYM_PARSE_NAME_TOO_LONG, 0},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        fossil_math_sym_parse_error_t err;
+        fossil_math_sym_expr_t* e = fossil_math_sym_parse_n(cases[i].text, strlen(cases[i].text), &err);
+        ASSUME_ITS_TRUE(err.status == cases[i].status);
+        ASSUME_ITS_TRUE((e != NULL) == (cases[i].status == FOSSIL_MATH_SYM_PARSE_OK));
+        if (e == NULL) ASSUME_ITS_TRUE(err.offset == cases[i].offset);
+        ASSUME_ITS_TRUE(fossil_math_sym_parse_message(err.status) != NULL);
+        fossil_math_sym_free(e);
+    }
+    // Trailing input is rejected rather than silently dropped
+    ASSUME_ITS_TRUE(fossil_math_sym_parse("2 + x )") == NULL);
+
+    char deep[2 * FOSSIL_MATH_SYM_PARSE_DEPTH + 8];
+    size_t n = 0;
+    for (int i = 0; i <= FOSSIL_MATH_SYM_PARSE_DEPTH; ++i) deep[n++] = '(';
+    deep[n++] = 'x';
+    fossil_math_sym_parse_error_t err;
+    ASSUME_ITS_TRUE(fossil_math_sym_parse_n(deep, n, &err) == NULL);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_TOO_DEEP);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_parse) {
+    // Only the first len bytes are read, so formulas can be sliced from a larger buffer
+    const char* text = "x * (x + y); 3 * (x + y)";
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_parse_error_t err;
+    fossil_math_sym_node_t a = fossil_math_sym_graph_parse(g, text, 11, &err);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_OK);
+    size_t before = fossil_math_sym_graph_size(g);
+    fossil_math_sym_node_t b = fossil_math_sym_graph_parse(g, text + 13, 11, &err);
+    ASSUME_ITS_TRUE(a != FOSSIL_MATH_SYM_NONE && b != FOSSIL_MATH_SYM_NONE);
+    // x + y is shared; only 3 and the product are new
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_size(g) == before + 2);
+
+    const char* names[] = {"x", "y"};
+    double v[2] = {2.0, 3.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, a, names, v, 2), 10.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, b, names, v, 2), 15.0, 0.0);
+
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_parse(g, text, 12, &err) == FOSSIL_MATH_SYM_NONE);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_UNEXPECTED_CHAR && err.offset == 11);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_parse(NULL, text, 1, &err) == FOSSIL_MATH_SYM_NONE);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_INVALID);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_substitute_values) {
+    const char* vars[] = {"x", "y"};
+    const double values[] = {2.0, 3.0};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * (y + z) + sin(x * y)");
+    fossil_math_sym_expr_t* partial = fossil_math_sym_substitute_values(expr, vars, values, 2);
+    ASSUME_ITS_TRUE(partial != NULL);
+    char buf[64];
+    fossil_math_sym_to_string(partial, buf, sizeof(buf));
+    ASSUME_ITS_TRUE(strchr(buf, 'x') == NULL && strchr(buf, 'y') == NULL && strchr(buf, 'z') != NULL);
+    // With every variable bound the result folds to one constant
+    const char* all[] = {"z", "x", "y", "x"};
+    const double vals[] = {1.0, 2.0, 3.0, 100.0};
+    fossil_math_sym_expr_t* whole = fossil_math_sym_substitute_values(expr, all, vals, 4);
+    ASSUME_ITS_TRUE(whole != NULL && whole->type == fossil_math_sym_CONST);
+    ASSUME_ITS_EQUAL_F64(whole->value, 8.0 + sin(6.0), 1e-12);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_free(partial);
+    fossil_math_sym_free(whole);
+}
+
+FOSSIL_TEST(c_math_test_sym_substitute_exprs) {
+    const char* vars[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x - y");
+    const fossil_math_sym_expr_t* swap[] = {fossil_math_sym_parse("y"), fossil_math_sym_parse("x + 1")};
+    fossil_math_sym_expr_t* sub = fossil_math_sym_substitute_exprs(expr, vars, swap, 2);
+    ASSUME_ITS_TRUE(sub != NULL);
+    // Simultaneous: y - (x + 1) at x = 2, y = 3
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval(sub, test_var_lookup), 0.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_TRUE(fossil_math_sym_substitute_exprs(expr, vars, NULL, 2) == NULL);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_free(sub);
+    fossil_math_sym_free((fossil_math_sym_expr_t*)swap[0]);
+    fossil_math_sym_free((fossil_math_sym_expr_t*)swap[1]);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_substitute) {
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t shared = fossil_math_sym_graph_parse(g, "sin(y) * y", 10, NULL);
+    fossil_math_sym_node_t f = fossil_math_sym_graph_parse(g, "x * (sin(y) * y) + x", 20, NULL);
+    const char* vars[] = {"x"};
+    fossil_math_sym_node_t value = fossil_math_sym_graph_const(g, 2.0);
+    fossil_math_sym_node_t sub = fossil_math_sym_graph_substitute(g, f, vars, &value, 1);
+    ASSUME_ITS_TRUE(sub != FOSSIL_MATH_SYM_NONE && sub != f);
+    // The untouched operand is the same node, not a copy
+    fossil_math_sym_node_t left, right, a, b;
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_children(g, sub, &left, &right) == 0);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_children(g, left, &a, &b) == 0);
+    ASSUME_ITS_TRUE(b == shared);
+    // Nothing to replace returns the input node itself
+    const char* other[] = {"w"};
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_substitute(g, f, other, &value, 1) == f);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_substitute(g, f, vars, NULL, 1) == FOSSIL_MATH_SYM_NONE);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_compile_gradient) {
+    const char* names[] = {"x", "y", "w"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("sin(x * y) + x^3 / y - exp(-y) * sqrt(x)");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile_gradient(expr, names, 3);
+    ASSUME_ITS_TRUE(prog != NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_outputs(prog) == 4);
+    const double x = 1.3, y = 0.7, vars[] = {x, y, 5.0};
+    double out[4];
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_compiled_many(prog, vars, out) == 0);
+    ASSUME_ITS_EQUAL_F64(out[0], sin(x * y) + x * x * x / y - exp(-y) * sqrt(x), 1e-12);
+    ASSUME_ITS_EQUAL_F64(out[1], y * cos(x * y) + 3.0 * x * x / y - exp(-y) / (2.0 * sqrt(x)), 1e-12);
+    ASSUME_ITS_EQUAL_F64(out[2], x * cos(x * y) - x * x * x / (y * y) + exp(-y) * sqrt(x), 1e-12);
+    ASSUME_ITS_EQUAL_F64(out[3], 0.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(prog, vars), out[0], 1e-15);
+
+    // Batch evaluation writes every output column
+    double xs[300], ys[300], ws[300], f[300], gx[300], gy[300], gw[300];
+    for (size_t i = 0; i < 300; ++i) {
+        xs[i] = 0.5 + 0.01 * (double)i;
+        ys[i] = 1.0 + 0.002 * (double)i;
+        ws[i] = 0.0;
+    }
+    const double* cols[] = {xs, ys, ws};
+    double* outs[] = {f, gx, gy, gw};
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch_many(prog, cols, outs, 300) == 0);
+    double point[] = {xs[257], ys[257], 0.0}, expect[4];
+    fossil_math_sym_eval_compiled_many(prog, point, expect);
+    ASSUME_ITS_EQUAL_F64(f[257], expect[0], 1e-15);
+    ASSUME_ITS_EQUAL_F64(gx[257], expect[1], 1e-15);
+    ASSUME_ITS_EQUAL_F64(gy[257], expect[2], 1e-15);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_gradient_shares_work) {
+    // A chain of n variables: n forward derivatives would repeat the chain n times
+    char text[2048];
+    const char* names[40];
+    char storage[40][8];
+    size_t len = 0;
+    for (int i = 0; i < 40; ++i) {
+        snprintf(storage[i], sizeof(storage[i]), "v%d", i);
+        names[i] = storage[i];
+        len += (size_t)snprintf(text + len, sizeof(text) - len, "%ssin(v%d * x)", i ? " * " : "", i);
+    }
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse(text);
+    const char* all[41];
+    for (int i = 0; i < 40; ++i) all[i] = names[i];
+    all[40] = "x";
+    fossil_math_sym_compiled_t* value_x = fossil_math_sym_compile(expr, all, 41);
+    fossil_math_sym_compiled_t* grad = fossil_math_sym_compile_gradient(expr, all, 41);
+    ASSUME_ITS_TRUE(value_x != NULL && grad != NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_length(grad) < 8 * fossil_math_sym_compiled_length(value_x));
+
+    double vars[41], out[42];
+    for (int i = 0; i < 41; ++i) vars[i] = 0.9 + 0.01 * i;
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_compiled_many(grad, vars, out) == 0);
+    double product = 1.0;
+    for (int i = 0; i < 40; ++i) product *= sin(vars[i] * vars[40]);
+    ASSUME_ITS_EQUAL_F64(out[0], product, 1e-12);
+    ASSUME_ITS_EQUAL_F64(out[1], product / sin(vars[0] * vars[40]) * cos(vars[0] * vars[40]) * vars[40], 1e-12);
+    fossil_math_sym_compiled_free(value_x);
+    fossil_math_sym_compiled_free(grad);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_compile_jacobian) {
+    const char* names[] = {"x", "y"};
+    const fossil_math_sym_expr_t* exprs[] = {fossil_math_sym_parse("x * y + max(x, y)"), fossil_math_sym_parse("log(x) - y^2")};
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile_jacobian(exprs, 2, names, 2);
+    ASSUME_ITS_TRUE(prog != NULL && fossil_math_sym_compiled_outputs(prog) == 6);
+    const double vars[] = {2.0, 3.0};
+    double out[6];
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_compiled_many(prog, vars, out) == 0);
+    ASSUME_ITS_EQUAL_F64(out[0], 9.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(out[1], log(2.0) - 9.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(out[2], 3.0, 1e-15);  // d f0 / dx
+    ASSUME_ITS_EQUAL_F64(out[3], 3.0, 1e-15);  // d f0 / dy
+    ASSUME_ITS_EQUAL_F64(out[4], 0.5, 1e-15);  // d f1 / dx
+    ASSUME_ITS_EQUAL_F64(out[5], -6.0, 1e-15); // d f1 / dy
+    // Variables missing from the list cannot be compiled
+    ASSUME_ITS_TRUE(fossil_math_sym_compile_jacobian(exprs, 2, names, 1) == NULL);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free((fossil_math_sym_expr_t*)exprs[0]);
+    fossil_math_sym_free((fossil_math_sym_expr_t*)exprs[1]);
+}
+
+FOSSIL_TEST(c_math_test_sym_compiled_serialize) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * exp(y) - 2.5 / (x + y)");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile_gradient(expr, names, 2);
+    size_t size = fossil_math_sym_compiled_serialize(prog, NULL, 0);
+    ASSUME_ITS_TRUE(size > 0);
+    unsigned char* bytes = malloc(size);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_serialize(prog, bytes, size) == size);
+
+    fossil_math_sym_compiled_t* copy = fossil_math_sym_compiled_deserialize(bytes, size);
+    ASSUME_ITS_TRUE(copy != NULL && fossil_math_sym_compiled_outputs(copy) == 3);
+    const double vars[] = {1.5, -0.5};
+    double a[3], b[3];
+    fossil_math_sym_eval_compiled_many(prog, vars, a);
+    fossil_math_sym_eval_compiled_many(copy, vars, b);
+    for (int i = 0; i < 3; ++i) ASSUME_ITS_TRUE(a[i] == b[i]);
+
+    // Truncated, corrupted and foreign input is rejected
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_deserialize(bytes, size - 1) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_deserialize(NULL, size) == NULL);
+    bytes[0] = 'X';
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_deserialize(bytes, size) == NULL);
+    bytes[0] = 'F';
+    bytes[size - 1] = 0xFF;  // output register out of range
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_deserialize(bytes, size) == NULL);
+    // More temporaries than instructions could write: ntemps follows the magic, version, nvars and nconsts
+    fossil_math_sym_compiled_serialize(prog, bytes, size);
+    bytes[13] = bytes[14] = bytes[15] = 0;
+    bytes[16] = 0x20;
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_deserialize(bytes, size) == NULL);
+    free(bytes);
+    fossil_math_sym_compiled_free(copy);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_serialize) {
+    const char* text = "sin(x * (x + y)) + x * (x + y) * cos(x * (x + y))";
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_graph_t* h = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t f = fossil_math_sym_graph_parse(g, text, strlen(text), NULL);
+    size_t size = fossil_math_sym_graph_serialize(g, f, NULL, 0);
+    unsigned char* bytes = malloc(size);
+    fossil_math_sym_graph_serialize(g, f, bytes, size);
+    // Shared subexpressions are encoded once, so the DAG is smaller than the text
+    ASSUME_ITS_TRUE(size < 10 * fossil_math_sym_graph_count(g, f) + 32);
+
+    fossil_math_sym_node_t r = fossil_math_sym_graph_deserialize(h, bytes, size);
+    ASSUME_ITS_TRUE(r != FOSSIL_MATH_SYM_NONE);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_count(h, r) == fossil_math_sym_graph_count(g, f));
+    const char* names[] = {"x", "y"};
+    const double values[] = {0.3, 1.1};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(h, r, names, values, 2), fossil_math_sym_graph_eval(g, f, names, values, 2), 0.0);
+    // Decoding into the source graph finds the existing nodes
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_deserialize(g, bytes, size) == f);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_deserialize(h, bytes, size - 1) == FOSSIL_MATH_SYM_NONE);
+    free(bytes);
+    fossil_math_sym_graph_free(g);
+    fossil_math_sym_graph_free(h);
+}
+
+FOSSIL_TEST(c_math_test_sym_cache_hits) {
+    const char* names[] = {"x", "y"};
+    const char* text = "x^2 + y * sin(x)";
+    fossil_math_sym_cache_t* cache = fossil_math_sym_cache_create(0);
+    fossil_math_sym_parse_error_t err;
+    fossil_math_sym_compiled_t* p1 = fossil_math_sym_cache_compile(cache, text, strlen(text), names, 2, 0, &err);
+    fossil_math_sym_compiled_t* p2 = fossil_math_sym_cache_compile(cache, text, strlen(text), names, 2, 0, &err);
+    fossil_math_sym_compiled_t* p3 = fossil_math_sym_cache_compile(cache, text, strlen(text), names, 2, FOSSIL_MATH_SYM_CACHE_GRADIENT, &err);
+    ASSUME_ITS_TRUE(p1 != NULL && p2 != NULL && p3 != NULL && p1 != p2);
+    const double vars[] = {2.0, 3.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_eval_compiled(p2, vars), 4.0 + 3.0 * sin(2.0), 1e-15);
+    ASSUME_ITS_TRUE(fossil_math_sym_compiled_outputs(p3) == 3);
+
+    // Failures are reported and not cached
+    ASSUME_ITS_TRUE(fossil_math_sym_cache_compile(cache, "x +", 3, names, 2, 0, &err) == NULL);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_EXPECTED_OPERAND && err.offset == 3);
+    ASSUME_ITS_TRUE(fossil_math_sym_cache_compile(cache, "x + z", 5, names, 2, 0, &err) == NULL);
+    ASSUME_ITS_TRUE(err.status == FOSSIL_MATH_SYM_PARSE_INVALID);
+
+    fossil_math_sym_cache_stats_t stats;
+    fossil_math_sym_cache_stats(cache, &stats);
+    ASSUME_ITS_TRUE(stats.hits == 1 && stats.misses == 4 && stats.entries == 2);
+    fossil_math_sym_cache_clear(cache);
+    fossil_math_sym_cache_stats(cache, &stats);
+    ASSUME_ITS_TRUE(stats.entries == 0 && stats.bytes == 0 && stats.hits == 1);
+    fossil_math_sym_compiled_free(p1);
+    fossil_math_sym_compiled_free(p2);
+    fossil_math_sym_compiled_free(p3);
+    fossil_math_sym_cache_free(cache);
+}
+
+FOSSIL_TEST(c_math_test_sym_cache_evicts) {
+    const char* names[] = {"x"};
+    fossil_math_sym_cache_t* cache = fossil_math_sym_cache_create(1024);
+    char text[32];
+    for (int i = 0; i < 64; ++i) {
+        int n = snprintf(text, sizeof(text), "x * %d + sin(x)", i);
+        fossil_math_sym_compiled_free(fossil_math_sym_cache_compile(cache, text, (size_t)n, names, 1, 0, NULL));
+    }
+    fossil_math_sym_cache_stats_t stats;
+    fossil_math_sym_cache_stats(cache, &stats);
+    ASSUME_ITS_TRUE(stats.bytes <= 1024 && stats.evictions > 0 && stats.entries + stats.evictions == 64);
+    // The most recent formula is still cached, the first one is not
+    fossil_math_sym_compiled_free(fossil_math_sym_cache_compile(cache, text, strlen(text), names, 1, 0, NULL));
+    fossil_math_sym_compiled_free(fossil_math_sym_cache_compile(cache, "x * 0 + sin(x)", 14, names, 1, 0, NULL));
+    fossil_math_sym_cache_stats(cache, &stats);
+    ASSUME_ITS_TRUE(stats.hits == 1 && stats.misses == 65);
+    fossil_math_sym_cache_free(cache);
+}
+
+typedef struct {
+    fossil_math_sym_cache_t* cache;
+    int failures;
+    fossil_math_mutex_t* lock;
+} test_sym_cache_job_t;
+
+static void test_sym_cache_worker(size_t begin, size_t end, void* ctx) {
+    test_sym_cache_job_t* job = (test_sym_cache_job_t*)ctx;
+    const char* names[] = {"x"};
+    char text[32];
+    int failures = 0;
+    for (size_t i = begin; i < end; ++i) {
+        int k = (int)(i % 8);
+        int n = snprintf(text, sizeof(text), "%d * x + %d", k, k);
+        fossil_math_sym_compiled_t* prog = fossil_math_sym_cache_compile(job->cache, text, (size_t)n, names, 1, 0, NULL);
+        double x = 2.0;
+        if (!prog || fossil_math_sym_eval_compiled(prog, &x) != 3.0 * k) failures++;
+        fossil_math_sym_compiled_free(prog);
+    }
+    fossil_math_mutex_lock(job->lock);
+    job->failures += failures;
+    fossil_math_mutex_unlock(job->lock);
+}
+
+FOSSIL_TEST(c_math_test_sym_cache_threads) {
+    test_sym_cache_job_t job = {fossil_math_sym_cache_create(0), 0, fossil_math_mutex_create()};
+    fossil_math_parallel_set_threads(4);
+    fossil_math_parallel_for(2000, 50, test_sym_cache_worker, &job);
+    fossil_math_parallel_set_threads(0);
+    fossil_math_sym_cache_stats_t stats;
+    fossil_math_sym_cache_stats(job.cache, &stats);
+    ASSUME_ITS_TRUE(job.failures == 0);
+    ASSUME_ITS_TRUE(stats.hits + stats.misses == 2000 && stats.entries == 8);
+    fossil_math_mutex_free(job.lock);
+    fossil_math_sym_cache_free(job.cache);
+}
+
+FOSSIL_TEST(c_math_test_sym_interval_encloses) {
+    const char* texts[] = {"x * y - x / (y + 3)", "sin(x) * cos(y) + exp(x - y)", "sqrt(abs(x)) + log(y + 2) - x^3",
+                           "min(x, y) * max(x, -y) + (x + y)^2", "x^0.5 + y^-2", "(x - y) / (x * x + 1)"};
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_interval_t box[2] = {{-1.3, 0.7}, {0.25, 2.5}};
+    int inside = 1;
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t) {
+        fossil_math_sym_expr_t* expr = fossil_math_sym_parse(texts[t]);
+        fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+        fossil_math_sym_interval_t iv = fossil_math_sym_eval_interval(expr, names, box, 2);
+        fossil_math_sym_interval_t ic = fossil_math_sym_eval_compiled_interval(prog, box);
+        if (iv.lo != ic.lo || iv.hi != ic.hi) inside = 0;
+        for (int i = 0; i <= 40; ++i) {
+            for (int j = 0; j <= 40; ++j) {
+                double v[2] = {box[0].lo + (box[0].hi - box[0].lo) * i / 40.0, box[1].lo + (box[1].hi - box[1].lo) * j / 40.0};
+                double f = fossil_math_sym_eval_compiled(prog, v);
+                if (!isnan(f) && (f < iv.lo || f > iv.hi)) inside = 0;
+            }
+        }
+        fossil_math_sym_compiled_free(prog);
+        fossil_math_sym_free(expr);
+    }
+    ASSUME_ITS_TRUE(inside);
+}
+
+FOSSIL_TEST(c_math_test_sym_interval_rounding) {
+    const char* names[] = {"x"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x + 0.1");
+    // 0.1 + 0.2 is not representable; the bounds must straddle the exact sum
+    fossil_math_sym_interval_t point = {0.2, 0.2};
+    fossil_math_sym_interval_t r = fossil_math_sym_eval_interval(expr, names, &point, 1);
+    ASSUME_ITS_TRUE(r.lo < r.hi && r.lo <= 0.1 + 0.2 && r.hi >= 0.1 + 0.2);
+    ASSUME_ITS_TRUE(nextafter(r.lo, INFINITY) == r.hi);
+    fossil_math_sym_free(expr);
+    // Exact operations stay degenerate
+    expr = fossil_math_sym_parse("x * 4 - 1");
+    fossil_math_sym_interval_t two = {2.0, 2.0};
+    r = fossil_math_sym_eval_interval(expr, names, &two, 1);
+    ASSUME_ITS_TRUE(r.lo == 7.0 && r.hi == 7.0);
+    fossil_math_sym_free(expr);
+    expr = fossil_math_sym_parse("sqrt(x)");
+    r = fossil_math_sym_eval_interval(expr, names, &two, 1);
+    ASSUME_ITS_TRUE(r.lo < sqrt(2.0) + 1e-15 && r.hi > sqrt(2.0) - 1e-15 && r.lo * r.lo <= 2.0 && r.hi * r.hi >= 2.0);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_interval_domains) {
+    const char* names[] = {"x"};
+    fossil_math_sym_interval_t neg = {-3.0, -1.0}, sym = {-1.0, 1.0}, wide = {-1.0, 4.0};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("log(x)");
+    fossil_math_sym_interval_t r = fossil_math_sym_eval_interval(expr, names, &neg, 1);
+    ASSUME_ITS_TRUE(isnan(r.lo) && isnan(r.hi));
+    fossil_math_sym_free(expr);
+    expr = fossil_math_sym_parse("1 / x");
+    r = fossil_math_sym_eval_interval(expr, names, &sym, 1);
+    ASSUME_ITS_TRUE(isinf(r.lo) && r.lo < 0.0 && isinf(r.hi) && r.hi > 0.0);
+    fossil_math_sym_free(expr);
+    expr = fossil_math_sym_parse("sqrt(x)");
+    r = fossil_math_sym_eval_interval(expr, names, &wide, 1);
+    ASSUME_ITS_TRUE(r.lo == 0.0 && r.hi == 2.0);
+    fossil_math_sym_free(expr);
+    expr = fossil_math_sym_parse("x^2");
+    r = fossil_math_sym_eval_interval(expr, names, &sym, 1);
+    ASSUME_ITS_TRUE(r.lo == 0.0 && r.hi >= 1.0 && r.hi < 1.0 + 1e-15);
+    fossil_math_sym_free(expr);
+    expr = fossil_math_sym_parse("sin(x)");
+    r = fossil_math_sym_eval_interval(expr, names, &wide, 1);
+    ASSUME_ITS_TRUE(r.lo < sin(-1.0) && r.lo > -0.85 && r.hi == 1.0);
+    fossil_math_sym_free(expr);
+    // Unknown variables give the empty interval
+    expr = fossil_math_sym_parse("x + y");
+    r = fossil_math_sym_eval_interval(expr, names, &sym, 1);
+    ASSUME_ITS_TRUE(isnan(r.lo));
+    fossil_math_sym_free(expr);
+    // Like fmin and fmax, min and max pass the other operand through an empty one
+    const char* both[] = {"x", "y"};
+    fossil_math_sym_interval_t box[2] = {neg, {3.0, 4.0}};
+    expr = fossil_math_sym_parse("min(y, log(x)) + max(log(x), 2 * y)");
+    r = fossil_math_sym_eval_interval(expr, both, box, 2);
+    ASSUME_ITS_TRUE(r.lo <= 9.0 && r.lo > 8.99 && r.hi >= 12.0 && r.hi < 12.01);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, both, 2);
+    double point[2] = {-2.0, 3.5};
+    double v = fossil_math_sym_eval_compiled(prog, point);
+    r = fossil_math_sym_eval_compiled_interval(prog, box);
+    ASSUME_ITS_TRUE(v == 10.5 && r.lo <= v && v <= r.hi);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_interval_outputs) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("x * y");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile_gradient(expr, names, 2);
+    fossil_math_sym_interval_t box[2] = {{1.0, 2.0}, {3.0, 4.0}}, out[3];
+    // The single-output form reads only the value, whatever the output count
+    fossil_math_sym_interval_t r = fossil_math_sym_eval_compiled_interval(prog, box);
+    ASSUME_ITS_TRUE(r.lo == 3.0 && r.hi == 8.0);
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_compiled_interval_many(prog, box, out) == 0);
+    ASSUME_ITS_TRUE(out[0].lo == 3.0 && out[0].hi == 8.0);
+    ASSUME_ITS_TRUE(out[1].lo == 3.0 && out[1].hi == 4.0);
+    ASSUME_ITS_TRUE(out[2].lo == 1.0 && out[2].hi == 2.0);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_interval_batch) {
+    const char* names[] = {"x", "y"};
+    fossil_math_sym_expr_t* expr = fossil_math_sym_parse("exp(x) * y - cos(x * y)");
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, names, 2);
+    enum { N = 500 };
+    static fossil_math_sym_interval_t xs[N], ys[N], out[N];
+    for (int i = 0; i < N; ++i) {
+        xs[i].lo = -2.0 + 0.01 * i;
+        xs[i].hi = xs[i].lo + 0.5;
+        ys[i].lo = 1.0 - 0.003 * i;
+        ys[i].hi = ys[i].lo + 0.01 * (i % 7);
+    }
+    const fossil_math_sym_interval_t* cols[] = {xs, ys};
+    ASSUME_ITS_TRUE(fossil_math_sym_eval_batch_interval(prog, cols, out, N) == 0);
+    int same = 1;
+    for (int i = 0; i < N; ++i) {
+        fossil_math_sym_interval_t box[2] = {xs[i], ys[i]};
+        fossil_math_sym_interval_t r = fossil_math_sym_eval_compiled_interval(prog, box);
+        if (r.lo != out[i].lo || r.hi != out[i].hi) same = 0;
+    }
+    ASSUME_ITS_TRUE(same);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_simplify_zero_divisor) {
+    // 2 / 0 is a divisor here, so flattening must not fold its zero into the numerator
+    const char* names[] = {"y"};
+    double v[1] = {3.0};
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    const char* text = "y / (2 / 0)";
+    fossil_math_sym_node_t s = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_parse(g, text, strlen(text), NULL));
+    ASSUME_ITS_TRUE(s != FOSSIL_MATH_SYM_NONE);
+    ASSUME_ITS_TRUE(isnan(fossil_math_sym_graph_eval(g, s, names, v, 1)));
+    text = "y * 0 / 2";
+    s = fossil_math_sym_graph_simplify(g, fossil_math_sym_graph_parse(g, text, strlen(text), NULL));
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, s, names, v, 1), 0.0, 0.0);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_graph_long_sum) {
+    // A left-nested chain one node deep per operand; simplify and diff must not recurse along it
+    size_t n = 300000;
+    char* text = malloc(2 * n);
+    ASSUME_ITS_TRUE(text != NULL);
+    for (size_t i = 0; i < n; ++i) {
+        text[2 * i] = 'x';
+        text[2 * i + 1] = '+';
+    }
+    const char* names[] = {"x"};
+    double v[1] = {0.5};
+    fossil_math_sym_graph_t* g = fossil_math_sym_graph_create();
+    fossil_math_sym_node_t sum = fossil_math_sym_graph_parse(g, text, 2 * n - 1, NULL);
+    free(text);
+    ASSUME_ITS_TRUE(sum != FOSSIL_MATH_SYM_NONE);
+    fossil_math_sym_node_t s = fossil_math_sym_graph_simplify(g, sum);
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, s, names, v, 1), 150000.0, 0.0);
+    ASSUME_ITS_TRUE(fossil_math_sym_graph_count(g, s) == 3);
+    fossil_math_sym_node_t d = fossil_math_sym_graph_diff(g, sum, "x");
+    ASSUME_ITS_EQUAL_F64(fossil_math_sym_graph_eval(g, d, names, v, 1), 300000.0, 0.0);
+    fossil_math_sym_graph_free(g);
+}
+
+FOSSIL_TEST(c_math_test_sym_emit_c_negative_zero) {
+    // -0.0 prints with a leading minus, so negating it must not emit "--0.0"
+    fossil_math_sym_expr_t* neg = fossil_math_sym_parse("-x");
+    fossil_math_sym_expr_t* expr = fossil_math_sym_substitute(neg, "x", -0.0);
+    fossil_math_sym_compiled_t* prog = fossil_math_sym_compile(expr, NULL, 0);
+    ASSUME_ITS_TRUE(prog != NULL);
+    char src[1024];
+    ASSUME_ITS_TRUE(fossil_math_sym_emit_c(prog, "f", src, sizeof(src)) < sizeof(src));
+    ASSUME_ITS_TRUE(strstr(src, "--") == NULL);
+    ASSUME_ITS_TRUE(strstr(src, "(-0.0)") != NULL);
+
+    char buf[64];
+    const char* cache = c_math_test_sym_cache_dir(buf);
+    fossil_math_sym_native_t* native = fossil_math_sym_native_compile(prog, cache, NULL);
+    if (native) {
+        ASSUME_ITS_EQUAL_F64(fossil_math_sym_native_eval(native, NULL), 0.0, 0.0);
+        ASSUME_ITS_TRUE(!signbit(fossil_math_sym_native_eval(native, NULL)));
+        fossil_math_sym_native_free(native);
+    }
+    c_math_test_sym_cache_remove(cache);
+    fossil_math_sym_compiled_free(prog);
+    fossil_math_sym_free(expr);
+    fossil_math_sym_free(neg);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -137,8 +1165,49 @@ FOSSIL_TEST_GROUP(c_symbolic_tests) {
     FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_parse_constants);
     FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_simplify_basic);
     FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_to_string_parens);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_to_string_negative_base);
     FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_eval_division_by_zero);
     FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_substitute_all_vars);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compile_eval);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compile_unknown_var);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compile_deep);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_eval_batch);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_eval_batch_leaf);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_emit_c);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_native_compile);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_diff_free);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_hash_consing);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_simplify);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_diff_shared);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_compile_cse);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_compact);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_simplify_canonical);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_simplify_derivative);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_parse_functions);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_diff_functions);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_functions_compiled);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_simplify_functions);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_parse_errors);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_parse);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_substitute_values);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_substitute_exprs);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_substitute);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compile_gradient);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_gradient_shares_work);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compile_jacobian);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_compiled_serialize);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_serialize);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_cache_hits);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_cache_evicts);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_cache_threads);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_interval_encloses);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_interval_rounding);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_interval_domains);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_interval_batch);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_interval_outputs);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_simplify_zero_divisor);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_graph_long_sum);
+    FOSSIL_ADD_TEST(c_symbolic_fixture, c_math_test_sym_emit_c_negative_zero);
 
     FOSSIL_ADD_SUITE(c_symbolic_fixture);
 } // end of tests
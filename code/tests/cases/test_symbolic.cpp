@@ -128,6 +128,144 @@ FOSSIL_TEST(cpp_math_test_sym_substitute_all_vars) {
     fossil::math::Symbolic::free(sub2);
 }
 
+FOSSIL_TEST(cpp_math_test_sym_compiled) {
+    auto expr = fossil::math::Symbolic::parse("x * y + 1");
+    fossil::math::SymCompiled prog(expr, {"x", "y"});
+    ASSUME_ITS_EQUAL_F64(prog({2.0, 3.0}), 7.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(prog({-1.0, 4.0}), -3.0, 0.0);
+    bool thrown = false;
+    try {
+        fossil::math::SymCompiled bad(expr, {"x"});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+    fossil::math::Symbolic::free(expr);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_compiled_batch) {
+    auto expr = fossil::math::Symbolic::parse("x * y + 1");
+    fossil::math::SymCompiled prog(expr, {"x", "y"});
+    std::vector<double> out = prog.eval_batch({{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}});
+    ASSUME_ITS_TRUE(out.size() == 3);
+    ASSUME_ITS_EQUAL_F64(out[0], 5.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(out[2], 19.0, 0.0);
+    fossil::math::Symbolic::free(expr);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_graph) {
+    fossil::math::SymGraph g;
+    fossil_math_sym_node_t x = g.var("x");
+    fossil_math_sym_node_t xx = g.op('*', x, x);
+    fossil_math_sym_node_t f = g.op('+', xx, g.op('*', g.constant(3.0), x));
+    ASSUME_ITS_TRUE(g.op('*', x, x) == xx);
+    fossil_math_sym_node_t d = g.diff(f, "x");
+    ASSUME_ITS_EQUAL_F64(g.eval(d, {"x"}, {2.0}), 7.0, 0.0);
+    fossil::math::SymCompiled prog = g.compile(f, {"x"});
+    ASSUME_ITS_EQUAL_F64(prog({2.0}), 10.0, 0.0);
+    ASSUME_ITS_TRUE(g.count(f) == 5);
+    ASSUME_ITS_TRUE(g.bytes() > 0);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_simplify_canonical) {
+    fossil::math::SymGraph g;
+    auto a = fossil::math::Symbolic::parse("x * 2 + x - y * 0");
+    auto b = fossil::math::Symbolic::parse("3 * x");
+    ASSUME_ITS_TRUE(g.simplify(g.intern(a)) == g.simplify(g.intern(b)));
+    fossil::math::Symbolic::free(a);
+    fossil::math::Symbolic::free(b);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_functions) {
+    auto expr = fossil::math::Symbolic::parse("sin(x)^2 + cos(x)^2 - min(x, y)");
+    fossil::math::SymCompiled prog(expr, {"x", "y"});
+    ASSUME_ITS_EQUAL_F64(prog({0.7, 0.25}), 0.75, 1e-12);
+    std::vector<double> out = prog.eval_batch({{0.5, 2.0}, {1.0, 1.0}});
+    ASSUME_ITS_EQUAL_F64(out[0], 0.5, 1e-12);
+    ASSUME_ITS_EQUAL_F64(out[1], 0.0, 1e-12);
+    fossil::math::Symbolic::free(expr);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_graph_parse) {
+    fossil::math::SymGraph g;
+    fossil_math_sym_node_t f = g.parse("x^2 - 1e-1 * x");
+    ASSUME_ITS_EQUAL_F64(g.eval(f, {"x"}, {2.0}), 3.8, 1e-15);
+    std::string message;
+    try {
+        g.parse("x + (y");
+    } catch (const std::invalid_argument& e) {
+        message = e.what();
+    }
+    ASSUME_ITS_TRUE(message.find("offset 6") != std::string::npos);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_substitute_many) {
+    auto expr = fossil::math::Symbolic::parse("x * y + z");
+    auto sub = fossil::math::Symbolic::substitute(expr, std::vector<std::string>{"x", "y"}, std::vector<double>{2.0, 4.0});
+    ASSUME_ITS_EQUAL_F64(fossil::math::Symbolic::eval(sub, [](const std::string&) { return 1.0; }), 9.0, 1e-15);
+    fossil::math::SymGraph g;
+    fossil_math_sym_node_t f = g.parse("x * y + z");
+    fossil_math_sym_node_t h = g.substitute(f, {"x", "z"}, {g.var("z"), g.constant(1.0)});
+    ASSUME_ITS_EQUAL_F64(g.eval(h, {"y", "z"}, {3.0, 5.0}), 16.0, 1e-15);
+    fossil::math::Symbolic::free(expr);
+    fossil::math::Symbolic::free(sub);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_gradient) {
+    auto expr = fossil::math::Symbolic::parse("x^2 * y + cos(y)");
+    fossil::math::SymCompiled prog = fossil::math::SymCompiled::gradient(expr, {"x", "y"});
+    ASSUME_ITS_TRUE(prog.outputs() == 3);
+    std::vector<double> out = prog.eval_all({3.0, 0.5});
+    ASSUME_ITS_EQUAL_F64(out[0], 4.5 + cos(0.5), 1e-15);
+    ASSUME_ITS_EQUAL_F64(out[1], 3.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(out[2], 9.0 - sin(0.5), 1e-15);
+    fossil::math::Symbolic::free(expr);
+
+    fossil::math::SymGraph g;
+    fossil_math_sym_node_t f = g.parse("x * y * z");
+    std::vector<fossil_math_sym_node_t> grad = g.gradient(f, {"x", "y", "z"});
+    fossil::math::SymCompiled all = g.compile({f, grad[0], grad[1], grad[2]}, {"x", "y", "z"});
+    std::vector<double> v = all.eval_all({2.0, 3.0, 4.0});
+    ASSUME_ITS_EQUAL_F64(v[0], 24.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(v[1], 12.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(v[2], 8.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(v[3], 6.0, 1e-15);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_cache) {
+    fossil::math::SymCache cache;
+    fossil::math::SymCompiled a = cache.compile("x * y - 1", {"x", "y"});
+    fossil::math::SymCompiled b = cache.compile("x * y - 1", {"x", "y"});
+    ASSUME_ITS_EQUAL_F64(b({3.0, 4.0}), 11.0, 1e-15);
+    ASSUME_ITS_TRUE(cache.stats().hits == 1);
+    fossil::math::SymCompiled c = fossil::math::SymCompiled::deserialize(a.serialize());
+    ASSUME_ITS_EQUAL_F64(c({3.0, 4.0}), 11.0, 1e-15);
+    bool threw = false;
+    try {
+        cache.compile("x * (y", {"x", "y"});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+
+    fossil::math::SymGraph g, h;
+    fossil_math_sym_node_t f = g.parse("exp(x) * exp(x)");
+    fossil_math_sym_node_t r = h.deserialize(g.serialize(f));
+    ASSUME_ITS_EQUAL_F64(h.eval(r, {"x"}, {0.5}), exp(1.0), 1e-15);
+}
+
+FOSSIL_TEST(cpp_math_test_sym_interval) {
+    auto expr = fossil::math::Symbolic::parse("x * x - y");
+    fossil_math_sym_interval_t r = fossil::math::Symbolic::eval_interval(expr, {"x", "y"}, {{-2.0, 3.0}, {1.0, 1.0}});
+    ASSUME_ITS_TRUE(r.lo <= -7.0 && r.hi >= 8.0 && r.lo > -7.0 - 1e-12 && r.hi < 8.0 + 1e-12);
+    fossil::math::SymCompiled prog(expr, {"x", "y"});
+    fossil_math_sym_interval_t c = prog.eval_interval({{-2.0, 3.0}, {1.0, 1.0}});
+    ASSUME_ITS_TRUE(c.lo == r.lo && c.hi == r.hi);
+    std::vector<fossil_math_sym_interval_t> b = prog.eval_batch_interval({{{-2.0, 3.0}, {0.0, 1.0}}, {{1.0, 1.0}, {0.0, 0.0}}});
+    ASSUME_ITS_TRUE(b.size() == 2 && b[0].lo == r.lo && b[1].lo <= 0.0 && b[1].hi >= 1.0);
+    fossil::math::Symbolic::free(expr);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -140,6 +278,16 @@ FOSSIL_TEST_GROUP(cpp_symbolicpp_tests) {
     FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_to_string_parens);
     FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_eval_division_by_zero);
     FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_substitute_all_vars);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_compiled);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_compiled_batch);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_graph);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_simplify_canonical);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_functions);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_graph_parse);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_substitute_many);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_gradient);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_cache);
+    FOSSIL_ADD_TEST(cpp_symbolicpp_fixture, cpp_math_test_sym_interval);
 
     FOSSIL_ADD_SUITE(cpp_symbolicpp_fixture);
 } // end of tests